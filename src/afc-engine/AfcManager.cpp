@@ -3,8 +3,12 @@
 #include <QFileInfo>
 
 #include "AfcManager.h"
+#include "KmlWriter.h"
 #include "RlanRegion.h"
 #include "lininterp.h"
+#include "afclogging/LoggingTiming.h"
+#include <future>
+#include <thread>
 
 // "--runtime_opt" masks
 // These bits corresponds to RNTM_OPT_... bits in src/ratapi/ratapi/defs.py
@@ -14,6 +18,7 @@
 #define RUNTIME_OPT_URL 4
 #define RUNTIME_OPT_ENABLE_SLOW_DBG 16
 #define RUNTIME_OPT_CERT_ID 32
+#define RUNTIME_OPT_TERRAIN_PROFILE 64
 
 extern double qerfi(double q);
 
@@ -70,18 +75,24 @@ LOGGER_DEFINE_GLOBAL(logger, "AfcManager")
 // const double fixedRelevance = 0.5;
 
 /**
- * Encapsulates a XML writer to a file
+ * Encapsulates a KML writer to a KMZ file
  * All fields are NULL if filename parameter in constructor is not a valid path.
+ * KMZ entry is compressed on KML writer's background thread
  */
 class ZXmlWriter
 {
 	public:
-		std::unique_ptr<QXmlStreamWriter> xml_writer;
+		std::unique_ptr<KmlWriter> xml_writer;
 		std::unique_ptr<QIODevice> _file;
 		std::unique_ptr<ZipWriter> zip_writer;
 
 		ZXmlWriter(const std::string &filename);
 		~ZXmlWriter();
+
+		/** Flushes KML document and closes KMZ file. Throws
+		 * std::runtime_error on write error
+		 */
+		void close();
 };
 
 ZXmlWriter::ZXmlWriter(const std::string &filename)
@@ -89,7 +100,13 @@ ZXmlWriter::ZXmlWriter(const std::string &filename)
 	if (!filename.empty()) {
 		zip_writer.reset(new ZipWriter(QString::fromStdString(filename)));
 		_file = zip_writer->openFile("doc.kml");
-		xml_writer.reset(new QXmlStreamWriter(_file.get()));
+		QIODevice *file = _file.get();
+		xml_writer.reset(new KmlWriter([file](const char *data, size_t len) {
+			if (file->write(data, (qint64)len) != (qint64)len) {
+				throw std::runtime_error("Error writing KMZ file: " +
+							 file->errorString().toStdString());
+			}
+		}));
 	}
 }
 
@@ -99,6 +116,45 @@ ZXmlWriter::~ZXmlWriter()
 	_file.reset();
 	zip_writer.reset();
 }
+
+void ZXmlWriter::close()
+{
+	if (xml_writer) {
+		xml_writer->finish();
+		xml_writer.reset();
+	}
+	if (_file) {
+		// ZipWriter content file only reports close failure via error string
+		QString prevError = _file->errorString();
+		_file->close();
+		if (_file->errorString() != prevError) {
+			throw std::runtime_error("Error writing KMZ file: " +
+						 _file->errorString().toStdString());
+		}
+		_file.reset();
+	}
+	zip_writer.reset();
+}
+
+/** Queues heatmap grid point for evaluation unless its value is already set
+ * @param lonIdx Longitude index of grid point
+ * @param latIdx Latitude index of grid point
+ * @param numPtsLat Number of latitude values in grid
+ * @param evalPtList List of points evaluated in next pass
+ * @param ptDoneList Per point flags (lonIdx * numPtsLat + latIdx): value set or queued
+ */
+void queueHeatmapPoint(int lonIdx,
+		       int latIdx,
+		       int numPtsLat,
+		       std::vector<std::pair<int, int>> &evalPtList,
+		       std::vector<bool> &ptDoneList)
+{
+	int ptIdx = lonIdx * numPtsLat + latIdx;
+	if (!ptDoneList[ptIdx]) {
+		ptDoneList[ptIdx] = true;
+		evalPtList.push_back(std::make_pair(lonIdx, latIdx));
+	}
+}
 }; // end namespace
 
 namespace OpClass
@@ -324,20 +380,11 @@ class ExcThrParamClass
 	public:
 		double rlanDiscriminationGainDB;
 		double bodyLossDB;
-		std::string buildingPenetrationModelStr;
+		CConst::BuildingPenetrationModelEnum buildingPenetrationModel;
 		double buildingPenetrationCDF;
 		double buildingPenetrationDB;
 		double angleOffBoresightDeg;
-		std::string pathLossModelStr;
-		double pathLossCDF;
-		std::string pathClutterTxModelStr;
-		double pathClutterTxCDF;
-		double pathClutterTxDB;
-		std::string txClutterStr;
-		std::string pathClutterRxModelStr;
-		double pathClutterRxCDF;
-		double pathClutterRxDB;
-		std::string rxClutterStr;
+		PathLossResultClass pathLossResult;
 		double rxGainDB;
 		double discriminationGain;
 		std::string rxAntennaSubModelStr;
@@ -439,8 +486,8 @@ class ExThrGzipCsv : public GzipCsv
 		ColDouble fresnelIndex;
 		ColStr comment; // Field from runExclusionZoneAnalysis()
 
-		ExThrGzipCsv(const std::string filename) :
-			GzipCsv(filename),
+		ExThrGzipCsv(const std::string filename, Format format = Format::CsvGz) :
+			GzipCsv(filename, DEFAULT_COMPRESS_LEVEL, format),
 			fsid(this, "FS_ID"),
 			region(this, "FS_REGION"),
 			dbName(this, "DBNAME"),
@@ -564,7 +611,10 @@ AfcManager::AfcManager()
 	_createKmz = false;
 	_createDebugFiles = false;
 	_createSlowDebugFiles = false;
+	_createTerrainProfile = false;
 	_certifiedIndoor = false;
+	_excThrFormat = GzipCsv::Format::CsvGz;
+	_asyncLogFlag = false;
 
 	_dataIf = (AfcDataIf *)NULL;
 
@@ -683,6 +733,13 @@ AfcManager::AfcManager()
 	_closeInDist = quietNaN;
 	_pathLossClampFSPL = false;
 	_printSkippedLinksFlag = false;
+	_rxGainTableFlag = false;
+	_itmScreeningFlag = false;
+	_itmScreeningMarginDB = 10.0;
+	_itmScreeningDecimation = 8;
+	_heatmapRefineFlag = false;
+	_heatmapRefineStep = 8;
+	_heatmapRefineTolDB = 3.0;
 	_roundPSDEIRPFlag = true;
 
 	_wlanMinFreqMHz = -1;
@@ -742,6 +799,7 @@ AfcManager::AfcManager()
 
 	_heatmapIToNDB = (double **)NULL;
 	_heatmapIsIndoor = (bool **)NULL;
+	_heatmapIsInterpolated = (bool **)NULL;
 	_heatmapNumPtsLon = 0;
 	_heatmapNumPtsLat = 0;
 	_heatmapMinIToNDB = quietNaN;
@@ -790,6 +848,7 @@ bool sortFunction(std::pair<double, double> p0, std::pair<double, double> p1)
 /******************************************************************************************/
 void AfcManager::initializeDatabases()
 {
+	LOGGER_TIMED_SCOPE("initializeDatabases");
 	if (_responseCode != CConst::successResponseCode) {
 		return;
 	}
@@ -822,6 +881,9 @@ void AfcManager::initializeDatabases()
 						 << regionPolygonFileStrList[regionIdx]);
 		}
 
+		// Speeds up numerous in_bdy_area() calls (e.g. when population grid is built)
+		regionPoly->buildMask();
+
 		_regionPolygonList.push_back(regionPoly);
 		LOGGER_INFO(logger) << "REGION: " << regionPolygonFileStrList[regionIdx]
 				    << " AREA: " << regionArea;
@@ -897,28 +959,7 @@ void AfcManager::initializeDatabases()
 	/**************************************************************************************/
 	/* Set Path Loss Model Parameters                                                     */
 	/**************************************************************************************/
-	switch (_pathLossModel) {
-		case CConst::ITMBldgPathLossModel:
-			_closeInDist = 0.0; // Radius in which close in path loss model is used
-			break;
-		case CConst::CoalitionOpt6PathLossModel:
-			_closeInDist = 1.0e3; // Radius in which close in path loss model is used
-			break;
-		case CConst::FCC6GHzReportAndOrderPathLossModel:
-			_closeInDist = 1.0e3; // Radius in which close in path loss model is used
-			break;
-		case CConst::FSPLPathLossModel:
-			_closeInDist = 0.0; // Radius in which close in path loss model is used
-			break;
-		default:
-			throw std::runtime_error(
-				ErrStream()
-				<< std::string("ERROR: Path Loss Model set to invalid value \"") +
-					   CConst::strPathLossModelList->type_to_str(
-						   _pathLossModel) +
-					   "\"");
-			break;
-	}
+	setPathLossModel(_pathLossModel);
 
 	ULSClass::pathLossModel = _pathLossModel;
 
@@ -1166,7 +1207,7 @@ void AfcManager::initializeDatabases()
 	/**************************************************************************************/
 	/* Setup ITU data                                                                    */
 	/**************************************************************************************/
-	_ituData = new ITUDataClass(_radioClimateFile, _surfRefracFile);
+	_ituData = new ITUDataClass(_radioClimateFile, _surfRefracFile, _gridCacheDir);
 	LOGGER_INFO(logger) << "Reading ITU data files: " << _radioClimateFile << " and "
 			    << _surfRefracFile;
 	/**************************************************************************************/
@@ -1220,6 +1261,7 @@ void AfcManager::initializeDatabases()
 			_rainForestPolygon = PolygonClass::combinePolygons(polyList);
 
 			_rainForestPolygon->name = "Rain Forest";
+			_rainForestPolygon->buildMask();
 
 			for (int polyIdx = 0; polyIdx < (int)polyList.size(); ++polyIdx) {
 				PolygonClass *poly = polyList[polyIdx];
@@ -1236,7 +1278,8 @@ void AfcManager::initializeDatabases()
 					    minLat,
 					    minLon,
 					    maxLat,
-					    maxLon);
+					    maxLon,
+					    _gridCacheDir);
 	}
 	/**************************************************************************************/
 
@@ -1275,17 +1318,91 @@ void AfcManager::initializeDatabases()
 	splitFrequencyRanges();
 
 	/**************************************************************************************/
-	/* Convert confidences it gaussian thresholds                                         */
+	/* Convert confidences to gaussian thresholds and precompute propagation model       */
+	/* coefficients for each channel/segment frequency                                    */
 	/**************************************************************************************/
+	setPropModelConfidence(_confidenceBldg2109,
+			       _confidenceClutter2108,
+			       _fsConfidenceClutter2108,
+			       _confidenceWinner2LOS,
+			       _confidenceWinner2NLOS,
+			       _confidenceWinner2Combined);
+	for (const auto &channel : _channelList) {
+		_propModelContext.addChannel(channel.freqMHzList);
+	}
+	LOGGER_DEBUG(logger) << "Propagation model coefficients precomputed for "
+			     << _propModelContext.getNumFreq() << " frequencies";
+	/**************************************************************************************/
+}
+/**************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: AfcManager::setPathLossModel()                                         ****/
+/**** Sets path loss model and parameters derived from it.                             ****/
+/******************************************************************************************/
+void AfcManager::setPathLossModel(CConst::PathLossModelEnum pathLossModel)
+{
+	switch (pathLossModel) {
+		case CConst::ITMBldgPathLossModel:
+			_closeInDist = 0.0; // Radius in which close in path loss model is used
+			break;
+		case CConst::CoalitionOpt6PathLossModel:
+			_closeInDist = 1.0e3; // Radius in which close in path loss model is used
+			break;
+		case CConst::FCC6GHzReportAndOrderPathLossModel:
+			_closeInDist = 1.0e3; // Radius in which close in path loss model is used
+			break;
+		case CConst::FSPLPathLossModel:
+			_closeInDist = 0.0; // Radius in which close in path loss model is used
+			break;
+		default:
+			throw std::runtime_error(
+				ErrStream()
+				<< std::string("ERROR: Path Loss Model set to invalid value \"") +
+					   CConst::strPathLossModelList->type_to_str(
+						   pathLossModel) +
+					   "\"");
+			break;
+	}
+
+	_pathLossModel = pathLossModel;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: AfcManager::setPropModelConfidence()                                   ****/
+/**** Converts model confidences to gaussian thresholds. Clears precomputed model      ****/
+/**** coefficients, as they depend on confidence.                                      ****/
+/******************************************************************************************/
+void AfcManager::setPropModelConfidence(double confidenceBldg2109,
+					double confidenceClutter2108,
+					double fsConfidenceClutter2108,
+					double confidenceWinner2LOS,
+					double confidenceWinner2NLOS,
+					double confidenceWinner2Combined)
+{
+	_confidenceBldg2109 = confidenceBldg2109;
+	_confidenceClutter2108 = confidenceClutter2108;
+	_fsConfidenceClutter2108 = fsConfidenceClutter2108;
+	_confidenceWinner2LOS = confidenceWinner2LOS;
+	_confidenceWinner2NLOS = confidenceWinner2NLOS;
+	_confidenceWinner2Combined = confidenceWinner2Combined;
+
 	_zbldg2109 = -qerfi(_confidenceBldg2109);
 	_zclutter2108 = -qerfi(_confidenceClutter2108);
 	_fsZclutter2108 = -qerfi(_fsConfidenceClutter2108);
 	_zwinner2LOS = -qerfi(_confidenceWinner2LOS);
 	_zwinner2NLOS = -qerfi(_confidenceWinner2NLOS);
 	_zwinner2Combined = -qerfi(_confidenceWinner2Combined);
-	/**************************************************************************************/
+
+	_propModelContext.setConfidence(_zbldg2109,
+					_zclutter2108,
+					_fsZclutter2108,
+					_zwinner2LOS,
+					_zwinner2NLOS,
+					_zwinner2Combined);
 }
-/**************************************************************************************/
+/******************************************************************************************/
 
 /******************************************************************************************/
 /**** FUNCTION: AfcManager::clearData                                                  ****/
@@ -1315,6 +1432,15 @@ void AfcManager::clearData()
 		free(_heatmapIsIndoor);
 	}
 
+	if (_heatmapIsInterpolated) {
+		int lonIdx;
+		for (lonIdx = 0; lonIdx < _heatmapNumPtsLon; ++lonIdx) {
+			free(_heatmapIsInterpolated[lonIdx]);
+		}
+		free(_heatmapIsInterpolated);
+		_heatmapIsInterpolated = (bool **)NULL;
+	}
+
 	if (_heatmapIToNDB) {
 		int lonIdx;
 		for (lonIdx = 0; lonIdx < _heatmapNumPtsLon; ++lonIdx) {
@@ -1364,6 +1490,7 @@ void AfcManager::clearULSList()
 /******************************************************************************************/
 void AfcManager::importGUIjson(const std::string &inputJSONpath)
 {
+	LOGGER_TIMED_SCOPE("importGUIjson");
 	// Read input parameters from GUI in JSON file
 	QJsonDocument jsonDoc;
 	// Use SearchPaths::forReading("data", ..., true) to ensure that the input file exists
@@ -2638,7 +2765,30 @@ void AfcManager::setCmdLineParams(std::string &inputFilePath,
 				 po::value<uint32_t>()->default_value(3),
 				 "bit 0: create 'fast' debug files; bit 1: create kmz and progress "
 				 "files; bit 2: interpret file pathes as URLs; bit 4: create "
-				 "'slow' debug files");
+				 "'slow' debug files; bit 6: create terrain access profile")(
+		"shared-tile-cache",
+		po::value<std::string>()->default_value(""),
+		"name of POSIX shared memory object for terrain tile cache, shared by all "
+		"engine processes on the node (e.g. '/afc_tiles'). Empty to not use")(
+		"shared-tile-cache-mb",
+		po::value<int>()->default_value(SharedTileCache::DEFAULT_SEGMENT_MB),
+		"size of shared terrain tile cache in megabytes (only used when cache is "
+		"created)")("grid-cache-dir",
+			    po::value<std::string>()->default_value(""),
+			    "directory for memory-mapped cache of preprocessed population and ITU "
+			    "grids. Empty to not use")(
+		"exc-thr-format",
+		po::value<std::string>()->default_value("csv"),
+		"format of exc_thr debug file: 'csv' (exc_thr.csv.gz) or 'columnar' (binary "
+		"exc_thr.afccol, see tools/columnar)")(
+		"timing-report",
+		po::value<std::string>()->default_value(""),
+		"file for JSON report on time spent in processing phases and path loss models. "
+		"Empty to not measure")(
+		"async-log",
+		po::bool_switch(),
+		"write log records from background thread. Records still queued when engine "
+		"aborts or is killed are lost");
 
 	po::variables_map cmdLineArgs;
 	po::store(po::parse_command_line(argc, argv, optDescript),
@@ -2725,11 +2875,44 @@ void AfcManager::setCmdLineParams(std::string &inputFilePath,
 		if (tmp & RUNTIME_OPT_ENABLE_SLOW_DBG) {
 			AfcManager::_createSlowDebugFiles = true;
 		}
+		if (tmp & RUNTIME_OPT_TERRAIN_PROFILE) {
+			// Must be set before CachedGdal objects are created
+			AfcManager::_createTerrainProfile = true;
+			CachedGdalBase::setAccessProfiler(std::make_shared<GdalAccessProfiler>());
+		}
+	}
+	_gridCacheDir = cmdLineArgs["grid-cache-dir"].as<std::string>();
+	std::string excThrFormat = cmdLineArgs["exc-thr-format"].as<std::string>();
+	if (excThrFormat == "csv") {
+		_excThrFormat = GzipCsv::Format::CsvGz;
+	} else if (excThrFormat == "columnar") {
+		_excThrFormat = GzipCsv::Format::Columnar;
+	} else {
+		throw std::runtime_error("AfcManager::setCmdLineParams(): exc-thr-format command "
+					 "line argument has invalid value '" +
+					 excThrFormat + "'");
+	}
+	_timingReportFile = cmdLineArgs["timing-report"].as<std::string>();
+	Logging::setTimingEnabled(!_timingReportFile.empty());
+	_asyncLogFlag = cmdLineArgs["async-log"].as<bool>();
+	if (!cmdLineArgs["shared-tile-cache"].as<std::string>().empty()) {
+		// Failure to use shared cache is not fatal - tiles will be read from GDAL files
+		try {
+			size_t maxTileBytes = (size_t)CachedGdalBase::DEFAULT_MAX_TILE_SIZE *
+					      CachedGdalBase::DEFAULT_MAX_TILE_SIZE * sizeof(float);
+			CachedGdalBase::setSharedTileCache(std::make_shared<SharedTileCache>(
+				cmdLineArgs["shared-tile-cache"].as<std::string>(),
+				(size_t)cmdLineArgs["shared-tile-cache-mb"].as<int>() << 20,
+				maxTileBytes));
+		} catch (std::exception &err) {
+			LOGGER_WARN(logger) << "Shared tile cache not used: " << err.what();
+		}
 	}
 }
 
 void AfcManager::importConfigAFCjson(const std::string &inputJSONpath, const std::string &tempDir)
 {
+	LOGGER_TIMED_SCOPE("importConfigAFCjson");
 	QString errMsg;
 
 	if (_responseCode != CConst::successResponseCode) {
@@ -3561,6 +3744,75 @@ void AfcManager::importConfigAFCjson(const std::string &inputJSONpath, const std
 		_printSkippedLinksFlag = false;
 	}
 
+	// ***********************************
+	// If this flag is set, FS antenna gain is interpolated from per pattern tables, cells of
+	// table where interpolation error exceeds 0.01 dB are computed from pattern
+	// ***********************************
+	if (jsonObj.contains("rxGainTableFlag") && !jsonObj["rxGainTableFlag"].isUndefined()) {
+		_rxGainTableFlag = jsonObj["rxGainTableFlag"].toBool();
+	} else {
+		_rxGainTableFlag = false;
+	}
+
+	// ***********************************
+	// If this flag is set, ITM path loss is first computed on coarse terrain profile (every
+	// itmScreeningDecimation-th point) and lowered by itmScreeningMarginDB. Full ITM path
+	// loss is computed only if EIRP limit for this lower bound is below current channel EIRP
+	// ***********************************
+	if (jsonObj.contains("itmScreeningFlag") && !jsonObj["itmScreeningFlag"].isUndefined()) {
+		_itmScreeningFlag = jsonObj["itmScreeningFlag"].toBool();
+	} else {
+		_itmScreeningFlag = false;
+	}
+	if (jsonObj.contains("itmScreeningMarginDB") &&
+	    !jsonObj["itmScreeningMarginDB"].isUndefined()) {
+		_itmScreeningMarginDB = jsonObj["itmScreeningMarginDB"].toDouble();
+	} else {
+		_itmScreeningMarginDB = 10.0;
+	}
+	if (jsonObj.contains("itmScreeningDecimation") &&
+	    !jsonObj["itmScreeningDecimation"].isUndefined()) {
+		_itmScreeningDecimation = jsonObj["itmScreeningDecimation"].toInt();
+	} else {
+		_itmScreeningDecimation = 8;
+	}
+	if ((_itmScreeningMarginDB < 0.0) || (_itmScreeningDecimation < 1)) {
+		throw std::runtime_error(ErrStream() << "ERROR: Invalid ITM screening parameters: "
+							"itmScreeningMarginDB = "
+						     << _itmScreeningMarginDB
+						     << ", itmScreeningDecimation = "
+						     << _itmScreeningDecimation);
+	}
+
+	// ***********************************
+	// If this flag is set, heatmap I/N is computed on grid with spacing of heatmapRefineStep
+	// points. Cells whose corners straddle a color threshold or differ by more than
+	// heatmapRefineTolDB are subdivided, remaining points are interpolated
+	// ***********************************
+	if (jsonObj.contains("heatmapRefineFlag") && !jsonObj["heatmapRefineFlag"].isUndefined()) {
+		_heatmapRefineFlag = jsonObj["heatmapRefineFlag"].toBool();
+	} else {
+		_heatmapRefineFlag = false;
+	}
+	if (jsonObj.contains("heatmapRefineStep") && !jsonObj["heatmapRefineStep"].isUndefined()) {
+		_heatmapRefineStep = jsonObj["heatmapRefineStep"].toInt();
+	} else {
+		_heatmapRefineStep = 8;
+	}
+	if (jsonObj.contains("heatmapRefineTolDB") &&
+	    !jsonObj["heatmapRefineTolDB"].isUndefined()) {
+		_heatmapRefineTolDB = jsonObj["heatmapRefineTolDB"].toDouble();
+	} else {
+		_heatmapRefineTolDB = 3.0;
+	}
+	if ((_heatmapRefineStep < 1) || (_heatmapRefineTolDB < 0.0)) {
+		throw std::runtime_error(ErrStream() << "ERROR: Invalid heatmap refinement "
+							"parameters: heatmapRefineStep = "
+						     << _heatmapRefineStep
+						     << ", heatmapRefineTolDB = "
+						     << _heatmapRefineTolDB);
+	}
+
 	if (jsonObj.contains("roundPSDEIRPFlag") && !jsonObj["roundPSDEIRPFlag"].isUndefined()) {
 		_roundPSDEIRPFlag = jsonObj["roundPSDEIRPFlag"].toBool();
 	} else {
@@ -3654,12 +3906,13 @@ void AfcManager::importConfigAFCjson(const std::string &inputJSONpath, const std
 	}
 }
 
-QJsonArray generateStatusMessages(const std::vector<std::string> &messages)
+void writeStatusMessages(JsonWriter &json, const std::vector<std::string> &messages)
 {
-	auto array = QJsonArray();
-	for (auto &m : messages)
-		array.append(QJsonValue(QString::fromStdString(m)));
-	return array;
+	json.beginArray();
+	for (auto &m : messages) {
+		json.value(m);
+	}
+	json.endArray();
 }
 
 void AfcManager::addBuildingDatabaseTiles(OGRLayer *layer)
@@ -3887,47 +4140,44 @@ void AfcManager::addDeniedRegions(OGRLayer *layer)
 	}
 }
 
-QJsonDocument AfcManager::generateRatAfcJson()
+void AfcManager::writeRatAfcJson(JsonWriter &json)
 {
 	std::vector<psdFreqRangeClass> psdFreqRangeList;
 	computeInquiredFreqRangesPSD(psdFreqRangeList);
 
-	// compute availableSpectrumInfo
-	QJsonArray spectrumInfos = QJsonArray();
+	// availableSpectrumInfo is only written if there is at least one valid PSD
+	bool hasSpectrumInfos = false;
 	for (auto &freqRange : psdFreqRangeList) {
-		for (int i = 0; i < (int)freqRange.psd_dBm_MHzList.size(); i++) {
-			if (!std::isnan(freqRange.psd_dBm_MHzList.at(i))) {
-				spectrumInfos.append(QJsonObject {
-					{"frequencyRange",
-					 QJsonObject {{"lowFrequency", freqRange.freqMHzList.at(i)},
-						      {"highFrequency",
-						       freqRange.freqMHzList.at(i + 1)}}},
-					{"maxPsd", freqRange.psd_dBm_MHzList.at(i)}});
-			}
+		for (auto &psd : freqRange.psd_dBm_MHzList) {
+			hasSpectrumInfos = hasSpectrumInfos || !std::isnan(psd);
 		}
 	}
 
-	QJsonArray channelInfos = QJsonArray();
-	QJsonArray blackChannelInfos = QJsonArray();
-	QJsonArray redChannelInfos = QJsonArray();
+	// Channel indices and EIRPs per inquired operating class
+	struct ChannelGroup {
+			int operatingClass;
+			std::vector<int> indices;
+			std::vector<double> eirps;
+			std::vector<int> blackIndices;
+			std::vector<int> redIndices;
+	};
+	std::vector<ChannelGroup> channelGroups;
 	if (_responseCode == CConst::successResponseCode) {
 		for (const auto &group : _inquiredChannels) {
-			auto operatingClass = group.first;
-			auto indexArray = QJsonArray();
-			auto blackIndexArray = QJsonArray();
-			auto redIndexArray = QJsonArray();
-			auto eirpArray = QJsonArray();
+			channelGroups.push_back(ChannelGroup());
+			ChannelGroup &channelGroup = channelGroups.back();
+			channelGroup.operatingClass = group.first;
 
 			for (const auto &chan : _channelList) {
 				if ((chan.type == ChannelType::INQUIRED_CHANNEL) &&
-				    (chan.operatingClass == operatingClass)) {
+				    (chan.operatingClass == channelGroup.operatingClass)) {
 					ChannelColor chanColor = std::get<2>(chan.segList[0]);
 					if (chanColor == BLACK) {
-						blackIndexArray.append(chan.index);
+						channelGroup.blackIndices.push_back(chan.index);
 					} else if (chanColor == RED) {
-						redIndexArray.append(chan.index);
+						channelGroup.redIndices.push_back(chan.index);
 					} else {
-						indexArray.append(chan.index);
+						channelGroup.indices.push_back(chan.index);
 						double eirpVal =
 							std::min(std::get<0>(chan.segList[0]),
 								 std::get<1>(chan.segList[0]));
@@ -3936,24 +4186,10 @@ QJsonDocument AfcManager::generateRatAfcJson()
 							// multiple of 0.1 dB
 							eirpVal = std::floor(eirpVal * 10) / 10.0;
 						}
-						eirpArray.append(eirpVal);
+						channelGroup.eirps.push_back(eirpVal);
 					}
 				}
 			}
-
-			auto channelGroup = QJsonObject {{"globalOperatingClass",
-							  QJsonValue(operatingClass)},
-							 {"channelCfi", indexArray},
-							 {"maxEirp", eirpArray}};
-			auto blackChannelGroup = QJsonObject {{"globalOperatingClass",
-							       QJsonValue(operatingClass)},
-							      {"channelCfi", blackIndexArray}};
-			auto redChannelGroup = QJsonObject {{"globalOperatingClass",
-							     QJsonValue(operatingClass)},
-							    {"channelCfi", redIndexArray}};
-			channelInfos.append(channelGroup);
-			blackChannelInfos.append(blackChannelGroup);
-			redChannelInfos.append(redChannelGroup);
 		}
 	}
 
@@ -3999,82 +4235,115 @@ QJsonDocument AfcManager::generateRatAfcJson()
 		hasSupplementalInfoFlag = true;
 	}
 
-	QJsonObject responseObj;
-	responseObj.insert("responseCode", _responseCode);
-	responseObj.insert("shortDescription", shortDescription.c_str());
-
-	if (hasSupplementalInfoFlag) {
-		QJsonObject paramObj;
-		QJsonArray paramsArray;
-
-		if (_missingParams.size()) {
-			paramsArray = QJsonArray();
-			for (auto &param : _missingParams) {
-				paramsArray.append(param);
+	json.beginObject();
+	json.key("version").value(_guiJsonVersion.toStdString());
+	json.key("availableSpectrumInquiryResponses").beginArray();
+	json.beginObject();
+	json.key("requestId").value(_requestId.toStdString());
+	json.key("rulesetId").value(_rulesetId.toStdString());
+	if (!channelGroups.empty()) {
+		json.key("availableChannelInfo").beginArray();
+		for (auto &channelGroup : channelGroups) {
+			json.beginObject();
+			json.key("globalOperatingClass").value(channelGroup.operatingClass);
+			json.key("channelCfi").beginArray();
+			for (auto index : channelGroup.indices) {
+				json.value(index);
 			}
-			paramObj.insert("missingParams", paramsArray);
-		}
-
-		if (_invalidParams.size()) {
-			paramsArray = QJsonArray();
-			for (auto &param : _invalidParams) {
-				paramsArray.append(param);
+			json.endArray();
+			json.key("maxEirp").beginArray();
+			for (auto eirp : channelGroup.eirps) {
+				json.value(eirp);
 			}
-			paramObj.insert("invalidParams", paramsArray);
+			json.endArray();
+			json.endObject();
 		}
-
-		if (_unexpectedParams.size()) {
-			paramsArray = QJsonArray();
-			for (auto &param : _unexpectedParams) {
-				paramsArray.append(param);
+		json.endArray();
+	}
+	if (hasSpectrumInfos) {
+		json.key("availableFrequencyInfo").beginArray();
+		for (auto &freqRange : psdFreqRangeList) {
+			for (int i = 0; i < (int)freqRange.psd_dBm_MHzList.size(); i++) {
+				if (!std::isnan(freqRange.psd_dBm_MHzList.at(i))) {
+					json.beginObject();
+					json.key("frequencyRange").beginObject();
+					json.key("lowFrequency").value(freqRange.freqMHzList.at(i));
+					json.key("highFrequency")
+						.value(freqRange.freqMHzList.at(i + 1));
+					json.endObject();
+					json.key("maxPsd").value(freqRange.psd_dBm_MHzList.at(i));
+					json.endObject();
+				}
 			}
-			paramObj.insert("unexpectedParams", paramsArray);
 		}
-
-		responseObj.insert("supplementalInfo", paramObj);
-	}
-
-	QJsonObject availableSpectrumInquiryResponse;
-	availableSpectrumInquiryResponse.insert("requestId", _requestId);
-	availableSpectrumInquiryResponse.insert("rulesetId", _rulesetId);
-	if (channelInfos.size()) {
-		availableSpectrumInquiryResponse.insert("availableChannelInfo", channelInfos);
-	}
-	if (spectrumInfos.size()) {
-		availableSpectrumInquiryResponse.insert("availableFrequencyInfo", spectrumInfos);
+		json.endArray();
 	}
 	if (_responseCode == CConst::successResponseCode) {
-		availableSpectrumInquiryResponse.insert("availabilityExpireTime",
-							ISO8601TimeUTC(1));
+		json.key("availabilityExpireTime").value(ISO8601TimeUTC(1).toStdString());
+	}
+
+	json.key("vendorExtensions").beginArray();
+	json.beginObject();
+	json.key("extensionId").value("openAfc.redBlackData");
+	json.key("parameters").beginObject();
+	if (!channelGroups.empty()) {
+		json.key("blackChannelInfo").beginArray();
+		for (auto &channelGroup : channelGroups) {
+			json.beginObject();
+			json.key("globalOperatingClass").value(channelGroup.operatingClass);
+			json.key("channelCfi").beginArray();
+			for (auto index : channelGroup.blackIndices) {
+				json.value(index);
+			}
+			json.endArray();
+			json.endObject();
+		}
+		json.endArray();
+		json.key("redChannelInfo").beginArray();
+		for (auto &channelGroup : channelGroups) {
+			json.beginObject();
+			json.key("globalOperatingClass").value(channelGroup.operatingClass);
+			json.key("channelCfi").beginArray();
+			for (auto index : channelGroup.redIndices) {
+				json.value(index);
+			}
+			json.endArray();
+			json.endObject();
+		}
+		json.endArray();
 	}
+	json.endObject();
+	json.endObject();
+	json.endArray();
 
-	QJsonObject extensionParameterObj;
-	if (blackChannelInfos.size()) {
-		extensionParameterObj.insert("blackChannelInfo", blackChannelInfos);
-	}
-	if (redChannelInfos.size()) {
-		extensionParameterObj.insert("redChannelInfo", redChannelInfos);
+	json.key("response").beginObject();
+	json.key("responseCode").value((int)_responseCode);
+	json.key("shortDescription").value(shortDescription);
+	if (hasSupplementalInfoFlag) {
+		json.key("supplementalInfo").beginObject();
+		const std::vector<std::pair<const char *, const QStringList *>> paramLists = {
+			{"missingParams", &_missingParams},
+			{"invalidParams", &_invalidParams},
+			{"unexpectedParams", &_unexpectedParams}};
+		for (auto &paramList : paramLists) {
+			if (paramList.second->size()) {
+				json.key(paramList.first).beginArray();
+				for (auto &param : *paramList.second) {
+					json.value(param.toStdString());
+				}
+				json.endArray();
+			}
+		}
+		json.endObject();
 	}
+	json.endObject();
 
-	QJsonObject vendorExtensionObj;
-	vendorExtensionObj.insert("extensionId", "openAfc.redBlackData");
-	vendorExtensionObj.insert("parameters", extensionParameterObj);
-
-	QJsonArray vendorExtensionArray;
-	vendorExtensionArray.append(vendorExtensionObj);
-
-	availableSpectrumInquiryResponse.insert("vendorExtensions", vendorExtensionArray);
-
-	availableSpectrumInquiryResponse.insert("response", responseObj);
-
-	QJsonObject responses {{"version", _guiJsonVersion},
-			       {"availableSpectrumInquiryResponses",
-				QJsonArray {availableSpectrumInquiryResponse}}};
-
-	return QJsonDocument(responses);
+	json.endObject();
+	json.endArray();
+	json.endObject();
 }
 
-QJsonDocument AfcManager::generateExclusionZoneJson()
+void AfcManager::writeExclusionZoneJson(JsonWriter &json)
 {
 	QTemporaryDir tempDir;
 	if (!tempDir.isValid()) {
@@ -4186,20 +4455,12 @@ QJsonDocument AfcManager::generateExclusionZoneJson()
 	// Allocation clean-up
 	GDALClose(dataSet); // Remove the reference to the dataset
 
-	// Create file to be written to (creates a file, a json object, and a json document in order
-	// to store)
-	std::ifstream tempFileStream(tempOutFilePath.toStdString(), std::ifstream::in);
-	const std::string geoJsonCollection = slurp(tempFileStream);
-
-	QJsonDocument geoJsonDoc = QJsonDocument::fromJson(
-		QString::fromStdString(geoJsonCollection).toUtf8());
-	QJsonObject geoJsonObj = geoJsonDoc.object();
-
-	QJsonObject analysisJsonObj = {{"geoJson", geoJsonObj},
-				       {"statusMessageList",
-					generateStatusMessages(statusMessageList)}};
-
-	return QJsonDocument(analysisJsonObj);
+	// GeoJSON, written by GDAL, is copied to output as is
+	json.beginObject();
+	json.key("geoJson").rawValueFromFile(tempOutFilePath.toStdString());
+	json.key("statusMessageList");
+	writeStatusMessages(json, statusMessageList);
+	json.endObject();
 }
 
 OGRLayer *AfcManager::createGeoJSONLayer(const char *tmpPath, GDALDataset **dataSet)
@@ -4243,10 +4504,12 @@ void AfcManager::addHeatmap(OGRLayer *layer)
 	OGRFieldDefn objOpacity("fill-opacity", OFTReal);
 	OGRFieldDefn valueField(valueStr.c_str(), OFTReal);
 	OGRFieldDefn indoor("indoor", OFTString);
+	OGRFieldDefn interpolated("interpolated", OFTString);
 	objFill.SetWidth(8);
 	objOpacity.SetWidth(32);
 	valueField.SetWidth(32);
 	indoor.SetWidth(32);
+	interpolated.SetWidth(32);
 
 	if (layer->CreateField(&objFill) != OGRERR_NONE) {
 		throw std::runtime_error("AfcManager::addHeatmap(): Could not create 'fill' field "
@@ -4264,6 +4527,10 @@ void AfcManager::addHeatmap(OGRLayer *layer)
 		throw std::runtime_error("AfcManager::addHeatmap(): Could not create 'indoor' "
 					 "field in layer of the output data source");
 	}
+	if (_heatmapRefineFlag && (layer->CreateField(&interpolated) != OGRERR_NONE)) {
+		throw std::runtime_error("AfcManager::addHeatmap(): Could not create "
+					 "'interpolated' field in layer of the output data source");
+	}
 
 	double latDel = 0.5 * (_heatmapMaxLat - _heatmapMinLat) /
 			_heatmapNumPtsLat; // distance from center point to top/bot side of square
@@ -4324,6 +4591,11 @@ void AfcManager::addHeatmap(OGRLayer *layer)
 			}
 			heatmapFeature->SetField("indoor",
 						 _heatmapIsIndoor[lonIdx][latIdx] ? "Y" : "N");
+			if (_heatmapRefineFlag) {
+				heatmapFeature->SetField(
+					"interpolated",
+					_heatmapIsInterpolated[lonIdx][latIdx] ? "Y" : "N");
+			}
 
 			// Create OGRPoints to store the coordinates of the heatmap box
 			// ***IMPORTANT NOTE: Coordinates stored as (Lon,Lat) here, required by
@@ -4377,7 +4649,18 @@ void AfcManager::addHeatmap(OGRLayer *layer)
 
 void AfcManager::exportGUIjson(const QString &exportJsonPath, const std::string &tempDir)
 {
-	QJsonDocument outputDocument;
+	LOGGER_TIMED_SCOPE("exportGUIjson");
+	// Response is compressed and written as it is generated
+	std::unique_ptr<AfcGzipWriter> outputWriter = AfcManager::_dataIf->openGzipWriter(
+		exportJsonPath);
+	if (!outputWriter) {
+		throw std::runtime_error("Error writing output file");
+	}
+	JsonWriter json([&outputWriter](const char *data, size_t len) {
+		if (!outputWriter->write(data, len)) {
+			throw std::runtime_error("Error writing output file");
+		}
+	});
 	if (_analysisType == "APAnalysis") {
 		// if the request type is PAWS then we only return the spectrum data
 		// outputDocument = QJsonDocument(jsonSpectrumData(_channelList, _deviceDesc,
@@ -4395,16 +4678,16 @@ void AfcManager::exportGUIjson(const QString &exportJsonPath, const std::string
 		// temporarily return PAWS until we write new generator function
 		// outputDocument = QJsonDocument(jsonSpectrumData(_rlanBWList, _numChan,
 		// _channelData, _deviceDesc, _wlanMinFreq));
-		outputDocument = generateRatAfcJson();
+		writeRatAfcJson(json);
 
 		if ((_responseCode == CConst::successResponseCode) &&
 		    (!_mapDataGeoJsonFile.empty())) {
 			generateMapDataGeoJson(tempDir);
 		}
 	} else if (_analysisType == "ExclusionZoneAnalysis") {
-		outputDocument = generateExclusionZoneJson();
+		writeExclusionZoneJson(json);
 	} else if (_analysisType == "ScanAnalysis") {
-		outputDocument = QJsonDocument();
+		// Empty output
 #if DEBUG_AFC
 	} else if (_analysisType == "test_itm") {
 		// Do nothing
@@ -4416,9 +4699,8 @@ void AfcManager::exportGUIjson(const QString &exportJsonPath, const std::string
 						     << _analysisType << "\"");
 	}
 
-	// Write analysis outputs to JSON file
-	QByteArray data = outputDocument.toJson();
-	if (!AfcManager::_dataIf->gzipAndWriteFile(exportJsonPath, data)) {
+	json.flush();
+	if (!outputWriter->close()) {
 		throw std::runtime_error("Error writing output file");
 	}
 	LOGGER_DEBUG(logger) << "Output file written to " << exportJsonPath.toStdString();
@@ -4426,8 +4708,7 @@ void AfcManager::exportGUIjson(const QString &exportJsonPath, const std::string
 
 void AfcManager::generateMapDataGeoJson(const std::string &tempDir)
 {
-	QJsonDocument outputDocument;
-
+	LOGGER_TIMED_SCOPE("generateMapDataGeoJson");
 	QTemporaryDir geoTempDir;
 	if (!geoTempDir.isValid()) {
 		throw std::runtime_error("AfcManager::generateMapDataGeoJson(): Failed to create a "
@@ -4714,31 +4995,26 @@ void AfcManager::generateMapDataGeoJson(const std::string &tempDir)
 	// Allocation clean-up
 	GDALClose(dataSet); // Remove the reference to the dataset
 
-	// Create file to be written to (creates a file, a json object, and a json document in order
-	// to store)
-	std::ifstream tempFileStream(tempOutFilePath.toStdString(), std::ifstream::in);
-	const std::string geoJsonCollection = slurp(tempFileStream);
-
-	QJsonDocument geoJsonDoc = QJsonDocument::fromJson(
-		QString::fromStdString(geoJsonCollection).toUtf8());
-	QJsonObject geoJsonObj = geoJsonDoc.object();
-
-	QJsonObject analysisJsonObj = {{"geoJson", geoJsonObj}};
-
-	outputDocument = QJsonDocument(analysisJsonObj);
-
-	// Write map data GEOJSON file
+	// Write map data GEOJSON file. GeoJSON, written by GDAL, is copied to output as is
 	std::string fullPathMapDataFile = QDir(QString::fromStdString(tempDir))
 						  .filePath(QString::fromStdString(
 							  _mapDataGeoJsonFile))
 						  .toStdString();
 	auto mapDataFile = FileHelpers::open(QString::fromStdString(fullPathMapDataFile),
 					     QIODevice::WriteOnly);
-	auto gzip_writer = new GzipStream(mapDataFile.get());
+	std::unique_ptr<GzipStream> gzip_writer(new GzipStream(mapDataFile.get()));
 	if (!gzip_writer->open(QIODevice::WriteOnly)) {
 		throw std::runtime_error("Gzip failed to open.");
 	}
-	gzip_writer->write(outputDocument.toJson());
+	JsonWriter json([&gzip_writer](const char *data, size_t len) {
+		if (gzip_writer->write(data, len) != (qint64)len) {
+			throw std::runtime_error("Error writing map data file");
+		}
+	});
+	json.beginObject();
+	json.key("geoJson").rawValueFromFile(tempOutFilePath.toStdString());
+	json.endObject();
+	json.flush();
 	gzip_writer->close();
 	LOGGER_DEBUG(logger) << "Output file written to " << mapDataFile->fileName().toStdString();
 }
@@ -5300,6 +5576,7 @@ void AfcManager::readULSData(
 	const double &minLon,
 	const double &maxLon)
 {
+	LOGGER_TIMED_SCOPE("readULSData");
 	AnomalyGzipCsv anomGc(_fsAnomFile);
 
 	int prIdx;
@@ -6480,6 +6757,9 @@ void AfcManager::readULSData(
 				uls->setRxAntenna(rxAntenna);
 				uls->setTxAntenna(txAntenna);
 				uls->setRxAntennaCategory(rxAntennaCategory);
+				if (_rxGainTableFlag) {
+					uls->setRxGainTableCache(&_rxGainTableCache);
+				}
 				uls->setTxGain(txGain);
 				uls->setTxEIRP(txEIRP);
 				uls->setRxAntennaFeederLossDB(rxAntennaFeederLossDB);
@@ -6586,6 +6866,10 @@ void AfcManager::readULSData(
 				for (prIdx = 0; prIdx < numPR; ++prIdx) {
 					PRClass &pr = uls->getPR(prIdx);
 
+					if (_rxGainTableFlag) {
+						pr.gainTableCache = &_rxGainTableCache;
+					}
+
 					int validFlag;
 					pr.type = (CConst::PRTypeEnum)CConst::strPRTypeList
 							  ->str_to_type(row.prType[prIdx],
@@ -7284,6 +7568,7 @@ void AfcManager::readDeniedRegionData(std::string filename)
 
 void AfcManager::fixFSTerrain()
 {
+	LOGGER_TIMED_SCOPE("fixFSTerrain");
 	int ulsIdx;
 	for (ulsIdx = 0; ulsIdx <= _ulsList->getSize() - 1; ulsIdx++) {
 		ULSClass *uls = (*_ulsList)[ulsIdx];
@@ -7426,73 +7711,39 @@ double AfcManager::q(double Z) const
 /**** Compute Random Building Penetration according to ITU-R P.[BEL]                   ****/
 /**** Note that a loss value in DB is returned as a negative number.                   ****/
 /******************************************************************************************/
-double AfcManager::computeBuildingPenetration(CConst::BuildingTypeEnum buildingType,
-					      double elevationAngleDeg,
-					      double frequency,
-					      std::string &buildingPenetrationModelStr,
-					      double &buildingPenetrationCDF) const
+double AfcManager::computeBuildingPenetration(
+	CConst::BuildingTypeEnum buildingType,
+	double elevationAngleDeg,
+	const PropModelFreqCoeffClass &freqCoeff,
+	CConst::BuildingPenetrationModelEnum &buildingPenetrationModel,
+	double &buildingPenetrationCDF) const
 {
-	double r, s, t, u, v, w, x, y, z;
-	double A, B, C;
-	double mA, sA, mB, sB;
+	LOGGER_TIMED_SCOPE("buildingLoss.P2109");
 
 	if (_fixedBuildingLossFlag) {
-		buildingPenetrationModelStr = "FIXED VALUE";
+		buildingPenetrationModel = CConst::fixedValueBuildingPenetrationModel;
 		buildingPenetrationCDF = 0.5;
 		return (_fixedBuildingLossValue);
 	} else if (buildingType == CConst::noBuildingType) {
-		buildingPenetrationModelStr = "NONE";
+		buildingPenetrationModel = CConst::noneBuildingPenetrationModel;
 		buildingPenetrationCDF = 0.5;
 		return (0.0);
-	} else if (buildingType == CConst::traditionalBuildingType) {
-		r = 12.64;
-		s = 3.72;
-		t = 0.96;
-		u = 9.6;
-		v = 2.0;
-		w = 9.1;
-		x = -3.0;
-		y = 4.5;
-		z = -2.0;
-	} else if (buildingType == CConst::thermallyEfficientBuildingType) {
-		r = 28.19;
-		s = -3.00;
-		t = 8.48;
-		u = 13.5;
-		v = 3.8;
-		w = 27.8;
-		x = -2.9;
-		y = 9.4;
-		z = -2.1;
-	} else {
+	}
+
+	int bldgIdx = PropModelFreqCoeffClass::bldgTypeIdx(buildingType);
+	if (bldgIdx == -1) {
 		throw std::runtime_error("ERROR in computeBuildingPenetration(), Invalid building "
 					 "type");
 	}
 
-	buildingPenetrationModelStr = "P.2109";
+	buildingPenetrationModel = CConst::P2109BuildingPenetrationModel;
 
-	double fGHz = frequency * 1.0e-9;
-	double logf = log(fGHz) / log(10.0);
+	// Frequency and confidence dependent terms of A, B and C are precomputed, A = A0 + Le
 	double Le = 0.212 * fabs(elevationAngleDeg);
-	double Lh = r + s * logf + t * logf * logf;
-
-	mA = Lh + Le;
-	mB = w + x * logf;
-	sA = u + v * logf;
-	sB = y + z * logf;
 
-	arma::vec gauss(1);
-	gauss[0] = _zbldg2109;
-
-	A = gauss[0] * sA + mA;
-	B = gauss[0] * sB + mB;
-	C = -3.0;
-
-	double lossDB = 10.0 *
-			log(exp(A * log(10.0) / 10.0) + exp(B * log(10.0) / 10.0) +
-			    exp(C * log(10.0) / 10.0)) /
-			log(10.0);
-	buildingPenetrationCDF = q(-gauss[0]);
+	double lossDB = 10.0 * log10(freqCoeff.bldg2109ALin[bldgIdx] * exp(Le * log(10.0) / 10.0) +
+				     freqCoeff.bldg2109BCLin[bldgIdx]);
+	buildingPenetrationCDF = _propModelContext.bldg2109CDF;
 
 	return (lossDB);
 }
@@ -7500,6 +7751,8 @@ double AfcManager::computeBuildingPenetration(CConst::BuildingTypeEnum buildingT
 
 /******************************************************************************************/
 /**** AfcManager::computePathLoss                                                      ****/
+/**** Path loss kernel. Models that produced path loss and clutter values are set as   ****/
+/**** enums in result, names are resolved only when results are written out.           ****/
 /******************************************************************************************/
 void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 				 bool itmFSPLFlag,
@@ -7510,7 +7763,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 				 double distKm,
 				 double fsplDistKm,
 				 double win2DistKm,
-				 double frequency,
+				 const PropModelFreqCoeffClass &freqCoeff,
 				 double txLongitudeDeg,
 				 double txLatitudeDeg,
 				 double txHeightM,
@@ -7519,41 +7772,18 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 				 double rxLatitudeDeg,
 				 double rxHeightM,
 				 double elevationAngleRxDeg,
-				 double &pathLoss,
-				 double &pathClutterTxDB,
-				 double &pathClutterRxDB,
-				 std::string &pathLossModelStr,
-				 double &pathLossCDF,
-				 std::string &pathClutterTxModelStr,
-				 double &pathClutterTxCDF,
-				 std::string &pathClutterRxModelStr,
-				 double &pathClutterRxCDF,
-				 std::string *txClutterStrPtr,
-				 std::string *rxClutterStrPtr,
+				 PathLossResultClass &result,
 				 double **ITMProfilePtr,
-				 double **isLOSProfilePtr,
-				 double *isLOSSurfaceFracPtr
+				 LOSOracleClass *losOracle
 #if DEBUG_AFC
 				 ,
 				 std::vector<std::string> &ITMHeightType
 #endif
 ) const
 {
-	double frequencyGHz = frequency * 1.0e-9;
+	LOGGER_TIMED_SCOPE("pathLoss");
 
-	if (txClutterStrPtr) {
-		*txClutterStrPtr = "";
-	}
-
-	if (rxClutterStrPtr) {
-		*rxClutterStrPtr = "";
-	}
-
-	pathLossModelStr = "";
-	pathClutterTxModelStr = "";
-	pathClutterTxCDF = -1.0;
-	pathClutterRxModelStr = "";
-	pathClutterRxCDF = -1.0;
+	result = PathLossResultClass();
 
 	if (pathLossModel == CConst::ITMBldgPathLossModel) {
 		if ((propEnv == CConst::urbanPropEnv) || (propEnv == CConst::suburbanPropEnv)) {
@@ -7615,7 +7845,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 									1,
 								_itmMaxNumPts);
 							bool losFlag =
-								UlsMeasurementAnalysis::isLOS(
+								losOracle->isLOS(
 									_terrainDataModel,
 									QPointF(txLatitudeDeg,
 										txLongitudeDeg),
@@ -7623,14 +7853,11 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 									QPointF(rxLatitudeDeg,
 										rxLongitudeDeg),
 									rxHeightM,
-									distKm,
-									numPts,
-									isLOSProfilePtr,
-									isLOSSurfaceFracPtr);
+									numPts);
 							if (losFlag) {
 								if ((_winner2LOSOption ==
 								     CConst::CdsmLOSOption) &&
-								    (*isLOSSurfaceFracPtr <
+								    (losOracle->getCdsmFrac() <
 								     _cdsmLOSThr)) {
 									winner2LOSValue = 0;
 								} else {
@@ -7650,26 +7877,28 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					double sigma, probLOS;
 					if (propEnv == CConst::urbanPropEnv) {
 						// Winner2 C2: urban
-						pathLoss = Winner2_C2urban(1000 * win2DistKm,
-									   rxHeightM,
-									   txHeightM,
-									   frequency,
-									   sigma,
-									   pathLossModelStr,
-									   pathLossCDF,
-									   probLOS,
-									   winner2LOSValue);
+						result.pathLoss = Winner2_C2urban(
+							1000 * win2DistKm,
+							rxHeightM,
+							txHeightM,
+							freqCoeff,
+							sigma,
+							result.pathLossModel,
+							result.pathLossCDF,
+							probLOS,
+							winner2LOSValue);
 					} else if (propEnv == CConst::suburbanPropEnv) {
 						// Winner2 C1: suburban
-						pathLoss = Winner2_C1suburban(1000 * win2DistKm,
-									      rxHeightM,
-									      txHeightM,
-									      frequency,
-									      sigma,
-									      pathLossModelStr,
-									      pathLossCDF,
-									      probLOS,
-									      winner2LOSValue);
+						result.pathLoss = Winner2_C1suburban(
+							1000 * win2DistKm,
+							rxHeightM,
+							txHeightM,
+							freqCoeff,
+							sigma,
+							result.pathLossModel,
+							result.pathLossCDF,
+							probLOS,
+							winner2LOSValue);
 					}
 				} else {
 					throw std::runtime_error(ErrStream()
@@ -7678,15 +7907,13 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 								 << _closeInPathLossModel);
 				}
 			} else if (itmFSPLFlag) {
-				pathLoss = 20.0 *
-					   log((4 * M_PI * frequency * fsplDistKm * 1000) /
-					       CConst::c) /
-					   log(10.0);
-				pathLossModelStr = "FSPL";
-				pathLossCDF = 0.5;
+				result.pathLoss =
+					freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+				result.pathLossModel = CConst::FSPLPathLossResultModel;
+				result.pathLossCDF = 0.5;
 			} else {
 				// Terrain propagation: Terrain + ITM
-				double frequencyMHz = 1.0e-6 * frequency;
+				double frequencyMHz = 1.0e-6 * freqCoeff.frequency;
 				// std::cerr << "PATHLOSS," << txLatitudeDeg << "," <<
 				// txLongitudeDeg << "," << rxLatitudeDeg << "," << rxLongitudeDeg
 				// << std::endl;
@@ -7712,7 +7939,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 				/******************************************************************************************/
 				double u = _confidenceITM;
 
-				pathLoss = UlsMeasurementAnalysis::runPointToPoint(
+				result.pathLoss = UlsMeasurementAnalysis::runPointToPoint(
 					_terrainDataModel,
 					true,
 					QPointF(txLatitudeDeg, txLongitudeDeg),
@@ -7731,21 +7958,19 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					numPts,
 					NULL,
 					ITMProfilePtr);
-				pathLossModelStr = "ITM_BLDG";
-				pathLossCDF = _confidenceITM;
+				result.pathLossModel = CConst::ITMBldgPathLossResultModel;
+				result.pathLossCDF = _confidenceITM;
 			}
 		} else if ((propEnv == CConst::ruralPropEnv) ||
 			   (propEnv == CConst::barrenPropEnv)) {
 			if (itmFSPLFlag) {
-				pathLoss = 20.0 *
-					   log((4 * M_PI * frequency * fsplDistKm * 1000) /
-					       CConst::c) /
-					   log(10.0);
-				pathLossModelStr = "FSPL";
-				pathLossCDF = 0.5;
+				result.pathLoss =
+					freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+				result.pathLossModel = CConst::FSPLPathLossResultModel;
+				result.pathLossCDF = 0.5;
 			} else {
 				// Terrain propagation: Terrain + ITM
-				double frequencyMHz = 1.0e-6 * frequency;
+				double frequencyMHz = 1.0e-6 * freqCoeff.frequency;
 				int numPts = std::min(((int)floor(distKm * 1000 / _itmMinSpacing)) +
 							      1,
 						      _itmMaxNumPts);
@@ -7761,7 +7986,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					(txLatitudeDeg + rxLatitudeDeg) / 2,
 					(txLongitudeDeg + rxLongitudeDeg) / 2);
 				double u = _confidenceITM;
-				pathLoss = UlsMeasurementAnalysis::runPointToPoint(
+				result.pathLoss = UlsMeasurementAnalysis::runPointToPoint(
 					_terrainDataModel,
 					true,
 					QPointF(txLatitudeDeg, txLongitudeDeg),
@@ -7780,22 +8005,22 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					numPts,
 					NULL,
 					ITMProfilePtr);
-				pathLossModelStr = "ITM_BLDG";
-				pathLossCDF = _confidenceITM;
+				result.pathLossModel = CConst::ITMBldgPathLossResultModel;
+				result.pathLossCDF = _confidenceITM;
 
-				pathLossModelStr = "ITM_BLDG";
-				pathLossCDF = _confidenceITM;
+				result.pathLossModel = CConst::ITMBldgPathLossResultModel;
+				result.pathLossCDF = _confidenceITM;
 			}
 		} else {
 			throw std::runtime_error(ErrStream() << "ERROR reading ULS data: propEnv = "
 							     << propEnv << " INVALID value");
 		}
-		pathClutterTxDB = 0.0;
-		pathClutterTxModelStr = "NONE";
-		pathClutterTxCDF = 0.5;
-		pathClutterRxDB = 0.0;
-		pathClutterRxModelStr = "NONE";
-		pathClutterRxCDF = 0.5;
+		result.pathClutterTxDB = 0.0;
+		result.pathClutterTxModel = CConst::noneClutterModel;
+		result.pathClutterTxCDF = 0.5;
+		result.pathClutterRxDB = 0.0;
+		result.pathClutterRxModel = CConst::noneClutterModel;
+		result.pathClutterRxCDF = 0.5;
 	} else if (pathLossModel == CConst::CoalitionOpt6PathLossModel) {
 #if 1
 		// As of 2021.12.03 this path loss model is no longer supported for AFC.
@@ -7843,7 +8068,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 									1,
 								_itmMaxNumPts);
 							bool losFlag =
-								UlsMeasurementAnalysis::isLOS(
+								losOracle->isLOS(
 									_terrainDataModel,
 									QPointF(txLatitudeDeg,
 										txLongitudeDeg),
@@ -7851,9 +8076,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 									QPointF(rxLatitudeDeg,
 										rxLongitudeDeg),
 									rxHeightM,
-									distKm,
-									numPts,
-									isLOSProfilePtr);
+									numPts);
 							winner2LOSValue = (losFlag ? 1 : 2);
 						}
 					} else if (_winner2LOSOption == CConst::ForceLOSLOSOption) {
@@ -7866,26 +8089,28 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					double sigma, probLOS;
 					if (propEnv == CConst::urbanPropEnv) {
 						// Winner2 C2: urban
-						pathLoss = Winner2_C2urban(1000 * distKm,
-									   rxHeightM,
-									   txHeightM,
-									   frequency,
-									   sigma,
-									   pathLossModelStr,
-									   pathLossCDF,
-									   probLOS,
-									   winner2LOSValue);
+						result.pathLoss = Winner2_C2urban(
+							1000 * distKm,
+							rxHeightM,
+							txHeightM,
+							freqCoeff,
+							sigma,
+							result.pathLossModel,
+							result.pathLossCDF,
+							probLOS,
+							winner2LOSValue);
 					} else if (propEnv == CConst::suburbanPropEnv) {
 						// Winner2 C1: suburban
-						pathLoss = Winner2_C1suburban(1000 * distKm,
-									      rxHeightM,
-									      txHeightM,
-									      frequency,
-									      sigma,
-									      pathLossModelStr,
-									      pathLossCDF,
-									      probLOS,
-									      winner2LOSValue);
+						result.pathLoss = Winner2_C1suburban(
+							1000 * distKm,
+							rxHeightM,
+							txHeightM,
+							freqCoeff,
+							sigma,
+							result.pathLossModel,
+							result.pathLossCDF,
+							probLOS,
+							winner2LOSValue);
 					}
 				} else {
 					throw std::runtime_error(ErrStream()
@@ -7893,20 +8118,18 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 								    "loss model = "
 								 << _closeInPathLossModel);
 				}
-				pathClutterTxDB = 0.0;
-				pathClutterTxModelStr = "NONE";
-				pathClutterTxCDF = 0.5;
+				result.pathClutterTxDB = 0.0;
+				result.pathClutterTxModel = CConst::noneClutterModel;
+				result.pathClutterTxCDF = 0.5;
 			} else {
 				if (itmFSPLFlag) {
-					pathLoss = 20.0 *
-						   log((4 * M_PI * frequency * fsplDistKm * 1000) /
-						       CConst::c) /
-						   log(10.0);
-					pathLossModelStr = "FSPL";
-					pathLossCDF = 0.5;
+					result.pathLoss =
+						freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+					result.pathLossModel = CConst::FSPLPathLossResultModel;
+					result.pathLossCDF = 0.5;
 				} else {
 					// Terrain propagation: Terrain + ITM
-					double frequencyMHz = 1.0e-6 * frequency;
+					double frequencyMHz = 1.0e-6 * freqCoeff.frequency;
 					// std::cerr << "PATHLOSS," << txLatitudeDeg << "," <<
 					// txLongitudeDeg << "," << rxLatitudeDeg << "," <<
 					// rxLongitudeDeg << std::endl;
@@ -7933,7 +8156,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					/******************************************************************************************/
 					double u = _confidenceITM;
 
-					pathLoss = UlsMeasurementAnalysis::runPointToPoint(
+					result.pathLoss = UlsMeasurementAnalysis::runPointToPoint(
 						_terrainDataModel,
 						false,
 						QPointF(txLatitudeDeg, txLongitudeDeg),
@@ -7952,50 +8175,42 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 						numPts,
 						NULL,
 						ITMProfilePtr);
-					pathLossModelStr = "ITM";
-					pathLossCDF = _confidenceITM;
+					result.pathLossModel = CConst::ITMPathLossResultModel;
+					result.pathLossCDF = _confidenceITM;
 				}
 
+				LOGGER_TIMED_SCOPE("pathLoss.P2108");
 				// ITU-R P.[CLUTTER] sec 3.2
-				double Ll = 23.5 + 9.6 * log(frequencyGHz) / log(10.0);
-				double Ls = 32.98 + 23.9 * log(distKm) / log(10.0) +
-					    3.0 * log(frequencyGHz) / log(10.0);
-
-				arma::vec gauss(1);
-				gauss[0] = _zclutter2108;
-
-				double Lctt = -5.0 *
-						      log(exp(-0.2 * Ll * log(10.0)) +
-							  exp(-0.2 * Ls * log(10.0))) /
-						      log(10.0) +
-					      6.0 * gauss[0];
-				pathClutterTxDB = Lctt;
-
-				pathClutterTxModelStr = "P.2108";
-				pathClutterTxCDF = q(-gauss[0]);
+				// Frequency dependent terms of Ll and Ls are precomputed
+				double LsLin = freqCoeff.clutter2108LsLin *
+					       pow(distKm, -0.2 * 23.9);
+				double Lctt = -5.0 * log10(freqCoeff.clutter2108LlLin + LsLin) +
+					      _propModelContext.clutter2108DB;
+				result.pathClutterTxDB = Lctt;
+
+				result.pathClutterTxModel = CConst::P2108ClutterModel;
+				result.pathClutterTxCDF = _propModelContext.clutter2108CDF;
 				if (_applyClutterFSRxFlag && (rxHeightM <= 10.0) &&
 				    (distKm >= 1.0)) {
-					pathClutterRxDB = pathClutterTxDB;
-					pathClutterRxModelStr = pathClutterTxModelStr;
-					pathClutterRxCDF = pathClutterTxCDF;
+					result.pathClutterRxDB = result.pathClutterTxDB;
+					result.pathClutterRxModel = result.pathClutterTxModel;
+					result.pathClutterRxCDF = result.pathClutterTxCDF;
 				} else {
-					pathClutterRxDB = 0.0;
-					pathClutterRxModelStr = "NONE";
-					pathClutterRxCDF = 0.5;
+					result.pathClutterRxDB = 0.0;
+					result.pathClutterRxModel = CConst::noneClutterModel;
+					result.pathClutterRxCDF = 0.5;
 				}
 			}
 		} else if ((propEnv == CConst::ruralPropEnv) ||
 			   (propEnv == CConst::barrenPropEnv)) {
 			if (itmFSPLFlag) {
-				pathLoss = 20.0 *
-					   log((4 * M_PI * frequency * fsplDistKm * 1000) /
-					       CConst::c) /
-					   log(10.0);
-				pathLossModelStr = "FSPL";
-				pathLossCDF = 0.5;
+				result.pathLoss =
+					freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+				result.pathLossModel = CConst::FSPLPathLossResultModel;
+				result.pathLossCDF = 0.5;
 			} else {
 				// Terrain propagation: Terrain + ITM
-				double frequencyMHz = 1.0e-6 * frequency;
+				double frequencyMHz = 1.0e-6 * freqCoeff.frequency;
 				int numPts = std::min(((int)floor(distKm * 1000 / _itmMinSpacing)) +
 							      1,
 						      _itmMaxNumPts);
@@ -8011,7 +8226,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					(txLatitudeDeg + rxLatitudeDeg) / 2,
 					(txLongitudeDeg + rxLongitudeDeg) / 2);
 				double u = _confidenceITM;
-				pathLoss = UlsMeasurementAnalysis::runPointToPoint(
+				result.pathLoss = UlsMeasurementAnalysis::runPointToPoint(
 					_terrainDataModel,
 					false,
 					QPointF(txLatitudeDeg, txLongitudeDeg),
@@ -8030,28 +8245,28 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					numPts,
 					NULL,
 					ITMProfilePtr);
-				pathLossModelStr = "ITM";
-				pathLossCDF = _confidenceITM;
+				result.pathLossModel = CConst::ITMPathLossResultModel;
+				result.pathLossCDF = _confidenceITM;
 			}
 
 			// ITU-R p.452 Clutter loss function
-			pathClutterTxDB = AfcManager::computeClutter452HtEl(txHeightM,
+			result.pathClutterTxDB = AfcManager::computeClutter452HtEl(txHeightM,
 									    distKm,
 									    elevationAngleTxDeg);
-			pathClutterTxModelStr = "452_HT_ELANG";
-			pathClutterTxCDF = 0.5;
+			result.pathClutterTxModel = CConst::P452HtElAngClutterModel;
+			result.pathClutterTxCDF = 0.5;
 
 			if (_applyClutterFSRxFlag && (rxHeightM <= 10.0) && (distKm >= 1.0)) {
-				pathClutterRxDB =
+				result.pathClutterRxDB =
 					AfcManager::computeClutter452HtEl(rxHeightM,
 									  distKm,
 									  elevationAngleRxDeg);
-				pathClutterRxModelStr = "452_HT_ELANG";
-				pathClutterRxCDF = 0.5;
+				result.pathClutterRxModel = CConst::P452HtElAngClutterModel;
+				result.pathClutterRxCDF = 0.5;
 			} else {
-				pathClutterRxDB = 0.0;
-				pathClutterRxModelStr = "NONE";
-				pathClutterRxCDF = 0.5;
+				result.pathClutterRxDB = 0.0;
+				result.pathClutterRxModel = CConst::noneClutterModel;
+				result.pathClutterRxCDF = 0.5;
 			}
 		} else {
 			throw std::runtime_error(ErrStream() << "ERROR: propEnv = " << propEnv
@@ -8062,15 +8277,13 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 		// Path Loss Model used in FCC Report and Order
 
 		if (fsplDistKm * 1000 < 30.0) {
-			pathLoss = 20.0 *
-				   log((4 * M_PI * frequency * fsplDistKm * 1000) / CConst::c) /
-				   log(10.0);
-			pathLossModelStr = "FSPL";
-			pathLossCDF = 0.5;
-
-			pathClutterTxDB = 0.0;
-			pathClutterTxModelStr = "NONE";
-			pathClutterTxCDF = 0.5;
+			result.pathLoss = freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+			result.pathLossModel = CConst::FSPLPathLossResultModel;
+			result.pathLossCDF = 0.5;
+
+			result.pathClutterTxDB = 0.0;
+			result.pathClutterTxModel = CConst::noneClutterModel;
+			result.pathClutterTxCDF = 0.5;
 		} else if (win2DistKm * 1000 < _closeInDist) {
 			int winner2LOSValue = 0; // 1: Force LOS, 2: Force NLOS, 0: Compute probLOS,
 						 // then select or combine.
@@ -8112,19 +8325,16 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					int numPts = std::min(
 						((int)floor(distKm * 1000 / _itmMinSpacing)) + 1,
 						_itmMaxNumPts);
-					bool losFlag = UlsMeasurementAnalysis::isLOS(
+					bool losFlag = losOracle->isLOS(
 						_terrainDataModel,
 						QPointF(txLatitudeDeg, txLongitudeDeg),
 						txHeightM,
 						QPointF(rxLatitudeDeg, rxLongitudeDeg),
 						rxHeightM,
-						distKm,
-						numPts,
-						isLOSProfilePtr,
-						isLOSSurfaceFracPtr);
+						numPts);
 					if (losFlag) {
 						if ((_winner2LOSOption == CConst::CdsmLOSOption) &&
-						    (*isLOSSurfaceFracPtr < _cdsmLOSThr)) {
+						    (losOracle->getCdsmFrac() < _cdsmLOSThr)) {
 							winner2LOSValue = 0;
 						} else {
 							winner2LOSValue = 1;
@@ -8142,50 +8352,49 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 			double sigma, probLOS;
 			if (propEnv == CConst::urbanPropEnv) {
 				// Winner2 C2: urban
-				pathLoss = Winner2_C2urban(1000 * win2DistKm,
-							   rxHeightM,
-							   txHeightM,
-							   frequency,
-							   sigma,
-							   pathLossModelStr,
-							   pathLossCDF,
-							   probLOS,
-							   winner2LOSValue);
+				result.pathLoss = Winner2_C2urban(1000 * win2DistKm,
+								  rxHeightM,
+								  txHeightM,
+								  freqCoeff,
+								  sigma,
+								  result.pathLossModel,
+								  result.pathLossCDF,
+								  probLOS,
+								  winner2LOSValue);
 			} else if (propEnv == CConst::suburbanPropEnv) {
 				// Winner2 C1: suburban
-				pathLoss = Winner2_C1suburban(1000 * win2DistKm,
-							      rxHeightM,
-							      txHeightM,
-							      frequency,
-							      sigma,
-							      pathLossModelStr,
-							      pathLossCDF,
-							      probLOS,
-							      winner2LOSValue);
+				result.pathLoss = Winner2_C1suburban(1000 * win2DistKm,
+								     rxHeightM,
+								     txHeightM,
+								     freqCoeff,
+								     sigma,
+								     result.pathLossModel,
+								     result.pathLossCDF,
+								     probLOS,
+								     winner2LOSValue);
 			} else if ((propEnv == CConst::ruralPropEnv) ||
 				   (propEnv == CConst::barrenPropEnv)) {
 				// Winner2 D1: rural
-				pathLoss = Winner2_D1rural(1000 * win2DistKm,
-							   rxHeightM,
-							   txHeightM,
-							   frequency,
-							   sigma,
-							   pathLossModelStr,
-							   pathLossCDF,
-							   probLOS,
-							   winner2LOSValue);
+				result.pathLoss = Winner2_D1rural(1000 * win2DistKm,
+								  rxHeightM,
+								  txHeightM,
+								  freqCoeff,
+								  sigma,
+								  result.pathLossModel,
+								  result.pathLossCDF,
+								  probLOS,
+								  winner2LOSValue);
 			} else {
 				throw std::runtime_error(ErrStream()
 							 << "ERROR: propEnv = " << propEnv
 							 << " INVALID value");
 			}
 			if (_winner2LOSOption == CConst::CdsmLOSOption) {
-				pathLossModelStr += " cdsmFrac = " +
-						    std::to_string(*isLOSSurfaceFracPtr);
+				result.cdsmFrac = losOracle->getCdsmFrac();
 			}
-			pathClutterTxModelStr = "NONE";
-			pathClutterTxDB = 0.0;
-			pathClutterTxCDF = 0.5;
+			result.pathClutterTxModel = CConst::noneClutterModel;
+			result.pathClutterTxDB = 0.0;
+			result.pathClutterTxCDF = 0.5;
 		} else {
 			bool rlanHasClutter;
 			switch (_rlanITMTxClutterMethod) {
@@ -8199,16 +8408,13 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					int numPts = std::min(
 						((int)floor(distKm * 1000 / _itmMinSpacing)) + 1,
 						_itmMaxNumPts);
-					bool losFlag = UlsMeasurementAnalysis::isLOS(
+					bool losFlag = losOracle->isLOS(
 						_terrainDataModel,
 						QPointF(txLatitudeDeg, txLongitudeDeg),
 						txHeightM,
 						QPointF(rxLatitudeDeg, rxLongitudeDeg),
 						rxHeightM,
-						distKm,
-						numPts,
-						isLOSProfilePtr,
-						isLOSSurfaceFracPtr);
+						numPts);
 					rlanHasClutter = !losFlag;
 				} break;
 			}
@@ -8216,15 +8422,13 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 			if ((propEnv == CConst::urbanPropEnv) ||
 			    (propEnv == CConst::suburbanPropEnv)) {
 				if (itmFSPLFlag) {
-					pathLoss = 20.0 *
-						   log((4 * M_PI * frequency * fsplDistKm * 1000) /
-						       CConst::c) /
-						   log(10.0);
-					pathLossModelStr = "FSPL";
-					pathLossCDF = 0.5;
+					result.pathLoss =
+						freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+					result.pathLossModel = CConst::FSPLPathLossResultModel;
+					result.pathLossCDF = 0.5;
 				} else {
 					// Terrain propagation: SRTM + ITM
-					double frequencyMHz = 1.0e-6 * frequency;
+					double frequencyMHz = 1.0e-6 * freqCoeff.frequency;
 					int numPts = std::min(
 						((int)floor(distKm * 1000 / _itmMinSpacing)) + 1,
 						_itmMaxNumPts);
@@ -8242,7 +8446,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 							(txLatitudeDeg + rxLatitudeDeg) / 2,
 							(txLongitudeDeg + rxLongitudeDeg) / 2);
 					double u = _confidenceITM;
-					pathLoss = UlsMeasurementAnalysis::runPointToPoint(
+					result.pathLoss = UlsMeasurementAnalysis::runPointToPoint(
 						_terrainDataModel,
 						false,
 						QPointF(txLatitudeDeg, txLongitudeDeg),
@@ -8261,46 +8465,39 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 						numPts,
 						NULL,
 						ITMProfilePtr);
-					pathLossModelStr = "ITM";
-					pathLossCDF = _confidenceITM;
+					result.pathLossModel = CConst::ITMPathLossResultModel;
+					result.pathLossCDF = _confidenceITM;
 				}
 
 				if (rlanHasClutter) {
+					LOGGER_TIMED_SCOPE("pathLoss.P2108");
 					// ITU-R P.[CLUTTER] sec 3.2
-					double Ll = 23.5 + 9.6 * log(frequencyGHz) / log(10.0);
-					double Ls = 32.98 + 23.9 * log(distKm) / log(10.0) +
-						    3.0 * log(frequencyGHz) / log(10.0);
-
-					arma::vec gauss(1);
-					gauss[0] = _zclutter2108;
-
-					double Lctt = -5.0 *
-							      log(exp(-0.2 * Ll * log(10.0)) +
-								  exp(-0.2 * Ls * log(10.0))) /
-							      log(10.0) +
-						      6.0 * gauss[0];
-
-					pathClutterTxDB = Lctt;
-					pathClutterTxModelStr = "P.2108";
-					pathClutterTxCDF = q(-gauss[0]);
+					// Frequency dependent terms of Ll and Ls are precomputed
+					double LsLin = freqCoeff.clutter2108LsLin *
+						       pow(distKm, -0.2 * 23.9);
+					double Lctt =
+						-5.0 * log10(freqCoeff.clutter2108LlLin + LsLin) +
+						_propModelContext.clutter2108DB;
+
+					result.pathClutterTxDB = Lctt;
+					result.pathClutterTxModel = CConst::P2108ClutterModel;
+					result.pathClutterTxCDF = _propModelContext.clutter2108CDF;
 				} else {
-					pathClutterTxModelStr = "NONE";
-					pathClutterTxDB = 0.0;
-					pathClutterTxCDF = 0.5;
+					result.pathClutterTxModel = CConst::noneClutterModel;
+					result.pathClutterTxDB = 0.0;
+					result.pathClutterTxCDF = 0.5;
 				}
 
 			} else if ((propEnv == CConst::ruralPropEnv) ||
 				   (propEnv == CConst::barrenPropEnv)) {
 				if (itmFSPLFlag) {
-					pathLoss = 20.0 *
-						   log((4 * M_PI * frequency * fsplDistKm * 1000) /
-						       CConst::c) /
-						   log(10.0);
-					pathLossModelStr = "FSPL";
-					pathLossCDF = 0.5;
+					result.pathLoss =
+						freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+					result.pathLossModel = CConst::FSPLPathLossResultModel;
+					result.pathLossCDF = 0.5;
 				} else {
 					// Terrain propagation: SRTM + ITM
-					double frequencyMHz = 1.0e-6 * frequency;
+					double frequencyMHz = 1.0e-6 * freqCoeff.frequency;
 					double u = _confidenceITM;
 					int numPts = std::min(
 						((int)floor(distKm * 1000 / _itmMinSpacing)) + 1,
@@ -8318,7 +8515,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 						_ituData->getSurfaceRefractivityValue(
 							(txLatitudeDeg + rxLatitudeDeg) / 2,
 							(txLongitudeDeg + rxLongitudeDeg) / 2);
-					pathLoss = UlsMeasurementAnalysis::runPointToPoint(
+					result.pathLoss = UlsMeasurementAnalysis::runPointToPoint(
 						_terrainDataModel,
 						false,
 						QPointF(txLatitudeDeg, txLongitudeDeg),
@@ -8337,8 +8534,8 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 						numPts,
 						NULL,
 						ITMProfilePtr);
-					pathLossModelStr = "ITM";
-					pathLossCDF = _confidenceITM;
+					result.pathLossModel = CConst::ITMPathLossResultModel;
+					result.pathLossCDF = _confidenceITM;
 				}
 
 				if ((rlanHasClutter) &&
@@ -8352,42 +8549,23 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 						case CConst::deciduousTreesNLCDLandCat:
 							ha = 15.0;
 							dk = 0.05;
-							if (txClutterStrPtr) {
-								*txClutterStrPtr = "DECIDUOUS_"
-										   "TREES";
-							}
 							break;
 						case CConst::coniferousTreesNLCDLandCat:
 							ha = 20.0;
 							dk = 0.05;
-							if (txClutterStrPtr) {
-								*txClutterStrPtr = "CONIFEROUS_"
-										   "TREES";
-							}
 							break;
 						case CConst::highCropFieldsNLCDLandCat:
 							ha = 4.0;
 							dk = 0.1;
-							if (txClutterStrPtr) {
-								*txClutterStrPtr = "HIGH_CROP_"
-										   "FIELDS";
-							}
 							break;
 						case CConst::villageCenterNLCDLandCat:
 						case CConst::unknownNLCDLandCat:
 							ha = 5.0;
 							dk = 0.07;
-							if (txClutterStrPtr) {
-								*txClutterStrPtr = "VILLAGE_CENTER";
-							}
 							break;
 						case CConst::tropicalRainForestNLCDLandCat:
 							ha = 20.0;
 							dk = 0.03;
-							if (txClutterStrPtr) {
-								*txClutterStrPtr = "TROPICAL_RAIN_"
-										   "FOREST";
-							}
 							break;
 						default:
 							ha = quietNaN;
@@ -8397,7 +8575,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					}
 
 					if (distKm < 10 * dk) {
-						pathClutterTxDB = 0.0;
+						result.pathClutterTxDB = 0.0;
 					} else {
 						double elevationAngleThresholdDeg =
 							std::atan((ha - txHeightM) /
@@ -8405,29 +8583,26 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 							180.0 / M_PI;
 						if (elevationAngleTxDeg >
 						    elevationAngleThresholdDeg) {
-							pathClutterTxDB = 0.0;
+							result.pathClutterTxDB = 0.0;
 						} else {
-							const double Ffc =
-								0.25 +
-								0.375 * (1 +
-									 std::tanh(7.5 *
-										   (frequencyGHz -
-										    0.5)));
-							double result = 10.25 * Ffc * exp(-1 * dk);
-							result *= 1 -
+							double lossDB = 10.25 *
+									freqCoeff.clutter452Ffc *
+									exp(-1 * dk);
+							lossDB *= 1 -
 								  std::tanh(6 * (txHeightM / ha -
 										 0.625));
-							result -= 0.33;
-							pathClutterTxDB = result;
+							lossDB -= 0.33;
+							result.pathClutterTxDB = lossDB;
 						}
 					}
 
-					pathClutterTxModelStr = "452_NLCD";
-					pathClutterTxCDF = 0.5;
+					result.pathClutterTxModel = CConst::P452NLCDClutterModel;
+					result.txClutter = nlcdLandCatTx;
+					result.pathClutterTxCDF = 0.5;
 				} else {
-					pathClutterTxModelStr = "NONE";
-					pathClutterTxDB = 0.0;
-					pathClutterTxCDF = 0.5;
+					result.pathClutterTxModel = CConst::noneClutterModel;
+					result.pathClutterTxDB = 0.0;
+					result.pathClutterTxCDF = 0.5;
 				}
 			} else {
 				CORE_DUMP;
@@ -8436,28 +8611,22 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 
 		if (_applyClutterFSRxFlag && (rxHeightM <= _maxFsAglHeight) && (distKm >= 1.0)) {
 			if (distKm * 1000 < _closeInDist) {
-				pathClutterRxDB = 0.0;
-				pathClutterRxModelStr = "NONE";
-				pathClutterRxCDF = 0.5;
+				result.pathClutterRxDB = 0.0;
+				result.pathClutterRxModel = CConst::noneClutterModel;
+				result.pathClutterRxCDF = 0.5;
 			} else if ((propEnvRx == CConst::urbanPropEnv) ||
 				   (propEnvRx == CConst::suburbanPropEnv)) {
+				LOGGER_TIMED_SCOPE("pathLoss.P2108");
 				// ITU-R P.[CLUTTER] sec 3.2
-				double Ll = 23.5 + 9.6 * log(frequencyGHz) / log(10.0);
-				double Ls = 32.98 + 23.9 * log(distKm) / log(10.0) +
-					    3.0 * log(frequencyGHz) / log(10.0);
-
-				arma::vec gauss(1);
-				gauss[0] = _fsZclutter2108;
-
-				double Lctt = -5.0 *
-						      log(exp(-0.2 * Ll * log(10.0)) +
-							  exp(-0.2 * Ls * log(10.0))) /
-						      log(10.0) +
-					      6.0 * gauss[0];
-
-				pathClutterRxDB = Lctt;
-				pathClutterRxModelStr = "P.2108";
-				pathClutterRxCDF = q(-gauss[0]);
+				// Frequency dependent terms of Ll and Ls are precomputed
+				double LsLin = freqCoeff.clutter2108LsLin *
+					       pow(distKm, -0.2 * 23.9);
+				double Lctt = -5.0 * log10(freqCoeff.clutter2108LlLin + LsLin) +
+					      _propModelContext.fsClutter2108DB;
+
+				result.pathClutterRxDB = Lctt;
+				result.pathClutterRxModel = CConst::P2108ClutterModel;
+				result.pathClutterRxCDF = _propModelContext.fsClutter2108CDF;
 			} else if ((propEnvRx == CConst::ruralPropEnv) ||
 				   (propEnvRx == CConst::barrenPropEnv)) {
 				bool clutterFlag = _allowRuralFSClutterFlag &&
@@ -8471,34 +8640,19 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 						case CConst::deciduousTreesNLCDLandCat:
 							ha = 15.0;
 							dk = 0.05;
-							if (rxClutterStrPtr) {
-								*rxClutterStrPtr = "DECIDUOUS_"
-										   "TREES";
-							}
 							break;
 						case CConst::coniferousTreesNLCDLandCat:
 							ha = 20.0;
 							dk = 0.05;
-							if (rxClutterStrPtr) {
-								*rxClutterStrPtr = "CONIFEROUS_"
-										   "TREES";
-							}
 							break;
 						case CConst::highCropFieldsNLCDLandCat:
 							ha = 4.0;
 							dk = 0.1;
-							if (rxClutterStrPtr) {
-								*rxClutterStrPtr = "HIGH_CROP_"
-										   "FIELDS";
-							}
 							break;
 						case CConst::villageCenterNLCDLandCat:
 						case CConst::unknownNLCDLandCat:
 							ha = 5.0;
 							dk = 0.07;
-							if (rxClutterStrPtr) {
-								*rxClutterStrPtr = "VILLAGE_CENTER";
-							}
 							break;
 						default:
 							CORE_DUMP;
@@ -8506,7 +8660,7 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 					}
 
 					if (distKm < 10 * dk) {
-						pathClutterRxDB = 0.0;
+						result.pathClutterRxDB = 0.0;
 					} else {
 						double elevationAngleThresholdDeg =
 							std::atan((ha - rxHeightM) /
@@ -8514,29 +8668,26 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 							180.0 / M_PI;
 						if (elevationAngleRxDeg >
 						    elevationAngleThresholdDeg) {
-							pathClutterRxDB = 0.0;
+							result.pathClutterRxDB = 0.0;
 						} else {
-							const double Ffc =
-								0.25 +
-								0.375 * (1 +
-									 std::tanh(7.5 *
-										   (frequencyGHz -
-										    0.5)));
-							double result = 10.25 * Ffc * exp(-1 * dk);
-							result *= 1 -
+							double lossDB = 10.25 *
+									freqCoeff.clutter452Ffc *
+									exp(-1 * dk);
+							lossDB *= 1 -
 								  std::tanh(6 * (rxHeightM / ha -
 										 0.625));
-							result -= 0.33;
-							pathClutterRxDB = result;
+							lossDB -= 0.33;
+							result.pathClutterRxDB = lossDB;
 						}
 					}
 
-					pathClutterRxModelStr = "452_NLCD";
-					pathClutterRxCDF = 0.5;
+					result.pathClutterRxModel = CConst::P452NLCDClutterModel;
+					result.rxClutter = nlcdLandCatRx;
+					result.pathClutterRxCDF = 0.5;
 				} else {
-					pathClutterRxDB = 0.0;
-					pathClutterRxModelStr = "NONE";
-					pathClutterRxCDF = 0.5;
+					result.pathClutterRxDB = 0.0;
+					result.pathClutterRxModel = CConst::noneClutterModel;
+					result.pathClutterRxCDF = 0.5;
 				}
 			} else {
 				throw std::runtime_error(
@@ -8544,77 +8695,297 @@ void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
 						    << rxLongitudeDeg << " " << rxLatitudeDeg);
 			}
 		} else {
-			pathClutterRxDB = 0.0;
-			pathClutterRxModelStr = "NONE";
-			pathClutterRxCDF = 0.5;
+			result.pathClutterRxDB = 0.0;
+			result.pathClutterRxModel = CConst::noneClutterModel;
+			result.pathClutterRxCDF = 0.5;
 		}
 	} else if (pathLossModel == CConst::FSPLPathLossModel) {
-		pathLoss = 20.0 * log((4 * M_PI * frequency * fsplDistKm * 1000) / CConst::c) /
-			   log(10.0);
-		pathLossModelStr = "FSPL";
-		pathLossCDF = 0.5;
-
-		pathClutterTxDB = 0.0;
-		pathClutterTxModelStr = "NONE";
-		pathClutterTxCDF = 0.5;
-
-		pathClutterRxDB = 0.0;
-		pathClutterRxModelStr = "NONE";
-		pathClutterRxCDF = 0.5;
+		result.pathLoss = freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+		result.pathLossModel = CConst::FSPLPathLossResultModel;
+		result.pathLossCDF = 0.5;
+
+		result.pathClutterTxDB = 0.0;
+		result.pathClutterTxModel = CConst::noneClutterModel;
+		result.pathClutterTxCDF = 0.5;
+
+		result.pathClutterRxDB = 0.0;
+		result.pathClutterRxModel = CConst::noneClutterModel;
+		result.pathClutterRxCDF = 0.5;
 	} else {
 		throw std::runtime_error(ErrStream() << "ERROR reading ULS data: pathLossModel = "
 						     << pathLossModel << " INVALID value");
 	}
 
 	if (_pathLossClampFSPL) {
-		double fspl = 20.0 * log((4 * M_PI * frequency * fsplDistKm * 1000) / CConst::c) /
-			      log(10.0);
-		if (pathLoss < fspl) {
-			pathLossModelStr += "_" + std::to_string(pathLoss) + "_CLAMPFSPL";
-			pathLoss = fspl;
+		double fspl = freqCoeff.fsplDB + 20.0 * log10(fsplDistKm * 1000);
+		if (result.pathLoss < fspl) {
+			result.unclampedPathLoss = result.pathLoss;
+			result.pathLoss = fspl;
 		}
 	}
 }
 /******************************************************************************************/
 
+/******************************************************************************************/
+/**** AfcManager::computePathLoss                                                      ****/
+/**** Same as above, with model names returned as strings                              ****/
+/******************************************************************************************/
+void AfcManager::computePathLoss(CConst::PathLossModelEnum pathLossModel,
+				 bool itmFSPLFlag,
+				 CConst::PropEnvEnum propEnv,
+				 CConst::PropEnvEnum propEnvRx,
+				 CConst::NLCDLandCatEnum nlcdLandCatTx,
+				 CConst::NLCDLandCatEnum nlcdLandCatRx,
+				 double distKm,
+				 double fsplDistKm,
+				 double win2DistKm,
+				 double frequency,
+				 double txLongitudeDeg,
+				 double txLatitudeDeg,
+				 double txHeightM,
+				 double elevationAngleTxDeg,
+				 double rxLongitudeDeg,
+				 double rxLatitudeDeg,
+				 double rxHeightM,
+				 double elevationAngleRxDeg,
+				 double &pathLoss,
+				 double &pathClutterTxDB,
+				 double &pathClutterRxDB,
+				 std::string &pathLossModelStr,
+				 double &pathLossCDF,
+				 std::string &pathClutterTxModelStr,
+				 double &pathClutterTxCDF,
+				 std::string &pathClutterRxModelStr,
+				 double &pathClutterRxCDF,
+				 std::string *txClutterStrPtr,
+				 std::string *rxClutterStrPtr,
+				 double **ITMProfilePtr,
+				 LOSOracleClass *losOracle
+#if DEBUG_AFC
+				 ,
+				 std::vector<std::string> &ITMHeightType
+#endif
+) const
+{
+	PathLossResultClass result;
+
+	computePathLoss(pathLossModel,
+			itmFSPLFlag,
+			propEnv,
+			propEnvRx,
+			nlcdLandCatTx,
+			nlcdLandCatRx,
+			distKm,
+			fsplDistKm,
+			win2DistKm,
+			_propModelContext.getFreqCoeff(frequency),
+			txLongitudeDeg,
+			txLatitudeDeg,
+			txHeightM,
+			elevationAngleTxDeg,
+			rxLongitudeDeg,
+			rxLatitudeDeg,
+			rxHeightM,
+			elevationAngleRxDeg,
+			result,
+			ITMProfilePtr,
+			losOracle
+#if DEBUG_AFC
+			,
+			ITMHeightType
+#endif
+	);
+
+	pathLoss = result.pathLoss;
+	pathLossCDF = result.pathLossCDF;
+	pathLossModelStr = result.pathLossModelStr();
+	pathClutterTxDB = result.pathClutterTxDB;
+	pathClutterTxCDF = result.pathClutterTxCDF;
+	pathClutterTxModelStr = result.pathClutterTxModelStr();
+	pathClutterRxDB = result.pathClutterRxDB;
+	pathClutterRxCDF = result.pathClutterRxCDF;
+	pathClutterRxModelStr = result.pathClutterRxModelStr();
+	if (txClutterStrPtr) {
+		*txClutterStrPtr = result.txClutterStr();
+	}
+	if (rxClutterStrPtr) {
+		*rxClutterStrPtr = result.rxClutterStr();
+	}
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** AfcManager::screenITMSegments                                                    ****/
+/**** First tier of two tier ITM evaluation. Path loss at lowest and highest           ****/
+/**** evaluation frequency of itmSegList is computed on coarse terrain profile (every  ****/
+/**** _itmScreeningDecimation-th point of full profile) and lowered by                 ****/
+/**** _itmScreeningMarginDB. EIRP limit for this lower bound of path loss is computed  ****/
+/**** for each segment exactly as in full evaluation. Returns true if it is below      ****/
+/**** current EIRP of some segment, i.e. full evaluation may lower channel EIRP.       ****/
+/**** Otherwise full evaluation would leave channels unchanged and may be skipped.     ****/
+/******************************************************************************************/
+bool AfcManager::screenITMSegments(const ChannelStruct *channel,
+				   const std::vector<int> &itmSegList,
+				   const std::vector<double> *rxPowerDBW_0PLList,
+				   double noiseLevelDBW,
+				   CConst::PropEnvEnum propEnv,
+				   CConst::PropEnvEnum propEnvRx,
+				   CConst::NLCDLandCatEnum nlcdLandCatTx,
+				   CConst::NLCDLandCatEnum nlcdLandCatRx,
+				   double distKm,
+				   double fsplDistKm,
+				   double win2DistKm,
+				   double txLongitudeDeg,
+				   double txLatitudeDeg,
+				   double txHeightM,
+				   double elevationAngleTxDeg,
+				   double rxLongitudeDeg,
+				   double rxLatitudeDeg,
+				   double rxHeightM,
+				   double elevationAngleRxDeg,
+				   LOSOracleClass *losOracle) const
+{
+	LOGGER_TIMED_SCOPE("pathLoss.screening");
+
+	bool inquiredFreqFlag = (channel->type == INQUIRED_FREQUENCY);
+	int numBandEdge = (inquiredFreqFlag ? 2 : 1);
+
+	// Evaluation frequency of band edge of segment, same as in full evaluation
+	auto evalFreqMHz = [channel, inquiredFreqFlag](int freqSegIdx, int bandEdgeIdx) {
+		double startFreqMHz = channel->freqMHzList[freqSegIdx];
+		double stopFreqMHz = channel->freqMHzList[freqSegIdx + 1];
+		if (inquiredFreqFlag) {
+			return (bandEdgeIdx == 0 ? startFreqMHz : stopFreqMHz);
+		}
+		return ((startFreqMHz + stopFreqMHz) / 2.0);
+	};
+	double minFreqMHz = evalFreqMHz(itmSegList.front(), 0);
+	double maxFreqMHz = evalFreqMHz(itmSegList.back(), numBandEdge - 1);
+
+	// Profile passed to computePathLoss() is used as is, so ITM runs on coarse profile
+	int numPts = std::min(((int)floor(distKm * 1000 / _itmMinSpacing)) + 1, _itmMaxNumPts);
+	int numCoarsePts = std::max((numPts - 1) / _itmScreeningDecimation + 1, 2);
+	double *coarseProfile = UlsMeasurementAnalysis::computeElevationVector(
+		_terrainDataModel,
+		true,
+		false,
+		QPointF(txLatitudeDeg, txLongitudeDeg),
+		QPointF(rxLatitudeDeg, rxLongitudeDeg),
+		numCoarsePts,
+		(double *)NULL);
+#if DEBUG_AFC
+	std::vector<std::string> itmHeightType;
+#endif
+
+	double freqPathLoss[2];
+	int numFreq = (maxFreqMHz > minFreqMHz ? 2 : 1);
+	for (int freqIdx = 0; freqIdx < numFreq; ++freqIdx) {
+		PathLossResultClass pathLossResult;
+		computePathLoss(_pathLossModel,
+				false,
+				propEnv,
+				propEnvRx,
+				nlcdLandCatTx,
+				nlcdLandCatRx,
+				distKm,
+				fsplDistKm,
+				win2DistKm,
+				_propModelContext.getFreqCoeff(
+					(freqIdx == 0 ? minFreqMHz : maxFreqMHz) * 1.0e6),
+				txLongitudeDeg,
+				txLatitudeDeg,
+				txHeightM,
+				elevationAngleTxDeg,
+				rxLongitudeDeg,
+				rxLatitudeDeg,
+				rxHeightM,
+				elevationAngleRxDeg,
+				pathLossResult,
+				&coarseProfile,
+				losOracle
+#if DEBUG_AFC
+				,
+				itmHeightType
+#endif
+		);
+		freqPathLoss[freqIdx] = pathLossResult.pathLoss - _itmScreeningMarginDB;
+	}
+	if (numFreq == 1) {
+		freqPathLoss[1] = freqPathLoss[0];
+	}
+	free(coarseProfile);
+
+	for (int itmSegIdx = 0; itmSegIdx < (int)itmSegList.size(); ++itmSegIdx) {
+		int freqSegIdx = itmSegList[itmSegIdx];
+		ChannelColor chanColor = std::get<2>(channel->segList[freqSegIdx]);
+		if ((chanColor == BLACK) || (chanColor == RED)) {
+			continue;
+		}
+		double maxEIRPdBm;
+		if (inquiredFreqFlag) {
+			maxEIRPdBm = _inquiredFrequencyMaxPSD_dBmPerMHz +
+				     10.0 * log10((double)channel->bandwidth(freqSegIdx));
+		} else {
+			maxEIRPdBm = _maxEIRP_dBm;
+		}
+		for (int bandEdgeIdx = 0; bandEdgeIdx < numBandEdge; ++bandEdgeIdx) {
+			double pathLoss;
+			if (numFreq == 1) {
+				pathLoss = freqPathLoss[0];
+			} else {
+				double freqMHz = evalFreqMHz(freqSegIdx, bandEdgeIdx);
+				pathLoss = (freqPathLoss[0] * (maxFreqMHz - freqMHz) +
+					    freqPathLoss[1] * (freqMHz - minFreqMHz)) /
+					   (maxFreqMHz - minFreqMHz);
+			}
+			double I2NDB = rxPowerDBW_0PLList[bandEdgeIdx][itmSegIdx] - pathLoss -
+				       noiseLevelDBW;
+			double eirpLimit_dBm = maxEIRPdBm + _IoverN_threshold_dB - I2NDB;
+			const auto &seg = channel->segList[freqSegIdx];
+			double eirp_dBm = (bandEdgeIdx == 0 ? std::get<0>(seg) : std::get<1>(seg));
+			if (eirpLimit_dBm < eirp_dBm) {
+				return (true);
+			}
+		}
+	}
+
+	return (false);
+}
+/******************************************************************************************/
+
 /******************************************************************************************/
 /**** FUNCTION: AfcManager::Winner2_C1suburban_LOS                                     ****/
 /**** Winner II: C1, suburban LOS                                                      ****/
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_C1suburban_LOS(double distance,
 					  double hBS,
 					  double hMS,
-					  double frequency,
+					  const PropModelFreqCoeffClass &freqCoeff,
 					  double zval,
-					  double &sigma,
-					  double &pathLossCDF) const
+					  double &sigma) const
 {
 	double retval;
 
-	double dBP = 4 * hBS * hMS * frequency / CConst::c;
+	double dBP = freqCoeff.winner2BPFactor * hBS * hMS;
 
 	if (distance < 30.0) {
 		// FSPL
 		sigma = 0.0;
-		retval = -(20.0 * log10(CConst::c / (4 * M_PI * frequency * distance)));
+		retval = freqCoeff.fsplDB + 20.0 * log10(distance);
 	} else if (distance < dBP) {
 		sigma = 4.0;
-		retval = 23.8 * log10(distance) + 41.2 + 20 * log10(frequency * 1.0e-9 / 5);
+		retval = 23.8 * log10(distance) + 41.2 + 20 * freqCoeff.winner2LogF5;
 	} else {
 		sigma = 6.0;
 		retval = 40.0 * log10(distance) + 11.65 - 16.2 * log10(hBS) - 16.2 * log10(hMS) +
-			 3.8 * log10(frequency * 1.0e-9 / 5);
+			 3.8 * freqCoeff.winner2LogF5;
 	}
 
-	arma::vec gauss(1);
-	gauss[0] = zval;
-
-	retval += sigma * (gauss[0]);
-	pathLossCDF = q(-gauss[0]);
+	retval += sigma * zval;
 
 	return (retval);
 }
@@ -8626,27 +8997,22 @@ double AfcManager::Winner2_C1suburban_LOS(double distance,
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_C1suburban_NLOS(double distance,
 					   double hBS,
 					   double /* hMS */,
-					   double frequency,
+					   const PropModelFreqCoeffClass &freqCoeff,
 					   double zval,
-					   double &sigma,
-					   double &pathLossCDF) const
+					   double &sigma) const
 {
 	double retval;
 
 	sigma = 8.0;
 	retval = (44.9 - 6.55 * log10(hBS)) * log10(distance) + 31.46 + 5.83 * log10(hBS) +
-		 23.0 * log10(frequency * 1.0e-9 / 5);
-
-	arma::vec gauss(1);
-	gauss[0] = zval;
+		 23.0 * freqCoeff.winner2LogF5;
 
-	retval += sigma * (gauss[0]);
-	pathLossCDF = q(-gauss[0]);
+	retval += sigma * zval;
 
 	return (retval);
 }
@@ -8658,18 +9024,19 @@ double AfcManager::Winner2_C1suburban_NLOS(double distance,
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_C1suburban(double distance,
 				      double hBS,
 				      double hMS,
-				      double frequency,
+				      const PropModelFreqCoeffClass &freqCoeff,
 				      double &sigma,
-				      std::string &pathLossModelStr,
+				      CConst::PathLossResultModelEnum &pathLossModel,
 				      double &pathLossCDF,
 				      double &probLOS,
 				      int losValue) const
 {
+	LOGGER_TIMED_SCOPE("pathLoss.Winner2");
 	double retval = quietNaN;
 
 	if ((losValue == 0) && (_closeInHgtFlag) && (hMS > _closeInHgtLOS)) {
@@ -8685,48 +9052,43 @@ double AfcManager::Winner2_C1suburban(double distance,
 			double plLOS = Winner2_C1suburban_LOS(distance,
 							      hBS,
 							      hMS,
-							      frequency,
+							      freqCoeff,
 							      0.0,
-							      sigmaLOS,
-							      pathLossCDF);
+							      sigmaLOS);
 			double plNLOS = Winner2_C1suburban_NLOS(distance,
 								hBS,
 								hMS,
-								frequency,
+								freqCoeff,
 								0.0,
-								sigmaNLOS,
-								pathLossCDF);
+								sigmaNLOS);
 			retval = probLOS * plLOS + (1.0 - probLOS) * plNLOS;
 			sigma = sqrt(probLOS * probLOS * sigmaLOS * sigmaLOS +
 				     (1.0 - probLOS) * (1.0 - probLOS) * sigmaNLOS * sigmaNLOS);
 
-			arma::vec gauss(1);
-			gauss[0] = _zwinner2Combined;
+			retval += sigma * _zwinner2Combined;
+			pathLossCDF = _propModelContext.winner2CombinedCDF;
 
-			retval += sigma * gauss[0];
-			pathLossCDF = q(-(gauss[0]));
-
-			pathLossModelStr = "W2C1_SUBURBAN_COMB";
+			pathLossModel = CConst::W2C1SuburbanCombPathLossResultModel;
 		} else if (_winner2UnknownLOSMethod ==
 			   CConst::PLOSThresholdWinner2UnknownLOSMethod) {
 			if (probLOS > _winner2ProbLOSThr) {
 				retval = Winner2_C1suburban_LOS(distance,
 								hBS,
 								hMS,
-								frequency,
+								freqCoeff,
 								_zwinner2LOS,
-								sigma,
-								pathLossCDF);
-				pathLossModelStr = "W2C1_SUBURBAN_LOS";
+								sigma);
+				pathLossCDF = _propModelContext.winner2LOSCDF;
+				pathLossModel = CConst::W2C1SuburbanLOSPathLossResultModel;
 			} else {
 				retval = Winner2_C1suburban_NLOS(distance,
 								 hBS,
 								 hMS,
-								 frequency,
+								 freqCoeff,
 								 _zwinner2NLOS,
-								 sigma,
-								 pathLossCDF);
-				pathLossModelStr = "W2C1_SUBURBAN_NLOS";
+								 sigma);
+				pathLossCDF = _propModelContext.winner2NLOSCDF;
+				pathLossModel = CConst::W2C1SuburbanNLOSPathLossResultModel;
 			}
 		} else {
 			CORE_DUMP;
@@ -8735,20 +9097,20 @@ double AfcManager::Winner2_C1suburban(double distance,
 		retval = Winner2_C1suburban_LOS(distance,
 						hBS,
 						hMS,
-						frequency,
+						freqCoeff,
 						_zwinner2LOS,
-						sigma,
-						pathLossCDF);
-		pathLossModelStr = "W2C1_SUBURBAN_LOS";
+						sigma);
+		pathLossCDF = _propModelContext.winner2LOSCDF;
+		pathLossModel = CConst::W2C1SuburbanLOSPathLossResultModel;
 	} else if (losValue == 2) {
 		retval = Winner2_C1suburban_NLOS(distance,
 						 hBS,
 						 hMS,
-						 frequency,
+						 freqCoeff,
 						 _zwinner2NLOS,
-						 sigma,
-						 pathLossCDF);
-		pathLossModelStr = "W2C1_SUBURBAN_NLOS";
+						 sigma);
+		pathLossCDF = _propModelContext.winner2NLOSCDF;
+		pathLossModel = CConst::W2C1SuburbanNLOSPathLossResultModel;
 	} else {
 		CORE_DUMP;
 	}
@@ -8763,38 +9125,33 @@ double AfcManager::Winner2_C1suburban(double distance,
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_C2urban_LOS(double distance,
 				       double hBS,
 				       double hMS,
-				       double frequency,
+				       const PropModelFreqCoeffClass &freqCoeff,
 				       double zval,
-				       double &sigma,
-				       double &pathLossCDF) const
+				       double &sigma) const
 {
 	double retval;
 
-	double dBP = 4 * (hBS - 1.0) * (hMS - 1.0) * frequency / CConst::c;
+	double dBP = freqCoeff.winner2BPFactor * (hBS - 1.0) * (hMS - 1.0);
 
 	if (distance < 10.0) {
 		// FSPL
 		sigma = 0.0;
-		retval = -(20.0 * log10(CConst::c / (4 * M_PI * frequency * distance)));
+		retval = freqCoeff.fsplDB + 20.0 * log10(distance);
 	} else if (distance < dBP) {
 		sigma = 4.0;
-		retval = 26.0 * log10(distance) + 39.0 + 20 * log10(frequency * 1.0e-9 / 5);
+		retval = 26.0 * log10(distance) + 39.0 + 20 * freqCoeff.winner2LogF5;
 	} else {
 		sigma = 6.0;
 		retval = 40.0 * log10(distance) + 13.47 - 14.0 * log10(hBS - 1) -
-			 14.0 * log10(hMS - 1) + 6.0 * log10(frequency * 1.0e-9 / 5);
+			 14.0 * log10(hMS - 1) + 6.0 * freqCoeff.winner2LogF5;
 	}
 
-	arma::vec gauss(1);
-	gauss[0] = zval;
-
-	retval += sigma * (gauss[0]);
-	pathLossCDF = q(-gauss[0]);
+	retval += sigma * zval;
 
 	return (retval);
 }
@@ -8806,27 +9163,22 @@ double AfcManager::Winner2_C2urban_LOS(double distance,
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_C2urban_NLOS(double distance,
 					double hBS,
 					double /* hMS */,
-					double frequency,
+					const PropModelFreqCoeffClass &freqCoeff,
 					double zval,
-					double &sigma,
-					double &pathLossCDF) const
+					double &sigma) const
 {
 	double retval;
 
 	sigma = 8.0;
 	retval = (44.9 - 6.55 * log10(hBS)) * log10(distance) + 34.46 + 5.83 * log10(hBS) +
-		 23.0 * log10(frequency * 1.0e-9 / 5);
-
-	arma::vec gauss(1);
-	gauss[0] = zval;
+		 23.0 * freqCoeff.winner2LogF5;
 
-	retval += sigma * (gauss[0]);
-	pathLossCDF = q(-gauss[0]);
+	retval += sigma * zval;
 
 	return (retval);
 }
@@ -8838,18 +9190,19 @@ double AfcManager::Winner2_C2urban_NLOS(double distance,
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_C2urban(double distance,
 				   double hBS,
 				   double hMS,
-				   double frequency,
+				   const PropModelFreqCoeffClass &freqCoeff,
 				   double &sigma,
-				   std::string &pathLossModelStr,
+				   CConst::PathLossResultModelEnum &pathLossModel,
 				   double &pathLossCDF,
 				   double &probLOS,
 				   int losValue) const
 {
+	LOGGER_TIMED_SCOPE("pathLoss.Winner2");
 	double retval = quietNaN;
 
 	if ((losValue == 0) && (_closeInHgtFlag) && (hMS > _closeInHgtLOS)) {
@@ -8867,48 +9220,43 @@ double AfcManager::Winner2_C2urban(double distance,
 			double plLOS = Winner2_C2urban_LOS(distance,
 							   hBS,
 							   hMS,
-							   frequency,
+							   freqCoeff,
 							   0.0,
-							   sigmaLOS,
-							   pathLossCDF);
+							   sigmaLOS);
 			double plNLOS = Winner2_C2urban_NLOS(distance,
 							     hBS,
 							     hMS,
-							     frequency,
+							     freqCoeff,
 							     0.0,
-							     sigmaNLOS,
-							     pathLossCDF);
+							     sigmaNLOS);
 			retval = probLOS * plLOS + (1.0 - probLOS) * plNLOS;
 			sigma = sqrt(probLOS * probLOS * sigmaLOS * sigmaLOS +
 				     (1.0 - probLOS) * (1.0 - probLOS) * sigmaNLOS * sigmaNLOS);
 
-			arma::vec gauss(1);
-			gauss[0] = _zwinner2Combined;
+			retval += sigma * _zwinner2Combined;
+			pathLossCDF = _propModelContext.winner2CombinedCDF;
 
-			retval += sigma * gauss[0];
-			pathLossCDF = q(-(gauss[0]));
-
-			pathLossModelStr = "W2C2_URBAN_COMB";
+			pathLossModel = CConst::W2C2UrbanCombPathLossResultModel;
 		} else if (_winner2UnknownLOSMethod ==
 			   CConst::PLOSThresholdWinner2UnknownLOSMethod) {
 			if (probLOS > _winner2ProbLOSThr) {
 				retval = Winner2_C2urban_LOS(distance,
 							     hBS,
 							     hMS,
-							     frequency,
+							     freqCoeff,
 							     _zwinner2LOS,
-							     sigma,
-							     pathLossCDF);
-				pathLossModelStr = "W2C2_URBAN_LOS";
+							     sigma);
+				pathLossCDF = _propModelContext.winner2LOSCDF;
+				pathLossModel = CConst::W2C2UrbanLOSPathLossResultModel;
 			} else {
 				retval = Winner2_C2urban_NLOS(distance,
 							      hBS,
 							      hMS,
-							      frequency,
+							      freqCoeff,
 							      _zwinner2NLOS,
-							      sigma,
-							      pathLossCDF);
-				pathLossModelStr = "W2C2_URBAN_NLOS";
+							      sigma);
+				pathLossCDF = _propModelContext.winner2NLOSCDF;
+				pathLossModel = CConst::W2C2UrbanNLOSPathLossResultModel;
 			}
 		} else {
 			CORE_DUMP;
@@ -8917,20 +9265,20 @@ double AfcManager::Winner2_C2urban(double distance,
 		retval = Winner2_C2urban_LOS(distance,
 					     hBS,
 					     hMS,
-					     frequency,
+					     freqCoeff,
 					     _zwinner2LOS,
-					     sigma,
-					     pathLossCDF);
-		pathLossModelStr = "W2C2_URBAN_LOS";
+					     sigma);
+		pathLossCDF = _propModelContext.winner2LOSCDF;
+		pathLossModel = CConst::W2C2UrbanLOSPathLossResultModel;
 	} else if (losValue == 2) {
 		retval = Winner2_C2urban_NLOS(distance,
 					      hBS,
 					      hMS,
-					      frequency,
+					      freqCoeff,
 					      _zwinner2NLOS,
-					      sigma,
-					      pathLossCDF);
-		pathLossModelStr = "W2C2_URBAN_NLOS";
+					      sigma);
+		pathLossCDF = _propModelContext.winner2NLOSCDF;
+		pathLossModel = CConst::W2C2UrbanNLOSPathLossResultModel;
 	} else {
 		CORE_DUMP;
 	}
@@ -8945,38 +9293,33 @@ double AfcManager::Winner2_C2urban(double distance,
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_D1rural_LOS(double distance,
 				       double hBS,
 				       double hMS,
-				       double frequency,
+				       const PropModelFreqCoeffClass &freqCoeff,
 				       double zval,
-				       double &sigma,
-				       double &pathLossCDF) const
+				       double &sigma) const
 {
 	double retval;
 
-	double dBP = 4 * (hBS) * (hMS)*frequency / CConst::c;
+	double dBP = freqCoeff.winner2BPFactor * (hBS) * (hMS);
 
 	if (distance < 10.0) {
 		// FSPL
 		sigma = 0.0;
-		retval = -(20.0 * log10(CConst::c / (4 * M_PI * frequency * distance)));
+		retval = freqCoeff.fsplDB + 20.0 * log10(distance);
 	} else if (distance < dBP) {
 		sigma = 4.0;
-		retval = 21.5 * log10(distance) + 44.2 + 20 * log10(frequency * 1.0e-9 / 5);
+		retval = 21.5 * log10(distance) + 44.2 + 20 * freqCoeff.winner2LogF5;
 	} else {
 		sigma = 6.0;
 		retval = 40.0 * log10(distance) + 10.5 - 18.5 * log10(hBS) - 18.5 * log10(hMS) +
-			 1.5 * log10(frequency * 1.0e-9 / 5);
+			 1.5 * freqCoeff.winner2LogF5;
 	}
 
-	arma::vec gauss(1);
-	gauss[0] = zval;
-
-	retval += sigma * gauss[0];
-	pathLossCDF = q(-gauss[0]);
+	retval += sigma * zval;
 
 	return (retval);
 }
@@ -8988,27 +9331,22 @@ double AfcManager::Winner2_D1rural_LOS(double distance,
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_D1rural_NLOS(double distance,
 					double hBS,
 					double hMS,
-					double frequency,
+					const PropModelFreqCoeffClass &freqCoeff,
 					double zval,
-					double &sigma,
-					double &pathLossCDF) const
+					double &sigma) const
 {
 	double retval;
 
 	sigma = 8.0;
 	retval = 25.1 * log10(distance) + 55.4 - 0.13 * (hBS - 25) * log10(distance / 100) -
-		 0.9 * (hMS - 1.5) + 21.3 * log10(frequency * 1.0e-9 / 5);
+		 0.9 * (hMS - 1.5) + 21.3 * freqCoeff.winner2LogF5;
 
-	arma::vec gauss(1);
-	gauss[0] = zval;
-
-	retval += sigma * gauss[0];
-	pathLossCDF = q(-gauss[0]);
+	retval += sigma * zval;
 
 	return (retval);
 }
@@ -9020,18 +9358,19 @@ double AfcManager::Winner2_D1rural_NLOS(double distance,
 /**** distance = link distance (m)                                                     ****/
 /**** hBS = BS antenna height (m)                                                      ****/
 /**** hMS = MS antenna height (m)                                                      ****/
-/**** frequency = Frequency (Hz)                                                       ****/
+/**** freqCoeff = Model coefficients for frequency                                     ****/
 /******************************************************************************************/
 double AfcManager::Winner2_D1rural(double distance,
 				   double hBS,
 				   double hMS,
-				   double frequency,
+				   const PropModelFreqCoeffClass &freqCoeff,
 				   double &sigma,
-				   std::string &pathLossModelStr,
+				   CConst::PathLossResultModelEnum &pathLossModel,
 				   double &pathLossCDF,
 				   double &probLOS,
 				   int losValue) const
 {
+	LOGGER_TIMED_SCOPE("pathLoss.Winner2");
 	double retval = quietNaN;
 
 	if ((losValue == 0) && (_closeInHgtFlag) && (hMS > _closeInHgtLOS)) {
@@ -9047,48 +9386,43 @@ double AfcManager::Winner2_D1rural(double distance,
 			double plLOS = Winner2_D1rural_LOS(distance,
 							   hBS,
 							   hMS,
-							   frequency,
+							   freqCoeff,
 							   0.0,
-							   sigmaLOS,
-							   pathLossCDF);
+							   sigmaLOS);
 			double plNLOS = Winner2_D1rural_NLOS(distance,
 							     hBS,
 							     hMS,
-							     frequency,
+							     freqCoeff,
 							     0.0,
-							     sigmaNLOS,
-							     pathLossCDF);
+							     sigmaNLOS);
 			retval = probLOS * plLOS + (1.0 - probLOS) * plNLOS;
 			sigma = sqrt(probLOS * probLOS * sigmaLOS * sigmaLOS +
 				     (1.0 - probLOS) * (1.0 - probLOS) * sigmaNLOS * sigmaNLOS);
 
-			arma::vec gauss(1);
-			gauss[0] = _zwinner2Combined;
-
-			retval += sigma * gauss[0];
-			pathLossCDF = q(-(gauss[0]));
+			retval += sigma * _zwinner2Combined;
+			pathLossCDF = _propModelContext.winner2CombinedCDF;
 
-			pathLossModelStr = "W2D1_RURAL_COMB";
+			pathLossModel = CConst::W2D1RuralCombPathLossResultModel;
 		} else if (_winner2UnknownLOSMethod ==
 			   CConst::PLOSThresholdWinner2UnknownLOSMethod) {
 			if (probLOS > _winner2ProbLOSThr) {
 				retval = Winner2_D1rural_LOS(distance,
 							     hBS,
 							     hMS,
-							     frequency,
+							     freqCoeff,
 							     _zwinner2LOS,
-							     sigma,
-							     pathLossCDF);
-				pathLossModelStr = "W2D1_RURAL_LOS";
+							     sigma);
+				pathLossCDF = _propModelContext.winner2LOSCDF;
+				pathLossModel = CConst::W2D1RuralLOSPathLossResultModel;
 			} else {
 				retval = Winner2_D1rural_NLOS(distance,
 							      hBS,
 							      hMS,
-							      frequency,
+							      freqCoeff,
 							      _zwinner2NLOS,
-							      sigma,
-							      pathLossCDF);
-				pathLossModelStr = "W2D1_RURAL_NLOS";
+							      sigma);
+				pathLossCDF = _propModelContext.winner2NLOSCDF;
+				pathLossModel = CConst::W2D1RuralNLOSPathLossResultModel;
 			}
 		} else {
 			CORE_DUMP;
@@ -9097,20 +9431,20 @@ double AfcManager::Winner2_D1rural(double distance,
 		retval = Winner2_D1rural_LOS(distance,
 					     hBS,
 					     hMS,
-					     frequency,
+					     freqCoeff,
 					     _zwinner2LOS,
-					     sigma,
-					     pathLossCDF);
-		pathLossModelStr = "W2D1_RURAL_LOS";
+					     sigma);
+		pathLossCDF = _propModelContext.winner2LOSCDF;
+		pathLossModel = CConst::W2D1RuralLOSPathLossResultModel;
 	} else if (losValue == 2) {
 		retval = Winner2_D1rural_NLOS(distance,
 					      hBS,
 					      hMS,
-					      frequency,
+					      freqCoeff,
 					      _zwinner2NLOS,
-					      sigma,
-					      pathLossCDF);
-		pathLossModelStr = "W2D1_RURAL_NLOS";
+					      sigma);
+		pathLossCDF = _propModelContext.winner2NLOSCDF;
+		pathLossModel = CConst::W2D1RuralNLOSPathLossResultModel;
 	} else {
 		CORE_DUMP;
 	}
@@ -9174,6 +9508,10 @@ void AfcManager::compute()
 		throw std::runtime_error(ErrStream() << "ERROR: Unrecognized analysis type = \""
 						     << _analysisType << "\"");
 	}
+
+	if (!_terrainProfileFile.empty()) {
+		CachedGdalBase::accessProfiler()->writeCsv(_terrainProfileFile);
+	}
 }
 /******************************************************************************************/
 
@@ -9182,6 +9520,7 @@ void AfcManager::compute()
 /******************************************************************************************/
 void AfcManager::runPointAnalysis()
 {
+	LOGGER_TIMED_SCOPE("runPointAnalysis");
 	std::ostringstream errStr;
 
 #if DEBUG_AFC
@@ -9219,6 +9558,7 @@ void AfcManager::runPointAnalysis()
 	CConst::PropEnvEnum rlanPropEnv[scanPointList.size()];
 	CConst::NLCDLandCatEnum rlanNlcdLandCat[scanPointList.size()];
 
+	LOGGER_TIMER(scanPointTimer, "runPointAnalysis.scanPointSetup");
 	int scanPtIdx, rlanHtIdx;
 	for (scanPtIdx = 0; scanPtIdx < (int)scanPointList.size(); scanPtIdx++) {
 		LatLon scanPt = scanPointList[scanPtIdx];
@@ -9283,6 +9623,7 @@ void AfcManager::runPointAnalysis()
 							scanPt.first,
 							rlanNlcdLandCat[scanPtIdx]);
 	}
+	scanPointTimer.stop();
 	/**************************************************************************************/
 
 	/**************************************************************************************/
@@ -9290,7 +9631,7 @@ void AfcManager::runPointAnalysis()
 	/**************************************************************************************/
 	ExThrGzipCsv *excthrGc = (ExThrGzipCsv *)NULL;
 	if (!_excThrFile.empty()) {
-		excthrGc = new ExThrGzipCsv(_excThrFile);
+		excthrGc = new ExThrGzipCsv(_excThrFile, _excThrFormat);
 	}
 
 	EirpGzipCsv eirpGc(_eirpGcFile);
@@ -9302,8 +9643,14 @@ void AfcManager::runPointAnalysis()
 	ZXmlWriter kml_writer(_kmlFile);
 	auto &fkml = kml_writer.xml_writer;
 
+	// Two tier ITM evaluation skips links that don't limit EIRP, so it is not used when
+	// per link results are written
+	bool itmScreenFlag = _itmScreeningFlag && (!excthrGc) && (!eirpGc) && (!fkml);
+	int numItmScreen = 0; // Number of FS/scan point links screened with coarse ITM
+	int numItmPruned = 0; // Number of screened links for which full ITM was skipped
+
 	if (fkml) {
-		fkml->setAutoFormatting(true);
+		fkml->setAutoFormatting(_createDebugFiles);
 		fkml->writeStartDocument();
 		fkml->writeStartElement("kml");
 		fkml->writeAttribute("xmlns", "http://www.opengis.net/kml/2.2");
@@ -9456,6 +9803,7 @@ void AfcManager::runPointAnalysis()
 		fkml->writeTextElement("name", "RLAN");
 
 		std::vector<GeodeticCoord> ptList = _rlanRegion->getBoundary(_terrainDataModel);
+		std::string coords;
 
 		/**********************************************************************************/
 		/* CENTER                                                                         */
@@ -9468,11 +9816,13 @@ void AfcManager::runPointAnalysis()
 		fkml->writeTextElement("styleUrl", "#dotStyle");
 		fkml->writeStartElement("Point");
 		fkml->writeTextElement("altitudeMode", "absolute");
-		fkml->writeTextElement("coordinates",
-				       QString::asprintf("%.10f,%.10f,%.2f",
-							 rlanCenterPtGeo.longitudeDeg,
-							 rlanCenterPtGeo.latitudeDeg,
-							 rlanCenterPtGeo.heightKm * 1000.0));
+		coords.clear();
+		KmlWriter::appendCoordinate(coords,
+					    rlanCenterPtGeo.longitudeDeg,
+					    rlanCenterPtGeo.latitudeDeg,
+					    rlanCenterPtGeo.heightKm * 1000.0,
+					    false);
+		fkml->writeTextElement("coordinates", coords);
 		fkml->writeEndElement(); // Point
 		fkml->writeEndElement(); // Placemark
 		/**********************************************************************************/
@@ -9491,15 +9841,14 @@ void AfcManager::runPointAnalysis()
 		fkml->writeStartElement("outerBoundaryIs");
 		fkml->writeStartElement("LinearRing");
 
-		QString top_coords = QString();
+		std::string top_coords;
 		for (ptIdx = 0; ptIdx <= (int)ptList.size(); ptIdx++) {
 			GeodeticCoord pt = ptList[ptIdx % ptList.size()];
-			top_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt.longitudeDeg,
-						  pt.latitudeDeg,
-						  pt.heightKm * 1000.0 +
-							  _rlanRegion->getHeightUncertainty()));
+			KmlWriter::appendCoordinate(
+				top_coords,
+				pt.longitudeDeg,
+				pt.latitudeDeg,
+				pt.heightKm * 1000.0 + _rlanRegion->getHeightUncertainty());
 		}
 
 		fkml->writeTextElement("coordinates", top_coords);
@@ -9523,15 +9872,14 @@ void AfcManager::runPointAnalysis()
 		fkml->writeStartElement("outerBoundaryIs");
 		fkml->writeStartElement("LinearRing");
 
-		QString bottom_coords = QString();
+		std::string bottom_coords;
 		for (ptIdx = 0; ptIdx <= (int)ptList.size(); ptIdx++) {
 			GeodeticCoord pt = ptList[ptIdx % ptList.size()];
-			bottom_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt.longitudeDeg,
-						  pt.latitudeDeg,
-						  pt.heightKm * 1000.0 -
-							  _rlanRegion->getHeightUncertainty()));
+			KmlWriter::appendCoordinate(
+				bottom_coords,
+				pt.longitudeDeg,
+				pt.latitudeDeg,
+				pt.heightKm * 1000.0 - _rlanRegion->getHeightUncertainty());
 		}
 		fkml->writeTextElement("coordinates", bottom_coords);
 		fkml->writeEndElement(); // LinearRing
@@ -9558,37 +9906,32 @@ void AfcManager::runPointAnalysis()
 
 			GeodeticCoord pt1 = ptList[ptIdx];
 			GeodeticCoord pt2 = ptList[(ptIdx + 1) % ptList.size()];
-			QString side_coords;
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt1.longitudeDeg,
-						  pt1.latitudeDeg,
-						  pt1.heightKm * 1000.0 -
-							  _rlanRegion->getHeightUncertainty()));
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt1.longitudeDeg,
-						  pt1.latitudeDeg,
-						  pt1.heightKm * 1000.0 +
-							  _rlanRegion->getHeightUncertainty()));
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt2.longitudeDeg,
-						  pt2.latitudeDeg,
-						  pt2.heightKm * 1000.0 +
-							  _rlanRegion->getHeightUncertainty()));
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt2.longitudeDeg,
-						  pt2.latitudeDeg,
-						  pt2.heightKm * 1000.0 -
-							  _rlanRegion->getHeightUncertainty()));
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt1.longitudeDeg,
-						  pt1.latitudeDeg,
-						  pt1.heightKm * 1000.0 -
-							  _rlanRegion->getHeightUncertainty()));
+			std::string side_coords;
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt1.longitudeDeg,
+				pt1.latitudeDeg,
+				pt1.heightKm * 1000.0 - _rlanRegion->getHeightUncertainty());
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt1.longitudeDeg,
+				pt1.latitudeDeg,
+				pt1.heightKm * 1000.0 + _rlanRegion->getHeightUncertainty());
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt2.longitudeDeg,
+				pt2.latitudeDeg,
+				pt2.heightKm * 1000.0 + _rlanRegion->getHeightUncertainty());
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt2.longitudeDeg,
+				pt2.latitudeDeg,
+				pt2.heightKm * 1000.0 - _rlanRegion->getHeightUncertainty());
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt1.longitudeDeg,
+				pt1.latitudeDeg,
+				pt1.heightKm * 1000.0 - _rlanRegion->getHeightUncertainty());
 
 			fkml->writeTextElement("coordinates", side_coords);
 			fkml->writeEndElement(); // LinearRing
@@ -9620,11 +9963,13 @@ void AfcManager::runPointAnalysis()
 				fkml->writeTextElement("styleUrl", "#dotStyle");
 				fkml->writeStartElement("Point");
 				fkml->writeTextElement("altitudeMode", "absolute");
-				fkml->writeTextElement("coordinates",
-						       QString::asprintf("%.10f,%.10f,%.2f",
-									 scanPt.second,
-									 scanPt.first,
-									 heightAMSL));
+				coords.clear();
+				KmlWriter::appendCoordinate(coords,
+							    scanPt.second,
+							    scanPt.first,
+							    heightAMSL,
+							    false);
+				fkml->writeTextElement("coordinates", coords);
 				fkml->writeEndElement(); // Point
 				fkml->writeEndElement(); // Placemark
 			}
@@ -9676,29 +10021,30 @@ void AfcManager::runPointAnalysis()
 					fkml->writeStartElement("outerBoundaryIs");
 					fkml->writeStartElement("LinearRing");
 
-					QString more_coords = QString::asprintf(
-						"%.10f,%.10f,%.2f\n",
+					std::string more_coords;
+					KmlWriter::appendCoordinate(
+						more_coords,
 						_rlanRegion->getCenterLongitude(),
 						_rlanRegion->getCenterLatitude(),
 						_rlanRegion->getCenterHeightAMSL());
 
 					GeodeticCoord pt = ptgPtList[cvgPhiIdx];
-					more_coords.append(QString::asprintf("%.10f,%.10f,%.2f\n",
-									     pt.longitudeDeg,
-									     pt.latitudeDeg,
-									     pt.heightKm * 1000.0));
+					KmlWriter::appendCoordinate(more_coords,
+								    pt.longitudeDeg,
+								    pt.latitudeDeg,
+								    pt.heightKm * 1000.0);
 
 					pt = ptgPtList[(cvgPhiIdx + 1) % numCvgPoints];
-					more_coords.append(QString::asprintf("%.10f,%.10f,%.2f\n",
-									     pt.longitudeDeg,
-									     pt.latitudeDeg,
-									     pt.heightKm * 1000.0));
+					KmlWriter::appendCoordinate(more_coords,
+								    pt.longitudeDeg,
+								    pt.latitudeDeg,
+								    pt.heightKm * 1000.0);
 
-					more_coords.append(QString::asprintf(
-						"%.10f,%.10f,%.2f\n",
+					KmlWriter::appendCoordinate(
+						more_coords,
 						_rlanRegion->getCenterLongitude(),
 						_rlanRegion->getCenterLatitude(),
-						_rlanRegion->getCenterHeightAMSL()));
+						_rlanRegion->getCenterHeightAMSL());
 
 					fkml->writeTextElement("coordinates", more_coords);
 					fkml->writeEndElement(); // LinearRing
@@ -9728,14 +10074,13 @@ void AfcManager::runPointAnalysis()
 			fkml->writeStartElement("outerBoundaryIs");
 			fkml->writeStartElement("LinearRing");
 
-			QString top_bdy_coords = QString();
+			std::string top_bdy_coords;
 			for (ptIdx = 0; ptIdx <= (int)bdyPtList.size(); ptIdx++) {
 				GeodeticCoord pt = bdyPtList[ptIdx % bdyPtList.size()];
-				top_bdy_coords.append(
-					QString::asprintf("%.10f,%.10f,%.2f\n",
-							  pt.longitudeDeg,
-							  pt.latitudeDeg,
-							  _rlanRegion->getMaxHeightAMSL()));
+				KmlWriter::appendCoordinate(top_bdy_coords,
+							    pt.longitudeDeg,
+							    pt.latitudeDeg,
+							    _rlanRegion->getMaxHeightAMSL());
 			}
 
 			fkml->writeTextElement("coordinates", top_bdy_coords);
@@ -9759,14 +10104,13 @@ void AfcManager::runPointAnalysis()
 			fkml->writeStartElement("outerBoundaryIs");
 			fkml->writeStartElement("LinearRing");
 
-			QString bottom_bdy_coords = QString();
+			std::string bottom_bdy_coords;
 			for (ptIdx = 0; ptIdx <= (int)bdyPtList.size(); ptIdx++) {
 				GeodeticCoord pt = bdyPtList[ptIdx % bdyPtList.size()];
-				bottom_bdy_coords.append(
-					QString::asprintf("%.10f,%.10f,%.2f\n",
-							  pt.longitudeDeg,
-							  pt.latitudeDeg,
-							  _rlanRegion->getMinHeightAMSL()));
+				KmlWriter::appendCoordinate(bottom_bdy_coords,
+							    pt.longitudeDeg,
+							    pt.latitudeDeg,
+							    _rlanRegion->getMinHeightAMSL());
 			}
 
 			fkml->writeTextElement("coordinates", bottom_bdy_coords);
@@ -9812,7 +10156,7 @@ void AfcManager::runPointAnalysis()
 			Vector3 drUpVec;
 			Vector3 drEastVec;
 			Vector3 drNorthVec;
-			QString dr_coords;
+			std::string dr_coords;
 			MultibandRasterClass::HeightResult drLidarHeightResult;
 			CConst::HeightSourceEnum drHeightSource;
 			DeniedRegionClass::GeometryEnum drGeometry = dr->getGeometry();
@@ -9844,32 +10188,27 @@ void AfcManager::runPointAnalysis()
 						fkml->writeStartElement("outerBoundaryIs");
 						fkml->writeStartElement("LinearRing");
 
-						dr_coords = QString();
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStart,
-										   rectLatStart,
-										   0.0));
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStop,
-										   rectLatStart,
-										   0.0));
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStop,
-										   rectLatStop,
-										   0.0));
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStart,
-										   rectLatStop,
-										   0.0));
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStart,
-										   rectLatStart,
-										   0.0));
+						dr_coords.clear();
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStart,
+									    rectLatStart,
+									    0.0);
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStop,
+									    rectLatStart,
+									    0.0);
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStop,
+									    rectLatStop,
+									    0.0);
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStart,
+									    rectLatStop,
+									    0.0);
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStart,
+									    rectLatStart,
+									    0.0);
 
 						fkml->writeTextElement("coordinates", dr_coords);
 						fkml->writeEndElement(); // LinearRing
@@ -9916,7 +10255,7 @@ void AfcManager::runPointAnalysis()
 					fkml->writeStartElement("outerBoundaryIs");
 					fkml->writeStartElement("LinearRing");
 
-					dr_coords = QString();
+					dr_coords.clear();
 					for (ptIdx = 0; ptIdx <= numPtsCircle; ++ptIdx) {
 						double phi = 2 * M_PI * ptIdx / numPtsCircle;
 						Vector3 circlePtPosn = drCenterPosn +
@@ -9929,11 +10268,11 @@ void AfcManager::runPointAnalysis()
 						GeodeticCoord circlePtPosnGeodetic =
 							EcefModel::ecefToGeodetic(circlePtPosn);
 
-						dr_coords.append(QString::asprintf(
-							"%.10f,%.10f,%.2f\n",
+						KmlWriter::appendCoordinate(
+							dr_coords,
 							circlePtPosnGeodetic.longitudeDeg,
 							circlePtPosnGeodetic.latitudeDeg,
-							0.0));
+							0.0);
 					}
 
 					fkml->writeTextElement("coordinates", dr_coords);
@@ -10793,26 +11132,12 @@ void AfcManager::runPointAnalysis()
 
 														if (state ==
 														    0) {
-															std::string
-																buildingPenetrationModelStr;
+															CConst::BuildingPenetrationModelEnum
+																buildingPenetrationModel;
 															double buildingPenetrationCDF;
 															double buildingPenetrationDB;
 
-															std::string
-																txClutterStr;
-															std::string
-																rxClutterStr;
-															std::string
-																pathLossModelStr;
-															double pathLossCDF;
-															std::string
-																pathClutterTxModelStr;
-															double pathClutterTxCDF;
-															double pathClutterTxDB;
-															std::string
-																pathClutterRxModelStr;
-															double pathClutterRxCDF;
-															double pathClutterRxDB;
+															PathLossResultClass pathLossResult;
 															double rxGainDB;
 															double discriminationGain;
 															std::string
@@ -10825,6 +11150,14 @@ void AfcManager::runPointAnalysis()
 															double reflectorD0;
 															double reflectorD1;
 
+															const PropModelFreqCoeffClass &freqCoeff =
+																_propModelContext.getSegFreqCoeff(
+																	chanIdx,
+																	freqSegIdx,
+																	(channelType == INQUIRED_FREQUENCY ?
+																		 bandEdgeIdx :
+																		 2));
+
 															computePathLoss(
 																contains2D ?
 																	CConst::FSPLPathLossModel :
@@ -10839,7 +11172,7 @@ void AfcManager::runPointAnalysis()
 																distKm,
 																fsplDistKm,
 																win2DistKm,
-																evalFreqHz,
+																freqCoeff,
 																rlanCoord
 																	.longitudeDeg,
 																rlanCoord
@@ -10850,30 +11183,21 @@ void AfcManager::runPointAnalysis()
 																ulsRxLatitude,
 																ulsRxHeightAGL,
 																elevationAngleRxDeg,
-																pathLoss,
-																pathClutterTxDB,
-																pathClutterRxDB,
-																pathLossModelStr,
-																pathLossCDF,
-																pathClutterTxModelStr,
-																pathClutterTxCDF,
-																pathClutterRxModelStr,
-																pathClutterRxCDF,
-																&txClutterStr,
-																&rxClutterStr,
+																pathLossResult,
 																&(uls->ITMHeightProfile),
-																&(uls->isLOSHeightProfile),
-																&(uls->isLOSSurfaceFrac)
+																&(uls->losOracle)
 #if DEBUG_AFC
 																	,
 																uls->ITMHeightType
 #endif
 															);
+															pathLoss =
+																pathLossResult.pathLoss;
 															buildingPenetrationDB = computeBuildingPenetration(
 																_buildingType,
 																elevationAngleTxDeg,
-																evalFreqHz,
-																buildingPenetrationModelStr,
+																freqCoeff,
+																buildingPenetrationModel,
 																buildingPenetrationCDF);
 
 															if (contains2D) {
@@ -10976,8 +11300,10 @@ void AfcManager::runPointAnalysis()
 																rlanDiscriminationGainDB -
 																_bodyLossDB -
 																buildingPenetrationDB -
-																pathClutterTxDB -
-																pathClutterRxDB +
+																pathLossResult
+																	.pathClutterTxDB -
+																pathLossResult
+																	.pathClutterRxDB +
 																rxGainDB +
 																nearFieldOffsetDB -
 																spectralOverlapLossDB -
@@ -10991,8 +11317,8 @@ void AfcManager::runPointAnalysis()
 																	.bodyLossDB =
 																	_bodyLossDB;
 																excThrParam[bandEdgeIdx]
-																	.buildingPenetrationModelStr =
-																	buildingPenetrationModelStr;
+																	.buildingPenetrationModel =
+																	buildingPenetrationModel;
 																excThrParam[bandEdgeIdx]
 																	.buildingPenetrationCDF =
 																	buildingPenetrationCDF;
@@ -11003,35 +11329,8 @@ void AfcManager::runPointAnalysis()
 																	.angleOffBoresightDeg =
 																	angleOffBoresightDeg;
 																excThrParam[bandEdgeIdx]
-																	.pathLossModelStr =
-																	pathLossModelStr;
-																excThrParam[bandEdgeIdx]
-																	.pathLossCDF =
-																	pathLossCDF;
-																excThrParam[bandEdgeIdx]
-																	.pathClutterTxModelStr =
-																	pathClutterTxModelStr;
-																excThrParam[bandEdgeIdx]
-																	.pathClutterTxCDF =
-																	pathClutterTxCDF;
-																excThrParam[bandEdgeIdx]
-																	.pathClutterTxDB =
-																	pathClutterTxDB;
-																excThrParam[bandEdgeIdx]
-																	.txClutterStr =
-																	txClutterStr;
-																excThrParam[bandEdgeIdx]
-																	.pathClutterRxModelStr =
-																	pathClutterRxModelStr;
-																excThrParam[bandEdgeIdx]
-																	.pathClutterRxCDF =
-																	pathClutterRxCDF;
-																excThrParam[bandEdgeIdx]
-																	.pathClutterRxDB =
-																	pathClutterRxDB;
-																excThrParam[bandEdgeIdx]
-																	.rxClutterStr =
-																	rxClutterStr;
+																	.pathLossResult =
+																	pathLossResult;
 																excThrParam[bandEdgeIdx]
 																	.rxGainDB =
 																	rxGainDB;
@@ -11158,7 +11457,7 @@ void AfcManager::runPointAnalysis()
 																_pathLossModel;
 															eirpGc.resultedPathLossModel =
 																excThrParam[bandEdgeIdx]
-																	.pathLossModelStr;
+																	.pathLossResult.pathLossModelStr();
 															eirpGc.buildingPenetrationDb =
 																excThrParam[bandEdgeIdx]
 																	.buildingPenetrationDB;
@@ -11177,26 +11476,26 @@ void AfcManager::runPointAnalysis()
 																[scanPtIdx];
 															eirpGc.pathClutterTxModel =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterTxModelStr;
+																	.pathLossResult.pathClutterTxModelStr();
 															eirpGc.pathClutterTxDb =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterTxDB;
+																	.pathLossResult.pathClutterTxDB;
 															eirpGc.txClutter =
 																excThrParam[bandEdgeIdx]
-																	.txClutterStr;
+																	.pathLossResult.txClutterStr();
 															eirpGc.rxPropEnv =
 																fsPropEnv;
 															eirpGc.nlcdRx =
 																nlcdLandCatRx;
 															eirpGc.pathClutterRxModel =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterRxModelStr;
+																	.pathLossResult.pathClutterRxModelStr();
 															eirpGc.pathClutterRxDb =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterRxDB;
+																	.pathLossResult.pathClutterRxDB;
 															eirpGc.rxClutter =
 																excThrParam[bandEdgeIdx]
-																	.rxClutterStr;
+																	.pathLossResult.rxClutterStr();
 															eirpGc.nearFieldOffsetDb =
 																excThrParam[bandEdgeIdx]
 																	.nearFieldOffsetDB;
@@ -11444,18 +11743,20 @@ void AfcManager::runPointAnalysis()
 																_bodyLossDB;
 															excthrGc->rlanClutterCategory =
 																excThrParam[bandEdgeIdx]
-																	.txClutterStr;
+																	.pathLossResult.txClutterStr();
 															excthrGc->fsClutterCategory =
 																excThrParam[bandEdgeIdx]
-																	.rxClutterStr;
+																	.pathLossResult.rxClutterStr();
 															excthrGc->buildingType =
 																bldgTypeStr;
 															excthrGc->buildingPenetration =
 																excThrParam[bandEdgeIdx]
 																	.buildingPenetrationDB;
 															excthrGc->buildingPenetrationModel =
-																excThrParam[bandEdgeIdx]
-																	.buildingPenetrationModelStr;
+																CConst::strBuildingPenetrationModelList
+																	->type_to_str(
+																		excThrParam[bandEdgeIdx]
+																			.buildingPenetrationModel);
 															excthrGc->buildingPenetrationCdf =
 																excThrParam[bandEdgeIdx]
 																	.buildingPenetrationCDF;
@@ -11463,28 +11764,28 @@ void AfcManager::runPointAnalysis()
 																pathLoss;
 															excthrGc->pathLossModel =
 																excThrParam[bandEdgeIdx]
-																	.pathLossModelStr;
+																	.pathLossResult.pathLossModelStr();
 															excthrGc->pathLossCdf =
 																excThrParam[bandEdgeIdx]
-																	.pathLossCDF;
+																	.pathLossResult.pathLossCDF;
 															excthrGc->pathClutterTx =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterTxDB;
+																	.pathLossResult.pathClutterTxDB;
 															excthrGc->pathClutterTxMode =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterTxModelStr;
+																	.pathLossResult.pathClutterTxModelStr();
 															excthrGc->pathClutterTxCdf =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterTxCDF;
+																	.pathLossResult.pathClutterTxCDF;
 															excthrGc->pathClutterRx =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterRxDB;
+																	.pathLossResult.pathClutterRxDB;
 															excthrGc->pathClutterRxMode =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterRxModelStr;
+																	.pathLossResult.pathClutterRxModelStr();
 															excthrGc->pathClutterRxCdf =
 																excThrParam[bandEdgeIdx]
-																	.pathClutterRxCDF;
+																	.pathLossResult.pathClutterRxCDF;
 															excthrGc->rlanBandwidth =
 																bandwidthMHz;
 															excthrGc->rlanStartFreq =
@@ -11790,25 +12091,45 @@ void AfcManager::runPointAnalysis()
 												if (freqSegIdx ==
 												    channel->segList
 													    .size()) {
-													std::string
-														txClutterStr;
-													std::string
-														rxClutterStr;
-													std::string
-														pathLossModelStr;
-													double pathLossCDF;
-													std::string
-														pathClutterTxModelStr;
-													double pathClutterTxCDF;
-													double pathClutterTxDB;
-													std::string
-														pathClutterRxModelStr;
-													double pathClutterRxCDF;
-													double pathClutterRxDB;
+													PathLossResultClass pathLossResult;
 
 													int numItmSeg =
 														itmSegList
 															.size();
+													// First tier: full ITM is skipped if coarse ITM shows it
+													// would not lower EIRP of any segment
+													if (itmScreenFlag &&
+													    (numItmSeg > 0)) {
+														numItmScreen++;
+														if (!screenITMSegments(
+															    channel,
+															    itmSegList,
+															    RxPowerDBW_0PLList,
+															    uls->getNoiseLevelDBW(),
+															    rlanPropEnv
+																    [scanPtIdx],
+															    fsPropEnv,
+															    rlanNlcdLandCat
+																    [scanPtIdx],
+															    nlcdLandCatRx,
+															    distKm,
+															    fsplDistKm,
+															    win2DistKm,
+															    rlanCoord
+																    .longitudeDeg,
+															    rlanCoord
+																    .latitudeDeg,
+															    rlanHtAboveTerrain,
+															    elevationAngleTxDeg,
+															    ulsRxLongitude,
+															    ulsRxLatitude,
+															    ulsRxHeightAGL,
+															    elevationAngleRxDeg,
+															    &(uls->losOracle))) {
+															numItmPruned++;
+															numItmSeg = 0;
+														}
+													}
 													if ((numItmSeg >
 													     1) ||
 													    ((numItmSeg >
@@ -11864,8 +12185,9 @@ void AfcManager::runPointAnalysis()
 															distKm,
 															fsplDistKm,
 															win2DistKm,
-															itmStartFreqMHz *
-																1.0e6,
+															_propModelContext.getFreqCoeff(
+																itmStartFreqMHz *
+																	1.0e6),
 															rlanCoord
 																.longitudeDeg,
 															rlanCoord
@@ -11876,25 +12198,17 @@ void AfcManager::runPointAnalysis()
 															ulsRxLatitude,
 															ulsRxHeightAGL,
 															elevationAngleRxDeg,
-															itmStartPathLoss,
-															pathClutterTxDB,
-															pathClutterRxDB,
-															pathLossModelStr,
-															pathLossCDF,
-															pathClutterTxModelStr,
-															pathClutterTxCDF,
-															pathClutterRxModelStr,
-															pathClutterRxCDF,
-															&txClutterStr,
-															&rxClutterStr,
+															pathLossResult,
 															&(uls->ITMHeightProfile),
-															&(uls->isLOSHeightProfile),
-															&(uls->isLOSSurfaceFrac)
+															&(uls->losOracle)
 #if DEBUG_AFC
 																,
 															uls->ITMHeightType
 #endif
 														);
+														itmStartPathLoss =
+															pathLossResult
+																.pathLoss;
 
 														computePathLoss(
 															contains2D ?
@@ -11910,8 +12224,9 @@ void AfcManager::runPointAnalysis()
 															distKm,
 															fsplDistKm,
 															win2DistKm,
-															itmStopFreqMHz *
-																1.0e6,
+															_propModelContext.getFreqCoeff(
+																itmStopFreqMHz *
+																	1.0e6),
 															rlanCoord
 																.longitudeDeg,
 															rlanCoord
@@ -11922,25 +12237,17 @@ void AfcManager::runPointAnalysis()
 															ulsRxLatitude,
 															ulsRxHeightAGL,
 															elevationAngleRxDeg,
-															itmStopPathLoss,
-															pathClutterTxDB,
-															pathClutterRxDB,
-															pathLossModelStr,
-															pathLossCDF,
-															pathClutterTxModelStr,
-															pathClutterTxCDF,
-															pathClutterRxModelStr,
-															pathClutterRxCDF,
-															&txClutterStr,
-															&rxClutterStr,
+															pathLossResult,
 															&(uls->ITMHeightProfile),
-															&(uls->isLOSHeightProfile),
-															&(uls->isLOSSurfaceFrac)
+															&(uls->losOracle)
 #if DEBUG_AFC
 																,
 															uls->ITMHeightType
 #endif
 														);
+														itmStopPathLoss =
+															pathLossResult
+																.pathLoss;
 														state = 1;
 														itmSegIdx =
 															0;
@@ -11971,9 +12278,10 @@ void AfcManager::runPointAnalysis()
 															distKm,
 															fsplDistKm,
 															win2DistKm,
-															(itmStartFreqMHz +
-															 itmStopFreqMHz) *
-																0.5e6,
+															_propModelContext.getFreqCoeff(
+																(itmStartFreqMHz +
+																 itmStopFreqMHz) *
+																	0.5e6),
 															rlanCoord
 																.longitudeDeg,
 															rlanCoord
@@ -11984,25 +12292,17 @@ void AfcManager::runPointAnalysis()
 															ulsRxLatitude,
 															ulsRxHeightAGL,
 															elevationAngleRxDeg,
-															itmStartPathLoss,
-															pathClutterTxDB,
-															pathClutterRxDB,
-															pathLossModelStr,
-															pathLossCDF,
-															pathClutterTxModelStr,
-															pathClutterTxCDF,
-															pathClutterRxModelStr,
-															pathClutterRxCDF,
-															&txClutterStr,
-															&rxClutterStr,
+															pathLossResult,
 															&(uls->ITMHeightProfile),
-															&(uls->isLOSHeightProfile),
-															&(uls->isLOSSurfaceFrac)
+															&(uls->losOracle)
 #if DEBUG_AFC
 																,
 															uls->ITMHeightType
 #endif
 														);
+														itmStartPathLoss =
+															pathLossResult
+																.pathLoss;
 
 														itmStopPathLoss =
 															itmStartPathLoss;
@@ -12151,11 +12451,7 @@ void AfcManager::runPointAnalysis()
 									uls->ITMHeightProfile =
 										(double *)NULL;
 								}
-								if (uls->isLOSHeightProfile) {
-									free(uls->isLOSHeightProfile);
-									uls->isLOSHeightProfile =
-										(double *)NULL;
-								}
+								uls->losOracle.clear();
 							}
 						}
 
@@ -12257,6 +12553,22 @@ void AfcManager::runPointAnalysis()
 		numProc++;
 	}
 
+	/**************************************************************************************/
+	/* Write FS placemarks. Per-FS fragments are generated in parallel, in batches        */
+	/**************************************************************************************/
+	LOGGER_TIMER(kmlTimer, "runPointAnalysis.kml");
+	std::vector<double> kmlBeamWidthDegList;
+	if (fkml) {
+		// Beamwidth (same for all segments) is computed upfront, so that parallel part
+		// only does geometry and formatting
+		kmlBeamWidthDegList.resize(sortedUlsList.size(), quietNaN);
+		for (ulsIdx = 0; ulsIdx < (int)sortedUlsList.size(); ulsIdx++) {
+			if (ulsFlagList[ulsIdx]) {
+				kmlBeamWidthDegList[ulsIdx] =
+					sortedUlsList[ulsIdx]->computeBeamWidth(3.0);
+			}
+		}
+	}
 	for (int colorIdx = 0; (colorIdx < 3) && (fkml); ++colorIdx) {
 		fkml->writeStartElement("Folder");
 		std::string visibilityStr;
@@ -12284,6 +12596,7 @@ void AfcManager::runPointAnalysis()
 		}
 		fkml->writeTextElement("visibility", visibilityStr.c_str());
 
+		std::vector<int> colorUlsIdxList;
 		for (ulsIdx = 0; ulsIdx < (int)sortedUlsList.size(); ulsIdx++) {
 			bool useFlag = ulsFlagList[ulsIdx];
 
@@ -12301,208 +12614,221 @@ void AfcManager::runPointAnalysis()
 											     false);
 				}
 			}
-			if ((useFlag) && (fkml)) {
-				ULSClass *uls = sortedUlsList[ulsIdx];
-				std::string dbName = std::get<0>(_ulsDatabaseList[uls->getDBIdx()]);
+			if (useFlag) {
+				colorUlsIdxList.push_back(ulsIdx);
+			}
+		}
 
-				fkml->writeStartElement("Folder");
-				fkml->writeTextElement("name",
-						       QString::fromStdString(
-							       dbName + "_" +
-							       std::to_string(uls->getID())));
-				// fkml->writeTextElement("name",
-				// QString::fromStdString(uls->getCallsign()));
+		// Writes folder of single FS
+		auto writeFsFolder = [&](KmlWriter &fsKml, int fsUlsIdx) {
+			ULSClass *uls = sortedUlsList[fsUlsIdx];
+			std::string dbName = std::get<0>(_ulsDatabaseList[uls->getDBIdx()]);
+			std::string coords;
+			char nameBuf[256];
 
-				int numPR = uls->getNumPR();
-				for (int segIdx = 0; segIdx < numPR + 1; ++segIdx) {
-					Vector3 ulsTxPosn =
-						(segIdx == 0 ? uls->getTxPosition() :
-							       uls->getPR(segIdx - 1).positionTx);
-					double ulsTxLongitude =
-						(segIdx == 0 ? uls->getTxLongitudeDeg() :
-							       uls->getPR(segIdx - 1).longitudeDeg);
-					double ulsTxLatitude =
-						(segIdx == 0 ? uls->getTxLatitudeDeg() :
-							       uls->getPR(segIdx - 1).latitudeDeg);
-					double ulsTxHeight =
-						(segIdx == 0 ? uls->getTxHeightAMSL() :
-							       uls->getPR(segIdx - 1).heightAMSLTx);
-
-					Vector3 ulsRxPosn = (segIdx == numPR ?
-								     uls->getRxPosition() :
-								     uls->getPR(segIdx).positionRx);
-					double ulsRxLongitude =
-						(segIdx == numPR ? uls->getRxLongitudeDeg() :
-								   uls->getPR(segIdx).longitudeDeg);
-					double ulsRxLatitude =
-						(segIdx == numPR ? uls->getRxLatitudeDeg() :
-								   uls->getPR(segIdx).latitudeDeg);
-					double ulsRxHeight =
-						(segIdx == numPR ? uls->getRxHeightAMSL() :
-								   uls->getPR(segIdx).heightAMSLRx);
-
-					bool txLocFlag = (!std::isnan(ulsTxPosn.x())) &&
-							 (!std::isnan(ulsTxPosn.y())) &&
-							 (!std::isnan(ulsTxPosn.z()));
-
-					double linkDistKm;
-					if (!txLocFlag) {
-						linkDistKm = 1.0;
-						Vector3 segPointing =
-							(segIdx == numPR ?
-								 uls->getAntennaPointing() :
-								 uls->getPR(segIdx).pointing);
-						ulsTxPosn = ulsRxPosn + linkDistKm * segPointing;
-					} else {
-						linkDistKm = (ulsTxPosn - ulsRxPosn).len();
-					}
+			fsKml.writeStartElement("Folder");
+			fsKml.writeTextElement("name", dbName + "_" + std::to_string(uls->getID()));
+			// fsKml.writeTextElement("name",
+			// QString::fromStdString(uls->getCallsign()));
 
-					if ((segIdx == 0) && (addPlacemarks) && (txLocFlag)) {
-						fkml->writeStartElement("Placemark");
-						fkml->writeTextElement(
-							"name",
-							QString::asprintf("%s %s_%d",
-									  "TX",
-									  dbName.c_str(),
-									  uls->getID()));
-						fkml->writeTextElement("visibility", "1");
-						fkml->writeTextElement("styleUrl",
-								       placemarkStyleStr.c_str());
-						fkml->writeStartElement("Point");
-						fkml->writeTextElement("altitudeMode", "absolute");
-						fkml->writeTextElement(
-							"coordinates",
-							QString::asprintf("%.10f,%.10f,%.2f",
-									  ulsTxLongitude,
-									  ulsTxLatitude,
-									  ulsTxHeight));
-						fkml->writeEndElement(); // Point
-						fkml->writeEndElement(); // Placemark
-					}
+			int numPR = uls->getNumPR();
+			for (int segIdx = 0; segIdx < numPR + 1; ++segIdx) {
+				Vector3 ulsTxPosn = (segIdx == 0 ?
+							     uls->getTxPosition() :
+							     uls->getPR(segIdx - 1).positionTx);
+				double ulsTxLongitude =
+					(segIdx == 0 ? uls->getTxLongitudeDeg() :
+						       uls->getPR(segIdx - 1).longitudeDeg);
+				double ulsTxLatitude =
+					(segIdx == 0 ? uls->getTxLatitudeDeg() :
+						       uls->getPR(segIdx - 1).latitudeDeg);
+				double ulsTxHeight =
+					(segIdx == 0 ? uls->getTxHeightAMSL() :
+						       uls->getPR(segIdx - 1).heightAMSLTx);
 
-					double beamWidthDeg = uls->computeBeamWidth(3.0);
-					double beamWidthRad = beamWidthDeg * (M_PI / 180.0);
+				Vector3 ulsRxPosn = (segIdx == numPR ?
+							     uls->getRxPosition() :
+							     uls->getPR(segIdx).positionRx);
+				double ulsRxLongitude = (segIdx == numPR ?
+								 uls->getRxLongitudeDeg() :
+								 uls->getPR(segIdx).longitudeDeg);
+				double ulsRxLatitude = (segIdx == numPR ?
+								uls->getRxLatitudeDeg() :
+								uls->getPR(segIdx).latitudeDeg);
+				double ulsRxHeight = (segIdx == numPR ?
+							      uls->getRxHeightAMSL() :
+							      uls->getPR(segIdx).heightAMSLRx);
 
-					Vector3 zvec = (ulsTxPosn - ulsRxPosn).normalized();
-					Vector3 xvec =
-						(Vector3(zvec.y(), -zvec.x(), 0.0)).normalized();
-					Vector3 yvec = zvec.cross(xvec);
+				bool txLocFlag = (!std::isnan(ulsTxPosn.x())) &&
+						 (!std::isnan(ulsTxPosn.y())) &&
+						 (!std::isnan(ulsTxPosn.z()));
 
-					int numCvgPoints = 32;
+				double linkDistKm;
+				if (!txLocFlag) {
+					linkDistKm = 1.0;
+					Vector3 segPointing = (segIdx == numPR ?
+								       uls->getAntennaPointing() :
+								       uls->getPR(segIdx).pointing);
+					ulsTxPosn = ulsRxPosn + linkDistKm * segPointing;
+				} else {
+					linkDistKm = (ulsTxPosn - ulsRxPosn).len();
+				}
 
-					std::vector<GeodeticCoord> ptList;
-					double cvgTheta = beamWidthRad;
-					int cvgPhiIdx;
-					for (cvgPhiIdx = 0; cvgPhiIdx < numCvgPoints; ++cvgPhiIdx) {
-						double cvgPhi = 2 * M_PI * cvgPhiIdx / numCvgPoints;
-						Vector3 cvgIntPosn =
-							ulsRxPosn +
-							linkDistKm * (zvec * cos(cvgTheta) +
+				if ((segIdx == 0) && (addPlacemarks) && (txLocFlag)) {
+					fsKml.writeStartElement("Placemark");
+					snprintf(nameBuf,
+						 sizeof(nameBuf),
+						 "%s %s_%d",
+						 "TX",
+						 dbName.c_str(),
+						 uls->getID());
+					fsKml.writeTextElement("name", nameBuf);
+					fsKml.writeTextElement("visibility", "1");
+					fsKml.writeTextElement("styleUrl", placemarkStyleStr);
+					fsKml.writeStartElement("Point");
+					fsKml.writeTextElement("altitudeMode", "absolute");
+					coords.clear();
+					KmlWriter::appendCoordinate(coords,
+								    ulsTxLongitude,
+								    ulsTxLatitude,
+								    ulsTxHeight,
+								    false);
+					fsKml.writeTextElement("coordinates", coords);
+					fsKml.writeEndElement(); // Point
+					fsKml.writeEndElement(); // Placemark
+				}
+
+				double beamWidthDeg = kmlBeamWidthDegList[fsUlsIdx];
+				double beamWidthRad = beamWidthDeg * (M_PI / 180.0);
+
+				Vector3 zvec = (ulsTxPosn - ulsRxPosn).normalized();
+				Vector3 xvec = (Vector3(zvec.y(), -zvec.x(), 0.0)).normalized();
+				Vector3 yvec = zvec.cross(xvec);
+
+				int numCvgPoints = 32;
+
+				std::vector<GeodeticCoord> ptList;
+				double cvgTheta = beamWidthRad;
+				int cvgPhiIdx;
+				for (cvgPhiIdx = 0; cvgPhiIdx < numCvgPoints; ++cvgPhiIdx) {
+					double cvgPhi = 2 * M_PI * cvgPhiIdx / numCvgPoints;
+					Vector3 cvgIntPosn = ulsRxPosn +
+							     linkDistKm *
+								     (zvec * cos(cvgTheta) +
 								      (xvec * cos(cvgPhi) +
 								       yvec * sin(cvgPhi)) *
 									      sin(cvgTheta));
 
-						GeodeticCoord cvgIntPosnGeodetic =
-							EcefModel::ecefToGeodetic(cvgIntPosn);
-						ptList.push_back(cvgIntPosnGeodetic);
-					}
+					GeodeticCoord cvgIntPosnGeodetic =
+						EcefModel::ecefToGeodetic(cvgIntPosn);
+					ptList.push_back(cvgIntPosnGeodetic);
+				}
 
-					if (addPlacemarks) {
-						std::string nameStr;
-						if (segIdx == numPR) {
-							nameStr = "RX";
-						} else {
-							nameStr = "PR " +
-								  std::to_string(segIdx + 1);
-							;
-						}
-						fkml->writeStartElement("Placemark");
-						fkml->writeTextElement(
-							"name",
-							QString::asprintf("%s %s_%d",
-									  nameStr.c_str(),
-									  dbName.c_str(),
-									  uls->getID()));
-						fkml->writeTextElement("visibility", "1");
-						fkml->writeTextElement("styleUrl",
-								       placemarkStyleStr.c_str());
-						fkml->writeStartElement("Point");
-						fkml->writeTextElement("altitudeMode", "absolute");
-						fkml->writeTextElement(
-							"coordinates",
-							QString::asprintf("%.10f,%.10f,%.2f",
-									  ulsRxLongitude,
-									  ulsRxLatitude,
-									  ulsRxHeight));
-						fkml->writeEndElement(); // Point
-						fkml->writeEndElement(); // Placemark
+				if (addPlacemarks) {
+					std::string nameStr;
+					if (segIdx == numPR) {
+						nameStr = "RX";
+					} else {
+						nameStr = "PR " + std::to_string(segIdx + 1);
 					}
+					fsKml.writeStartElement("Placemark");
+					snprintf(nameBuf,
+						 sizeof(nameBuf),
+						 "%s %s_%d",
+						 nameStr.c_str(),
+						 dbName.c_str(),
+						 uls->getID());
+					fsKml.writeTextElement("name", nameBuf);
+					fsKml.writeTextElement("visibility", "1");
+					fsKml.writeTextElement("styleUrl", placemarkStyleStr);
+					fsKml.writeStartElement("Point");
+					fsKml.writeTextElement("altitudeMode", "absolute");
+					coords.clear();
+					KmlWriter::appendCoordinate(coords,
+								    ulsRxLongitude,
+								    ulsRxLatitude,
+								    ulsRxHeight,
+								    false);
+					fsKml.writeTextElement("coordinates", coords);
+					fsKml.writeEndElement(); // Point
+					fsKml.writeEndElement(); // Placemark
+				}
 
-					if (true) {
-						fkml->writeStartElement("Folder");
-						fkml->writeTextElement(
-							"name",
-							QString::asprintf("Beamcone_%d",
-									  segIdx + 1));
-
-						for (cvgPhiIdx = 0; cvgPhiIdx < numCvgPoints;
-						     ++cvgPhiIdx) {
-							fkml->writeStartElement("Placemark");
-							fkml->writeTextElement(
-								"name",
-								QString::asprintf("p%d",
-										  cvgPhiIdx));
-							fkml->writeTextElement(
-								"styleUrl",
-								polyStyleStr.c_str());
-							fkml->writeTextElement(
-								"visibility",
-								visibilityStr.c_str());
-							fkml->writeStartElement("Polygon");
-							fkml->writeTextElement("extrude", "0");
-							fkml->writeTextElement("altitudeMode",
-									       "absolute");
-							fkml->writeStartElement("outerBoundaryIs");
-							fkml->writeStartElement("LinearRing");
-
-							QString more_coords = QString::asprintf(
-								"%.10f,%.10f,%.2f\n",
-								ulsRxLongitude,
-								ulsRxLatitude,
-								ulsRxHeight);
-
-							GeodeticCoord pt = ptList[cvgPhiIdx];
-							more_coords.append(QString::asprintf(
-								"%.10f,%.10f,%.2f\n",
-								pt.longitudeDeg,
-								pt.latitudeDeg,
-								pt.heightKm * 1000.0));
-
-							pt = ptList[(cvgPhiIdx + 1) % numCvgPoints];
-							more_coords.append(QString::asprintf(
-								"%.10f,%.10f,%.2f\n",
-								pt.longitudeDeg,
-								pt.latitudeDeg,
-								pt.heightKm * 1000.0));
-
-							more_coords.append(
-								QString::asprintf("%.10f,%.10f,%."
-										  "2f\n",
-										  ulsRxLongitude,
-										  ulsRxLatitude,
-										  ulsRxHeight));
-
-							fkml->writeTextElement("coordinates",
-									       more_coords);
-							fkml->writeEndElement(); // LinearRing
-							fkml->writeEndElement(); // outerBoundaryIs
-							fkml->writeEndElement(); // Polygon
-							fkml->writeEndElement(); // Placemark
-						}
-						fkml->writeEndElement(); // Beamcone
+				fsKml.writeStartElement("Folder");
+				fsKml.writeTextElement("name",
+						       "Beamcone_" + std::to_string(segIdx + 1));
+
+				for (cvgPhiIdx = 0; cvgPhiIdx < numCvgPoints; ++cvgPhiIdx) {
+					fsKml.writeStartElement("Placemark");
+					fsKml.writeTextElement("name",
+							       "p" + std::to_string(cvgPhiIdx));
+					fsKml.writeTextElement("styleUrl", polyStyleStr);
+					fsKml.writeTextElement("visibility", visibilityStr);
+					fsKml.writeStartElement("Polygon");
+					fsKml.writeTextElement("extrude", "0");
+					fsKml.writeTextElement("altitudeMode", "absolute");
+					fsKml.writeStartElement("outerBoundaryIs");
+					fsKml.writeStartElement("LinearRing");
+
+					coords.clear();
+					KmlWriter::appendCoordinate(coords,
+								    ulsRxLongitude,
+								    ulsRxLatitude,
+								    ulsRxHeight);
+					for (int k = 0; k < 2; ++k) {
+						const GeodeticCoord &pt =
+							ptList[(cvgPhiIdx + k) % numCvgPoints];
+						KmlWriter::appendCoordinate(coords,
+									    pt.longitudeDeg,
+									    pt.latitudeDeg,
+									    pt.heightKm * 1000.0);
 					}
+					KmlWriter::appendCoordinate(coords,
+								    ulsRxLongitude,
+								    ulsRxLatitude,
+								    ulsRxHeight);
+
+					fsKml.writeTextElement("coordinates", coords);
+					fsKml.writeEndElement(); // LinearRing
+					fsKml.writeEndElement(); // outerBoundaryIs
+					fsKml.writeEndElement(); // Polygon
+					fsKml.writeEndElement(); // Placemark
 				}
-				fkml->writeEndElement(); // Folder
+				fsKml.writeEndElement(); // Beamcone
+			}
+			fsKml.writeEndElement(); // Folder
+		};
+
+		// Batches bound memory taken by fragments
+		const int kmlBatchSize = 256;
+		int numKmlThreads = std::max(1, (int)std::thread::hardware_concurrency());
+		for (int batchStart = 0; batchStart < (int)colorUlsIdxList.size();
+		     batchStart += kmlBatchSize) {
+			int batchSize = std::min(kmlBatchSize,
+						 (int)colorUlsIdxList.size() - batchStart);
+			std::vector<KmlWriter> fragments;
+			fragments.reserve(batchSize);
+			for (int i = 0; i < batchSize; ++i) {
+				fragments.push_back(fkml->fragment());
+			}
+			int numThreads = std::min(numKmlThreads, batchSize);
+			std::vector<std::future<void>> futures;
+			for (int threadIdx = 0; threadIdx < numThreads; ++threadIdx) {
+				futures.push_back(std::async(std::launch::async, [&, threadIdx]() {
+					for (int i = threadIdx; i < batchSize; i += numThreads) {
+						writeFsFolder(fragments[i],
+							      colorUlsIdxList[batchStart + i]);
+					}
+				}));
+			}
+			for (auto &future : futures) {
+				future.wait();
+			}
+			for (auto &future : futures) {
+				future.get();
+			}
+			for (auto &fragment : fragments) {
+				fkml->writeFragment(fragment);
 			}
 		}
 		fkml->writeEndElement(); // Folder
@@ -12519,7 +12845,9 @@ void AfcManager::runPointAnalysis()
 		fkml->writeEndElement(); // Document
 		fkml->writeEndElement(); // kml
 		fkml->writeEndDocument();
+		kml_writer.close();
 	}
+	kmlTimer.stop();
 
 	if (fFSList) {
 		fclose(fFSList);
@@ -12559,6 +12887,12 @@ void AfcManager::runPointAnalysis()
 	/**************************************************************************************/
 
 	_terrainDataModel->printStats();
+	if (itmScreenFlag) {
+		LOGGER_INFO(logger) << "ITM screening: full ITM skipped for " << numItmPruned
+				    << " of " << numItmScreen << " links ("
+				    << (numItmScreen ? 100.0 * numItmPruned / numItmScreen : 0.0)
+				    << "%)";
+	}
 
 	int chanIdx;
 	for (chanIdx = 0; chanIdx < (int)_channelList.size(); ++chanIdx) {
@@ -12648,6 +12982,7 @@ std::vector<ULSClass *> AfcManager::getSortedUls()
 /******************************************************************************************/
 void AfcManager::runScanAnalysis()
 {
+	LOGGER_TIMED_SCOPE("runScanAnalysis");
 	std::ostringstream errStr;
 
 	LOGGER_INFO(logger) << "Executing AfcManager::runScanAnalysis()";
@@ -12720,7 +13055,7 @@ void AfcManager::runScanAnalysis()
 	auto &fkml = kml_writer->xml_writer;
 
 	if (fkml) {
-		fkml->setAutoFormatting(true);
+		fkml->setAutoFormatting(_createDebugFiles);
 		fkml->writeStartDocument();
 		fkml->writeStartElement("kml");
 		fkml->writeAttribute("xmlns", "http://www.opengis.net/kml/2.2");
@@ -12866,6 +13201,7 @@ void AfcManager::runScanAnalysis()
 		fkml->writeTextElement("name", "RLAN");
 
 		std::vector<GeodeticCoord> ptList = _rlanRegion->getBoundary(_terrainDataModel);
+		std::string coords;
 
 		/**********************************************************************************/
 		/* CENTER                                                                         */
@@ -12878,11 +13214,13 @@ void AfcManager::runScanAnalysis()
 		fkml->writeTextElement("styleUrl", "#dotStyle");
 		fkml->writeStartElement("Point");
 		fkml->writeTextElement("altitudeMode", "absolute");
-		fkml->writeTextElement("coordinates",
-				       QString::asprintf("%.10f,%.10f,%.2f",
-							 rlanCenterPtGeo.longitudeDeg,
-							 rlanCenterPtGeo.latitudeDeg,
-							 rlanCenterPtGeo.heightKm * 1000.0));
+		coords.clear();
+		KmlWriter::appendCoordinate(coords,
+					    rlanCenterPtGeo.longitudeDeg,
+					    rlanCenterPtGeo.latitudeDeg,
+					    rlanCenterPtGeo.heightKm * 1000.0,
+					    false);
+		fkml->writeTextElement("coordinates", coords);
 		fkml->writeEndElement(); // Point
 		fkml->writeEndElement(); // Placemark
 		/**********************************************************************************/
@@ -12901,15 +13239,14 @@ void AfcManager::runScanAnalysis()
 		fkml->writeStartElement("outerBoundaryIs");
 		fkml->writeStartElement("LinearRing");
 
-		QString top_coords = QString();
+		std::string top_coords;
 		for (ptIdx = 0; ptIdx <= (int)ptList.size(); ptIdx++) {
 			GeodeticCoord pt = ptList[ptIdx % ptList.size()];
-			top_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt.longitudeDeg,
-						  pt.latitudeDeg,
-						  pt.heightKm * 1000.0 +
-							  _rlanRegion->getHeightUncertainty()));
+			KmlWriter::appendCoordinate(
+				top_coords,
+				pt.longitudeDeg,
+				pt.latitudeDeg,
+				pt.heightKm * 1000.0 + _rlanRegion->getHeightUncertainty());
 		}
 
 		fkml->writeTextElement("coordinates", top_coords);
@@ -12933,15 +13270,14 @@ void AfcManager::runScanAnalysis()
 		fkml->writeStartElement("outerBoundaryIs");
 		fkml->writeStartElement("LinearRing");
 
-		QString bottom_coords = QString();
+		std::string bottom_coords;
 		for (ptIdx = 0; ptIdx <= (int)ptList.size(); ptIdx++) {
 			GeodeticCoord pt = ptList[ptIdx % ptList.size()];
-			bottom_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt.longitudeDeg,
-						  pt.latitudeDeg,
-						  pt.heightKm * 1000.0 -
-							  _rlanRegion->getHeightUncertainty()));
+			KmlWriter::appendCoordinate(
+				bottom_coords,
+				pt.longitudeDeg,
+				pt.latitudeDeg,
+				pt.heightKm * 1000.0 - _rlanRegion->getHeightUncertainty());
 		}
 		fkml->writeTextElement("coordinates", bottom_coords);
 		fkml->writeEndElement(); // LinearRing
@@ -12968,37 +13304,32 @@ void AfcManager::runScanAnalysis()
 
 			GeodeticCoord pt1 = ptList[ptIdx];
 			GeodeticCoord pt2 = ptList[(ptIdx + 1) % ptList.size()];
-			QString side_coords;
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt1.longitudeDeg,
-						  pt1.latitudeDeg,
-						  pt1.heightKm * 1000.0 -
-							  _rlanRegion->getHeightUncertainty()));
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt1.longitudeDeg,
-						  pt1.latitudeDeg,
-						  pt1.heightKm * 1000.0 +
-							  _rlanRegion->getHeightUncertainty()));
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt2.longitudeDeg,
-						  pt2.latitudeDeg,
-						  pt2.heightKm * 1000.0 +
-							  _rlanRegion->getHeightUncertainty()));
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt2.longitudeDeg,
-						  pt2.latitudeDeg,
-						  pt2.heightKm * 1000.0 -
-							  _rlanRegion->getHeightUncertainty()));
-			side_coords.append(
-				QString::asprintf("%.10f,%.10f,%.2f\n",
-						  pt1.longitudeDeg,
-						  pt1.latitudeDeg,
-						  pt1.heightKm * 1000.0 -
-							  _rlanRegion->getHeightUncertainty()));
+			std::string side_coords;
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt1.longitudeDeg,
+				pt1.latitudeDeg,
+				pt1.heightKm * 1000.0 - _rlanRegion->getHeightUncertainty());
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt1.longitudeDeg,
+				pt1.latitudeDeg,
+				pt1.heightKm * 1000.0 + _rlanRegion->getHeightUncertainty());
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt2.longitudeDeg,
+				pt2.latitudeDeg,
+				pt2.heightKm * 1000.0 + _rlanRegion->getHeightUncertainty());
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt2.longitudeDeg,
+				pt2.latitudeDeg,
+				pt2.heightKm * 1000.0 - _rlanRegion->getHeightUncertainty());
+			KmlWriter::appendCoordinate(
+				side_coords,
+				pt1.longitudeDeg,
+				pt1.latitudeDeg,
+				pt1.heightKm * 1000.0 - _rlanRegion->getHeightUncertainty());
 
 			fkml->writeTextElement("coordinates", side_coords);
 			fkml->writeEndElement(); // LinearRing
@@ -13050,11 +13381,13 @@ void AfcManager::runScanAnalysis()
 				fkml->writeTextElement("styleUrl", "#dotStyle");
 				fkml->writeStartElement("Point");
 				fkml->writeTextElement("altitudeMode", "absolute");
-				fkml->writeTextElement("coordinates",
-						       QString::asprintf("%.10f,%.10f,%.2f",
-									 scanPt.second,
-									 scanPt.first,
-									 heightAMSL));
+				coords.clear();
+				KmlWriter::appendCoordinate(coords,
+							    scanPt.second,
+							    scanPt.first,
+							    heightAMSL,
+							    false);
+				fkml->writeTextElement("coordinates", coords);
 				fkml->writeEndElement(); // Point
 				fkml->writeEndElement(); // Placemark
 			}
@@ -13084,7 +13417,7 @@ void AfcManager::runScanAnalysis()
 			Vector3 drUpVec;
 			Vector3 drEastVec;
 			Vector3 drNorthVec;
-			QString dr_coords;
+			std::string dr_coords;
 			MultibandRasterClass::HeightResult drLidarHeightResult;
 			CConst::HeightSourceEnum drHeightSource;
 			DeniedRegionClass::GeometryEnum drGeometry = dr->getGeometry();
@@ -13116,32 +13449,27 @@ void AfcManager::runScanAnalysis()
 						fkml->writeStartElement("outerBoundaryIs");
 						fkml->writeStartElement("LinearRing");
 
-						dr_coords = QString();
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStart,
-										   rectLatStart,
-										   0.0));
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStop,
-										   rectLatStart,
-										   0.0));
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStop,
-										   rectLatStop,
-										   0.0));
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStart,
-										   rectLatStop,
-										   0.0));
-						dr_coords.append(QString::asprintf("%.10f,%.10f,%."
-										   "2f\n",
-										   rectLonStart,
-										   rectLatStart,
-										   0.0));
+						dr_coords.clear();
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStart,
+									    rectLatStart,
+									    0.0);
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStop,
+									    rectLatStart,
+									    0.0);
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStop,
+									    rectLatStop,
+									    0.0);
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStart,
+									    rectLatStop,
+									    0.0);
+						KmlWriter::appendCoordinate(dr_coords,
+									    rectLonStart,
+									    rectLatStart,
+									    0.0);
 
 						fkml->writeTextElement("coordinates", dr_coords);
 						fkml->writeEndElement(); // LinearRing
@@ -13190,7 +13518,7 @@ void AfcManager::runScanAnalysis()
 					fkml->writeStartElement("outerBoundaryIs");
 					fkml->writeStartElement("LinearRing");
 
-					dr_coords = QString();
+					dr_coords.clear();
 					for (ptIdx = 0; ptIdx <= numPtsCircle; ++ptIdx) {
 						double phi = 2 * M_PI * ptIdx / numPtsCircle;
 						Vector3 circlePtPosn = drCenterPosn +
@@ -13203,11 +13531,11 @@ void AfcManager::runScanAnalysis()
 						GeodeticCoord circlePtPosnGeodetic =
 							EcefModel::ecefToGeodetic(circlePtPosn);
 
-						dr_coords.append(QString::asprintf(
-							"%.10f,%.10f,%.2f\n",
+						KmlWriter::appendCoordinate(
+							dr_coords,
 							circlePtPosnGeodetic.longitudeDeg,
 							circlePtPosnGeodetic.latitudeDeg,
-							0.0));
+							0.0);
 					}
 
 					fkml->writeTextElement("coordinates", dr_coords);
@@ -13231,6 +13559,7 @@ void AfcManager::runScanAnalysis()
 		fkml->writeEndElement(); // Document
 		fkml->writeEndElement(); // kml
 		fkml->writeEndDocument();
+		kml_writer->close();
 	}
 	delete kml_writer;
 
@@ -13470,31 +13799,21 @@ void AfcManager::runScanAnalysis()
 										(chanStartFreq +
 										 chanStopFreq) /
 										2;
+									PropModelFreqCoeffClass freqCoeff =
+										_propModelContext.getFreqCoeff(
+											chanCenterFreq);
 
-									std::string
-										buildingPenetrationModelStr;
+									CConst::BuildingPenetrationModelEnum
+										buildingPenetrationModel;
 									double buildingPenetrationCDF;
 									double buildingPenetrationDB = computeBuildingPenetration(
 										_buildingType,
 										elevationAngleTxDeg,
-										chanCenterFreq,
-										buildingPenetrationModelStr,
+										freqCoeff,
+										buildingPenetrationModel,
 										buildingPenetrationCDF);
 
-									std::string txClutterStr;
-									std::string rxClutterStr;
-									std::string
-										pathLossModelStr;
-									double pathLossCDF;
-									double pathLoss;
-									std::string
-										pathClutterTxModelStr;
-									double pathClutterTxCDF;
-									double pathClutterTxDB;
-									std::string
-										pathClutterRxModelStr;
-									double pathClutterRxCDF;
-									double pathClutterRxDB;
+									PathLossResultClass pathLossResult;
 
 									computePathLoss(
 										_pathLossModel,
@@ -13506,7 +13825,7 @@ void AfcManager::runScanAnalysis()
 										distKm,
 										fsplDistKm,
 										win2DistKm,
-										chanCenterFreq,
+										freqCoeff,
 										rlanCoord
 											.longitudeDeg,
 										rlanCoord
@@ -13517,20 +13836,9 @@ void AfcManager::runScanAnalysis()
 										uls->getRxLatitudeDeg(),
 										uls->getRxHeightAboveTerrain(),
 										elevationAngleRxDeg,
-										pathLoss,
-										pathClutterTxDB,
-										pathClutterRxDB,
-										pathLossModelStr,
-										pathLossCDF,
-										pathClutterTxModelStr,
-										pathClutterTxCDF,
-										pathClutterRxModelStr,
-										pathClutterRxCDF,
-										&txClutterStr,
-										&rxClutterStr,
+										pathLossResult,
 										&(uls->ITMHeightProfile),
-										&(uls->isLOSHeightProfile),
-										&(uls->isLOSSurfaceFrac)
+										&(uls->losOracle)
 #if DEBUG_AFC
 											,
 										uls->ITMHeightType
@@ -13556,9 +13864,12 @@ void AfcManager::runScanAnalysis()
 										 30.0) -
 										_bodyLossDB -
 										buildingPenetrationDB -
-										pathLoss -
-										pathClutterTxDB -
-										pathClutterRxDB +
+										pathLossResult
+											.pathLoss -
+										pathLossResult
+											.pathClutterTxDB -
+										pathLossResult
+											.pathClutterRxDB +
 										rxGainDB -
 										spectralOverlapLossDB -
 										_polarizationLossDB -
@@ -13603,10 +13914,7 @@ void AfcManager::runScanAnalysis()
 					free(uls->ITMHeightProfile);
 					uls->ITMHeightProfile = (double *)NULL;
 				}
-				if (uls->isLOSHeightProfile) {
-					free(uls->isLOSHeightProfile);
-					uls->isLOSHeightProfile = (double *)NULL;
-				}
+				uls->losOracle.clear();
 			}
 
 			for (bwIdx = 0; bwIdx < numBW; ++bwIdx) {
@@ -13674,6 +13982,7 @@ void AfcManager::runScanAnalysis()
 /******************************************************************************************/
 void AfcManager::runExclusionZoneAnalysis()
 {
+	LOGGER_TIMED_SCOPE("runExclusionZoneAnalysis");
 #if DEBUG_AFC
 	// std::vector<int> fsidTraceList{2128, 3198, 82443};
 	// std::vector<int> fsidTraceList{64324};
@@ -13737,6 +14046,7 @@ void AfcManager::runExclusionZoneAnalysis()
 						     useACI,
 						     spectralAlgorithm);
 	double chanCenterFreq = (chanStartFreq + chanStopFreq) / 2;
+	_propModelContext.addFrequency(chanCenterFreq);
 
 	if (!hasOverlap) {
 		throw std::runtime_error(
@@ -13753,7 +14063,7 @@ void AfcManager::runExclusionZoneAnalysis()
 	/**************************************************************************************/
 	/* Create excThrFile, useful for debugging                                            */
 	/**************************************************************************************/
-	ExThrGzipCsv excthrGc(_excThrFile);
+	ExThrGzipCsv excthrGc(_excThrFile, _excThrFormat);
 
 	/**************************************************************************************/
 
@@ -13995,6 +14305,7 @@ double AfcManager::computeIToNMargin(double d,
 	rlanLat = uls->getRxLatitudeDeg() + d * ss;
 
 	double fsHeight = uls->getRxTerrainHeight() + uls->getRxHeightAboveTerrain();
+	PropModelFreqCoeffClass freqCoeff = _propModelContext.getFreqCoeff(chanCenterFreq);
 
 	double rlanHeightInput = std::get<2>(_rlanLLA);
 	double heightUncertainty = std::get<2>(_rlanUncerts_m);
@@ -14125,26 +14436,16 @@ double AfcManager::computeIToNMargin(double d,
 			fsplDistKm = distKm;
 		}
 
-		std::string buildingPenetrationModelStr;
+		CConst::BuildingPenetrationModelEnum buildingPenetrationModel;
 		double buildingPenetrationCDF;
 		double buildingPenetrationDB =
 			computeBuildingPenetration(_buildingType,
 						   elevationAngleTxDeg,
-						   chanCenterFreq,
-						   buildingPenetrationModelStr,
+						   freqCoeff,
+						   buildingPenetrationModel,
 						   buildingPenetrationCDF);
 
-		std::string txClutterStr;
-		std::string rxClutterStr;
-		std::string pathLossModelStr;
-		double pathLossCDF;
-		double pathLoss;
-		std::string pathClutterTxModelStr;
-		double pathClutterTxCDF;
-		double pathClutterTxDB;
-		std::string pathClutterRxModelStr;
-		double pathClutterRxCDF;
-		double pathClutterRxDB;
+		PathLossResultClass pathLossResult;
 
 		double rlanHtAboveTerrain = rlanCoord.heightKm * 1000.0 - rlanTerrainHeight;
 
@@ -14158,7 +14459,7 @@ double AfcManager::computeIToNMargin(double d,
 				distKm,
 				fsplDistKm,
 				win2DistKm,
-				chanCenterFreq,
+				freqCoeff,
 				rlanCoord.longitudeDeg,
 				rlanCoord.latitudeDeg,
 				rlanHtAboveTerrain,
@@ -14167,25 +14468,15 @@ double AfcManager::computeIToNMargin(double d,
 				uls->getRxLatitudeDeg(),
 				uls->getRxHeightAboveTerrain(),
 				elevationAngleRxDeg,
-				pathLoss,
-				pathClutterTxDB,
-				pathClutterRxDB,
-				pathLossModelStr,
-				pathLossCDF,
-				pathClutterTxModelStr,
-				pathClutterTxCDF,
-				pathClutterRxModelStr,
-				pathClutterRxCDF,
-				&txClutterStr,
-				&rxClutterStr,
+				pathLossResult,
 				&(uls->ITMHeightProfile),
-				&(uls->isLOSHeightProfile),
-				&(uls->isLOSSurfaceFrac)
+				&(uls->losOracle)
 #if DEBUG_AFC
 					,
 				uls->ITMHeightType
 #endif
 		);
+		double pathLoss = pathLossResult.pathLoss;
 
 		std::string rxAntennaSubModelStr;
 		double angleOffBoresightDeg = acos(uls->getAntennaPointing().dot(
@@ -14198,8 +14489,9 @@ double AfcManager::computeIToNMargin(double d,
 						     0);
 
 		double rxPowerDBW = (_exclusionZoneRLANEIRPDBm - 30.0) - _bodyLossDB -
-				    buildingPenetrationDB - pathLoss - pathClutterTxDB -
-				    pathClutterRxDB + rxGainDB - spectralOverlapLossDB -
+				    buildingPenetrationDB - pathLoss -
+				    pathLossResult.pathClutterTxDB -
+				    pathLossResult.pathClutterRxDB + rxGainDB - spectralOverlapLossDB -
 				    _polarizationLossDB - uls->getRxAntennaFeederLossDB();
 
 		double I2NDB = rxPowerDBW - uls->getNoiseLevelDBW();
@@ -14276,21 +14568,23 @@ double AfcManager::computeIToNMargin(double d,
 			excthrGc->boresightAngle = angleOffBoresightDeg;
 			excthrGc->rlanTxEirp = _exclusionZoneRLANEIRPDBm;
 			excthrGc->bodyLoss = _bodyLossDB;
-			excthrGc->rlanClutterCategory = txClutterStr;
-			excthrGc->fsClutterCategory = rxClutterStr;
+			excthrGc->rlanClutterCategory = pathLossResult.txClutterStr();
+			excthrGc->fsClutterCategory = pathLossResult.rxClutterStr();
 			excthrGc->buildingType = bldgTypeStr;
 			excthrGc->buildingPenetration = buildingPenetrationDB;
-			excthrGc->buildingPenetrationModel = buildingPenetrationModelStr;
+			excthrGc->buildingPenetrationModel =
+				CConst::strBuildingPenetrationModelList->type_to_str(
+					buildingPenetrationModel);
 			excthrGc->buildingPenetrationCdf = buildingPenetrationCDF;
 			excthrGc->pathLoss = pathLoss;
-			excthrGc->pathLossModel = pathLossModelStr;
-			excthrGc->pathLossCdf = pathLossCDF;
-			excthrGc->pathClutterTx = pathClutterTxDB;
-			excthrGc->pathClutterTxMode = pathClutterTxModelStr;
-			excthrGc->pathClutterTxCdf = pathClutterTxCDF;
-			excthrGc->pathClutterRx = pathClutterRxDB;
-			excthrGc->pathClutterRxMode = pathClutterRxModelStr;
-			excthrGc->pathClutterRxCdf = pathClutterRxCDF;
+			excthrGc->pathLossModel = pathLossResult.pathLossModelStr();
+			excthrGc->pathLossCdf = pathLossResult.pathLossCDF;
+			excthrGc->pathClutterTx = pathLossResult.pathClutterTxDB;
+			excthrGc->pathClutterTxMode = pathLossResult.pathClutterTxModelStr();
+			excthrGc->pathClutterTxCdf = pathLossResult.pathClutterTxCDF;
+			excthrGc->pathClutterRx = pathLossResult.pathClutterRxDB;
+			excthrGc->pathClutterRxMode = pathLossResult.pathClutterRxModelStr();
+			excthrGc->pathClutterRxCdf = pathLossResult.pathClutterRxCDF;
 			excthrGc->rlanBandwidth = bandwidth * 1.0e-6;
 			excthrGc->rlanStartFreq = chanStartFreq * 1.0e-6;
 			excthrGc->rlanStopFreq = chanStopFreq * 1.0e-6;
@@ -14320,10 +14614,7 @@ double AfcManager::computeIToNMargin(double d,
 		free(uls->ITMHeightProfile);
 		uls->ITMHeightProfile = (double *)NULL;
 	}
-	if (uls->isLOSHeightProfile) {
-		free(uls->isLOSHeightProfile);
-		uls->isLOSHeightProfile = (double *)NULL;
-	}
+	uls->losOracle.clear();
 	/**************************************************************************************/
 
 	return (minMarginDB);
@@ -14424,6 +14715,7 @@ void AfcManager::writeKML()
 	fkml->writeEndElement(); // Document
 	fkml->writeEndElement(); // kml
 	fkml->writeEndDocument();
+	kml_writer.close();
 
 	return;
 }
@@ -14566,6 +14858,7 @@ std::string AfcManager::getHeatmapColor(double itonVal, bool indoorFlag, bool he
 /******************************************************************************************/
 void AfcManager::runHeatmapAnalysis()
 {
+	LOGGER_TIMED_SCOPE("runHeatmapAnalysis");
 	std::ostringstream errStr;
 
 	LOGGER_INFO(logger) << "Executing AfcManager::runHeatmapAnalysis()";
@@ -14582,6 +14875,7 @@ void AfcManager::runHeatmapAnalysis()
 	double chanStartFreq = channel->freqMHzList[freqSegIdx] * 1.0e6;
 	double chanStopFreq = channel->freqMHzList[freqSegIdx + 1] * 1.0e6;
 	double chanCenterFreq = (chanStartFreq + chanStopFreq) / 2;
+	PropModelFreqCoeffClass freqCoeff = _propModelContext.getFreqCoeff(chanCenterFreq);
 	double chanBandwidth = chanStopFreq - chanStartFreq;
 	bool useACI = (channel->type == INQUIRED_FREQUENCY ? false : _aciFlag);
 	CConst::SpectralAlgorithmEnum spectralAlgorithm = (channel->type == INQUIRED_FREQUENCY ?
@@ -14635,18 +14929,23 @@ void AfcManager::runHeatmapAnalysis()
 	/**************************************************************************************/
 	_heatmapIToNDB = (double **)malloc(_heatmapNumPtsLon * sizeof(double *));
 	_heatmapIsIndoor = (bool **)malloc(_heatmapNumPtsLon * sizeof(bool *));
+	_heatmapIsInterpolated = (bool **)malloc(_heatmapNumPtsLon * sizeof(bool *));
 
 	int lonIdx, latIdx;
 	for (lonIdx = 0; lonIdx < _heatmapNumPtsLon; ++lonIdx) {
 		_heatmapIToNDB[lonIdx] = (double *)malloc(_heatmapNumPtsLat * sizeof(double));
 		_heatmapIsIndoor[lonIdx] = (bool *)malloc(_heatmapNumPtsLat * sizeof(bool));
+		_heatmapIsInterpolated[lonIdx] = (bool *)malloc(_heatmapNumPtsLat * sizeof(bool));
+		for (latIdx = 0; latIdx < _heatmapNumPtsLat; ++latIdx) {
+			_heatmapIsInterpolated[lonIdx][latIdx] = false;
+		}
 	}
 	/**************************************************************************************/
 
 	/**************************************************************************************/
 	/* Create excThrFile, useful for debugging                                            */
 	/**************************************************************************************/
-	ExThrGzipCsv excthrGc(_excThrFile);
+	ExThrGzipCsv excthrGc(_excThrFile, _excThrFormat);
 	/**************************************************************************************/
 
 	/**************************************************************************************/
@@ -14680,14 +14979,40 @@ void AfcManager::runHeatmapAnalysis()
 
 	bool itonFlag = (_heatmapAnalysisStr == "iton");
 
+	/**************************************************************************************/
+	/* Grid points are evaluated in passes. Without refinement, a single pass evaluates   */
+	/* all points. With refinement, first pass evaluates coarse grid, each following pass */
+	/* evaluates corners of subdivided cells, see refineHeatmapCells().                   */
+	/**************************************************************************************/
+	std::vector<std::pair<int, int>> evalPtList; // (lonIdx, latIdx) evaluated in next pass
+	std::vector<bool> ptDoneList; // Point value set (evaluated, queued or interpolated)
+	std::vector<std::tuple<int, int, int, int>> cellList; // Cells to be tested for refinement
+	std::vector<std::tuple<int, int, int, int>> acceptCellList; // Cells to be interpolated
+	if (_heatmapRefineFlag) {
+		ptDoneList.resize(totNumProc, false);
+		initHeatmapRefinement(evalPtList, ptDoneList, cellList);
+		LOGGER_INFO(logger) << "HEATMAP_REFINE: coarse grid has " << evalPtList.size()
+				    << " points, " << cellList.size() << " cells";
+	} else {
+		for (lonIdx = 0; lonIdx < _heatmapNumPtsLon; ++lonIdx) {
+			for (latIdx = 0; latIdx < _heatmapNumPtsLat; ++latIdx) {
+				evalPtList.push_back(std::make_pair(lonIdx, latIdx));
+			}
+		}
+	}
+	bool fillFlag = !_heatmapRefineFlag;
+	int numInterp = 0;
+
 	bool initFlag = false;
 	int numInvalid = 0;
 	int numProc = 0;
-	for (lonIdx = 0; lonIdx < _heatmapNumPtsLon; ++lonIdx) {
-		double rlanLon = (_heatmapMinLon * (2 * _heatmapNumPtsLon - 2 * lonIdx - 1) +
-				  _heatmapMaxLon * (2 * lonIdx + 1)) /
-				 (2 * _heatmapNumPtsLon);
-		for (latIdx = 0; latIdx < _heatmapNumPtsLat; ++latIdx) {
+	while (evalPtList.size()) {
+		for (int evalPtIdx = 0; evalPtIdx < (int)evalPtList.size(); ++evalPtIdx) {
+			lonIdx = evalPtList[evalPtIdx].first;
+			latIdx = evalPtList[evalPtIdx].second;
+			double rlanLon = (_heatmapMinLon * (2 * _heatmapNumPtsLon - 2 * lonIdx - 1) +
+					  _heatmapMaxLon * (2 * lonIdx + 1)) /
+					 (2 * _heatmapNumPtsLon);
 			double rlanLat = (_heatmapMinLat *
 						  (2 * _heatmapNumPtsLat - 2 * latIdx - 1) +
 					  _heatmapMaxLat * (2 * latIdx + 1)) /
@@ -14810,6 +15135,9 @@ void AfcManager::runHeatmapAnalysis()
 				std::make_tuple(std::numeric_limits<double>::infinity(),
 						std::numeric_limits<double>::infinity(),
 						GREEN);
+			// Also set for points without finite I/N (denied or no FS in range)
+			_heatmapIsIndoor[lonIdx][latIdx] = (_buildingType !=
+							    CConst::noBuildingType);
 
 			if (numRlanPosn) {
 				GeodeticCoord rlanCoord = rlanCoordList[0];
@@ -15081,30 +15409,18 @@ void AfcManager::runHeatmapAnalysis()
 										useACI,
 										spectralAlgorithm);
 								if (hasOverlap) {
-									std::string
-										buildingPenetrationModelStr;
+									CConst::BuildingPenetrationModelEnum
+										buildingPenetrationModel;
 									double buildingPenetrationCDF;
 									double buildingPenetrationDB = computeBuildingPenetration(
 										_buildingType,
 										elevationAngleTxDeg,
-										chanCenterFreq,
-										buildingPenetrationModelStr,
+										freqCoeff,
+										buildingPenetrationModel,
 										buildingPenetrationCDF);
 
-									std::string txClutterStr;
-									std::string rxClutterStr;
-									std::string
-										pathLossModelStr;
-									double pathLossCDF;
+									PathLossResultClass pathLossResult;
 									double pathLoss;
-									std::string
-										pathClutterTxModelStr;
-									double pathClutterTxCDF;
-									double pathClutterTxDB;
-									std::string
-										pathClutterRxModelStr;
-									double pathClutterRxCDF;
-									double pathClutterRxDB;
 									double rxGainDB;
 									double discriminationGain;
 									std::string
@@ -15136,7 +15452,7 @@ void AfcManager::runHeatmapAnalysis()
 										distKm,
 										fsplDistKm,
 										win2DistKm,
-										chanCenterFreq,
+										freqCoeff,
 										rlanCoord
 											.longitudeDeg,
 										rlanCoord
@@ -15147,25 +15463,16 @@ void AfcManager::runHeatmapAnalysis()
 										uls->getRxLatitudeDeg(),
 										uls->getRxHeightAboveTerrain(),
 										elevationAngleRxDeg,
-										pathLoss,
-										pathClutterTxDB,
-										pathClutterRxDB,
-										pathLossModelStr,
-										pathLossCDF,
-										pathClutterTxModelStr,
-										pathClutterTxCDF,
-										pathClutterRxModelStr,
-										pathClutterRxCDF,
-										&txClutterStr,
-										&rxClutterStr,
+										pathLossResult,
 										&(uls->ITMHeightProfile),
-										&(uls->isLOSHeightProfile),
-										&(uls->isLOSSurfaceFrac)
+										&(uls->losOracle)
 #if DEBUG_AFC
 											,
 										uls->ITMHeightType
 #endif
 									);
+									pathLoss =
+										pathLossResult.pathLoss;
 
 									angleOffBoresightDeg =
 										acos(uls->getAntennaPointing()
@@ -15256,8 +15563,10 @@ void AfcManager::runHeatmapAnalysis()
 										_bodyLossDB -
 										buildingPenetrationDB -
 										pathLoss -
-										pathClutterTxDB -
-										pathClutterRxDB +
+										pathLossResult
+											.pathClutterTxDB -
+										pathLossResult
+											.pathClutterRxDB +
 										rxGainDB +
 										nearFieldOffsetDB -
 										spectralOverlapLossDB -
@@ -15542,35 +15851,46 @@ void AfcManager::runHeatmapAnalysis()
 										excthrGc.bodyLoss =
 											_bodyLossDB;
 										excthrGc.rlanClutterCategory =
-											txClutterStr;
+											pathLossResult
+												.txClutterStr();
 										excthrGc.fsClutterCategory =
-											rxClutterStr;
+											pathLossResult
+												.rxClutterStr();
 										excthrGc.buildingType =
 											bldgTypeStr;
 										excthrGc.buildingPenetration =
 											buildingPenetrationDB;
 										excthrGc.buildingPenetrationModel =
-											buildingPenetrationModelStr;
+											CConst::strBuildingPenetrationModelList->type_to_str(
+												buildingPenetrationModel);
 										excthrGc.buildingPenetrationCdf =
 											buildingPenetrationCDF;
 										excthrGc.pathLoss =
 											pathLoss;
 										excthrGc.pathLossModel =
-											pathLossModelStr;
+											pathLossResult
+												.pathLossModelStr();
 										excthrGc.pathLossCdf =
-											pathLossCDF;
+											pathLossResult
+												.pathLossCDF;
 										excthrGc.pathClutterTx =
-											pathClutterTxDB;
+											pathLossResult
+												.pathClutterTxDB;
 										excthrGc.pathClutterTxMode =
-											pathClutterTxModelStr;
+											pathLossResult
+												.pathClutterTxModelStr();
 										excthrGc.pathClutterTxCdf =
-											pathClutterTxCDF;
+											pathLossResult
+												.pathClutterTxCDF;
 										excthrGc.pathClutterRx =
-											pathClutterRxDB;
+											pathLossResult
+												.pathClutterRxDB;
 										excthrGc.pathClutterRxMode =
-											pathClutterRxModelStr;
+											pathLossResult
+												.pathClutterRxModelStr();
 										excthrGc.pathClutterRxCdf =
-											pathClutterRxCDF;
+											pathLossResult
+												.pathClutterRxCDF;
 										excthrGc.rlanBandwidth =
 											(chanStopFreq -
 											 chanStartFreq) *
@@ -15668,11 +15988,7 @@ void AfcManager::runHeatmapAnalysis()
 								uls->ITMHeightProfile = (double *)
 									NULL;
 							}
-							if (uls->isLOSHeightProfile) {
-								free(uls->isLOSHeightProfile);
-								uls->isLOSHeightProfile = (double *)
-									NULL;
-							}
+							uls->losOracle.clear();
 						}
 					}
 				}
@@ -15719,6 +16035,25 @@ void AfcManager::runHeatmapAnalysis()
 
 #endif
 		}
+		evalPtList.clear();
+
+		while (cellList.size() && evalPtList.empty()) {
+			refineHeatmapCells(chanStartFreq,
+					   chanStopFreq,
+					   evalPtList,
+					   ptDoneList,
+					   cellList,
+					   acceptCellList);
+		}
+		if ((!fillFlag) && cellList.empty()) {
+			numInterp = interpolateHeatmapCells(acceptCellList, evalPtList, ptDoneList);
+			fillFlag = true;
+		}
+	}
+
+	if (_heatmapRefineFlag) {
+		LOGGER_INFO(logger) << "HEATMAP_REFINE: evaluated " << numProc << " of "
+				    << totNumProc << " points, " << numInterp << " interpolated";
 	}
 
 	if (numInvalid) {
@@ -16490,6 +16825,300 @@ void AfcManager::runHeatmapAnalysis()
 }
 /******************************************************************************************/
 
+/******************************************************************************************/
+/* AfcManager::initHeatmapRefinement()                                                    */
+/* Coarse grid of heatmap refinement has every _heatmapRefineStep-th point along each     */
+/* axis, and the last point. Cells span adjacent coarse points. Center point is added so  */
+/* that _heatmapRLANCenterPosn is computed.                                               */
+/******************************************************************************************/
+void AfcManager::initHeatmapRefinement(std::vector<std::pair<int, int>> &evalPtList,
+				       std::vector<bool> &ptDoneList,
+				       std::vector<std::tuple<int, int, int, int>> &cellList) const
+{
+	std::vector<int> lonNodeList, latNodeList;
+	int lonIdx, latIdx;
+	for (lonIdx = 0; lonIdx < _heatmapNumPtsLon - 1; lonIdx += _heatmapRefineStep) {
+		lonNodeList.push_back(lonIdx);
+	}
+	lonNodeList.push_back(_heatmapNumPtsLon - 1);
+	for (latIdx = 0; latIdx < _heatmapNumPtsLat - 1; latIdx += _heatmapRefineStep) {
+		latNodeList.push_back(latIdx);
+	}
+	latNodeList.push_back(_heatmapNumPtsLat - 1);
+
+	// Grid with single point along axis has single cell of zero width
+	int numLonNode = lonNodeList.size();
+	int numLatNode = latNodeList.size();
+	int numLonCell = std::max(numLonNode - 1, 1);
+	int numLatCell = std::max(numLatNode - 1, 1);
+	for (int lonCellIdx = 0; lonCellIdx < numLonCell; ++lonCellIdx) {
+		int lon0 = lonNodeList[lonCellIdx];
+		int lon1 = lonNodeList[std::min(lonCellIdx + 1, numLonNode - 1)];
+		for (int latCellIdx = 0; latCellIdx < numLatCell; ++latCellIdx) {
+			int lat0 = latNodeList[latCellIdx];
+			int lat1 = latNodeList[std::min(latCellIdx + 1, numLatNode - 1)];
+			cellList.push_back(std::make_tuple(lon0, lon1, lat0, lat1));
+		}
+	}
+
+	for (int lonNodeIdx = 0; lonNodeIdx < numLonNode; ++lonNodeIdx) {
+		for (int latNodeIdx = 0; latNodeIdx < numLatNode; ++latNodeIdx) {
+			queueHeatmapPoint(lonNodeList[lonNodeIdx],
+					  latNodeList[latNodeIdx],
+					  _heatmapNumPtsLat,
+					  evalPtList,
+					  ptDoneList);
+		}
+	}
+	queueHeatmapPoint(_heatmapNumPtsLon / 2,
+			  _heatmapNumPtsLat / 2,
+			  _heatmapNumPtsLat,
+			  evalPtList,
+			  ptDoneList);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/* AfcManager::refineHeatmapCells()                                                       */
+/* Tests each cell of cellList, whose corners are evaluated. Cell is accepted (moved to   */
+/* acceptCellList) if all corner values have the same indoor/outdoor status and either    */
+/* are the same infinity (no FS in range, or denied) or are finite, fall between the same */
+/* pair of color thresholds and differ by at most _heatmapRefineTolDB; and no denied      */
+/* region with spectral overlap is near the cell (unless it is denied). Otherwise cell is */
+/* split in half along each axis that is more than one point wide, cellList is replaced   */
+/* by the resulting subcells and their corners are queued in evalPtList.                  */
+/******************************************************************************************/
+void AfcManager::refineHeatmapCells(
+	double chanStartFreq,
+	double chanStopFreq,
+	std::vector<std::pair<int, int>> &evalPtList,
+	std::vector<bool> &ptDoneList,
+	std::vector<std::tuple<int, int, int, int>> &cellList,
+	std::vector<std::tuple<int, int, int, int>> &acceptCellList) const
+{
+	std::vector<DeniedRegionClass *> drList;
+	for (int drIdx = 0; drIdx < (int)_deniedRegionList.size(); ++drIdx) {
+		DeniedRegionClass *dr = _deniedRegionList[drIdx];
+		if (computeSpectralOverlapLoss((double *)NULL,
+					       chanStartFreq,
+					       chanStopFreq,
+					       dr->getStartFreq(),
+					       dr->getStopFreq(),
+					       false,
+					       CConst::psdSpectralAlgorithm)) {
+			drList.push_back(dr);
+		}
+	}
+	double lonStepDeg = (_heatmapMaxLon - _heatmapMinLon) / _heatmapNumPtsLon;
+	double latStepDeg = (_heatmapMaxLat - _heatmapMinLat) / _heatmapNumPtsLat;
+	double drHeightAGL = (std::isnan(_heatmapMaxRLANHeightAGL) ? 0.0 :
+								     _heatmapMaxRLANHeightAGL);
+
+	std::vector<std::tuple<int, int, int, int>> subCellList;
+	for (int cellIdx = 0; cellIdx < (int)cellList.size(); ++cellIdx) {
+		int lon0, lon1, lat0, lat1;
+		std::tie(lon0, lon1, lat0, lat1) = cellList[cellIdx];
+		int cornerLonIdx[4] = {lon0, lon1, lon0, lon1};
+		int cornerLatIdx[4] = {lat0, lat0, lat1, lat1};
+
+		// Cell with non-finite corner is only accepted if all corners have the same
+		// infinity (no FS in range or denied) and indoor/outdoor status
+		bool refineFlag = false;
+		bool infFlag = false;
+		for (int cIdx = 0; cIdx < 4; ++cIdx) {
+			double val = _heatmapIToNDB[cornerLonIdx[cIdx]][cornerLatIdx[cIdx]];
+			if (!std::isfinite(val)) {
+				infFlag = true;
+			}
+		}
+		if (infFlag) {
+			double val0 = _heatmapIToNDB[lon0][lat0];
+			bool indoorFlag = _heatmapIsIndoor[lon0][lat0];
+			refineFlag = std::isnan(val0);
+			for (int cIdx = 1; (cIdx < 4) && (!refineFlag); ++cIdx) {
+				int lonIdx = cornerLonIdx[cIdx];
+				int latIdx = cornerLatIdx[cIdx];
+				if ((_heatmapIToNDB[lonIdx][latIdx] != val0) ||
+				    (_heatmapIsIndoor[lonIdx][latIdx] != indoorFlag)) {
+					refineFlag = true;
+				}
+			}
+		} else {
+			bool indoorFlag = _heatmapIsIndoor[lon0][lat0];
+			const std::vector<double> &thrList = (indoorFlag ? _heatmapIndoorThrList :
+									   _heatmapOutdoorThrList);
+			double minVal = _heatmapIToNDB[lon0][lat0];
+			double maxVal = minVal;
+			int thrIdx = std::upper_bound(thrList.begin(), thrList.end(), minVal) -
+				     thrList.begin();
+			for (int cIdx = 1; (cIdx < 4) && (!refineFlag); ++cIdx) {
+				double val = _heatmapIToNDB[cornerLonIdx[cIdx]][cornerLatIdx[cIdx]];
+				if ((_heatmapIsIndoor[cornerLonIdx[cIdx]][cornerLatIdx[cIdx]] !=
+				     indoorFlag) ||
+				    (std::upper_bound(thrList.begin(), thrList.end(), val) -
+					     thrList.begin() !=
+				     thrIdx)) {
+					refineFlag = true;
+				}
+				minVal = std::min(minVal, val);
+				maxVal = std::max(maxVal, val);
+			}
+			if (maxVal - minVal > _heatmapRefineTolDB) {
+				refineFlag = true;
+			}
+		}
+
+		// Denied cells need no denied region check
+		if ((!refineFlag) && drList.size() &&
+		    (_heatmapIToNDB[lon0][lat0] != std::numeric_limits<double>::infinity())) {
+			// Denied region is near cell if within half diagonal of cell center
+			double lon = _heatmapMinLon + (0.5 * (lon0 + lon1) + 0.5) * lonStepDeg;
+			double lat = _heatmapMinLat + (0.5 * (lat0 + lat1) + 0.5) * latStepDeg;
+			double cellLonDeg = (lon1 - lon0 + 1) * lonStepDeg * cos(lat * M_PI / 180.0);
+			double cellLatDeg = (lat1 - lat0 + 1) * latStepDeg;
+			double maxDist = 0.5 * CConst::earthRadius * M_PI / 180.0 *
+					 sqrt(cellLonDeg * cellLonDeg + cellLatDeg * cellLatDeg);
+			for (int drIdx = 0; (drIdx < (int)drList.size()) && (!refineFlag);
+			     ++drIdx) {
+				if (drList[drIdx]->intersect(lon, lat, maxDist, drHeightAGL)) {
+					refineFlag = true;
+				}
+			}
+		}
+
+		if (!refineFlag) {
+			acceptCellList.push_back(cellList[cellIdx]);
+		} else if ((lon1 - lon0 > 1) || (lat1 - lat0 > 1)) {
+			// Cells at most one point wide have no points besides corners
+			std::vector<std::pair<int, int>> lonRangeList, latRangeList;
+			if (lon1 - lon0 > 1) {
+				lonRangeList.push_back(std::make_pair(lon0, (lon0 + lon1) / 2));
+				lonRangeList.push_back(std::make_pair((lon0 + lon1) / 2, lon1));
+			} else {
+				lonRangeList.push_back(std::make_pair(lon0, lon1));
+			}
+			if (lat1 - lat0 > 1) {
+				latRangeList.push_back(std::make_pair(lat0, (lat0 + lat1) / 2));
+				latRangeList.push_back(std::make_pair((lat0 + lat1) / 2, lat1));
+			} else {
+				latRangeList.push_back(std::make_pair(lat0, lat1));
+			}
+			for (auto &lonRange : lonRangeList) {
+				for (auto &latRange : latRangeList) {
+					subCellList.push_back(std::make_tuple(lonRange.first,
+									      lonRange.second,
+									      latRange.first,
+									      latRange.second));
+					int subLonIdx[2] = {lonRange.first, lonRange.second};
+					int subLatIdx[2] = {latRange.first, latRange.second};
+					for (int i = 0; i < 2; ++i) {
+						for (int j = 0; j < 2; ++j) {
+							queueHeatmapPoint(subLonIdx[i],
+									  subLatIdx[j],
+									  _heatmapNumPtsLat,
+									  evalPtList,
+									  ptDoneList);
+						}
+					}
+				}
+			}
+		}
+	}
+	cellList.swap(subCellList);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/* AfcManager::interpolateHeatmapCells()                                                  */
+/* Sets points of accepted cells that were not evaluated by bilinear interpolation of     */
+/* corner values (or to common infinite value of corners) and marks them in               */
+/* _heatmapIsInterpolated. For "Database" indoor/outdoor selection, points whose building */
+/* status differs from that of the cell are queued in evalPtList instead. Returns number  */
+/* of interpolated points.                                                                */
+/******************************************************************************************/
+int AfcManager::interpolateHeatmapCells(
+	const std::vector<std::tuple<int, int, int, int>> &acceptCellList,
+	std::vector<std::pair<int, int>> &evalPtList,
+	std::vector<bool> &ptDoneList)
+{
+	bool databaseFlag = (_heatmapIndoorOutdoorStr == "Database");
+	double lonStepDeg = (_heatmapMaxLon - _heatmapMinLon) / _heatmapNumPtsLon;
+	double latStepDeg = (_heatmapMaxLat - _heatmapMinLat) / _heatmapNumPtsLat;
+	int numInterp = 0;
+
+	for (int cellIdx = 0; cellIdx < (int)acceptCellList.size(); ++cellIdx) {
+		int lon0, lon1, lat0, lat1;
+		std::tie(lon0, lon1, lat0, lat1) = acceptCellList[cellIdx];
+		bool indoorFlag = _heatmapIsIndoor[lon0][lat0];
+		double val00 = _heatmapIToNDB[lon0][lat0];
+		double val10 = _heatmapIToNDB[lon1][lat0];
+		double val01 = _heatmapIToNDB[lon0][lat1];
+		double val11 = _heatmapIToNDB[lon1][lat1];
+
+		for (int lonIdx = lon0; lonIdx <= lon1; ++lonIdx) {
+			double fx = (lon1 > lon0 ? (double)(lonIdx - lon0) / (lon1 - lon0) : 0.0);
+			for (int latIdx = lat0; latIdx <= lat1; ++latIdx) {
+				int ptIdx = lonIdx * _heatmapNumPtsLat + latIdx;
+				if (ptDoneList[ptIdx]) {
+					continue;
+				}
+				ptDoneList[ptIdx] = true;
+
+				if (databaseFlag) {
+					double lon = _heatmapMinLon + (lonIdx + 0.5) * lonStepDeg;
+					double lat = _heatmapMinLat + (latIdx + 0.5) * latStepDeg;
+					double terrainHeight, bldgHeight;
+					MultibandRasterClass::HeightResult lidarHeightResult;
+					CConst::HeightSourceEnum heightSource;
+					_terrainDataModel->getTerrainHeight(lon,
+									    lat,
+									    terrainHeight,
+									    bldgHeight,
+									    lidarHeightResult,
+									    heightSource);
+					bool ptIndoorFlag =
+						(lidarHeightResult ==
+						 MultibandRasterClass::HeightResult::BUILDING);
+					if (ptIndoorFlag != indoorFlag) {
+						evalPtList.push_back(std::make_pair(lonIdx, latIdx));
+						continue;
+					}
+				}
+
+				if (std::isfinite(val00)) {
+					double fy = (lat1 > lat0 ? (double)(latIdx - lat0) /
+									   (lat1 - lat0) :
+								   0.0);
+					_heatmapIToNDB[lonIdx][latIdx] =
+						(1.0 - fx) * (1.0 - fy) * val00 +
+						fx * (1.0 - fy) * val10 + (1.0 - fx) * fy * val01 +
+						fx * fy * val11;
+				} else {
+					// All corners have the same infinity, blend would be NaN
+					_heatmapIToNDB[lonIdx][latIdx] = val00;
+				}
+				_heatmapIsIndoor[lonIdx][latIdx] = indoorFlag;
+				_heatmapIsInterpolated[lonIdx][latIdx] = true;
+				numInterp++;
+			}
+		}
+	}
+
+	return (numInterp);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/* AfcManager::writeTimingReport                                                          */
+/******************************************************************************************/
+void AfcManager::writeTimingReport() const
+{
+	if (!_timingReportFile.empty()) {
+		Logging::writeTimingReportFile(_timingReportFile);
+	}
+}
+/******************************************************************************************/
+
 /******************************************************************************************/
 /* AfcManager::printUserInputs                                                            */
 /******************************************************************************************/
@@ -16871,7 +17500,9 @@ void AfcManager::setConstInputs(const std::string &tempDir)
 
 	if (AfcManager::_createDebugFiles) {
 		_excThrFile = QDir(QString::fromStdString(tempDir))
-				      .filePath("exc_thr.csv.gz")
+				      .filePath((_excThrFormat == GzipCsv::Format::Columnar) ?
+							"exc_thr.afccol" :
+							"exc_thr.csv.gz")
 				      .toStdString();
 		_fsAnomFile = QDir(QString::fromStdString(tempDir))
 				      .filePath("fs_anom.csv.gz")
@@ -16892,6 +17523,11 @@ void AfcManager::setConstInputs(const std::string &tempDir)
 		_kmlFile =
 			QDir(QString::fromStdString(tempDir)).filePath("results.kmz").toStdString();
 	}
+	if (AfcManager::_createTerrainProfile) {
+		_terrainProfileFile = QDir(QString::fromStdString(tempDir))
+					      .filePath("terrain_profile.csv")
+					      .toStdString();
+	}
 	/**************************************************************************************/
 }
 /**************************************************************************************/
@@ -17800,7 +18436,7 @@ void AfcManager::runTestWinner2(std::string inputFile, std::string outputFile)
 	double plLOS, plNLOS, plCombined;
 	double zval, probLOS, pathLossCDF;
 	double sigmaLOS, sigmaNLOS, sigmaCombined;
-	std::string pathLossModelStr;
+	CConst::PathLossResultModelEnum pathLossModel;
 
 	int fieldIdx;
 
@@ -17996,27 +18632,33 @@ void AfcManager::runTestWinner2(std::string inputFile, std::string outputFile)
 
 				zval = -qerfi(confidence);
 				_zwinner2Combined = zval;
+				_propModelContext.setConfidence(_zbldg2109,
+								_zclutter2108,
+								_fsZclutter2108,
+								_zwinner2LOS,
+								_zwinner2NLOS,
+								_zwinner2Combined);
+				PropModelFreqCoeffClass freqCoeff =
+					_propModelContext.getFreqCoeff(frequency);
 				if (propEnv == CConst::urbanPropEnv) {
 					plLOS = Winner2_C2urban_LOS(distance,
 								    hb,
 								    hm,
-								    frequency,
+								    freqCoeff,
 								    zval,
-								    sigmaLOS,
-								    pathLossCDF);
+								    sigmaLOS);
 					plNLOS = Winner2_C2urban_NLOS(distance,
 								      hb,
 								      hm,
-								      frequency,
+								      freqCoeff,
 								      zval,
-								      sigmaNLOS,
-								      pathLossCDF);
+								      sigmaNLOS);
 					plCombined = Winner2_C2urban(distance,
 								     hb,
 								     hm,
-								     frequency,
+								     freqCoeff,
 								     sigmaCombined,
-								     pathLossModelStr,
+								     pathLossModel,
 								     pathLossCDF,
 								     probLOS,
 								     winner2LOSValue);
@@ -18024,23 +18666,21 @@ void AfcManager::runTestWinner2(std::string inputFile, std::string outputFile)
 					plLOS = Winner2_C1suburban_LOS(distance,
 								       hb,
 								       hm,
-								       frequency,
+								       freqCoeff,
 								       zval,
-								       sigmaLOS,
-								       pathLossCDF);
+								       sigmaLOS);
 					plNLOS = Winner2_C1suburban_NLOS(distance,
 									 hb,
 									 hm,
-									 frequency,
+									 freqCoeff,
 									 zval,
-									 sigmaNLOS,
-									 pathLossCDF);
+									 sigmaNLOS);
 					plCombined = Winner2_C1suburban(distance,
 									hb,
 									hm,
-									frequency,
+									freqCoeff,
 									sigmaCombined,
-									pathLossModelStr,
+									pathLossModel,
 									pathLossCDF,
 									probLOS,
 									winner2LOSValue);
@@ -18048,23 +18688,21 @@ void AfcManager::runTestWinner2(std::string inputFile, std::string outputFile)
 					plLOS = Winner2_D1rural_LOS(distance,
 								    hb,
 								    hm,
-								    frequency,
+								    freqCoeff,
 								    zval,
-								    sigmaLOS,
-								    pathLossCDF);
+								    sigmaLOS);
 					plNLOS = Winner2_D1rural_NLOS(distance,
 								      hb,
 								      hm,
-								      frequency,
+								      freqCoeff,
 								      zval,
-								      sigmaNLOS,
-								      pathLossCDF);
+								      sigmaNLOS);
 					plCombined = Winner2_D1rural(distance,
 								     hb,
 								     hm,
-								     frequency,
+								     freqCoeff,
 								     sigmaCombined,
-								     pathLossModelStr,
+								     pathLossModel,
 								     pathLossCDF,
 								     probLOS,
 								     winner2LOSValue);
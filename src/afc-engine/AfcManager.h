@@ -35,6 +35,10 @@
 #include "freq_band.h"
 #include "global_fn.h"
 #include "GdalHelpers.h"
+#include "LOSOracle.h"
+#include "PathLossResult.h"
+#include "PropModelContext.h"
+#include "RxGainTable.h"
 #include "denied_region.h"
 #include "readITUFiles.hpp"
 #include "str_type.h"
@@ -45,6 +49,7 @@
 #include "prtable.h"
 #include "terrain.h"
 #include "CachedGdal.h"
+#include "JsonWriter.h"
 // Loggers
 #include "afclogging/ErrStream.h"
 #include "afclogging/Logging.h"
@@ -146,11 +151,11 @@ class AfcManager
 		/* create OGR layer for generateExclusionZoneJson, generateMapDataGeoJson, */
 		OGRLayer *createGeoJSONLayer(const char *tmpPath, GDALDataset **dataSet);
 
-		// create JSON object for exclusion zone to be sent to GUI
-		QJsonDocument generateExclusionZoneJson();
+		// write JSON object for exclusion zone to be sent to GUI
+		void writeExclusionZoneJson(JsonWriter &json);
 
-		// create JSON object for new AFC specification
-		QJsonDocument generateRatAfcJson();
+		// write JSON response object for new AFC specification
+		void writeRatAfcJson(JsonWriter &json);
 
 		// add building database bounds to OGR layer
 		void addBuildingDatabaseTiles(OGRLayer *layer);
@@ -170,6 +175,9 @@ class AfcManager
 		// Print the user inputs for testing and debugging
 		void printUserInputs();
 
+		// Write per-phase timing report (if requested with --timing-report)
+		void writeTimingReport() const;
+
 		ULSClass *findULSID(int ulsID, int dbIdx, int &ulsIdx);
 
 		// ***** Perform AFC Engine computations *****
@@ -197,6 +205,11 @@ class AfcManager
 
 		void setConstInputs(const std::string &tempDir); // set inputs not specified by user
 
+		bool getAsyncLogFlag() const
+		{
+			return _asyncLogFlag;
+		}
+
 		void setFixedBuildingLossFlag(bool fixedBuildingLossFlag)
 		{
 			_fixedBuildingLossFlag = fixedBuildingLossFlag;
@@ -206,6 +219,16 @@ class AfcManager
 			_fixedBuildingLossValue = fixedBuildingLossValue;
 		}
 
+		// Path loss model and model confidences, normally taken from AFC config by
+		// initializeDatabases(). Allow running path loss kernels without databases
+		void setPathLossModel(CConst::PathLossModelEnum pathLossModel);
+		void setPropModelConfidence(double confidenceBldg2109,
+					    double confidenceClutter2108,
+					    double fsConfidenceClutter2108,
+					    double confidenceWinner2LOS,
+					    double confidenceWinner2NLOS,
+					    double confidenceWinner2Combined);
+
 		void clearData();
 		void clearULSList();
 
@@ -234,6 +257,34 @@ class AfcManager
 
 		void readDeniedRegionData(std::string filename);
 
+		// Path loss kernel: models producing the values are returned as enums in result
+		void computePathLoss(CConst::PathLossModelEnum pathLossModel,
+				     bool itmFSPLFlag,
+				     CConst::PropEnvEnum propEnv,
+				     CConst::PropEnvEnum propEnvRx,
+				     CConst::NLCDLandCatEnum nlcdLandCatTx,
+				     CConst::NLCDLandCatEnum nlcdLandCatRx,
+				     double distKm,
+				     double fsplDistKm,
+				     double win2DistKm,
+				     const PropModelFreqCoeffClass &freqCoeff,
+				     double txLongitudeDeg,
+				     double txLatitudeDeg,
+				     double txHeightM,
+				     double elevationAngleTxDeg,
+				     double rxLongitudeDeg,
+				     double rxLatitudeDeg,
+				     double rxHeightM,
+				     double elevationAngleRxDeg,
+				     PathLossResultClass &result,
+				     double **ITMProfilePtr,
+				     LOSOracleClass *losOracle
+#if DEBUG_AFC
+				     ,
+				     std::vector<std::string> &ITMHeightType
+#endif
+		) const;
+		// Same as above, with model names returned as strings
 		void computePathLoss(CConst::PathLossModelEnum pathLossModel,
 				     bool itmFSPLFlag,
 				     CConst::PropEnvEnum propEnv,
@@ -264,20 +315,43 @@ class AfcManager
 				     std::string *txClutterStrPtr,
 				     std::string *rxClutterStrPtr,
 				     double **ITMProfilePtr,
-				     double **isLOSProfilePtr,
-				     double *isLOSSurfaceFracPtr
+				     LOSOracleClass *losOracle
 #if DEBUG_AFC
 				     ,
 				     std::vector<std::string> &ITMHeightType
 #endif
 		) const;
 
+		// First tier of ITM evaluation: true if full ITM path loss may limit EIRP of any
+		// segment of itmSegList
+		bool screenITMSegments(const ChannelStruct *channel,
+				       const std::vector<int> &itmSegList,
+				       const std::vector<double> *rxPowerDBW_0PLList,
+				       double noiseLevelDBW,
+				       CConst::PropEnvEnum propEnv,
+				       CConst::PropEnvEnum propEnvRx,
+				       CConst::NLCDLandCatEnum nlcdLandCatTx,
+				       CConst::NLCDLandCatEnum nlcdLandCatRx,
+				       double distKm,
+				       double fsplDistKm,
+				       double win2DistKm,
+				       double txLongitudeDeg,
+				       double txLatitudeDeg,
+				       double txHeightM,
+				       double elevationAngleTxDeg,
+				       double rxLongitudeDeg,
+				       double rxLatitudeDeg,
+				       double rxHeightM,
+				       double elevationAngleRxDeg,
+				       LOSOracleClass *losOracle) const;
+
 		double q(double Z) const;
-		double computeBuildingPenetration(CConst::BuildingTypeEnum buildingType,
-						  double elevationAngleDeg,
-						  double frequency,
-						  std::string &buildingPenetrationModelStr,
-						  double &buildingPenetrationCDF) const;
+		double computeBuildingPenetration(
+			CConst::BuildingTypeEnum buildingType,
+			double elevationAngleDeg,
+			const PropModelFreqCoeffClass &freqCoeff,
+			CConst::BuildingPenetrationModelEnum &buildingPenetrationModel,
+			double &buildingPenetrationCDF) const;
 
 		double computeNearFieldLoss(double frequency,
 					    double maxGain,
@@ -287,70 +361,64 @@ class AfcManager
 		double Winner2_C1suburban_LOS(double distance,
 					      double hBS,
 					      double hMS,
-					      double frequency,
+					      const PropModelFreqCoeffClass &freqCoeff,
 					      double zval,
-					      double &sigma,
-					      double &pathLossCDF) const;
+					      double &sigma) const;
 		double Winner2_C1suburban_NLOS(double distance,
 					       double hBS,
 					       double hMS,
-					       double frequency,
+					       const PropModelFreqCoeffClass &freqCoeff,
 					       double zval,
-					       double &sigma,
-					       double &pathLossCDF) const;
+					       double &sigma) const;
 		double Winner2_C2urban_LOS(double distance,
 					   double hBS,
 					   double hMS,
-					   double frequency,
+					   const PropModelFreqCoeffClass &freqCoeff,
 					   double zval,
-					   double &sigma,
-					   double &pathLossCDF) const;
+					   double &sigma) const;
 		double Winner2_C2urban_NLOS(double distance,
 					    double hBS,
 					    double hMS,
-					    double frequency,
+					    const PropModelFreqCoeffClass &freqCoeff,
 					    double zval,
-					    double &sigma,
-					    double &pathLossCDF) const;
+					    double &sigma) const;
 		double Winner2_D1rural_LOS(double distance,
 					   double hBS,
 					   double hMS,
-					   double frequency,
+					   const PropModelFreqCoeffClass &freqCoeff,
 					   double zval,
-					   double &sigma,
-					   double &pathLossCDF) const;
+					   double &sigma) const;
 		double Winner2_D1rural_NLOS(double distance,
 					    double hBS,
 					    double hMS,
-					    double frequency,
+					    const PropModelFreqCoeffClass &freqCoeff,
 					    double zval,
-					    double &sigma,
-					    double &pathLossCDF) const;
+					    double &sigma) const;
 
 		double Winner2_C1suburban(double distance,
 					  double hBS,
 					  double hMS,
-					  double frequency,
+					  const PropModelFreqCoeffClass &freqCoeff,
 					  double &sigma,
-					  std::string &pathLossModelStr,
+					  CConst::PathLossResultModelEnum &pathLossModel,
 					  double &pathLossCDF,
 					  double &probLOS,
 					  int losValue) const;
 		double Winner2_C2urban(double distance,
 				       double hBS,
 				       double hMS,
-				       double frequency,
+				       const PropModelFreqCoeffClass &freqCoeff,
 				       double &sigma,
-				       std::string &pathLossModelStr,
+				       CConst::PathLossResultModelEnum &pathLossModel,
 				       double &pathLossCDF,
 				       double &probLOS,
 				       int losValue) const;
 		double Winner2_D1rural(double distance,
 				       double hBS,
 				       double hMS,
-				       double frequency,
+				       const PropModelFreqCoeffClass &freqCoeff,
 				       double &sigma,
-				       std::string &pathLossModelStr,
+				       CConst::PathLossResultModelEnum &pathLossModel,
 				       double &pathLossCDF,
 				       double &probLOS,
 				       int losValue) const;
@@ -371,6 +439,21 @@ class AfcManager
 		void runScanAnalysis();
 		void runExclusionZoneAnalysis();
 		void runHeatmapAnalysis();
+		void initHeatmapRefinement(
+			std::vector<std::pair<int, int>> &evalPtList,
+			std::vector<bool> &ptDoneList,
+			std::vector<std::tuple<int, int, int, int>> &cellList) const;
+		void refineHeatmapCells(
+			double chanStartFreq,
+			double chanStopFreq,
+			std::vector<std::pair<int, int>> &evalPtList,
+			std::vector<bool> &ptDoneList,
+			std::vector<std::tuple<int, int, int, int>> &cellList,
+			std::vector<std::tuple<int, int, int, int>> &acceptCellList) const;
+		int interpolateHeatmapCells(
+			const std::vector<std::tuple<int, int, int, int>> &acceptCellList,
+			std::vector<std::pair<int, int>> &evalPtList,
+			std::vector<bool> &ptDoneList);
 		void writeKML();
 		void createChannelList();
 		void splitFrequencyRanges();
@@ -435,7 +518,14 @@ class AfcManager
 		bool _createKmz;
 		bool _createDebugFiles;
 		bool _createSlowDebugFiles;
+		bool _createTerrainProfile;
 		bool _certifiedIndoor;
+		std::string _gridCacheDir; // Directory for cached population and ITU grids
+					   // (empty if not used)
+		GzipCsv::Format _excThrFormat; // Format of excThrFile (CSV or binary columnar)
+		std::string _timingReportFile; // Per-phase timing report file (empty if not
+					       // requested)
+		bool _asyncLogFlag; // Write log records from background thread
 
 		AfcDataIf *_dataIf;
 
@@ -672,6 +762,17 @@ class AfcManager
 		bool _printSkippedLinksFlag; // If set, links that are skipped in the analysis
 					     // because using FSPL does not limit I/N performance
 					     // are still printed in exc_thr file.  This
+		bool _rxGainTableFlag; // If set, FS and passive repeater antenna gain is
+				       // interpolated from tables of gain vs angle off boresight
+		RxGainTableCacheClass _rxGainTableCache; // Gain tables shared by FS antennas
+		bool _itmScreeningFlag; // If set, ITM path loss is first computed on coarse terrain
+					// profile, full ITM only where result may limit EIRP
+		double _itmScreeningMarginDB; // Coarse path loss is lowered by this margin
+		int _itmScreeningDecimation; // Coarse profile has every Nth point of full profile
+		bool _heatmapRefineFlag; // If set, heatmap is evaluated on coarse grid that is
+					 // subdivided where I/N varies, other points interpolated
+		int _heatmapRefineStep; // Spacing of coarse heatmap grid, in grid points
+		double _heatmapRefineTolDB; // Cells with larger I/N variation are subdivided
 		bool _roundPSDEIRPFlag; // If set, round down PSD and EIRP values in output json to
 					// nearest multiple of 0.1 dB. is useful for debugging, but
 					// depending on visibility threshold setting may impact
@@ -723,6 +824,8 @@ class AfcManager
 		std::string _kmlFile; // Generate kml file showing simulation results, primarily for
 				      // debugging
 		std::string _fsAnalysisListFile; // File containing list of FS used in the analysis
+		std::string _terrainProfileFile; // Generate file containing terrain tile access
+						 // statistics
 		int _maxLidarRegionLoadVal;
 		/**************************************************************************************/
 
@@ -764,6 +867,9 @@ class AfcManager
 		double _zwinner2NLOS;
 		double _zwinner2Combined;
 
+		PropModelContextClass _propModelContext; // Model coefficients for each frequency
+							 // in _channelList
+
 		std::vector<int>
 			_ulsIdxList; // Stores the indices of the ULS stations we are analyzing
 		DoubleTriplet _beamConeLatLons; // Stores beam cone coordinates together to be
@@ -805,6 +911,8 @@ class AfcManager
 					// [0,_heatmapNumPtsLon-1] latIdx in [0,_heatmapNumPtsLat-1]
 		bool **_heatmapIsIndoor; // Matrix of bool values: true for indoor, false for
 					 // outdoor for grid point (lonIdx, latIdx)
+		bool **_heatmapIsInterpolated; // Matrix of bool values: true if I/N of grid point
+					       // (lonIdx, latIdx) is interpolated, not computed
 		int _heatmapNumPtsLon; // Num LON values in heatmap matrix
 		int _heatmapNumPtsLat; // Num LAT values in heatmap matrix
 		double _heatmapMinIToNDB; // Min I/N in _heatmapIToNDB
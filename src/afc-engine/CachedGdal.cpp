@@ -8,10 +8,14 @@
 #include "CachedGdal.h"
 #include <assert.h>
 #include <boost/filesystem.hpp>
+#include <chrono>
 #include <fnmatch.h>
 #include <afclogging/Logging.h>
 #include <sstream>
 #include <stdexcept>
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
 
 namespace
 {
@@ -91,11 +95,13 @@ CachedGdalBase::TileInfo::TileInfo(CachedGdalBase *cachedGdal_,
 	tileVector(cachedGdal_->createTileVector(transformation_.latSize, transformation_.lonSize),
 		   [cachedGdal_](void *p) {
 			   cachedGdal_->deleteTileVector(p);
-		   })
+		   }),
+	profileStats(nullptr)
 {
 }
 
-CachedGdalBase::TileInfo::TileInfo() : cachedGdal(nullptr), gdalInfo(nullptr)
+CachedGdalBase::TileInfo::TileInfo() :
+	cachedGdal(nullptr), gdalInfo(nullptr), profileStats(nullptr)
 {
 }
 
@@ -114,6 +120,16 @@ CachedGdalBase::GdalDatasetHolder::GdalDatasetHolder(const std::string &fullFile
 		       << fullFileName << "' not found";
 		throw std::runtime_error(errStr.str());
 	}
+	// File stamp makes shared tile cache keys of replaced file different
+	struct stat st;
+	if (stat(fullFileName.c_str(), &st) != 0) {
+		errStr << "ERROR: CachedGdalBase::GdalDatasetHolder::GdalDatasetHolder(): "
+			  "Unable to stat GDAL data file '"
+		       << fullFileName << "': " << strerror(errno);
+		throw std::runtime_error(errStr.str());
+	}
+	fileMtimeNs = (int64_t)st.st_mtim.tv_sec * 1000000000LL + (int64_t)st.st_mtim.tv_nsec;
+	fileSize = (int64_t)st.st_size;
 	gdalDataset = static_cast<GDALDataset *>(GDALOpen(fullFileName.c_str(), GA_ReadOnly));
 	if (!gdalDataset) {
 		errStr << "ERROR: CachedGdalBase::GdalDatasetHolder::GdalDatasetHolder(): "
@@ -146,6 +162,9 @@ CachedGdalBase::PixelInfo::PixelInfo() : baseName(""), row(-1), column(-1)
 // CachedGdalBase
 ///////////////////////////////////////////////////////////////////////////////
 
+std::shared_ptr<SharedTileCache> CachedGdalBase::_defaultSharedTileCache;
+std::shared_ptr<GdalAccessProfiler> CachedGdalBase::_defaultAccessProfiler;
+
 CachedGdalBase::CachedGdalBase(std::string fileOrDir,
 			       const std::string &dsName,
 			       std::unique_ptr<GdalNameMapperBase> nameMapper,
@@ -162,9 +181,16 @@ CachedGdalBase::CachedGdalBase(std::string fileOrDir,
 	_tileCache(cacheSize),
 	_gdalDsCache(GDAL_CACHE_SIZE),
 	_recentGdalInfo(nullptr),
-	_allSeen(false)
+	_allSeen(false),
+	_sharedTileCache(_defaultSharedTileCache),
+	_accessProfiler(_defaultAccessProfiler),
+	_profilerInstance(-1)
 {
 	GDALAllRegister();
+	if (_accessProfiler) {
+		_profilerInstance =
+			_accessProfiler->addInstance(_dsName, _fileOrDir, cacheSize, maxTileSize);
+	}
 }
 
 void CachedGdalBase::initialize()
@@ -281,6 +307,9 @@ const void *CachedGdalBase::getTileVector(int band, double latDeg, double lonDeg
 		return nullptr;
 	}
 	const TileInfo &tileInfo(*_tileCache.recentValue());
+	if (tileInfo.profileStats) {
+		++tileInfo.profileStats->lookups;
+	}
 	int tileLatIdx, tileLonIdx;
 	tileInfo.transformation.computePixel(latDeg, lonDeg, &tileLatIdx, &tileLonIdx);
 	*pixelIndex = tileInfo.transformation.lonSize * tileLatIdx + tileLonIdx;
@@ -362,14 +391,72 @@ bool CachedGdalBase::findTile(int band, double latDeg, double lonDeg)
 			  gdalInfo);
 
 	// Now reading pixel data into buffer of tile object
+	auto readStart = std::chrono::steady_clock::now();
+	readTileData(tileKey,
+		     gdalInfo,
+		     latTileSize,
+		     lonTileSize,
+		     getTileBuffer(tileInfo.tileVector.get()));
+	if (_accessProfiler) {
+		tileInfo.profileStats = _accessProfiler->tileStats(_profilerInstance,
+								   tileKey.baseName,
+								   tileKey.band,
+								   tileKey.latOffset,
+								   tileKey.lonOffset);
+		tileInfo.profileStats->latDegMin = tileInfo.boundRect.latDegMin;
+		tileInfo.profileStats->lonDegMin = tileInfo.boundRect.lonDegMin;
+		tileInfo.profileStats->latDegMax = tileInfo.boundRect.latDegMax;
+		tileInfo.profileStats->lonDegMax = tileInfo.boundRect.lonDegMax;
+		++tileInfo.profileStats->loads;
+		std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() -
+							 readStart;
+		tileInfo.profileStats->loadSec += loadTime.count();
+	}
+	LOGGER_DEBUG(logger) << "[" << latTileSize << " X " << lonTileSize
+			     << "] tile retrieved from (" << tileKey.latOffset << ", "
+			     << tileKey.lonOffset << ") of band " << tileKey.band << " of '"
+			     << gdalInfo->baseName << "'";
+	// Finally adding tile to cache
+	_tileCache.add(tileKey, tileInfo);
+	return true;
+}
+
+void CachedGdalBase::readTileData(const TileKey &tileKey,
+				  const GdalInfo *gdalInfo,
+				  int latTileSize,
+				  int lonTileSize,
+				  void *buffer)
+{
 	const GdalDatasetHolder *datasetHolder = getGdalDatasetHolder(gdalInfo->baseName);
+	size_t tileBytes = (size_t)latTileSize * lonTileSize *
+			   (GDALGetDataTypeSize(_pixelType) / 8);
+	SharedTileCache::Key sharedKey = {0, 0};
+	if (_sharedTileCache) {
+		sharedKey = SharedTileCache::makeKey(datasetHolder->fullFileName,
+						     datasetHolder->fileMtimeNs,
+						     datasetHolder->fileSize,
+						     tileKey.band,
+						     tileKey.latOffset,
+						     tileKey.lonOffset,
+						     latTileSize,
+						     lonTileSize,
+						     (int)_pixelType);
+		if (_sharedTileCache->fetch(sharedKey, buffer, tileBytes)) {
+			LOGGER_DEBUG(logger) << "[" << latTileSize << " X " << lonTileSize
+					     << "] tile at (" << tileKey.latOffset << ", "
+					     << tileKey.lonOffset << ") of band " << tileKey.band
+					     << " of '" << gdalInfo->baseName
+					     << "' found in shared tile cache";
+			return;
+		}
+	}
 	CPLErr readError = datasetHolder->gdalDataset->GetRasterBand(tileKey.band)
 				   ->RasterIO(GF_Read,
 					      tileKey.lonOffset,
 					      tileKey.latOffset,
 					      lonTileSize,
 					      latTileSize,
-					      getTileBuffer(tileInfo.tileVector.get()),
+					      buffer,
 					      lonTileSize,
 					      latTileSize,
 					      _pixelType,
@@ -377,20 +464,16 @@ bool CachedGdalBase::findTile(int band, double latDeg, double lonDeg)
 					      0);
 	if (readError != CPLErr::CE_None) {
 		std::ostringstream errStr;
-		errStr << "ERROR: CachedGdalBase::findTile(): Reading GDAL data from '"
+		errStr << "ERROR: CachedGdalBase::readTileData(): Reading GDAL data from '"
 		       << tileKey.baseName << "' (band: " << tileKey.band
 		       << ", xOffset: " << tileKey.lonOffset << ", yOffset: " << tileKey.latOffset
 		       << ", xSize: " << lonTileSize << ", ySize: " << latTileSize
 		       << ") failed: " << CPLGetLastErrorMsg();
 		throw std::runtime_error(errStr.str());
 	}
-	LOGGER_DEBUG(logger) << "[" << latTileSize << " X " << lonTileSize
-			     << "] tile retrieved from (" << tileKey.latOffset << ", "
-			     << tileKey.lonOffset << ") of band " << tileKey.band << " of '"
-			     << gdalInfo->baseName << "'";
-	// Finally adding tile to cache
-	_tileCache.add(tileKey, tileInfo);
-	return true;
+	if (_sharedTileCache) {
+		_sharedTileCache->publish(sharedKey, buffer, tileBytes);
+	}
 }
 
 bool CachedGdalBase::getGdalPixel(double latDeg,
@@ -523,6 +606,26 @@ void CachedGdalBase::checkBandIndex(int band) const
 	throw std::runtime_error(errStr.str());
 }
 
+void CachedGdalBase::setSharedTileCache(std::shared_ptr<SharedTileCache> sharedTileCache)
+{
+	_defaultSharedTileCache = sharedTileCache;
+}
+
+const std::shared_ptr<SharedTileCache> &CachedGdalBase::sharedTileCache()
+{
+	return _defaultSharedTileCache;
+}
+
+void CachedGdalBase::setAccessProfiler(std::shared_ptr<GdalAccessProfiler> accessProfiler)
+{
+	_defaultAccessProfiler = accessProfiler;
+}
+
+const std::shared_ptr<GdalAccessProfiler> &CachedGdalBase::accessProfiler()
+{
+	return _defaultAccessProfiler;
+}
+
 bool CachedGdalBase::covers(double latDeg, double lonDeg)
 {
 	return forEachGdalInfo([latDeg, lonDeg](const GdalInfo &gdalInfo) {
@@ -152,18 +152,27 @@
  *		cases, when name-based mapping is not obvious and number of tile files
  *		is relatively small (e.g. Globe data)
  *	- LruValueCache. LRU cache - copyless improvement of boost::lru_cache
+ *	- SharedTileCache. Optional second-tier cache of tile pixel data in POSIX
+ *		shared memory, common for all engine processes on the node. If set
+ *		with CachedGdalBase::setSharedTileCache(), it is consulted before
+ *		reading tile from GDAL file and receives tiles read from GDAL files
+ *	- GdalAccessProfiler. Optional collector of per-tile lookup/load statistics.
+ *		If set with CachedGdalBase::setAccessProfiler(), receives statistics
+ *		from CachedGdal objects created afterwards
  */
 
 #ifndef CACHED_GDAL_H
 #define CACHED_GDAL_H
 
 #include <functional>
+#include "GdalAccessProfiler.h"
 #include "GdalNameMapper.h"
 #include "GdalTransform.h"
 #include <gdal_priv.h>
 #include "LruValueCache.h"
 #include <map>
 #include <memory>
+#include "SharedTileCache.h"
 #include <boost/core/noncopyable.hpp>
 #include <boost/optional.hpp>
 #include <string>
@@ -210,6 +219,12 @@ class CachedGdalBase : private boost::noncopyable
 
 				/** Full file name of GDAL file */
 				std::string fullFileName;
+
+				/** Modification time of GDAL file in nanoseconds */
+				int64_t fileMtimeNs;
+
+				/** Size of GDAL file in bytes */
+				int64_t fileSize;
 		};
 
 		/** Information of whereabouts of data for certain pixel */
@@ -287,6 +302,24 @@ class CachedGdalBase : private boost::noncopyable
 		 */
 		static std::string formatPosition(double latDeg, double lonDeg);
 
+		/** Sets node-wide shared tile cache, used by CachedGdal objects created
+		 * afterwards.
+		 * @param sharedTileCache Shared tile cache, null to not use one
+		 */
+		static void setSharedTileCache(std::shared_ptr<SharedTileCache> sharedTileCache);
+
+		/** Node-wide shared tile cache (null if not used) */
+		static const std::shared_ptr<SharedTileCache> &sharedTileCache();
+
+		/** Sets tile access statistics collector, used by CachedGdal objects
+		 * created afterwards.
+		 * @param accessProfiler Statistics collector, null to not collect
+		 */
+		static void setAccessProfiler(std::shared_ptr<GdalAccessProfiler> accessProfiler);
+
+		/** Tile access statistics collector (null if not used) */
+		static const std::shared_ptr<GdalAccessProfiler> &accessProfiler();
+
 	protected:
 		/** Constructor.
 		 * @param fileOrDir Name of file (for monolithic file data GDAL source) or
@@ -510,12 +543,28 @@ class CachedGdalBase : private boost::noncopyable
 
 				/** std::vector that contains tile pixel data */
 				std::shared_ptr<void> tileVector;
+
+				/** Access statistics of this tile (null if not collected) */
+				GdalAccessProfiler::TileStats *profileStats;
 		};
 
 		//////////////////////////////////////////////////
 		// CachedGdalBase. Private instance methods
 		//////////////////////////////////////////////////
 
+		/** Fills tile pixel data buffer - from shared tile cache or from GDAL file
+		 * @param tileKey Key of tile being read
+		 * @param gdalInfo GdalInfo of file containing tile
+		 * @param latTileSize Tile size in latitude direction
+		 * @param lonTileSize Tile size in longitude direction
+		 * @param buffer Buffer to fill
+		 */
+		void readTileData(const TileKey &tileKey,
+				  const GdalInfo *gdalInfo,
+				  int latTileSize,
+				  int lonTileSize,
+				  void *buffer);
+
 		/** Tries to find tile for given coordinates and bands
 		 * @param[in] band 1-based band index
 		 * @param[in] latDeg Latitude of point to look tile of in north-positive
@@ -625,6 +674,25 @@ class CachedGdalBase : private boost::noncopyable
 
 		/** True if information about all GDAL files retrieved to _gdalInfos */
 		bool _allSeen;
+
+		/** Node-wide shared tile cache (null if not used) */
+		std::shared_ptr<SharedTileCache> _sharedTileCache;
+
+		/** Tile access statistics collector (null if not used) */
+		std::shared_ptr<GdalAccessProfiler> _accessProfiler;
+
+		/** Index of this object in _accessProfiler */
+		int _profilerInstance;
+
+		//////////////////////////////////////////////////
+		// CachedGdalBase. Private static data
+		//////////////////////////////////////////////////
+
+		/** Shared tile cache for CachedGdal objects being created */
+		static std::shared_ptr<SharedTileCache> _defaultSharedTileCache;
+
+		/** Tile access statistics collector for CachedGdal objects being created */
+		static std::shared_ptr<GdalAccessProfiler> _defaultAccessProfiler;
 };
 
 /** Concrete GDAL cache class, parameterized by pixel data type */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+#include "GdalAccessProfiler.h"
+#include <afclogging/Logging.h>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "GdalAccessProfiler")
+
+} // end namespace
+
+int GdalAccessProfiler::addInstance(const std::string &dsName,
+				    const std::string &fileOrDir,
+				    int cacheSize,
+				    int maxTileSize)
+{
+	InstanceInfo instanceInfo;
+	instanceInfo.dsName = dsName;
+	instanceInfo.fileOrDir = fileOrDir;
+	instanceInfo.cacheSize = cacheSize;
+	instanceInfo.maxTileSize = maxTileSize;
+	_instances.push_back(instanceInfo);
+	return (int)_instances.size() - 1;
+}
+
+GdalAccessProfiler::TileStats *GdalAccessProfiler::tileStats(int instance,
+							       const std::string &baseName,
+							       int band,
+							       int latOffset,
+							       int lonOffset)
+{
+	auto inserted = _tiles.emplace(TileKey(instance, baseName, band, latOffset, lonOffset),
+				       TileStats());
+	TileStats &ret = inserted.first->second;
+	if (inserted.second) {
+		ret.lookups = ret.loads = 0;
+		ret.loadSec = 0;
+		ret.latDegMin = ret.lonDegMin = ret.latDegMax = ret.lonDegMax = 0;
+	}
+	return &ret;
+}
+
+void GdalAccessProfiler::writeCsv(const std::string &filename) const
+{
+	std::ofstream file(filename);
+	if (!file) {
+		std::ostringstream errStr;
+		errStr << "ERROR: GdalAccessProfiler::writeCsv(): Unable to open '" << filename
+		       << "' for writing";
+		throw std::runtime_error(errStr.str());
+	}
+	file << "INSTANCE,DATASET,FILE_OR_DIR,CACHE_SIZE,MAX_TILE_SIZE,FILE,BAND,LAT_OFFSET,"
+		"LON_OFFSET,MIN_LAT_DEG,MAX_LAT_DEG,MIN_LON_DEG,MAX_LON_DEG,LOOKUPS,LOADS,"
+		"LOAD_MS\n";
+	file << std::setprecision(9);
+	for (auto &tile : _tiles) {
+		const InstanceInfo &ii = _instances[std::get<0>(tile.first)];
+		const TileStats &ts = tile.second;
+		file << std::get<0>(tile.first) << ",\"" << ii.dsName << "\",\"" << ii.fileOrDir
+		     << "\"," << ii.cacheSize << "," << ii.maxTileSize << ",\""
+		     << std::get<1>(tile.first) << "\"," << std::get<2>(tile.first) << ","
+		     << std::get<3>(tile.first) << "," << std::get<4>(tile.first) << ","
+		     << ts.latDegMin << "," << ts.latDegMax << "," << ts.lonDegMin << ","
+		     << ts.lonDegMax << "," << ts.lookups << "," << ts.loads << ","
+		     << ts.loadSec * 1000 << "\n";
+	}
+	if (!file) {
+		std::ostringstream errStr;
+		errStr << "ERROR: GdalAccessProfiler::writeCsv(): Error writing '" << filename
+		       << "'";
+		throw std::runtime_error(errStr.str());
+	}
+	LOGGER_INFO(logger) << "Terrain access profile of " << _tiles.size()
+			    << " tiles written to '" << filename << "'";
+}
+
+void GdalAccessProfiler::logSummary() const
+{
+	std::vector<TileStats> totals(_instances.size(), TileStats());
+	std::vector<int> numTiles(_instances.size(), 0);
+	for (auto &ts : totals) {
+		ts.lookups = ts.loads = 0;
+		ts.loadSec = 0;
+	}
+	for (auto &tile : _tiles) {
+		int instance = std::get<0>(tile.first);
+		totals[instance].lookups += tile.second.lookups;
+		totals[instance].loads += tile.second.loads;
+		totals[instance].loadSec += tile.second.loadSec;
+		++numTiles[instance];
+	}
+	for (size_t instance = 0; instance < _instances.size(); ++instance) {
+		if (!numTiles[instance]) {
+			continue;
+		}
+		const TileStats &ts = totals[instance];
+		LOGGER_INFO(logger)
+			<< "TERRAIN_PROFILE " << _instances[instance].dsName << " ("
+			<< _instances[instance].fileOrDir << "): TILES = " << numTiles[instance]
+			<< "  LOOKUPS = " << ts.lookups << "  LOADS = " << ts.loads
+			<< "  RELOADS = " << (ts.loads - numTiles[instance])
+			<< "  LOAD_TIME = " << ts.loadSec << " s";
+	}
+}
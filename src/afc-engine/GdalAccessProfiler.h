@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+
+#ifndef GDAL_ACCESS_PROFILER_H
+#define GDAL_ACCESS_PROFILER_H
+
+#include <boost/core/noncopyable.hpp>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/** @file
+ * Collector of per-tile access statistics of CachedGdal objects.
+ *
+ * When profiler is set with CachedGdalBase::setAccessProfiler(), CachedGdal
+ * objects, created afterwards, register themselves in it and report tile
+ * lookups, tile loads (cache misses) and time spent reading tiles from GDAL
+ * files. Tile loaded more than once was evicted from LRU cache before it was
+ * reused.
+ *
+ * Collected statistics is written as CSV file (one row per tile) that may be
+ * analyzed with tools/terrain_profile/terrain_profile.py to find hot degree
+ * cells and to choose tile cache size and tile size for each data set.
+ *
+ * Class is not thread safe (neither is CachedGdal).
+ */
+
+/** Statistics collector for CachedGdal tile accesses */
+class GdalAccessProfiler : private boost::noncopyable
+{
+	public:
+		//////////////////////////////////////////////////
+		// GdalAccessProfiler. Public class types
+		//////////////////////////////////////////////////
+
+		/** Statistics of single tile */
+		struct TileStats {
+				/** Number of pixel lookups that used this tile */
+				long long lookups;
+
+				/** Number of times tile was loaded (cache misses) */
+				long long loads;
+
+				/** Total time of tile loading in seconds */
+				double loadSec;
+
+				/** Tile boundaries in north/east-positive degrees */
+				double latDegMin, lonDegMin, latDegMax, lonDegMax;
+		};
+
+		//////////////////////////////////////////////////
+		// GdalAccessProfiler. Public member functions
+		//////////////////////////////////////////////////
+
+		/** Default constructor */
+		GdalAccessProfiler() = default;
+
+		/** Registers CachedGdal object.
+		 * @param dsName Data set name
+		 * @param fileOrDir Name of GDAL file or directory
+		 * @param cacheSize Maximum number of tiles in LRU cache
+		 * @param maxTileSize Maximum tile size in one dimension
+		 * @return Instance index to use in tileStats()
+		 */
+		int addInstance(const std::string &dsName,
+				const std::string &fileOrDir,
+				int cacheSize,
+				int maxTileSize);
+
+		/** Returns statistics record for given tile, creating it if necessary.
+		 * Returned address remains valid for the lifetime of profiler
+		 * @param instance Instance index returned by addInstance()
+		 * @param baseName Base name of GDAL file containing tile
+		 * @param band 1-based band index
+		 * @param latOffset Tile offset in latitude direction
+		 * @param lonOffset Tile offset in longitude direction
+		 * @return Tile statistics record
+		 */
+		TileStats *tileStats(int instance,
+				     const std::string &baseName,
+				     int band,
+				     int latOffset,
+				     int lonOffset);
+
+		/** Writes per-tile statistics to CSV file.
+		 * Throws std::runtime_error on failure
+		 * @param filename Name of file to write
+		 */
+		void writeCsv(const std::string &filename) const;
+
+		/** Logs per-instance statistics summary */
+		void logSummary() const;
+
+	private:
+		//////////////////////////////////////////////////
+		// GdalAccessProfiler. Private class types
+		//////////////////////////////////////////////////
+
+		/** Registered CachedGdal object */
+		struct InstanceInfo {
+				/** Data set name */
+				std::string dsName;
+
+				/** Name of GDAL file or directory */
+				std::string fileOrDir;
+
+				/** Maximum number of tiles in LRU cache */
+				int cacheSize;
+
+				/** Maximum tile size in one dimension */
+				int maxTileSize;
+		};
+
+		/** Tile statistics key: instance, file base name, band, latitude offset,
+		 * longitude offset
+		 */
+		typedef std::tuple<int, std::string, int, int, int> TileKey;
+
+		//////////////////////////////////////////////////
+		// GdalAccessProfiler. Private instance data
+		//////////////////////////////////////////////////
+
+		/** Registered instances, indexed by instance index */
+		std::vector<InstanceInfo> _instances;
+
+		/** Tile statistics (std::map keeps element addresses stable) */
+		std::map<TileKey, TileStats> _tiles;
+};
+
+#endif /* GDAL_ACCESS_PROFILER_H */
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+#include "GridCache.h"
+#include <afclogging/Logging.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "GridCache")
+
+/** Cache file signature */
+const char MAGIC[8] = {'A', 'F', 'C', 'G', 'R', 'I', 'D', '1'};
+
+/** Chunk alignment in bytes */
+const size_t CHUNK_ALIGN = 8;
+
+/** Rounds chunk length up to alignment */
+size_t alignedBytes(size_t bytes)
+{
+	return (bytes + CHUNK_ALIGN - 1) / CHUNK_ALIGN * CHUNK_ALIGN;
+}
+} // end namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// GridCache::Header
+///////////////////////////////////////////////////////////////////////////////
+
+struct GridCache::Header {
+		/** File signature */
+		char magic[8];
+
+		/** Cache file key */
+		uint64_t key;
+
+		/** Total length of chunks (without header) */
+		uint64_t payloadBytes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// GridCache::KeyBuilder
+///////////////////////////////////////////////////////////////////////////////
+
+GridCache::KeyBuilder::KeyBuilder() : _hash(0xCBF29CE484222325ULL)
+{
+	// Layout version - change it when layout of any grid changes
+	add(1);
+}
+
+GridCache::KeyBuilder &GridCache::KeyBuilder::addBytes(const void *data, size_t bytes)
+{
+	// FNV-1a
+	const unsigned char *p = static_cast<const unsigned char *>(data);
+	for (size_t i = 0; i < bytes; ++i) {
+		_hash ^= p[i];
+		_hash *= 0x100000001B3ULL;
+	}
+	return *this;
+}
+
+GridCache::KeyBuilder &GridCache::KeyBuilder::addString(const std::string &s)
+{
+	add(s.size());
+	return addBytes(s.data(), s.size());
+}
+
+GridCache::KeyBuilder &GridCache::KeyBuilder::addFile(const std::string &filename)
+{
+	struct stat st;
+	if (stat(filename.c_str(), &st) != 0) {
+		std::ostringstream errStr;
+		errStr << "ERROR: GridCache::KeyBuilder::addFile(): Unable to stat '" << filename
+		       << "': " << strerror(errno);
+		throw std::runtime_error(errStr.str());
+	}
+	addString(filename);
+	add((int64_t)st.st_mtim.tv_sec);
+	add((int64_t)st.st_mtim.tv_nsec);
+	return add((int64_t)st.st_size);
+}
+
+uint64_t GridCache::KeyBuilder::key() const
+{
+	return _hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// GridCache
+///////////////////////////////////////////////////////////////////////////////
+
+GridCache::GridCache(const std::string &filename, void *data, size_t bytes) :
+	_name(filename), _data(data), _bytes(bytes), _offset(sizeof(Header))
+{
+}
+
+GridCache::~GridCache()
+{
+	munmap(_data, _bytes);
+}
+
+const std::string &GridCache::name() const
+{
+	return _name;
+}
+
+const void *GridCache::nextBytes(size_t bytes)
+{
+	if ((_offset + bytes) > _bytes) {
+		std::ostringstream errStr;
+		errStr << "ERROR: GridCache::nextBytes(): Cache file '" << _name
+		       << "' is shorter than expected";
+		throw std::runtime_error(errStr.str());
+	}
+	const void *ret = static_cast<const char *>(_data) + _offset;
+	_offset += alignedBytes(bytes);
+	return ret;
+}
+
+std::string GridCache::filename(const std::string &cacheDir,
+			       const std::string &prefix,
+			       uint64_t key)
+{
+	std::ostringstream ret;
+	ret << cacheDir << "/" << prefix << "_" << std::hex << std::setw(16) << std::setfill('0')
+	    << key << ".bin";
+	return ret.str();
+}
+
+std::unique_ptr<GridCache> GridCache::open(const std::string &filename, uint64_t key)
+{
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return nullptr;
+	}
+	struct stat st;
+	void *data = MAP_FAILED;
+	if ((fstat(fd, &st) == 0) && ((size_t)st.st_size >= sizeof(Header))) {
+		data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	if (data == MAP_FAILED) {
+		LOGGER_WARN(logger) << "Grid cache file '" << filename << "' can't be mapped";
+		return nullptr;
+	}
+	const Header *header = static_cast<const Header *>(data);
+	if ((memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) || (header->key != key) ||
+	    ((header->payloadBytes + sizeof(Header)) != (uint64_t)st.st_size)) {
+		LOGGER_WARN(logger) << "Grid cache file '" << filename << "' is invalid";
+		munmap(data, st.st_size);
+		return nullptr;
+	}
+	LOGGER_DEBUG(logger) << "Grid cache file '" << filename << "' mapped";
+	return std::unique_ptr<GridCache>(new GridCache(filename, data, st.st_size));
+}
+
+bool GridCache::write(const std::string &filename,
+		      uint64_t key,
+		      const std::vector<Chunk> &chunks)
+{
+	Header header;
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.key = key;
+	header.payloadBytes = 0;
+	for (auto &chunk : chunks) {
+		header.payloadBytes += alignedBytes(chunk.bytes);
+	}
+	std::ostringstream tempName;
+	tempName << filename << "." << getpid() << ".tmp";
+	FILE *fp = fopen(tempName.str().c_str(), "wb");
+	if (!fp) {
+		LOGGER_WARN(logger) << "Unable to create grid cache file '" << tempName.str()
+				    << "': " << strerror(errno);
+		return false;
+	}
+	static const char padding[CHUNK_ALIGN] = {0};
+	bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+	for (auto &chunk : chunks) {
+		if (!ok) {
+			break;
+		}
+		size_t padBytes = alignedBytes(chunk.bytes) - chunk.bytes;
+		ok = (fwrite(chunk.data, 1, chunk.bytes, fp) == chunk.bytes) &&
+		     (fwrite(padding, 1, padBytes, fp) == padBytes);
+	}
+	ok = (fclose(fp) == 0) && ok;
+	if (ok) {
+		ok = rename(tempName.str().c_str(), filename.c_str()) == 0;
+	}
+	if (!ok) {
+		LOGGER_WARN(logger) << "Unable to write grid cache file '" << filename
+				    << "': " << strerror(errno);
+		unlink(tempName.str().c_str());
+		return false;
+	}
+	LOGGER_INFO(logger) << "Grid cache file '" << filename << "' written";
+	return true;
+}
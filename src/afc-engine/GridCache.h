@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+
+#ifndef GRID_CACHE_H
+#define GRID_CACHE_H
+
+#include <boost/core/noncopyable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** @file
+ * Memory-mapped binary cache of preprocessed grids (population grid, ITU
+ * radio climate and surface refractivity maps).
+ *
+ * Grids, built from source files (GDAL rasters, text files) are written to
+ * cache directory as flat binary files and on subsequent runs are mapped to
+ * memory instead of being rebuilt. Cache file is identified by 64-bit key,
+ * computed from everything grid depends upon - names, modification times and
+ * sizes of source files and build parameters. Key is stored in file header
+ * and verified on open, so stale or foreign file is never used.
+ *
+ * File consists of header followed by sequence of arrays (chunks), each
+ * starting at 8-byte aligned offset. Layout of chunks is defined by the user
+ * (writer and reader must agree on it - any change of layout should be
+ * reflected in the key).
+ *
+ * Files are written to temporary name and renamed, so concurrent engine
+ * processes never see partially written file.
+ *
+ * Usage:
+ *	GridCache::KeyBuilder kb;
+ *	kb.addFile(sourceFile).add(param1).add(param2);
+ *	std::string filename = GridCache::filename(cacheDir, "mygrid", kb.key());
+ *	std::unique_ptr<GridCache> gc = GridCache::open(filename, kb.key());
+ *	if (gc) {
+ *		const int *data = gc->next<int>(count);
+ *	} else {
+ *		std::vector<int> data = ... build ...;
+ *		GridCache::write(filename, kb.key(),
+ *			{GridCache::Chunk(data.data(), data.size() * sizeof(int))});
+ *	}
+ */
+
+/** Memory-mapped grid cache file */
+class GridCache : private boost::noncopyable
+{
+	public:
+		//////////////////////////////////////////////////
+		// GridCache. Public class types
+		//////////////////////////////////////////////////
+
+		/** Builder of cache file key */
+		class KeyBuilder
+		{
+			public:
+				/** Default constructor */
+				KeyBuilder();
+
+				/** Adds byte sequence to key
+				 * @param data Data to add
+				 * @param bytes Data length
+				 * @return Reference to itself
+				 */
+				KeyBuilder &addBytes(const void *data, size_t bytes);
+
+				/** Adds trivially copyable value to key
+				 * @param value Value to add
+				 * @return Reference to itself
+				 */
+				template<class T>
+				KeyBuilder &add(const T &value)
+				{
+					return addBytes(&value, sizeof(value));
+				}
+
+				/** Adds string to key
+				 * @param s String to add
+				 * @return Reference to itself
+				 */
+				KeyBuilder &addString(const std::string &s);
+
+				/** Adds file name, modification time and size to key.
+				 * Throws std::runtime_error if file does not exist
+				 * @param filename Name of file
+				 * @return Reference to itself
+				 */
+				KeyBuilder &addFile(const std::string &filename);
+
+				/** Resulting key */
+				uint64_t key() const;
+
+			private:
+				/** Current hash value */
+				uint64_t _hash;
+		};
+
+		/** Array to write */
+		struct Chunk {
+				/** Constructor
+				 * @param data_ Array data
+				 * @param bytes_ Array length in bytes
+				 */
+				Chunk(const void *data_, size_t bytes_) : data(data_), bytes(bytes_)
+				{
+				}
+
+				/** Array data */
+				const void *data;
+
+				/** Array length in bytes */
+				size_t bytes;
+		};
+
+		//////////////////////////////////////////////////
+		// GridCache. Public member functions
+		//////////////////////////////////////////////////
+
+		/** Destructor. Unmaps file */
+		~GridCache();
+
+		/** Returns next array of cached file and advances to the following one.
+		 * Throws std::runtime_error if file is too short
+		 * @param count Number of elements in array
+		 * @return Pointer to mapped (read-only) array
+		 */
+		template<class T>
+		const T *next(size_t count)
+		{
+			return static_cast<const T *>(nextBytes(count * sizeof(T)));
+		}
+
+		/** Name of mapped file */
+		const std::string &name() const;
+
+		//////////////////////////////////////////////////
+		// GridCache. Public static methods
+		//////////////////////////////////////////////////
+
+		/** Name of cache file for given grid kind and key.
+		 * @param cacheDir Cache directory
+		 * @param prefix Grid kind (used as file name prefix)
+		 * @param key Cache file key
+		 * @return Full file name
+		 */
+		static std::string filename(const std::string &cacheDir,
+					    const std::string &prefix,
+					    uint64_t key);
+
+		/** Maps cache file to memory.
+		 * @param filename Name of cache file
+		 * @param key Expected cache file key
+		 * @return Mapped file or null pointer if file does not exist or
+		 *	is invalid
+		 */
+		static std::unique_ptr<GridCache> open(const std::string &filename, uint64_t key);
+
+		/** Atomically writes cache file. Failure is logged, but not
+		 * reported otherwise (it is just a cache)
+		 * @param filename Name of cache file
+		 * @param key Cache file key
+		 * @param chunks Arrays to write
+		 * @return True on success
+		 */
+		static bool write(const std::string &filename,
+				  uint64_t key,
+				  const std::vector<Chunk> &chunks);
+
+	private:
+		//////////////////////////////////////////////////
+		// GridCache. Private class types
+		//////////////////////////////////////////////////
+
+		/** Cache file header */
+		struct Header;
+
+		//////////////////////////////////////////////////
+		// GridCache. Private member functions
+		//////////////////////////////////////////////////
+
+		/** Constructor
+		 * @param filename Name of mapped file
+		 * @param data Mapped file data
+		 * @param bytes Mapped file length
+		 */
+		GridCache(const std::string &filename, void *data, size_t bytes);
+
+		/** Returns next chunk and advances to the following one.
+		 * Throws std::runtime_error if file is too short
+		 * @param bytes Chunk length in bytes
+		 * @return Pointer to chunk data
+		 */
+		const void *nextBytes(size_t bytes);
+
+		//////////////////////////////////////////////////
+		// GridCache. Private instance data
+		//////////////////////////////////////////////////
+
+		/** Name of mapped file */
+		std::string _name;
+
+		/** Mapped file data */
+		void *_data;
+
+		/** Mapped file length */
+		size_t _bytes;
+
+		/** Offset of next chunk */
+		size_t _offset;
+};
+
+#endif /* GRID_CACHE_H */
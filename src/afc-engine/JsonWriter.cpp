@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+#include "JsonWriter.h"
+#include <assert.h>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+/** Buffer size above which buffered text is handed to sink */
+const size_t FLUSH_SIZE = 64 * 1024;
+
+/** Size of chunks in which file is read in rawValueFromFile() */
+const size_t FILE_CHUNK_SIZE = 64 * 1024;
+
+} // end namespace
+
+JsonWriter::JsonWriter(const Sink &sink) : _sink(sink)
+{
+	_buffer.reserve(FLUSH_SIZE + 1024);
+}
+
+JsonWriter &JsonWriter::beginObject()
+{
+	beforeValue();
+	append('{');
+	_firstInLevel.push_back(true);
+	return *this;
+}
+
+JsonWriter &JsonWriter::endObject()
+{
+	assert(!_firstInLevel.empty() && !_afterKey);
+	_firstInLevel.pop_back();
+	append('}');
+	return *this;
+}
+
+JsonWriter &JsonWriter::beginArray()
+{
+	beforeValue();
+	append('[');
+	_firstInLevel.push_back(true);
+	return *this;
+}
+
+JsonWriter &JsonWriter::endArray()
+{
+	assert(!_firstInLevel.empty());
+	_firstInLevel.pop_back();
+	append(']');
+	return *this;
+}
+
+JsonWriter &JsonWriter::key(const char *name)
+{
+	beforeValue();
+	appendString(name, strlen(name));
+	append(':');
+	_afterKey = true;
+	return *this;
+}
+
+JsonWriter &JsonWriter::value(double v)
+{
+	if (!std::isfinite(v)) {
+		return valueNull();
+	}
+	beforeValue();
+	// Shortest representation that reads back to the same value
+	char buf[32];
+	for (int precision = 15; precision <= 17; ++precision) {
+		snprintf(buf, sizeof(buf), "%.*g", precision, v);
+		if (strtod(buf, nullptr) == v) {
+			break;
+		}
+	}
+	append(buf, strlen(buf));
+	return *this;
+}
+
+JsonWriter &JsonWriter::value(int v)
+{
+	beforeValue();
+	char buf[16];
+	int len = snprintf(buf, sizeof(buf), "%d", v);
+	append(buf, len);
+	return *this;
+}
+
+JsonWriter &JsonWriter::value(bool v)
+{
+	beforeValue();
+	if (v) {
+		append("true", 4);
+	} else {
+		append("false", 5);
+	}
+	return *this;
+}
+
+JsonWriter &JsonWriter::value(const char *v)
+{
+	beforeValue();
+	appendString(v, strlen(v));
+	return *this;
+}
+
+JsonWriter &JsonWriter::value(const std::string &v)
+{
+	beforeValue();
+	appendString(v.data(), v.size());
+	return *this;
+}
+
+JsonWriter &JsonWriter::valueNull()
+{
+	beforeValue();
+	append("null", 4);
+	return *this;
+}
+
+JsonWriter &JsonWriter::rawValue(const char *json, size_t len)
+{
+	beforeValue();
+	append(json, len);
+	return *this;
+}
+
+JsonWriter &JsonWriter::rawValueFromFile(const std::string &filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file) {
+		std::ostringstream errStr;
+		errStr << "ERROR: JsonWriter::rawValueFromFile(): Unable to open '" << filename
+		       << "'";
+		throw std::runtime_error(errStr.str());
+	}
+	beforeValue();
+	std::vector<char> chunk(FILE_CHUNK_SIZE);
+	while (file) {
+		file.read(chunk.data(), chunk.size());
+		append(chunk.data(), (size_t)file.gcount());
+	}
+	if (file.bad()) {
+		std::ostringstream errStr;
+		errStr << "ERROR: JsonWriter::rawValueFromFile(): Error reading '" << filename
+		       << "'";
+		throw std::runtime_error(errStr.str());
+	}
+	return *this;
+}
+
+void JsonWriter::flush()
+{
+	if (!_buffer.empty()) {
+		_sink(_buffer.data(), _buffer.size());
+		_buffer.clear();
+	}
+}
+
+void JsonWriter::beforeValue()
+{
+	if (_afterKey) {
+		_afterKey = false;
+		return;
+	}
+	if (_firstInLevel.empty()) {
+		return;
+	}
+	if (_firstInLevel.back()) {
+		_firstInLevel.back() = false;
+	} else {
+		append(',');
+	}
+}
+
+void JsonWriter::append(const char *data, size_t len)
+{
+	_buffer.append(data, len);
+	if (_buffer.size() >= FLUSH_SIZE) {
+		flush();
+	}
+}
+
+void JsonWriter::appendString(const char *s, size_t len)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+	append('"');
+	for (size_t i = 0; i < len; ++i) {
+		unsigned char c = (unsigned char)s[i];
+		switch (c) {
+			case '"':
+				append("\\\"", 2);
+				break;
+			case '\\':
+				append("\\\\", 2);
+				break;
+			case '\b':
+				append("\\b", 2);
+				break;
+			case '\f':
+				append("\\f", 2);
+				break;
+			case '\n':
+				append("\\n", 2);
+				break;
+			case '\r':
+				append("\\r", 2);
+				break;
+			case '\t':
+				append("\\t", 2);
+				break;
+			default:
+				if (c < 0x20) {
+					char esc[6] = {'\\', 'u', '0', '0', hexDigits[c >> 4],
+						       hexDigits[c & 0xF]};
+					append(esc, sizeof(esc));
+				} else {
+					append((char)c);
+				}
+				break;
+		}
+	}
+	append('"');
+	if (_buffer.size() >= FLUSH_SIZE) {
+		flush();
+	}
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <boost/core/noncopyable.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/** @file
+ * Streaming JSON writer.
+ *
+ * Emits compact JSON text straight to output sink (e.g. compressing file
+ * writer) without building document tree in memory. Values are formatted the
+ * same way QJsonDocument formats them: numbers in shortest form that reads
+ * back to the same double (non-finite numbers as null), strings in UTF-8
+ * with QJsonDocument escapes.
+ *
+ * Usage:
+ *	JsonWriter json([&](const char *data, size_t len) { ...write... });
+ *	json.beginObject();
+ *	json.key("version").value("1.4");
+ *	json.key("items").beginArray().value(1).value(2).endArray();
+ *	json.endObject();
+ *	json.flush();
+ *
+ * Commas are inserted automatically. Writer does not validate call sequence
+ * beyond assertions on nesting.
+ */
+
+/** Streaming JSON writer */
+class JsonWriter : private boost::noncopyable
+{
+	public:
+		//////////////////////////////////////////////////
+		// JsonWriter. Public class types
+		//////////////////////////////////////////////////
+
+		/** Output sink. Receives consecutive pieces of JSON text. Expected to
+		 * throw on failure
+		 */
+		typedef std::function<void(const char *data, size_t len)> Sink;
+
+		//////////////////////////////////////////////////
+		// JsonWriter. Public member functions
+		//////////////////////////////////////////////////
+
+		/** Constructor
+		 * @param sink Output sink
+		 */
+		explicit JsonWriter(const Sink &sink);
+
+		/** Destructor. Does not flush - flush() should be called explicitly */
+		~JsonWriter() = default;
+
+		/** Starts object */
+		JsonWriter &beginObject();
+
+		/** Ends object */
+		JsonWriter &endObject();
+
+		/** Starts array */
+		JsonWriter &beginArray();
+
+		/** Ends array */
+		JsonWriter &endArray();
+
+		/** Writes object key (must be followed by value) */
+		JsonWriter &key(const char *name);
+
+		/** Writes number value. Non-finite value is written as null */
+		JsonWriter &value(double v);
+
+		/** Writes integer value */
+		JsonWriter &value(int v);
+
+		/** Writes boolean value */
+		JsonWriter &value(bool v);
+
+		/** Writes string value */
+		JsonWriter &value(const char *v);
+
+		/** Writes string value */
+		JsonWriter &value(const std::string &v);
+
+		/** Writes null value */
+		JsonWriter &valueNull();
+
+		/** Writes already serialized JSON value as is
+		 * @param json Serialized JSON value
+		 * @param len Length of serialized value
+		 */
+		JsonWriter &rawValue(const char *json, size_t len);
+
+		/** Writes content of file (containing serialized JSON value) as value.
+		 * Throws std::runtime_error if file can't be read
+		 * @param filename Name of file containing JSON value
+		 */
+		JsonWriter &rawValueFromFile(const std::string &filename);
+
+		/** Hands buffered text to sink */
+		void flush();
+
+	private:
+		//////////////////////////////////////////////////
+		// JsonWriter. Private member functions
+		//////////////////////////////////////////////////
+
+		/** Writes separator (if needed) before value or key */
+		void beforeValue();
+
+		/** Appends text to buffer, flushes buffer if it is full */
+		void append(const char *data, size_t len);
+
+		/** Appends single character to buffer */
+		void append(char c)
+		{
+			_buffer += c;
+		}
+
+		/** Appends quoted and escaped string */
+		void appendString(const char *s, size_t len);
+
+		//////////////////////////////////////////////////
+		// JsonWriter. Private instance data
+		//////////////////////////////////////////////////
+
+		/** Output sink */
+		Sink _sink;
+
+		/** Text not yet handed to sink */
+		std::string _buffer;
+
+		/** For each open object/array - true if it has no elements yet */
+		std::vector<bool> _firstInLevel;
+
+		/** True if key was just written (value follows without separator) */
+		bool _afterKey = false;
+};
+
+#endif /* JSON_WRITER_H */
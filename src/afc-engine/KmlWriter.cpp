@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+#include "KmlWriter.h"
+#include <afclogging/Logging.h>
+#include <algorithm>
+#include <assert.h>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <stdio.h>
+#include <thread>
+
+namespace
+{
+// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "KmlWriter")
+
+/** Buffer size above which buffered text is handed to background thread */
+const size_t FLUSH_SIZE = 256 * 1024;
+
+/** Number of spaces per nesting level (same as QXmlStreamWriter default) */
+const int INDENT = 4;
+
+} // end namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** Background thread that hands text to sink. Text is exchanged by swapping
+ * buffers, so at most one buffer is being written while next is being filled
+ */
+class KmlWriter::Output : private boost::noncopyable
+{
+	public:
+		/** Constructor. Starts thread
+		 * @param sink Output sink
+		 */
+		explicit Output(const Sink &sink) : _sink(sink)
+		{
+			_thread = std::thread(&Output::threadFunc, this);
+		}
+
+		/** Destructor. Stops thread */
+		~Output()
+		{
+			stop();
+		}
+
+		/** Hands buffer to thread (swapping it with empty one). Throws if
+		 * sink failed
+		 * @param buf Buffer to write
+		 */
+		void submit(std::string &buf)
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cv.wait(lock, [this] { return _pending.empty() || !_error.empty(); });
+			checkError();
+			_pending.swap(buf);
+			buf.clear();
+			_cv.notify_all();
+		}
+
+		/** Waits until everything submitted is written, stops thread. Throws
+		 * if sink failed
+		 */
+		void finish()
+		{
+			stop();
+			std::unique_lock<std::mutex> lock(_mutex);
+			checkError();
+		}
+
+	private:
+		/** Thread function */
+		void threadFunc()
+		{
+			std::string buf;
+			for (;;) {
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_cv.wait(lock,
+						 [this] { return !_pending.empty() || _done; });
+					if (_pending.empty()) {
+						return;
+					}
+					buf.swap(_pending);
+					_cv.notify_all();
+				}
+				try {
+					_sink(buf.data(), buf.size());
+				} catch (const std::exception &ex) {
+					std::unique_lock<std::mutex> lock(_mutex);
+					_error = ex.what();
+					_cv.notify_all();
+					return;
+				}
+				buf.clear();
+			}
+		}
+
+		/** Waits for thread completion */
+		void stop()
+		{
+			if (!_thread.joinable()) {
+				return;
+			}
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_done = true;
+				_cv.notify_all();
+			}
+			_thread.join();
+		}
+
+		/** Throws if sink failed. Called under lock */
+		void checkError()
+		{
+			if (!_error.empty()) {
+				throw std::runtime_error("ERROR: KmlWriter: Error writing KML: " +
+							 _error);
+			}
+		}
+
+		Sink _sink;
+		std::thread _thread;
+		std::mutex _mutex;
+		std::condition_variable _cv;
+
+		/** Buffer submitted for writing */
+		std::string _pending;
+
+		/** True when no more buffers will be submitted */
+		bool _done = false;
+
+		/** Sink error message, empty if there was no error */
+		std::string _error;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+KmlWriter::KmlWriter(const Sink &sink) :
+	_output(new Output(sink)), _baseDepth(0), _autoFormatting(false), _startTagOpen(false)
+{
+	_buffer.reserve(FLUSH_SIZE + 4096);
+}
+
+KmlWriter::KmlWriter(bool autoFormatting, int depth) :
+	_baseDepth(depth), _autoFormatting(autoFormatting), _startTagOpen(false)
+{
+}
+
+KmlWriter::KmlWriter(KmlWriter &&other) :
+	_output(std::move(other._output)),
+	_buffer(std::move(other._buffer)),
+	_openElements(std::move(other._openElements)),
+	_baseDepth(other._baseDepth),
+	_autoFormatting(other._autoFormatting),
+	_startTagOpen(other._startTagOpen)
+{
+}
+
+KmlWriter::~KmlWriter()
+{
+	try {
+		finish();
+	} catch (const std::exception &ex) {
+		LOGGER_ERROR(logger) << ex.what();
+	}
+}
+
+KmlWriter KmlWriter::fragment() const
+{
+	return KmlWriter(_autoFormatting, _baseDepth + (int)_openElements.size());
+}
+
+void KmlWriter::setAutoFormatting(bool autoFormatting)
+{
+	_autoFormatting = autoFormatting;
+}
+
+void KmlWriter::writeStartDocument()
+{
+	_buffer += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
+}
+
+void KmlWriter::writeEndDocument()
+{
+	while (!_openElements.empty()) {
+		writeEndElement();
+	}
+	if (_autoFormatting) {
+		_buffer += '\n';
+	}
+	flushIfFull();
+}
+
+void KmlWriter::writeStartElement(const char *name)
+{
+	closeStartTag();
+	writeIndent(_baseDepth + (int)_openElements.size());
+	_buffer += '<';
+	_buffer += name;
+	_openElements.push_back(name);
+	_startTagOpen = true;
+}
+
+void KmlWriter::writeEndElement()
+{
+	assert(!_openElements.empty());
+	if (_startTagOpen) {
+		_buffer += "/>";
+		_startTagOpen = false;
+	} else {
+		writeIndent(_baseDepth + (int)_openElements.size() - 1);
+		_buffer += "</";
+		_buffer += _openElements.back();
+		_buffer += '>';
+	}
+	_openElements.pop_back();
+	flushIfFull();
+}
+
+void KmlWriter::writeAttribute(const char *name, const char *value)
+{
+	assert(_startTagOpen);
+	_buffer += ' ';
+	_buffer += name;
+	_buffer += "=\"";
+	appendEscaped(value, strlen(value), true);
+	_buffer += '"';
+}
+
+void KmlWriter::writeTextElement(const char *name, const char *text, size_t len)
+{
+	closeStartTag();
+	writeIndent(_baseDepth + (int)_openElements.size());
+	_buffer += '<';
+	_buffer += name;
+	_buffer += '>';
+	appendEscaped(text, len, false);
+	_buffer += "</";
+	_buffer += name;
+	_buffer += '>';
+	flushIfFull();
+}
+
+void KmlWriter::writeFragment(const KmlWriter &frag)
+{
+	assert(!frag._output);
+	closeStartTag();
+	_buffer += frag._buffer;
+	flushIfFull();
+}
+
+void KmlWriter::finish()
+{
+	if (!_output) {
+		return;
+	}
+	if (!_buffer.empty()) {
+		_output->submit(_buffer);
+	}
+	std::unique_ptr<Output> output(std::move(_output));
+	output->finish();
+}
+
+void KmlWriter::appendCoordinate(std::string &buf,
+				 double lonDeg,
+				 double latDeg,
+				 double heightM,
+				 bool newline)
+{
+	char tuple[96];
+	int len = snprintf(tuple,
+			   sizeof(tuple),
+			   newline ? "%.10f,%.10f,%.2f\n" : "%.10f,%.10f,%.2f",
+			   lonDeg,
+			   latDeg,
+			   heightM);
+	buf.append(tuple, std::min(len, (int)sizeof(tuple) - 1));
+}
+
+void KmlWriter::closeStartTag()
+{
+	if (_startTagOpen) {
+		_buffer += '>';
+		_startTagOpen = false;
+	}
+}
+
+void KmlWriter::writeIndent(int depth)
+{
+	if (_autoFormatting) {
+		_buffer += '\n';
+		_buffer.append((size_t)(depth * INDENT), ' ');
+	}
+}
+
+void KmlWriter::appendEscaped(const char *text, size_t len, bool attribute)
+{
+	for (size_t i = 0; i < len; ++i) {
+		char c = text[i];
+		switch (c) {
+			case '<':
+				_buffer += "&lt;";
+				break;
+			case '>':
+				_buffer += "&gt;";
+				break;
+			case '&':
+				_buffer += "&amp;";
+				break;
+			case '"':
+				if (attribute) {
+					_buffer += "&quot;";
+				} else {
+					_buffer += c;
+				}
+				break;
+			default:
+				_buffer += c;
+				break;
+		}
+	}
+}
+
+void KmlWriter::flushIfFull()
+{
+	if (_output && (_buffer.size() >= FLUSH_SIZE)) {
+		_output->submit(_buffer);
+	}
+}
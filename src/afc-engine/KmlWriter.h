@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+
+#ifndef KML_WRITER_H
+#define KML_WRITER_H
+
+#include <QString>
+#include <boost/core/noncopyable.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/** @file
+ * Streaming KML (XML) writer.
+ *
+ * Implements subset of QXmlStreamWriter interface used for KML generation,
+ * formatting text into reusable byte buffer. Filled buffer is handed to
+ * output sink (e.g. KMZ archive entry that compresses what is written to
+ * it) on background thread, so compression overlaps with generation.
+ *
+ * Independent parts of document (e.g. per-FS placemarks) may be generated
+ * in parallel into fragment writers (obtained with fragment()) and then
+ * appended to main writer with writeFragment() in desired order.
+ *
+ * Usage:
+ *	KmlWriter kml([&](const char *data, size_t len) { ...write... });
+ *	kml.setAutoFormatting(debugMode);
+ *	kml.writeStartDocument();
+ *	kml.writeStartElement("kml");
+ *	...
+ *	KmlWriter fragment = kml.fragment(); // Possibly in other thread
+ *	fragment.writeStartElement("Placemark");
+ *	...
+ *	kml.writeFragment(fragment);
+ *	...
+ *	kml.writeEndDocument();
+ *	kml.finish();
+ */
+
+/** Streaming KML writer */
+class KmlWriter : private boost::noncopyable
+{
+	public:
+		//////////////////////////////////////////////////
+		// KmlWriter. Public class types
+		//////////////////////////////////////////////////
+
+		/** Output sink. Receives consecutive pieces of KML text. Called on
+		 * background thread. Expected to throw on failure
+		 */
+		typedef std::function<void(const char *data, size_t len)> Sink;
+
+		//////////////////////////////////////////////////
+		// KmlWriter. Public member functions
+		//////////////////////////////////////////////////
+
+		/** Constructs writer to given sink
+		 * @param sink Output sink
+		 */
+		explicit KmlWriter(const Sink &sink);
+
+		/** Move constructor (used for fragments) */
+		KmlWriter(KmlWriter &&other);
+
+		/** Destructor. Calls finish(), logs errors */
+		~KmlWriter();
+
+		/** Returns writer for document fragment that will be appended to
+		 * this writer at current nesting level. Fragment has no sink - text
+		 * accumulates in memory. May be called from any thread
+		 */
+		KmlWriter fragment() const;
+
+		/** Enables indentation of nested elements (turned off by default) */
+		void setAutoFormatting(bool autoFormatting);
+
+		/** Writes XML declaration */
+		void writeStartDocument();
+
+		/** Closes all open elements */
+		void writeEndDocument();
+
+		/** Opens element
+		 * @param name Element name
+		 */
+		void writeStartElement(const char *name);
+
+		/** Closes last open element */
+		void writeEndElement();
+
+		/** Writes attribute of just opened element
+		 * @param name Attribute name
+		 * @param value Attribute value (UTF-8)
+		 */
+		void writeAttribute(const char *name, const char *value);
+
+		/** Writes element with text content
+		 * @param name Element name
+		 * @param text Element text (UTF-8)
+		 */
+		void writeTextElement(const char *name, const char *text)
+		{
+			writeTextElement(name, text, strlen(text));
+		}
+
+		/** Writes element with text content
+		 * @param name Element name
+		 * @param text Element text (UTF-8)
+		 */
+		void writeTextElement(const char *name, const std::string &text)
+		{
+			writeTextElement(name, text.data(), text.size());
+		}
+
+		/** Writes element with text content
+		 * @param name Element name
+		 * @param text Element text
+		 */
+		void writeTextElement(const char *name, const QString &text)
+		{
+			writeTextElement(name, text.toStdString());
+		}
+
+		/** Appends fragment, previously obtained with fragment(). Open
+		 * elements of fragment are not closed
+		 * @param frag Fragment to append
+		 */
+		void writeFragment(const KmlWriter &frag);
+
+		/** Hands all written text to sink and waits for its completion.
+		 * Throws std::runtime_error if sink failed
+		 */
+		void finish();
+
+		//////////////////////////////////////////////////
+		// KmlWriter. Public static methods
+		//////////////////////////////////////////////////
+
+		/** Appends KML coordinate tuple ("lon,lat,height") to given buffer
+		 * @param buf Buffer to append to
+		 * @param lonDeg Longitude in degrees
+		 * @param latDeg Latitude in degrees
+		 * @param heightM Height in meters
+		 * @param newline True to terminate tuple with newline
+		 */
+		static void appendCoordinate(std::string &buf,
+					     double lonDeg,
+					     double latDeg,
+					     double heightM,
+					     bool newline = true);
+
+	private:
+		//////////////////////////////////////////////////
+		// KmlWriter. Private types
+		//////////////////////////////////////////////////
+
+		/** Background thread that hands text to sink */
+		class Output;
+
+		//////////////////////////////////////////////////
+		// KmlWriter. Private member functions
+		//////////////////////////////////////////////////
+
+		/** Constructs fragment writer
+		 * @param autoFormatting Indentation of nested elements
+		 * @param depth Nesting level of fragment in parent document
+		 */
+		KmlWriter(bool autoFormatting, int depth);
+
+		/** Writes element with text content
+		 * @param name Element name
+		 * @param text Element text (UTF-8)
+		 * @param len Text length
+		 */
+		void writeTextElement(const char *name, const char *text, size_t len);
+
+		/** Terminates start tag of current element (if it is not yet
+		 * terminated)
+		 */
+		void closeStartTag();
+
+		/** Writes newline and indentation for given nesting level (if auto
+		 * formatting is on)
+		 */
+		void writeIndent(int depth);
+
+		/** Appends text, escaping XML special characters
+		 * @param text Text to append
+		 * @param len Text length
+		 * @param attribute True if text is attribute value
+		 */
+		void appendEscaped(const char *text, size_t len, bool attribute);
+
+		/** Hands buffer to background thread if it is full */
+		void flushIfFull();
+
+		//////////////////////////////////////////////////
+		// KmlWriter. Private instance data
+		//////////////////////////////////////////////////
+
+		/** Background output (null for fragment writers) */
+		std::unique_ptr<Output> _output;
+
+		/** Text not yet handed to output */
+		std::string _buffer;
+
+		/** Names of open elements (relative to fragment start) */
+		std::vector<std::string> _openElements;
+
+		/** Nesting level of fragment in parent document */
+		int _baseDepth;
+
+		/** Indentation of nested elements */
+		bool _autoFormatting;
+
+		/** True if start tag of last opened element is not terminated yet */
+		bool _startTagOpen;
+};
+
+#endif /* KML_WRITER_H */
@@ -0,0 +1,88 @@
+/******************************************************************************************/
+/**** FILE: LOSOracle.cpp                                                              ****/
+/******************************************************************************************/
+
+#include <cstdlib>
+#include <limits>
+#include "AfcDefinitions.h"
+#include "LOSOracle.h"
+#include "UlsMeasurementAnalysis.h"
+
+/******************************************************************************************/
+/**** CONSTRUCTOR: LOSOracleClass::LOSOracleClass()                                    ****/
+/******************************************************************************************/
+LOSOracleClass::LOSOracleClass()
+{
+	clear();
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: LOSOracleClass::clear()                                                ****/
+/******************************************************************************************/
+void LOSOracleClass::clear()
+{
+	heightList.clear();
+	cdsmFrac = quietNaN;
+	envelopeRxHeight = quietNaN;
+	minTxHeight = quietNaN;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: LOSOracleClass::isLOS()                                                ****/
+/******************************************************************************************/
+bool LOSOracleClass::isLOS(const TerrainClass *terrain,
+			   const QPointF &txLatLon,
+			   double txHeight,
+			   const QPointF &rxLatLon,
+			   double rxHeight,
+			   int numPts)
+{
+	if (heightList.empty()) {
+		double *profile = UlsMeasurementAnalysis::computeElevationVector(terrain,
+										 true,
+										 true,
+										 txLatLon,
+										 rxLatLon,
+										 numPts,
+										 &cdsmFrac);
+		heightList.assign(profile + 2, profile + 2 + numPts);
+		free(profile);
+	}
+
+	if (!(rxHeight == envelopeRxHeight)) {
+		computeEnvelope(rxHeight);
+	}
+
+	return (txHeight >= minTxHeight);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: LOSOracleClass::computeEnvelope()                                      ****/
+/**** With N profile points, line from TX (height h above terrain) clears point i if   ****/
+/**** (H_0 + h) * (N - 1 - i) + H_rx * i >= H_i * (N - 1), H_rx being RX height AMSL.  ****/
+/**** At TX itself this requires h >= 0, at RX RX height >= 0.                         ****/
+/******************************************************************************************/
+void LOSOracleClass::computeEnvelope(double rxHeight)
+{
+	int numPts = heightList.size();
+	double rxHeightAMSL = heightList[numPts - 1] + rxHeight;
+
+	if (rxHeight < 0.0) {
+		minTxHeight = std::numeric_limits<double>::infinity();
+	} else {
+		minTxHeight = 0.0;
+		for (int ptIdx = 1; ptIdx < numPts - 1; ++ptIdx) {
+			double h = (heightList[ptIdx] * (numPts - 1) - rxHeightAMSL * ptIdx) /
+					   (numPts - 1 - ptIdx) -
+				   heightList[0];
+			if (h > minTxHeight) {
+				minTxHeight = h;
+			}
+		}
+	}
+	envelopeRxHeight = rxHeight;
+}
+/******************************************************************************************/
@@ -0,0 +1,56 @@
+/******************************************************************************************/
+/**** FILE : LOSOracle.h                                                               ****/
+/******************************************************************************************/
+
+#ifndef LOS_ORACLE_H
+#define LOS_ORACLE_H
+
+#include <vector>
+#include <QPointF>
+
+class TerrainClass;
+
+/******************************************************************************************/
+/**** CLASS: LOSOracleClass                                                            ****/
+/**** Line of sight between TX and RX over building inclusive terrain profile. Profile ****/
+/**** and CDSM fraction are sampled once per ground track (on first query). For given  ****/
+/**** RX height, profile is reduced to max clearance envelope: minimum TX height above ****/
+/**** terrain at which line TX-RX clears all profile points. So LOS for every TX       ****/
+/**** (RLAN) height on the track is single comparison. Owner calls clear() when TX or  ****/
+/**** RX location changes.                                                             ****/
+/******************************************************************************************/
+class LOSOracleClass
+{
+	public:
+		LOSOracleClass();
+
+		// Forgets profile, next query samples new ground track
+		void clear();
+
+		// True if line from TX (txHeight above terrain) to RX (rxHeight above terrain)
+		// clears terrain and buildings. If profile is not sampled yet, it is sampled with
+		// numPts points
+		bool isLOS(const TerrainClass *terrain,
+			   const QPointF &txLatLon,
+			   double txHeight,
+			   const QPointF &rxLatLon,
+			   double rxHeight,
+			   int numPts);
+
+		// Fraction of interior profile points with CDSM height source (valid after isLOS())
+		double getCdsmFrac() const
+		{
+			return (cdsmFrac);
+		}
+
+	private:
+		void computeEnvelope(double rxHeight);
+
+		std::vector<double> heightList; // Profile heights AMSL (m), from TX to RX
+		double cdsmFrac;
+		double envelopeRxHeight; // RX height (m) for which minTxHeight was computed
+		double minTxHeight; // Min TX height (m) above terrain for LOS
+};
+/******************************************************************************************/
+
+#endif
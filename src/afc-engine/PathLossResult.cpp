@@ -0,0 +1,83 @@
+/******************************************************************************************/
+/**** FILE: PathLossResult.cpp                                                         ****/
+/******************************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include "PathLossResult.h"
+#include "str_type.h"
+
+/******************************************************************************************/
+/**** CONSTRUCTOR: PathLossResultClass::PathLossResultClass()                          ****/
+/******************************************************************************************/
+PathLossResultClass::PathLossResultClass() :
+	pathLoss(std::numeric_limits<double>::quiet_NaN()),
+	pathLossCDF(std::numeric_limits<double>::quiet_NaN()),
+	pathLossModel(CConst::unknownPathLossResultModel),
+	cdsmFrac(std::numeric_limits<double>::quiet_NaN()),
+	unclampedPathLoss(std::numeric_limits<double>::quiet_NaN()),
+	pathClutterTxDB(std::numeric_limits<double>::quiet_NaN()),
+	pathClutterTxCDF(-1.0),
+	pathClutterTxModel(CConst::unknownClutterModel),
+	txClutter(CConst::noClutterNLCDLandCat),
+	pathClutterRxDB(std::numeric_limits<double>::quiet_NaN()),
+	pathClutterRxCDF(-1.0),
+	pathClutterRxModel(CConst::unknownClutterModel),
+	rxClutter(CConst::noClutterNLCDLandCat)
+{
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PathLossResultClass::pathLossModelStr()                                ****/
+/******************************************************************************************/
+std::string PathLossResultClass::pathLossModelStr() const
+{
+	std::string str = CConst::strPathLossResultModelList->type_to_str(pathLossModel);
+
+	if (!std::isnan(cdsmFrac)) {
+		str += " cdsmFrac = " + std::to_string(cdsmFrac);
+	}
+	if (!std::isnan(unclampedPathLoss)) {
+		str += "_" + std::to_string(unclampedPathLoss) + "_CLAMPFSPL";
+	}
+
+	return (str);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PathLossResultClass::pathClutterTxModelStr()                           ****/
+/******************************************************************************************/
+std::string PathLossResultClass::pathClutterTxModelStr() const
+{
+	return (CConst::strClutterModelList->type_to_str(pathClutterTxModel));
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PathLossResultClass::pathClutterRxModelStr()                           ****/
+/******************************************************************************************/
+std::string PathLossResultClass::pathClutterRxModelStr() const
+{
+	return (CConst::strClutterModelList->type_to_str(pathClutterRxModel));
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PathLossResultClass::txClutterStr()                                    ****/
+/******************************************************************************************/
+std::string PathLossResultClass::txClutterStr() const
+{
+	return (CConst::strNLCDClutterList->type_to_str(txClutter));
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PathLossResultClass::rxClutterStr()                                    ****/
+/******************************************************************************************/
+std::string PathLossResultClass::rxClutterStr() const
+{
+	return (CConst::strNLCDClutterList->type_to_str(rxClutter));
+}
+/******************************************************************************************/
@@ -0,0 +1,46 @@
+/******************************************************************************************/
+/**** FILE : PathLossResult.h                                                          ****/
+/******************************************************************************************/
+
+#ifndef PATH_LOSS_RESULT_H
+#define PATH_LOSS_RESULT_H
+
+#include <string>
+#include "cconst.h"
+
+/******************************************************************************************/
+/**** CLASS: PathLossResultClass                                                       ****/
+/**** Result of AfcManager::computePathLoss(). Plain data: models that produced the    ****/
+/**** values are kept as enums, names are only resolved when results are written out.  ****/
+/******************************************************************************************/
+class PathLossResultClass
+{
+	public:
+		PathLossResultClass();
+
+		// Names as written to exc_thr/eirp output
+		std::string pathLossModelStr() const;
+		std::string pathClutterTxModelStr() const;
+		std::string pathClutterRxModelStr() const;
+		std::string txClutterStr() const;
+		std::string rxClutterStr() const;
+
+		double pathLoss;
+		double pathLossCDF;
+		CConst::PathLossResultModelEnum pathLossModel;
+		double cdsmFrac; // CDSM surface fraction of LOS path, NaN if not used
+		double unclampedPathLoss; // Path loss before clamping to FSPL, NaN if not clamped
+
+		double pathClutterTxDB;
+		double pathClutterTxCDF;
+		CConst::ClutterModelEnum pathClutterTxModel;
+		CConst::NLCDLandCatEnum txClutter; // Category used by 452_NLCD clutter model
+
+		double pathClutterRxDB;
+		double pathClutterRxCDF;
+		CConst::ClutterModelEnum pathClutterRxModel;
+		CConst::NLCDLandCatEnum rxClutter; // Category used by 452_NLCD clutter model
+};
+/******************************************************************************************/
+
+#endif
@@ -0,0 +1,168 @@
+/******************************************************************************************/
+/**** FILE: PropModelContext.cpp                                                       ****/
+/******************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "PropModelContext.h"
+
+namespace
+{
+// ITU-R P.2109 coefficients r, s, t, u, v, w, x, y, z for traditional and thermally
+// efficient buildings
+const double bldg2109Coeff[2][9] = {{12.64, 3.72, 0.96, 9.6, 2.0, 9.1, -3.0, 4.5, -2.0},
+				    {28.19, -3.00, 8.48, 13.5, 3.8, 27.8, -2.9, 9.4, -2.1}};
+
+// Probability that gaussian variable exceeds Z, same as AfcManager::q()
+double qFn(double Z)
+{
+	return (0.5 * erfc(Z / sqrt(2.0)));
+}
+}
+
+/******************************************************************************************/
+/**** CONSTRUCTOR: PropModelContextClass::PropModelContextClass()                      ****/
+/******************************************************************************************/
+PropModelContextClass::PropModelContextClass()
+{
+	clear();
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PropModelContextClass::clear()                                         ****/
+/******************************************************************************************/
+void PropModelContextClass::clear()
+{
+	setConfidence(std::numeric_limits<double>::quiet_NaN(),
+		      std::numeric_limits<double>::quiet_NaN(),
+		      std::numeric_limits<double>::quiet_NaN(),
+		      std::numeric_limits<double>::quiet_NaN(),
+		      std::numeric_limits<double>::quiet_NaN(),
+		      std::numeric_limits<double>::quiet_NaN());
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PropModelContextClass::setConfidence()                                 ****/
+/**** Clears frequencies and channels, as P.2109 coefficients depend on confidence.    ****/
+/******************************************************************************************/
+void PropModelContextClass::setConfidence(double zbldg2109Val,
+					  double zclutter2108Val,
+					  double fsZclutter2108Val,
+					  double zwinner2LOSVal,
+					  double zwinner2NLOSVal,
+					  double zwinner2CombinedVal)
+{
+	zbldg2109 = zbldg2109Val;
+	clutter2108DB = 6.0 * zclutter2108Val;
+	fsClutter2108DB = 6.0 * fsZclutter2108Val;
+	zwinner2LOS = zwinner2LOSVal;
+	zwinner2NLOS = zwinner2NLOSVal;
+	zwinner2Combined = zwinner2CombinedVal;
+
+	bldg2109CDF = qFn(-zbldg2109Val);
+	clutter2108CDF = qFn(-zclutter2108Val);
+	fsClutter2108CDF = qFn(-fsZclutter2108Val);
+	winner2LOSCDF = qFn(-zwinner2LOSVal);
+	winner2NLOSCDF = qFn(-zwinner2NLOSVal);
+	winner2CombinedCDF = qFn(-zwinner2CombinedVal);
+
+	freqList.clear();
+	freqCoeffList.clear();
+	chanFreqCoeffList.clear();
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PropModelContextClass::addFrequency()                                  ****/
+/******************************************************************************************/
+void PropModelContextClass::addFrequency(double frequency)
+{
+	auto it = std::lower_bound(freqList.begin(), freqList.end(), frequency);
+	if ((it != freqList.end()) && (*it == frequency)) {
+		return;
+	}
+	PropModelFreqCoeffClass freqCoeff;
+	computeFreqCoeff(frequency, freqCoeff);
+	freqCoeffList.insert(freqCoeffList.begin() + (it - freqList.begin()), freqCoeff);
+	freqList.insert(it, frequency);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PropModelContextClass::addChannel()                                    ****/
+/******************************************************************************************/
+void PropModelContextClass::addChannel(const std::vector<int> &freqMHzList)
+{
+	std::vector<PropModelFreqCoeffClass> segFreqCoeffList;
+	for (int freqSegIdx = 0; freqSegIdx + 1 < (int)freqMHzList.size(); ++freqSegIdx) {
+		double startFreqMHz = freqMHzList[freqSegIdx];
+		double stopFreqMHz = freqMHzList[freqSegIdx + 1];
+		for (double freqMHz :
+		     {startFreqMHz, stopFreqMHz, (startFreqMHz + stopFreqMHz) / 2.0}) {
+			addFrequency(freqMHz * 1.0e6);
+			segFreqCoeffList.push_back(getFreqCoeff(freqMHz * 1.0e6));
+		}
+	}
+	chanFreqCoeffList.push_back(segFreqCoeffList);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PropModelContextClass::getFreqCoeff()                                  ****/
+/******************************************************************************************/
+PropModelFreqCoeffClass PropModelContextClass::getFreqCoeff(double frequency) const
+{
+	auto it = std::lower_bound(freqList.begin(), freqList.end(), frequency);
+	if ((it != freqList.end()) && (*it == frequency)) {
+		return (freqCoeffList[it - freqList.begin()]);
+	}
+	PropModelFreqCoeffClass freqCoeff;
+	computeFreqCoeff(frequency, freqCoeff);
+	return (freqCoeff);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PropModelContextClass::computeFreqCoeff()                              ****/
+/******************************************************************************************/
+void PropModelContextClass::computeFreqCoeff(double frequency,
+					     PropModelFreqCoeffClass &freqCoeff) const
+{
+	double fGHz = frequency * 1.0e-9;
+	double logf = log10(fGHz);
+
+	freqCoeff.frequency = frequency;
+
+	freqCoeff.fsplDB = 20.0 * log10(4 * M_PI * frequency / CConst::c);
+
+	freqCoeff.winner2LogF5 = log10(fGHz / 5);
+	freqCoeff.winner2BPFactor = 4 * frequency / CConst::c;
+
+	// ITU-R P.[CLUTTER] sec 3.2
+	double Ll = 23.5 + 9.6 * logf;
+	double Ls0 = 32.98 + 3.0 * logf;
+	freqCoeff.clutter2108LlLin = exp(-0.2 * Ll * log(10.0));
+	freqCoeff.clutter2108LsLin = exp(-0.2 * Ls0 * log(10.0));
+
+	freqCoeff.clutter452Ffc = 0.25 + 0.375 * (1 + std::tanh(7.5 * (fGHz - 0.5)));
+
+	for (int bldgIdx = 0; bldgIdx < 2; ++bldgIdx) {
+		const double *k = bldg2109Coeff[bldgIdx];
+		double Lh = k[0] + k[1] * logf + k[2] * logf * logf;
+		double mB = k[5] + k[6] * logf;
+		double sA = k[3] + k[4] * logf;
+		double sB = k[7] + k[8] * logf;
+
+		double A0 = zbldg2109 * sA + Lh;
+		double B = zbldg2109 * sB + mB;
+		double C = -3.0;
+
+		freqCoeff.bldg2109ALin[bldgIdx] = exp(A0 * log(10.0) / 10.0);
+		freqCoeff.bldg2109BCLin[bldgIdx] = exp(B * log(10.0) / 10.0) +
+						   exp(C * log(10.0) / 10.0);
+	}
+}
+/******************************************************************************************/
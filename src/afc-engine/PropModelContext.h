@@ -0,0 +1,117 @@
+/******************************************************************************************/
+/**** FILE : PropModelContext.h                                                        ****/
+/******************************************************************************************/
+
+#ifndef PROP_MODEL_CONTEXT_H
+#define PROP_MODEL_CONTEXT_H
+
+#include <vector>
+#include "cconst.h"
+
+/******************************************************************************************/
+/**** CLASS: PropModelFreqCoeffClass                                                   ****/
+/**** Frequency and confidence dependent terms of P.2109, P.2108, P.452 clutter,       ****/
+/**** Winner II and FSPL models for a single frequency. Path loss kernels combine them ****/
+/**** with distance, height and elevation dependent terms only.                        ****/
+/******************************************************************************************/
+class PropModelFreqCoeffClass
+{
+	public:
+		double frequency; // Hz
+
+		double fsplDB; // FSPL at 1m: 20*log10(4*pi*f/c)
+
+		double winner2LogF5; // log10(fGHz/5)
+		double winner2BPFactor; // Break point distance over antenna heights: 4*f/c
+
+		double clutter2108LlLin; // 10^(-Ll/5), Ll = 23.5 + 9.6*log10(fGHz)
+		double clutter2108LsLin; // 10^(-Ls0/5), Ls0 = 32.98 + 3.0*log10(fGHz)
+		double clutter452Ffc; // Frequency factor of P.452 NLCD clutter loss
+
+		// P.2109 building entry loss, indexed by bldgTypeIdx()
+		double bldg2109ALin[2]; // 10^(A0/10), A0 is A without elevation term
+		double bldg2109BCLin[2]; // 10^(B/10) + 10^(C/10)
+
+		// Index of P.2109 coefficients of building type, -1 if type has none
+		static int bldgTypeIdx(CConst::BuildingTypeEnum buildingType)
+		{
+			if (buildingType == CConst::traditionalBuildingType) {
+				return (0);
+			} else if (buildingType == CConst::thermallyEfficientBuildingType) {
+				return (1);
+			}
+			return (-1);
+		}
+};
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** CLASS: PropModelContextClass                                                     ****/
+/**** Per request model context: statistical confidence terms and coefficients for     ****/
+/**** each channel/segment frequency in the request.                                   ****/
+/******************************************************************************************/
+class PropModelContextClass
+{
+	public:
+		PropModelContextClass();
+
+		void clear();
+
+		// Confidences as gaussian thresholds, must be set before adding frequencies
+		void setConfidence(double zbldg2109,
+				   double zclutter2108,
+				   double fsZclutter2108,
+				   double zwinner2LOS,
+				   double zwinner2NLOS,
+				   double zwinner2Combined);
+
+		// Precomputes coefficients for frequency (Hz), duplicates are ignored
+		void addFrequency(double frequency);
+
+		// Precomputes coefficients at start, stop and center of each segment of channel.
+		// Channels are indexed in order of addition
+		void addChannel(const std::vector<int> &freqMHzList);
+
+		// Coefficients for frequency (Hz), computed on the fly if frequency was not added
+		PropModelFreqCoeffClass getFreqCoeff(double frequency) const;
+
+		// Coefficients of channel segment at start (pos = 0), stop (pos = 1) or center
+		// (pos = 2) of segment
+		const PropModelFreqCoeffClass &getSegFreqCoeff(int chanIdx,
+							       int freqSegIdx,
+							       int pos) const
+		{
+			return (chanFreqCoeffList[chanIdx][3 * freqSegIdx + pos]);
+		}
+
+		int getNumFreq() const
+		{
+			return ((int)freqList.size());
+		}
+
+		double zbldg2109;
+		double clutter2108DB; // Confidence term of P.2108: 6.0*zclutter2108
+		double fsClutter2108DB; // Confidence term of P.2108 at FS: 6.0*fsZclutter2108
+		double zwinner2LOS;
+		double zwinner2NLOS;
+		double zwinner2Combined;
+
+		double bldg2109CDF;
+		double clutter2108CDF;
+		double fsClutter2108CDF;
+		double winner2LOSCDF;
+		double winner2NLOSCDF;
+		double winner2CombinedCDF;
+
+	private:
+		void computeFreqCoeff(double frequency, PropModelFreqCoeffClass &freqCoeff) const;
+
+		std::vector<double> freqList; // Sorted frequencies (Hz)
+		std::vector<PropModelFreqCoeffClass> freqCoeffList; // Coefficients for freqList
+
+		// Coefficients for each channel: start, stop and center of each segment
+		std::vector<std::vector<PropModelFreqCoeffClass>> chanFreqCoeffList;
+};
+/******************************************************************************************/
+
+#endif
@@ -0,0 +1,190 @@
+/******************************************************************************************/
+/**** FILE: RxGainTable.cpp                                                            ****/
+/******************************************************************************************/
+
+#include <cmath>
+#include "RxGainTable.h"
+#include "antenna.h"
+#include "calcitu1245.h"
+#include "calcitu699.h"
+#include "uls.h"
+#include <afclogging/Logging.h>
+
+namespace
+{
+// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "RxGainTable")
+
+// Fractions of cell at which interpolation is checked against pattern
+const double checkPosList[] = {0.25, 0.5, 0.75};
+}
+
+/******************************************************************************************/
+/**** CONSTRUCTOR: RxGainTableClass::RxGainTableClass()                                ****/
+/******************************************************************************************/
+RxGainTableClass::RxGainTableClass(const GainFnType &gainFn, double maxStepDeg, double maxErrDBVal)
+{
+	numCells = (int)ceil(180.0 / maxStepDeg - 1.0e-9);
+	double stepDeg = 180.0 / numCells;
+	invStepDeg = 1.0 / stepDeg;
+	numExactCells = 0;
+	maxErrDB = 0.0;
+
+	std::vector<std::string> nodeSubModelList(numCells + 1);
+	gainList.resize(numCells + 1);
+	for (int nodeIdx = 0; nodeIdx <= numCells; ++nodeIdx) {
+		gainList[nodeIdx] = (float)gainFn(nodeIdx * stepDeg, nodeSubModelList[nodeIdx]);
+	}
+
+	cellSubModelList.resize(numCells);
+	std::string subModelStr;
+	for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+		const std::string &cellSubModelStr = nodeSubModelList[cellIdx];
+		bool exactFlag = (nodeSubModelList[cellIdx + 1] != cellSubModelStr);
+		double cellMaxErrDB = 0.0;
+		for (int checkIdx = 0; (checkIdx < 3) && (!exactFlag); ++checkIdx) {
+			double t = checkPosList[checkIdx];
+			double gainDB = gainFn((cellIdx + t) * stepDeg, subModelStr);
+			double interpGainDB = gainList[cellIdx] +
+					      t * (gainList[cellIdx + 1] - gainList[cellIdx]);
+			double errDB = fabs(interpGainDB - gainDB);
+			if ((!(errDB <= maxErrDBVal)) || (subModelStr != cellSubModelStr)) {
+				exactFlag = true;
+			} else {
+				cellMaxErrDB = std::max(cellMaxErrDB, errDB);
+			}
+		}
+
+		int subModelIdx = -1;
+		if (!exactFlag) {
+			subModelIdx = std::find(subModelStrList.begin(),
+						subModelStrList.end(),
+						cellSubModelStr) -
+				      subModelStrList.begin();
+			if (subModelIdx == (int)subModelStrList.size()) {
+				if (subModelIdx < exactCellIdx) {
+					subModelStrList.push_back(cellSubModelStr);
+				} else {
+					exactFlag = true;
+				}
+			}
+		}
+
+		if (exactFlag) {
+			cellSubModelList[cellIdx] = exactCellIdx;
+			numExactCells++;
+		} else {
+			cellSubModelList[cellIdx] = (unsigned char)subModelIdx;
+			maxErrDB = std::max(maxErrDB, cellMaxErrDB);
+		}
+	}
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** CONSTRUCTOR: RxGainTableCacheClass::RxGainTableCacheClass()                      ****/
+/******************************************************************************************/
+RxGainTableCacheClass::RxGainTableCacheClass(double stepDegVal, double maxErrDBVal) :
+	stepDeg(stepDegVal), maxErrDB(maxErrDBVal)
+{
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: RxGainTableCacheClass::getTable()                                      ****/
+/**** Key holds only parameters pattern depends on, so that tables are shared.         ****/
+/******************************************************************************************/
+const RxGainTableClass *RxGainTableCacheClass::getTable(CConst::ULSAntennaTypeEnum antennaType,
+							AntennaClass *antenna,
+							CConst::AntennaCategoryEnum category,
+							double maxGain,
+							double Dlambda,
+							int divIdx,
+							double frequency)
+{
+	RxGainTableClass::GainFnType gainFn;
+	KeyType key;
+	switch (antennaType) {
+		case CConst::F1245AntennaType:
+			key = KeyType(antennaType, nullptr, 0, maxGain, Dlambda, 0, 0);
+			gainFn = [maxGain, Dlambda](double angleDeg, std::string &subModelStr) {
+				subModelStr = "";
+				return (calcItu1245::CalcITU1245(angleDeg, maxGain, Dlambda));
+			};
+			break;
+		case CConst::F699AntennaType:
+			key = KeyType(antennaType, nullptr, 0, maxGain, Dlambda, 0, 0);
+			gainFn = [maxGain, Dlambda](double angleDeg, std::string &subModelStr) {
+				subModelStr = "";
+				return (calcItu699::CalcITU699(angleDeg, maxGain, Dlambda));
+			};
+			break;
+		case CConst::R2AIP07AntennaType:
+			key = KeyType(antennaType, nullptr, category, maxGain, Dlambda, divIdx, 0);
+			gainFn = [=](double angleDeg, std::string &subModelStr) {
+				subModelStr = "";
+				return (ULSClass::calcR2AIP07Antenna(angleDeg,
+								     frequency,
+								     "",
+								     category,
+								     subModelStr,
+								     divIdx,
+								     maxGain,
+								     Dlambda));
+			};
+			break;
+		case CConst::R2AIP07CANAntennaType: {
+			int bandIdx = getBandIdx(antennaType, frequency);
+			if (bandIdx == -1) {
+				return (nullptr);
+			}
+			key = KeyType(antennaType, nullptr, 0, maxGain, 0.0, 0, bandIdx);
+			gainFn = [=](double angleDeg, std::string &subModelStr) {
+				subModelStr = "";
+				return (ULSClass::calcR2AIP07CANAntenna(angleDeg,
+									frequency,
+									"",
+									category,
+									subModelStr,
+									divIdx,
+									maxGain,
+									Dlambda));
+			};
+		} break;
+		case CConst::LUTAntennaType:
+			if (!antenna) {
+				return (nullptr);
+			}
+			key = KeyType(antennaType, antenna, 0, maxGain, 0.0, 0, 0);
+			gainFn = [antenna, maxGain](double angleDeg, std::string &subModelStr) {
+				subModelStr = "";
+				return (antenna->gainDB(angleDeg * M_PI / 180.0) + maxGain);
+			};
+			break;
+		default:
+			return (nullptr);
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	std::unique_ptr<RxGainTableClass> &table = tableMap[key];
+	if (!table) {
+		table.reset(new RxGainTableClass(gainFn, stepDeg, maxErrDB));
+		LOGGER_DEBUG(logger) << "Built RX gain table " << tableMap.size() << ": type "
+				     << antennaType << " gain " << maxGain << " cells "
+				     << table->getNumCells() << " from pattern "
+				     << table->getNumExactCells() << " max error (dB) "
+				     << table->getMaxErrDB();
+	}
+	return (table.get());
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: RxGainTableCacheClass::getNumTable()                                   ****/
+/******************************************************************************************/
+int RxGainTableCacheClass::getNumTable()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return ((int)tableMap.size());
+}
+/******************************************************************************************/
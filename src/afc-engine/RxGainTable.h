@@ -0,0 +1,133 @@
+/******************************************************************************************/
+/**** FILE : RxGainTable.h                                                             ****/
+/******************************************************************************************/
+
+#ifndef RX_GAIN_TABLE_H
+#define RX_GAIN_TABLE_H
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "cconst.h"
+
+class AntennaClass;
+
+/******************************************************************************************/
+/**** CLASS: RxGainTableClass                                                          ****/
+/**** Antenna gain vs angle off boresight on uniform grid over [0, 180] deg, linearly  ****/
+/**** interpolated. When built, pattern is evaluated at interior points of each cell,  ****/
+/**** cells where interpolation error exceeds maxErrDB (main lobe, discontinuities of  ****/
+/**** step patterns) or sub model changes are marked to be evaluated from pattern.     ****/
+/******************************************************************************************/
+class RxGainTableClass
+{
+	public:
+		typedef std::function<double(double angleOffBoresightDeg, std::string &subModelStr)>
+			GainFnType;
+
+		RxGainTableClass(const GainFnType &gainFn, double maxStepDeg, double maxErrDB);
+
+		// Interpolated gain (dB) and sub model at angle off boresight (deg). Returns false
+		// if angle is in a cell marked for evaluation from pattern or not in [0, 180]
+		bool lookup(double angleOffBoresightDeg,
+			    double &gainDB,
+			    std::string &subModelStr) const
+		{
+			double x = angleOffBoresightDeg * invStepDeg;
+			if (!(x >= 0.0) || (x > numCells)) {
+				return (false);
+			}
+			int cellIdx = std::min((int)x, numCells - 1);
+			unsigned char subModelIdx = cellSubModelList[cellIdx];
+			if (subModelIdx == exactCellIdx) {
+				return (false);
+			}
+			double t = x - cellIdx;
+			double g0 = gainList[cellIdx];
+			gainDB = g0 + t * (gainList[cellIdx + 1] - g0);
+			subModelStr = subModelStrList[subModelIdx];
+			return (true);
+		}
+
+		int getNumCells() const
+		{
+			return (numCells);
+		}
+		int getNumExactCells() const
+		{
+			return (numExactCells);
+		}
+		// Largest interpolation error (dB) found in cells that are interpolated
+		double getMaxErrDB() const
+		{
+			return (maxErrDB);
+		}
+
+	private:
+		static const unsigned char exactCellIdx = 0xFF;
+
+		double invStepDeg;
+		int numCells;
+		std::vector<float> gainList; // Gain (dB) at numCells+1 grid points
+		// Index in subModelStrList for each cell, exactCellIdx if evaluated from pattern
+		std::vector<unsigned char> cellSubModelList;
+		std::vector<std::string> subModelStrList;
+		int numExactCells;
+		double maxErrDB;
+};
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** CLASS: RxGainTableCacheClass                                                     ****/
+/**** FS/passive repeater antenna gain tables shared by all antennas of same pattern,  ****/
+/**** built on first request.                                                          ****/
+/******************************************************************************************/
+class RxGainTableCacheClass
+{
+	public:
+		RxGainTableCacheClass(double stepDegVal = 0.1, double maxErrDBVal = 0.01);
+
+		// Table of gain computed as ULSClass::computeRxGain() does for antenna of given
+		// type, nullptr if gain depends on more than angle off boresight (F.1336 omni)
+		// or frequency is invalid for pattern. antenna used for LUT type only, gain of LUT
+		// antenna is antenna->gainDB() + maxGain
+		const RxGainTableClass *getTable(CConst::ULSAntennaTypeEnum antennaType,
+						 AntennaClass *antenna,
+						 CConst::AntennaCategoryEnum category,
+						 double maxGain,
+						 double Dlambda,
+						 int divIdx,
+						 double frequency);
+
+		int getNumTable();
+
+		// Index of pattern variant selected by frequency: R2-AIP-07 CAN band, -1 if
+		// frequency is outside of CAN bands, 0 for other types
+		static int getBandIdx(CConst::ULSAntennaTypeEnum antennaType, double frequency)
+		{
+			if (antennaType != CConst::R2AIP07CANAntennaType) {
+				return (0);
+			} else if ((frequency >= 5925.0e6) && (frequency <= 6425.0e6)) {
+				return (0);
+			} else if ((frequency >= 6425.0e6) && (frequency <= 6930.0e6)) {
+				return (1);
+			}
+			return (-1);
+		}
+
+	private:
+		typedef std::tuple<int, AntennaClass *, int, double, double, int, int> KeyType;
+
+		double stepDeg;
+		double maxErrDB;
+		std::mutex mutex;
+		std::map<KeyType, std::unique_ptr<RxGainTableClass>> tableMap;
+};
+/******************************************************************************************/
+
+#endif
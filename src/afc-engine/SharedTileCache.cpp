@@ -0,0 +1,496 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+#include "SharedTileCache.h"
+#include <afclogging/Logging.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <chrono>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+	      "SharedTileCache requires lock-free 64-bit atomics for interprocess use");
+
+namespace
+{
+// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "SharedTileCache")
+
+/** Magic number in segment header */
+const uint64_t SEGMENT_MAGIC = 0x41464354494C4553ULL;
+
+/** Segment layout version. Should be changed on any layout change */
+const uint32_t SEGMENT_VERSION = 2;
+
+/** Alignment of slot data buffers */
+const size_t DATA_ALIGNMENT = 4096;
+
+/** Time to wait for other process to finish segment initialization */
+const int ATTACH_TIMEOUT_MS = 5000;
+
+/** Rounds value up to multiple of alignment */
+size_t alignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+/** Monotonic time in seconds (same clock for all processes on the node) */
+int64_t monotonicSec()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec;
+}
+
+/** Slot sequence number of writer that takes slot. Sequence number holds generation
+ * (odd while slot is being written) in lower 32 bits and, while slot is being
+ * written, write start time in upper 32 bits. Both change in one atomic operation,
+ * so competing writer never sees new odd generation with previous start time
+ * @param seq Current sequence number of slot
+ * @param now Monotonic time in seconds
+ * @return Sequence number to CAS slot to
+ */
+uint64_t makeWriteSeq(uint64_t seq, int64_t now)
+{
+	uint32_t gen = (uint32_t)seq;
+	gen += (gen & 1) ? 2 : 1;
+	return ((uint64_t)(uint32_t)now << 32) | gen;
+}
+
+/** Slot sequence number after write completes
+ * @param writeSeq Sequence number made by makeWriteSeq()
+ * @return Even nonzero sequence number (0 marks empty slot)
+ */
+uint64_t makeDoneSeq(uint64_t writeSeq)
+{
+	uint32_t gen = (uint32_t)writeSeq + 1;
+	return gen ? gen : 2;
+}
+
+/** True if slot is being written for too long (writer presumably crashed)
+ * @param seq Odd sequence number of slot
+ * @param now Monotonic time in seconds
+ */
+bool isStaleWrite(uint64_t seq, int64_t now)
+{
+	uint32_t elapsed = (uint32_t)now - (uint32_t)(seq >> 32);
+	return elapsed >= (uint32_t)SharedTileCache::STALE_WRITE_SEC;
+}
+
+/** FNV-1a hash of byte sequence
+ * @param data Data to hash
+ * @param len Data length
+ * @param seed Initial hash value
+ * @return Hash value
+ */
+uint64_t fnv1a(const void *data, size_t len, uint64_t seed)
+{
+	const unsigned char *p = static_cast<const unsigned char *>(data);
+	uint64_t ret = seed;
+	for (size_t i = 0; i < len; ++i) {
+		ret ^= p[i];
+		ret *= 0x100000001B3ULL;
+	}
+	return ret;
+}
+
+/** Final mixing of hash value (from MurmurHash3) */
+uint64_t mix64(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ULL;
+	h ^= h >> 33;
+	return h;
+}
+} // end namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// SharedTileCache::SegmentHeader
+///////////////////////////////////////////////////////////////////////////////
+
+struct SharedTileCache::SegmentHeader {
+		/** SEGMENT_MAGIC for initialized segment */
+		std::atomic<uint64_t> magic;
+
+		/** SEGMENT_VERSION */
+		uint32_t version;
+
+		/** Total number of slots (multiple of WAYS) */
+		uint32_t numSlots;
+
+		/** Size of slot data buffer */
+		uint64_t slotBytes;
+
+		/** Offset of first slot data buffer from segment start */
+		uint64_t dataOffset;
+
+		/** Access clock - source of slot access timestamps */
+		std::atomic<uint64_t> clock;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// SharedTileCache::SlotHeader
+///////////////////////////////////////////////////////////////////////////////
+
+struct alignas(64) SharedTileCache::SlotHeader {
+		/** Sequence number. 0 - empty, odd - being written (see makeWriteSeq()) */
+		std::atomic<uint64_t> seq;
+
+		/** Upper half of key */
+		std::atomic<uint64_t> keyHi;
+
+		/** Lower half of key */
+		std::atomic<uint64_t> keyLo;
+
+		/** Size of data in slot */
+		std::atomic<uint64_t> dataBytes;
+
+		/** Access clock value at last access */
+		std::atomic<uint64_t> lastUse;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// SharedTileCache
+///////////////////////////////////////////////////////////////////////////////
+
+SharedTileCache::SharedTileCache(const std::string &shmName,
+				 size_t segmentBytes,
+				 size_t slotBytes) :
+	_name(shmName),
+	_segment(nullptr),
+	_segmentBytes(0),
+	_header(nullptr),
+	_hits(0),
+	_misses(0),
+	_publishes(0)
+{
+	std::ostringstream errStr;
+	int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	bool created = fd >= 0;
+	if (!created) {
+		if (errno == EEXIST) {
+			fd = shm_open(_name.c_str(), O_RDWR, 0600);
+		}
+		if (fd < 0) {
+			errStr << "ERROR: SharedTileCache::SharedTileCache(): Can't open shared "
+				  "memory object '"
+			       << _name << "': " << strerror(errno);
+			throw std::runtime_error(errStr.str());
+		}
+	}
+	try {
+		if (created) {
+			createSegment(fd, segmentBytes, slotBytes);
+		} else {
+			attachSegment(fd);
+		}
+	} catch (...) {
+		close(fd);
+		if (created) {
+			shm_unlink(_name.c_str());
+		}
+		throw;
+	}
+	close(fd);
+	LOGGER_INFO(logger) << (created ? "Created" : "Attached to") << " shared tile cache '"
+			    << _name << "' of " << (_segmentBytes >> 20) << " MB: "
+			    << _header->numSlots << " slots of " << _header->slotBytes
+			    << " bytes";
+}
+
+SharedTileCache::~SharedTileCache()
+{
+	if (_segment) {
+		munmap(_segment, _segmentBytes);
+	}
+}
+
+void SharedTileCache::createSegment(int fd, size_t segmentBytes, size_t slotBytes)
+{
+	std::ostringstream errStr;
+	slotBytes = alignUp(slotBytes, DATA_ALIGNMENT);
+	size_t headersBytes = alignUp(sizeof(SegmentHeader), alignof(SlotHeader));
+	// Number of slots that fit into segment, rounded down to set size
+	size_t perSlot = sizeof(SlotHeader) + slotBytes;
+	uint32_t numSlots = (uint32_t)(segmentBytes / perSlot / WAYS * WAYS);
+	if (numSlots == 0) {
+		errStr << "ERROR: SharedTileCache::createSegment(): Segment size of "
+		       << segmentBytes << " bytes is too small to contain " << WAYS
+		       << " slots of " << slotBytes << " bytes";
+		throw std::runtime_error(errStr.str());
+	}
+	size_t dataOffset =
+		alignUp(headersBytes + numSlots * sizeof(SlotHeader), DATA_ALIGNMENT);
+	_segmentBytes = dataOffset + numSlots * slotBytes;
+	// Pages are allocated upfront: with merely truncated segment, first touch of page
+	// that does not fit into /dev/shm raises SIGBUS
+	int err = posix_fallocate(fd, 0, (off_t)_segmentBytes);
+	if (err != 0) {
+		errStr << "ERROR: SharedTileCache::createSegment(): Can't allocate "
+		       << _segmentBytes << " bytes for shared memory object '" << _name
+		       << "': " << strerror(err);
+		throw std::runtime_error(errStr.str());
+	}
+	void *p = mmap(nullptr, _segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED) {
+		errStr << "ERROR: SharedTileCache::createSegment(): Can't map shared memory "
+			  "object '"
+		       << _name << "': " << strerror(errno);
+		throw std::runtime_error(errStr.str());
+	}
+	_segment = static_cast<unsigned char *>(p);
+	// Freshly allocated segment is zero-filled, that makes all slots empty
+	_header = new (_segment) SegmentHeader;
+	_header->version = SEGMENT_VERSION;
+	_header->numSlots = numSlots;
+	_header->slotBytes = slotBytes;
+	_header->dataOffset = dataOffset;
+	_header->clock.store(1, std::memory_order_relaxed);
+	for (uint32_t slotIdx = 0; slotIdx < numSlots; ++slotIdx) {
+		new (slotHeader(slotIdx)) SlotHeader;
+	}
+	// Setting magic last tells other processes that segment is ready
+	_header->magic.store(SEGMENT_MAGIC, std::memory_order_release);
+}
+
+void SharedTileCache::attachSegment(int fd)
+{
+	std::ostringstream errStr;
+	auto deadline = std::chrono::steady_clock::now() +
+			std::chrono::milliseconds(ATTACH_TIMEOUT_MS);
+	// Creator might not yet have set segment size
+	struct stat st;
+	for (;;) {
+		if (fstat(fd, &st) != 0) {
+			errStr << "ERROR: SharedTileCache::attachSegment(): Can't stat shared "
+				  "memory object '"
+			       << _name << "': " << strerror(errno);
+			throw std::runtime_error(errStr.str());
+		}
+		// Segment writable by others might contain injected tiles
+		if ((st.st_uid != geteuid()) || (st.st_mode & (S_IRWXG | S_IRWXO))) {
+			errStr << "ERROR: SharedTileCache::attachSegment(): Shared memory "
+				  "object '"
+			       << _name << "' is not owned by current user or accessible by "
+			       << "others. Remove it to let it be recreated";
+			throw std::runtime_error(errStr.str());
+		}
+		if ((size_t)st.st_size >= sizeof(SegmentHeader)) {
+			break;
+		}
+		if (std::chrono::steady_clock::now() > deadline) {
+			errStr << "ERROR: SharedTileCache::attachSegment(): Shared memory "
+				  "object '"
+			       << _name << "' was not initialized in time";
+			throw std::runtime_error(errStr.str());
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	_segmentBytes = (size_t)st.st_size;
+	void *p = mmap(nullptr, _segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED) {
+		errStr << "ERROR: SharedTileCache::attachSegment(): Can't map shared memory "
+			  "object '"
+		       << _name << "': " << strerror(errno);
+		throw std::runtime_error(errStr.str());
+	}
+	_segment = static_cast<unsigned char *>(p);
+	_header = reinterpret_cast<SegmentHeader *>(_segment);
+	while (_header->magic.load(std::memory_order_acquire) != SEGMENT_MAGIC) {
+		if (std::chrono::steady_clock::now() > deadline) {
+			errStr << "ERROR: SharedTileCache::attachSegment(): Shared memory "
+				  "object '"
+			       << _name << "' was not initialized in time";
+			throw std::runtime_error(errStr.str());
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	if ((_header->version != SEGMENT_VERSION) ||
+	    ((_header->dataOffset + (size_t)_header->numSlots * _header->slotBytes) >
+	     _segmentBytes)) {
+		errStr << "ERROR: SharedTileCache::attachSegment(): Shared memory object '"
+		       << _name
+		       << "' has incompatible layout. Remove it to let it be recreated";
+		throw std::runtime_error(errStr.str());
+	}
+}
+
+const std::string &SharedTileCache::name() const
+{
+	return _name;
+}
+
+size_t SharedTileCache::slotBytes() const
+{
+	return _header->slotBytes;
+}
+
+SharedTileCache::SlotHeader *SharedTileCache::slotHeader(uint32_t slotIdx) const
+{
+	return reinterpret_cast<SlotHeader *>(
+		       _segment + alignUp(sizeof(SegmentHeader), alignof(SlotHeader))) +
+	       slotIdx;
+}
+
+unsigned char *SharedTileCache::slotData(uint32_t slotIdx) const
+{
+	return _segment + _header->dataOffset + (size_t)slotIdx * _header->slotBytes;
+}
+
+bool SharedTileCache::fetch(const Key &key, void *buf, size_t bytes)
+{
+	uint32_t firstSlot = (uint32_t)(key.lo % (_header->numSlots / WAYS)) * WAYS;
+	for (uint32_t slotIdx = firstSlot; slotIdx < (firstSlot + WAYS); ++slotIdx) {
+		SlotHeader *sh = slotHeader(slotIdx);
+		uint64_t seq = sh->seq.load(std::memory_order_acquire);
+		if ((seq == 0) || (seq & 1) ||
+		    (sh->keyHi.load(std::memory_order_relaxed) != key.hi) ||
+		    (sh->keyLo.load(std::memory_order_relaxed) != key.lo) ||
+		    (sh->dataBytes.load(std::memory_order_relaxed) != bytes)) {
+			continue;
+		}
+		memcpy(buf, slotData(slotIdx), bytes);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sh->seq.load(std::memory_order_relaxed) != seq) {
+			// Slot was overwritten while being copied
+			break;
+		}
+		sh->lastUse.store(_header->clock.fetch_add(1, std::memory_order_relaxed),
+				  std::memory_order_relaxed);
+		++_hits;
+		return true;
+	}
+	++_misses;
+	return false;
+}
+
+bool SharedTileCache::publish(const Key &key, const void *buf, size_t bytes)
+{
+	if (bytes > _header->slotBytes) {
+		return false;
+	}
+	uint32_t firstSlot = (uint32_t)(key.lo % (_header->numSlots / WAYS)) * WAYS;
+	int64_t now = monotonicSec();
+	// Looking for victim slot: empty, abandoned or least recently used
+	SlotHeader *victim = nullptr;
+	uint32_t victimIdx = 0;
+	uint64_t victimSeq = 0;
+	uint64_t victimLastUse = 0;
+	for (uint32_t slotIdx = firstSlot; slotIdx < (firstSlot + WAYS); ++slotIdx) {
+		SlotHeader *sh = slotHeader(slotIdx);
+		uint64_t seq = sh->seq.load(std::memory_order_acquire);
+		uint64_t lastUse;
+		if (seq == 0) {
+			lastUse = 0;
+		} else if (seq & 1) {
+			if (!isStaleWrite(seq, now)) {
+				continue;
+			}
+			lastUse = 0;
+		} else {
+			if ((sh->keyHi.load(std::memory_order_relaxed) == key.hi) &&
+			    (sh->keyLo.load(std::memory_order_relaxed) == key.lo)) {
+				// Other process published the same tile meanwhile
+				return false;
+			}
+			lastUse = sh->lastUse.load(std::memory_order_relaxed);
+		}
+		if ((!victim) || (lastUse < victimLastUse)) {
+			victim = sh;
+			victimIdx = slotIdx;
+			victimSeq = seq;
+			victimLastUse = lastUse;
+		}
+	}
+	if (!victim) {
+		return false;
+	}
+	// Taking the slot (abandoned slot is taken from its crashed writer). Write start
+	// time is part of sequence number, so slot is never seen taken but stale
+	uint64_t writeSeq = makeWriteSeq(victimSeq, now);
+	if (!victim->seq.compare_exchange_strong(victimSeq,
+						 writeSeq,
+						 std::memory_order_acq_rel)) {
+		return false;
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+	victim->keyHi.store(key.hi, std::memory_order_relaxed);
+	victim->keyLo.store(key.lo, std::memory_order_relaxed);
+	victim->dataBytes.store(bytes, std::memory_order_relaxed);
+	memcpy(slotData(victimIdx), buf, bytes);
+	victim->lastUse.store(_header->clock.fetch_add(1, std::memory_order_relaxed),
+			      std::memory_order_relaxed);
+	// Slot is only made valid if it was not reclaimed from this writer meanwhile
+	uint64_t expectedSeq = writeSeq;
+	if (!victim->seq.compare_exchange_strong(expectedSeq,
+						 makeDoneSeq(writeSeq),
+						 std::memory_order_release,
+						 std::memory_order_relaxed)) {
+		if (!(expectedSeq & 1)) {
+			// Writer that reclaimed slot completed while this one was still
+			// copying - slot content may be torn
+			victim->seq.compare_exchange_strong(expectedSeq,
+							    0,
+							    std::memory_order_release,
+							    std::memory_order_relaxed);
+		}
+		return false;
+	}
+	++_publishes;
+	return true;
+}
+
+long long SharedTileCache::hits() const
+{
+	return _hits;
+}
+
+long long SharedTileCache::misses() const
+{
+	return _misses;
+}
+
+long long SharedTileCache::publishes() const
+{
+	return _publishes;
+}
+
+SharedTileCache::Key SharedTileCache::makeKey(const std::string &fileName,
+					      int64_t fileMtimeNs,
+					      int64_t fileSize,
+					      int band,
+					      int latOffset,
+					      int lonOffset,
+					      int latSize,
+					      int lonSize,
+					      int pixelType)
+{
+	// Segment outlives processes, so file stamp is hashed to not serve tiles of
+	// replaced file
+	int64_t fileStamp[] = {fileMtimeNs, fileSize};
+	int32_t params[] = {band, latOffset, lonOffset, latSize, lonSize, pixelType};
+	uint64_t h1 = fnv1a(fileName.data(), fileName.size(), 0xCBF29CE484222325ULL);
+	h1 = fnv1a(fileStamp, sizeof(fileStamp), h1);
+	h1 = fnv1a(params, sizeof(params), h1);
+	uint64_t h2 = fnv1a(params, sizeof(params), 0x84222325CBF29CE4ULL);
+	h2 = fnv1a(fileStamp, sizeof(fileStamp), h2);
+	h2 = fnv1a(fileName.data(), fileName.size(), h2);
+	Key ret;
+	ret.hi = mix64(h1);
+	ret.lo = mix64(h2 ^ h1);
+	return ret;
+}
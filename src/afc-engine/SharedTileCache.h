@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+
+#ifndef SHARED_TILE_CACHE_H
+#define SHARED_TILE_CACHE_H
+
+#include <atomic>
+#include <boost/core/noncopyable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** @file
+ * Node-wide cache of decoded GDAL tiles, shared by all engine processes.
+ *
+ * Cache lives in POSIX shared memory segment (shm_open()), created by the
+ * first process that uses it and kept alive after process exit (so that
+ * subsequent requests on the same node benefit from tiles decoded by
+ * previous ones). Segment may be removed with 'rm /dev/shm/<name>' - next
+ * process will recreate it. Segment is only accessible by its owner, so all
+ * engine processes sharing it should run as the same user.
+ *
+ * Segment consists of header, array of slot headers and array of fixed-size
+ * slot data buffers. Slots are grouped into sets of WAYS slots, tile belongs
+ * to the set determined by its key hash (set-associative cache).
+ *
+ * Each slot is protected by sequence lock:
+ *	- Readers never block and never write anything but access timestamp. They
+ *		read the sequence number, copy the data, then reread the sequence
+ *		number. Odd sequence number (slot being written) or changed sequence
+ *		number (slot was overwritten while being copied) is a cache miss.
+ *	- Writers take slot by CAS-ing sequence number to odd value (that also
+ *		holds write start time), fill it and CAS sequence number to even
+ *		value. If slot can't be taken, tile is not published (it is no
+ *		harm - it is just a cache).
+ *	- Slot left in odd state by crashed writer is reclaimed after
+ *		STALE_WRITE_SEC seconds. Writer whose slot was reclaimed does not
+ *		make it valid.
+ *
+ * Eviction policy is least recently used within the set (access timestamps
+ * are taken from global counter in segment header).
+ *
+ * Usage:
+ *	SharedTileCache stc("/afc_tiles", 1024 * 1024 * 1024, 4000000);
+ *	SharedTileCache::Key key = SharedTileCache::makeKey(fileName, mtime, size, ...);
+ *	if (!stc.fetch(key, buf, bytes)) {
+ *		// ... read from GDAL into buf ...
+ *		stc.publish(key, buf, bytes);
+ *	}
+ */
+
+/** Tile cache in POSIX shared memory */
+class SharedTileCache : private boost::noncopyable
+{
+	public:
+		//////////////////////////////////////////////////
+		// SharedTileCache. Public class constants
+		//////////////////////////////////////////////////
+
+		/** Default size of shared memory segment in megabytes */
+		static const int DEFAULT_SEGMENT_MB = 2048;
+
+		/** Number of slots in set (cache associativity) */
+		static const int WAYS = 8;
+
+		/** Time in seconds after which slot, that is being written, is
+		 * considered abandoned by crashed writer
+		 */
+		static const int STALE_WRITE_SEC = 30;
+
+		//////////////////////////////////////////////////
+		// SharedTileCache. Public class types
+		//////////////////////////////////////////////////
+
+		/** Tile key (128-bit hash of tile whereabouts) */
+		struct Key {
+				/** Upper half of hash */
+				uint64_t hi;
+
+				/** Lower half of hash */
+				uint64_t lo;
+		};
+
+		//////////////////////////////////////////////////
+		// SharedTileCache. Public member functions
+		//////////////////////////////////////////////////
+
+		/** Constructor. Opens (creating if necessary) shared memory segment.
+		 * Throws std::runtime_error on failure.
+		 * @param shmName Shared memory object name (should start with '/')
+		 * @param segmentBytes Segment size. Only used if segment is created,
+		 *	otherwise size of existing segment is used
+		 * @param slotBytes Maximum size of tile data in bytes. Only used if
+		 *	segment is created, otherwise slot size of existing segment is used
+		 */
+		SharedTileCache(const std::string &shmName, size_t segmentBytes, size_t slotBytes);
+
+		/** Destructor - unmaps segment (but does not remove it) */
+		~SharedTileCache();
+
+		/** Shared memory object name */
+		const std::string &name() const;
+
+		/** Maximum size of tile data that may be cached */
+		size_t slotBytes() const;
+
+		/** Retrieves tile data from cache.
+		 * @param[in] key Tile key
+		 * @param[out] buf Buffer to copy tile data to
+		 * @param[in] bytes Expected tile data size
+		 * @return True if tile found and copied, false otherwise
+		 */
+		bool fetch(const Key &key, void *buf, size_t bytes);
+
+		/** Puts tile data to cache.
+		 * @param key Tile key
+		 * @param buf Tile data
+		 * @param bytes Tile data size
+		 * @return True if tile was published, false if it is too big or slot
+		 *	for it is busy
+		 */
+		bool publish(const Key &key, const void *buf, size_t bytes);
+
+		/** Number of successful fetches made by this process */
+		long long hits() const;
+
+		/** Number of unsuccessful fetches made by this process */
+		long long misses() const;
+
+		/** Number of tiles published by this process */
+		long long publishes() const;
+
+		//////////////////////////////////////////////////
+		// SharedTileCache. Public static methods
+		//////////////////////////////////////////////////
+
+		/** Makes key for tile.
+		 * @param fileName Full name of GDAL file
+		 * @param fileMtimeNs Modification time of GDAL file in nanoseconds
+		 * @param fileSize Size of GDAL file in bytes
+		 * @param band 1-based band index
+		 * @param latOffset Tile offset in latitude direction
+		 * @param lonOffset Tile offset in longitude direction
+		 * @param latSize Tile size in latitude direction
+		 * @param lonSize Tile size in longitude direction
+		 * @param pixelType Pixel type code
+		 * @return Tile key
+		 */
+		static Key makeKey(const std::string &fileName,
+				   int64_t fileMtimeNs,
+				   int64_t fileSize,
+				   int band,
+				   int latOffset,
+				   int lonOffset,
+				   int latSize,
+				   int lonSize,
+				   int pixelType);
+
+	private:
+		//////////////////////////////////////////////////
+		// SharedTileCache. Private class types
+		//////////////////////////////////////////////////
+
+		/** Segment header */
+		struct SegmentHeader;
+
+		/** Slot header */
+		struct SlotHeader;
+
+		//////////////////////////////////////////////////
+		// SharedTileCache. Private instance methods
+		//////////////////////////////////////////////////
+
+		/** Creates and initializes new segment
+		 * @param fd Descriptor of newly created shared memory object
+		 * @param segmentBytes Segment size
+		 * @param slotBytes Slot data size
+		 */
+		void createSegment(int fd, size_t segmentBytes, size_t slotBytes);
+
+		/** Maps segment, created (maybe still being created) by other process
+		 * @param fd Descriptor of shared memory object
+		 */
+		void attachSegment(int fd);
+
+		/** Header of slot with given index */
+		SlotHeader *slotHeader(uint32_t slotIdx) const;
+
+		/** Data buffer of slot with given index */
+		unsigned char *slotData(uint32_t slotIdx) const;
+
+		//////////////////////////////////////////////////
+		// SharedTileCache. Private instance data
+		//////////////////////////////////////////////////
+
+		/** Shared memory object name */
+		std::string _name;
+
+		/** Mapped segment */
+		unsigned char *_segment;
+
+		/** Mapped segment size */
+		size_t _segmentBytes;
+
+		/** Segment header (at the beginning of segment) */
+		SegmentHeader *_header;
+
+		/** Number of hits */
+		std::atomic_llong _hits;
+
+		/** Number of misses */
+		std::atomic_llong _misses;
+
+		/** Number of publishes */
+		std::atomic_llong _publishes;
+};
+
+#endif /* SHARED_TILE_CACHE_H */
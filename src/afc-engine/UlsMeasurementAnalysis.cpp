@@ -15,6 +15,7 @@
 #include "UlsMeasurementAnalysis.h"
 #include "gdal_priv.h"
 #include "cpl_conv.h" // for CPLMalloc()
+#include "afclogging/LoggingTiming.h"
 
 extern void point_to_point(double elev[],
 			   double tht_m,
@@ -368,17 +369,12 @@ double *computeElevationVector(const TerrainClass *terrain,
 	ret[1] = (tdist / (numpts - 1)) * 1000.0;
 
 	if (includeBldg) {
+		// Only building presence matters here, so building heights are not read
 		/*********************************************************************************************************/
 		// Compute numBldgPtTX so building at TX can be removed
 		/*********************************************************************************************************/
 		const QPointF &ptTX = latlons.at(0);
-		terrain->getTerrainHeight(ptTX.y(),
-					  ptTX.x(),
-					  terrainHeight,
-					  bldgHeight,
-					  lidarHeightResult,
-					  heightSource);
-		if (lidarHeightResult == MultibandRasterClass::BUILDING) {
+		if (terrain->isBuilding(ptTX.y(), ptTX.x())) {
 			bool found = false;
 			for (stepIdx = 1; (stepIdx < maxBldgStep) && (!found); stepIdx++) {
 				double ptIdxDbl = stepIdx * bldgDistRes / ret[1];
@@ -388,13 +384,7 @@ double *computeElevationVector(const TerrainClass *terrain,
 					     latlons.at(n1).x() * (ptIdxDbl - n0);
 				double pty = latlons.at(n0).y() * (n1 - ptIdxDbl) +
 					     latlons.at(n1).y() * (ptIdxDbl - n0);
-				terrain->getTerrainHeight(pty,
-							  ptx,
-							  terrainHeight,
-							  bldgHeight,
-							  lidarHeightResult,
-							  heightSource);
-				if (lidarHeightResult != MultibandRasterClass::BUILDING) {
+				if (!terrain->isBuilding(pty, ptx)) {
 					found = true;
 					numBldgPtTX = n1;
 				}
@@ -411,13 +401,7 @@ double *computeElevationVector(const TerrainClass *terrain,
 		// Compute numBldgPtRX so building at RX can be removed
 		/*********************************************************************************************************/
 		const QPointF &ptRX = latlons.at(numpts - 1);
-		terrain->getTerrainHeight(ptRX.y(),
-					  ptRX.x(),
-					  terrainHeight,
-					  bldgHeight,
-					  lidarHeightResult,
-					  heightSource);
-		if (lidarHeightResult == MultibandRasterClass::BUILDING) {
+		if (terrain->isBuilding(ptRX.y(), ptRX.x())) {
 			bool found = false;
 			for (stepIdx = 1; (stepIdx < maxBldgStep) && (!found); stepIdx++) {
 				double ptIdxDbl = (tdist * 1000 - stepIdx * bldgDistRes) / ret[1];
@@ -427,13 +411,7 @@ double *computeElevationVector(const TerrainClass *terrain,
 					     latlons.at(n1).x() * (ptIdxDbl - n0);
 				double pty = latlons.at(n0).y() * (n1 - ptIdxDbl) +
 					     latlons.at(n1).y() * (ptIdxDbl - n0);
-				terrain->getTerrainHeight(pty,
-							  ptx,
-							  terrainHeight,
-							  bldgHeight,
-							  lidarHeightResult,
-							  heightSource);
-				if (lidarHeightResult != MultibandRasterClass::BUILDING) {
+				if (!terrain->isBuilding(pty, ptx)) {
 					found = true;
 					numBldgPtRX = numpts - n1;
 				}
@@ -575,6 +553,7 @@ double runPointToPoint(const TerrainClass *terrain,
 		       char *prefix,
 		       double **heightProfilePtr)
 {
+	LOGGER_TIMED_SCOPE("pathLoss.ITM");
 	if (!(*heightProfilePtr)) {
 		*heightProfilePtr = computeElevationVector(terrain,
 							   includeBldg,
@@ -621,46 +600,6 @@ double runPointToPoint(const TerrainClass *terrain,
 	return rv;
 }
 
-bool isLOS(const TerrainClass *terrain,
-	   QPointF transLocLatLon,
-	   double transHt,
-	   QPointF receiveLocLatLon,
-	   double receiveHt,
-	   double lineOfSightDistanceKm,
-	   int numpts,
-	   double **heightProfilePtr,
-	   double *cdsmFracPtr)
-{
-	if (!(*heightProfilePtr)) {
-		*heightProfilePtr = computeElevationVector(terrain,
-							   true,
-							   true,
-							   transLocLatLon,
-							   receiveLocLatLon,
-							   numpts,
-							   cdsmFracPtr);
-	}
-
-	double txHeightAMSL = (*heightProfilePtr)[2] + transHt;
-	double rxHeightAMSL = (*heightProfilePtr)[2 + numpts - 1] + receiveHt;
-
-	int ptIdx;
-	bool losFlag = true;
-	for (ptIdx = 0; (ptIdx < numpts) && (losFlag); ++ptIdx) {
-		double ptHeight = (*heightProfilePtr)[2 + ptIdx];
-		double signalHeight = (txHeightAMSL * (numpts - 1 - ptIdx) + rxHeightAMSL * ptIdx) /
-				      (numpts - 1);
-
-		double clearance = signalHeight - ptHeight;
-
-		if (clearance < 0.0) {
-			losFlag = false;
-		}
-	}
-
-	return losFlag;
-}
-
 /******************************************************************************************/
 
 void dumpHeightProfile(const char *prefix, const double *heights)
@@ -49,16 +49,6 @@ double runPointToPoint(const TerrainClass *terrain,
 		       char *prefix,
 		       double **heightProfilePtr);
 
-bool isLOS(const TerrainClass *terrain,
-	   QPointF transLocLatLon,
-	   double transHt,
-	   QPointF receiveLocLatLon,
-	   double receiveHt,
-	   double lineOfSightDistanceKm,
-	   int numpts,
-	   double **heightProfilePtr,
-	   double *cdsmFracPtr);
-
 extern long long numInvalidSRTM;
 extern long long numSRTM;
 
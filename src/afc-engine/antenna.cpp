@@ -10,6 +10,10 @@
 #include <cstdlib>
 #include <cstdio>
 #include <stdexcept>
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <thread>
 
 #include "cconst.h"
 #include "antenna.h"
@@ -20,6 +24,7 @@
 #include "afclogging/Logging.h"
 #include "afclogging/ErrStream.h"
 #include "AfcDefinitions.h"
+#include "ratcommon/MappedCsvReader.h"
 
 // Logger for all instances of class
 LOGGER_DEFINE_GLOBAL(logger, "AntennaClass")
@@ -92,8 +97,6 @@ std::vector<AntennaClass *> AntennaClass::readMultipleBoresightAntennas(std::str
 {
 	int i, fieldIdx, antIdx;
 	double x_start, x_stop, u, xval, phase0, phaseRad;
-	char *chptr;
-	FILE *fp;
 	DblDblClass pt;
 	std::ostringstream errStr;
 
@@ -102,115 +105,126 @@ std::vector<AntennaClass *> AntennaClass::readMultipleBoresightAntennas(std::str
 					 << "ERROR: No multiple boresight antenna file specified");
 	}
 
-	if (!(fp = fopen(filename.c_str(), "rb"))) {
+	std::unique_ptr<MappedCsvReader> reader;
+	try {
+		reader.reset(new MappedCsvReader(filename));
+	} catch (const MappedCsvReader::FileError &) {
 		throw std::runtime_error(ErrStream() << "ERROR: Unable to open multiple boresight "
 							"antenna file \""
 						     << filename << "\"");
 	}
 
-	enum LineTypeEnum { labelLineType, dataLineType, ignoreLineType, unknownLineType };
-
-	LineTypeEnum lineType;
-
 	LOGGER_INFO(logger) << "Reading multiple boresight antenna file: " << filename;
 
-	int linenum = 0;
-	bool foundLabelLine = false;
+	/**************************************************************************/
+	/**** Parse chunks of file in parallel. First significant (not blank,  ****/
+	/**** not comment) line of chunk is kept as text (it may be label      ****/
+	/**** line), all significant lines are converted to numbers            ****/
+	/**************************************************************************/
+	struct ChunkRows {
+			bool hasFirst = false;
+			int firstLinenum = 0;
+			std::vector<std::string> firstRow;
+			std::vector<double> values;
+			std::vector<size_t> rowEnds;
+	};
+	const size_t fileSize = reader->whole().end - reader->whole().begin;
+	const int numChunks = std::max(1,
+				       std::min((int)std::thread::hardware_concurrency(),
+						(int)(fileSize >> 20) + 1));
+	const std::vector<MappedCsvReader::Chunk> chunks = reader->split(numChunks);
+	std::vector<ChunkRows> chunkRowsList(chunks.size());
+	std::vector<std::future<void>> futures;
+	for (size_t chunkIdx = 0; chunkIdx < chunks.size(); ++chunkIdx) {
+		futures.push_back(std::async(std::launch::async, [&, chunkIdx]() {
+			ChunkRows &chunkRows = chunkRowsList[chunkIdx];
+			MappedCsvReader::Cursor cursor(*reader, chunks[chunkIdx]);
+			std::vector<MappedCsvReader::Field> fieldList;
+			while (cursor.readRow(fieldList)) {
+				if (fieldList.empty() ||
+				    ((fieldList.size() == 1) && fieldList[0].empty()) ||
+				    ((!fieldList[0].empty()) && (fieldList[0][0] == '#'))) {
+					continue;
+				}
+				if (!chunkRows.hasFirst) {
+					chunkRows.hasFirst = true;
+					chunkRows.firstLinenum = reader->lineNumberOf(
+						cursor.rowStart());
+					for (const auto &field : fieldList) {
+						chunkRows.firstRow.push_back(
+							MappedCsvReader::toString(field));
+					}
+				}
+				for (const auto &field : fieldList) {
+					double value;
+					chunkRows.values.push_back(
+						MappedCsvReader::toDouble(field, value) ? value :
+											  0.0);
+				}
+				chunkRows.rowEnds.push_back(chunkRows.values.size());
+			}
+		}));
+	}
+	for (auto &future : futures) {
+		future.get();
+	}
 
 	std::vector<AntennaClass *> antennaList;
 
 	std::vector<ListClass<DblDblClass> *> lutGainList;
 
-	std::string line;
-
-	while (fgetline(fp, line, false)) {
-		linenum++;
-		std::vector<std::string> fieldList = splitCSV(line);
-
-		lineType = unknownLineType;
-		/**************************************************************************/
-		/**** Determine line type                                              ****/
-		/**************************************************************************/
-		if (fieldList.size() == 0) {
-			lineType = ignoreLineType;
-		} else {
-			int fIdx = fieldList[0].find_first_not_of(' ');
-			if (fIdx == (int)std::string::npos) {
-				if (fieldList.size() == 1) {
-					lineType = ignoreLineType;
-				}
-			} else {
-				if (fieldList[0].at(fIdx) == '#') {
-					lineType = ignoreLineType;
+	bool foundLabelLine = false;
+	for (const auto &chunkRows : chunkRowsList) {
+		size_t rowIdx = 0;
+		if (chunkRows.hasFirst && !foundLabelLine) {
+			/******************************************************************/
+			/**** Label line                                               ****/
+			/******************************************************************/
+			foundLabelLine = true;
+			rowIdx = 1;
+			for (fieldIdx = 0; fieldIdx < (int)chunkRows.firstRow.size(); fieldIdx++) {
+				const std::string &field = chunkRows.firstRow.at(fieldIdx);
+				if (fieldIdx == 0) {
+					if (field != "Off-axis angle (deg)") {
+						throw std::runtime_error(
+							ErrStream()
+							<< "ERROR: Invalid antenna data file \""
+							<< filename << "(" << chunkRows.firstLinenum
+							<< ")\" invalid \"Off-axis angle (deg)\" "
+							   "label = "
+							<< field);
+					}
+				} else {
+					ListClass<DblDblClass> *lutGain =
+						new ListClass<DblDblClass>(0);
+					lutGainList.push_back(lutGain);
+					AntennaClass *antenna =
+						new AntennaClass(CConst::antennaLUT_Boresight,
+								 field.c_str());
+					antennaList.push_back(antenna);
 				}
 			}
 		}
-
-		if ((lineType == unknownLineType) && (!foundLabelLine)) {
-			lineType = labelLineType;
-			foundLabelLine = 1;
-		}
-		if ((lineType == unknownLineType) && (foundLabelLine)) {
-			lineType = dataLineType;
-		}
-		/**************************************************************************/
-
-		/**************************************************************************/
-		/**** Process Line                                                     ****/
-		/**************************************************************************/
-		std::string field;
-		switch (lineType) {
-			case labelLineType:
-				for (fieldIdx = 0; fieldIdx < (int)fieldList.size(); fieldIdx++) {
-					field = fieldList.at(fieldIdx);
-					if (fieldIdx == 0) {
-						if (field != "Off-axis angle (deg)") {
-							throw std::runtime_error(
-								ErrStream()
-								<< "ERROR: Invalid antenna data "
-								   "file \""
-								<< filename << "(" << linenum
-								<< ")\" invalid \"Off-axis angle "
-								   "(deg)\" label = "
-								<< field);
-						}
-					} else {
-						ListClass<DblDblClass> *lutGain =
-							new ListClass<DblDblClass>(0);
-						lutGainList.push_back(lutGain);
-						AntennaClass *antenna = new AntennaClass(
-							CConst::antennaLUT_Boresight,
-							field.c_str());
-						antennaList.push_back(antenna);
-					}
-				}
-				break;
-			case dataLineType:
-				phaseRad = strtod(fieldList.at(0).c_str(), &chptr) * M_PI / 180;
-				for (fieldIdx = 1; fieldIdx < (int)fieldList.size(); fieldIdx++) {
-					field = fieldList.at(fieldIdx);
-					double gainVal = strtod(fieldList.at(fieldIdx).c_str(),
-								&chptr);
-					lutGainList[fieldIdx - 1]->append(
-						DblDblClass(phaseRad, gainVal));
-				}
-				break;
-
-			case ignoreLineType:
-			case unknownLineType:
-				// do nothing
-				break;
-			default:
-				throw std::runtime_error(
-					ErrStream() << "ERROR reading Antenna File: lineType = "
-						    << lineType << " INVALID value");
-				break;
+		/**********************************************************************/
+		/**** Data lines                                                   ****/
+		/**********************************************************************/
+		for (; rowIdx < chunkRows.rowEnds.size(); ++rowIdx) {
+			size_t rowBegin = rowIdx ? chunkRows.rowEnds[rowIdx - 1] : 0;
+			size_t rowEnd = chunkRows.rowEnds[rowIdx];
+			if (rowEnd - rowBegin - 1 > lutGainList.size()) {
+				throw std::runtime_error(ErrStream()
+							 << "ERROR: Invalid antenna data file \""
+							 << filename << "\": data line has more "
+							 << "fields than label line");
+			}
+			phaseRad = chunkRows.values[rowBegin] * M_PI / 180;
+			for (size_t k = rowBegin + 1; k < rowEnd; ++k) {
+				lutGainList[k - rowBegin - 1]->append(
+					DblDblClass(phaseRad, chunkRows.values[k]));
+			}
 		}
 	}
-
-	if (fp) {
-		fclose(fp);
-	}
+	reader.reset();
 
 	for (antIdx = 0; antIdx < static_cast<int>(lutGainList.size()); antIdx++) {
 		SplineClass *spline = new SplineClass(lutGainList[antIdx]);
@@ -0,0 +1,966 @@
+/******************************************************************************************/
+/**** FILE: BaselinePathLoss.cpp                                                       ****/
+/******************************************************************************************/
+
+#include <cmath>
+#include <stdexcept>
+#include <armadillo>
+#include "BaselinePathLoss.h"
+#include "AfcDefinitions.h"
+#include "global_defines.h"
+#include "afclogging/ErrStream.h"
+#include "afclogging/LoggingTiming.h"
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::BaselinePathLossClass()                         ****/
+/******************************************************************************************/
+BaselinePathLossClass::BaselinePathLossClass()
+{
+	closeInDist = 1.0e3;
+	closeInHgtFlag = true;
+	closeInHgtLOS = quietNaN;
+	winner2LOSOption = CConst::UnknownLOSOption;
+	winner2UnknownLOSMethod = CConst::PLOSCombineWinner2UnknownLOSMethod;
+	winner2ProbLOSThr = quietNaN;
+	rlanITMTxClutterMethod = CConst::ForceTrueITMClutterMethod;
+	applyClutterFSRxFlag = false;
+	maxFsAglHeight = quietNaN;
+	allowRuralFSClutterFlag = false;
+	pathLossClampFSPL = false;
+
+	zclutter2108 = 0.0;
+	fsZclutter2108 = 0.0;
+	zwinner2LOS = 0.0;
+	zwinner2NLOS = 0.0;
+	zwinner2Combined = 0.0;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::q()                                             ****/
+/**** Gaussian Q() function                                                            ****/
+/******************************************************************************************/
+double BaselinePathLossClass::q(double Z) const
+{
+	static const double sqrt2 = sqrt(2.0);
+
+	return (0.5 * erfc(Z / sqrt2));
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::computePathLoss()                               ****/
+/******************************************************************************************/
+void BaselinePathLossClass::computePathLoss(CConst::PathLossModelEnum pathLossModel,
+					    bool itmFSPLFlag,
+					    CConst::PropEnvEnum propEnv,
+					    CConst::PropEnvEnum propEnvRx,
+					    CConst::NLCDLandCatEnum nlcdLandCatTx,
+					    CConst::NLCDLandCatEnum nlcdLandCatRx,
+					    double distKm,
+					    double fsplDistKm,
+					    double win2DistKm,
+					    double frequency,
+					    double txHeightM,
+					    double elevationAngleTxDeg,
+					    double rxHeightM,
+					    double elevationAngleRxDeg,
+					    double &pathLoss,
+					    double &pathClutterTxDB,
+					    double &pathClutterRxDB,
+					    std::string &pathLossModelStr,
+					    double &pathLossCDF,
+					    std::string &pathClutterTxModelStr,
+					    double &pathClutterTxCDF,
+					    std::string &pathClutterRxModelStr,
+					    double &pathClutterRxCDF,
+					    std::string *txClutterStrPtr,
+					    std::string *rxClutterStrPtr) const
+{
+	LOGGER_TIMED_SCOPE("pathLoss");
+	double frequencyGHz = frequency * 1.0e-9;
+
+	if (txClutterStrPtr) {
+		*txClutterStrPtr = "";
+	}
+
+	if (rxClutterStrPtr) {
+		*rxClutterStrPtr = "";
+	}
+
+	pathLossModelStr = "";
+	pathClutterTxModelStr = "";
+	pathClutterTxCDF = -1.0;
+	pathClutterRxModelStr = "";
+	pathClutterRxCDF = -1.0;
+
+	if ((pathLossModel != CConst::FCC6GHzReportAndOrderPathLossModel) || (!itmFSPLFlag)) {
+		throw std::runtime_error(ErrStream()
+					 << "ERROR: BaselinePathLossClass: pathLossModel = "
+					 << pathLossModel << " itmFSPLFlag = " << itmFSPLFlag
+					 << " not supported");
+	}
+
+	// Path Loss Model used in FCC Report and Order
+
+	if (fsplDistKm * 1000 < 30.0) {
+		pathLoss = 20.0 * log((4 * M_PI * frequency * fsplDistKm * 1000) / CConst::c) /
+			   log(10.0);
+		pathLossModelStr = "FSPL";
+		pathLossCDF = 0.5;
+
+		pathClutterTxDB = 0.0;
+		pathClutterTxModelStr = "NONE";
+		pathClutterTxCDF = 0.5;
+	} else if (win2DistKm * 1000 < closeInDist) {
+		int winner2LOSValue = 0; // 1: Force LOS, 2: Force NLOS, 0: Compute probLOS,
+					 // then select or combine.
+		if (win2DistKm * 1000 <= 50.0) {
+			winner2LOSValue = 1;
+		} else if (winner2LOSOption == CConst::ForceLOSLOSOption) {
+			winner2LOSValue = 1;
+		} else if (winner2LOSOption == CConst::ForceNLOSLOSOption) {
+			winner2LOSValue = 2;
+		} else if (winner2LOSOption != CConst::UnknownLOSOption) {
+			throw std::runtime_error(
+				ErrStream() << "ERROR: BaselinePathLossClass: winner2LOSOption = "
+					    << winner2LOSOption << " not supported");
+		}
+
+		double sigma, probLOS;
+		if (propEnv == CConst::urbanPropEnv) {
+			// Winner2 C2: urban
+			pathLoss = Winner2_C2urban(1000 * win2DistKm,
+						   rxHeightM,
+						   txHeightM,
+						   frequency,
+						   sigma,
+						   pathLossModelStr,
+						   pathLossCDF,
+						   probLOS,
+						   winner2LOSValue);
+		} else if (propEnv == CConst::suburbanPropEnv) {
+			// Winner2 C1: suburban
+			pathLoss = Winner2_C1suburban(1000 * win2DistKm,
+						      rxHeightM,
+						      txHeightM,
+						      frequency,
+						      sigma,
+						      pathLossModelStr,
+						      pathLossCDF,
+						      probLOS,
+						      winner2LOSValue);
+		} else if ((propEnv == CConst::ruralPropEnv) ||
+			   (propEnv == CConst::barrenPropEnv)) {
+			// Winner2 D1: rural
+			pathLoss = Winner2_D1rural(1000 * win2DistKm,
+						   rxHeightM,
+						   txHeightM,
+						   frequency,
+						   sigma,
+						   pathLossModelStr,
+						   pathLossCDF,
+						   probLOS,
+						   winner2LOSValue);
+		} else {
+			throw std::runtime_error(ErrStream() << "ERROR: propEnv = " << propEnv
+							     << " INVALID value");
+		}
+		pathClutterTxModelStr = "NONE";
+		pathClutterTxDB = 0.0;
+		pathClutterTxCDF = 0.5;
+	} else {
+		bool rlanHasClutter;
+		switch (rlanITMTxClutterMethod) {
+			case CConst::ForceTrueITMClutterMethod:
+				rlanHasClutter = true;
+				break;
+			case CConst::ForceFalseITMClutterMethod:
+				rlanHasClutter = false;
+				break;
+			default:
+				throw std::runtime_error(
+					ErrStream()
+					<< "ERROR: BaselinePathLossClass: rlanITMTxClutterMethod = "
+					<< rlanITMTxClutterMethod << " not supported");
+				break;
+		}
+
+		pathLoss = 20.0 * log((4 * M_PI * frequency * fsplDistKm * 1000) / CConst::c) /
+			   log(10.0);
+		pathLossModelStr = "FSPL";
+		pathLossCDF = 0.5;
+
+		if ((propEnv == CConst::urbanPropEnv) || (propEnv == CConst::suburbanPropEnv)) {
+			if (rlanHasClutter) {
+				LOGGER_TIMED_SCOPE("pathLoss.P2108");
+				// ITU-R P.[CLUTTER] sec 3.2
+				double Ll = 23.5 + 9.6 * log(frequencyGHz) / log(10.0);
+				double Ls = 32.98 + 23.9 * log(distKm) / log(10.0) +
+					    3.0 * log(frequencyGHz) / log(10.0);
+
+				arma::vec gauss(1);
+				gauss[0] = zclutter2108;
+
+				double Lctt = -5.0 *
+						      log(exp(-0.2 * Ll * log(10.0)) +
+							  exp(-0.2 * Ls * log(10.0))) /
+						      log(10.0) +
+					      6.0 * gauss[0];
+
+				pathClutterTxDB = Lctt;
+				pathClutterTxModelStr = "P.2108";
+				pathClutterTxCDF = q(-gauss[0]);
+			} else {
+				pathClutterTxModelStr = "NONE";
+				pathClutterTxDB = 0.0;
+				pathClutterTxCDF = 0.5;
+			}
+		} else if ((propEnv == CConst::ruralPropEnv) ||
+			   (propEnv == CConst::barrenPropEnv)) {
+			if ((rlanHasClutter) && (nlcdLandCatTx == CConst::noClutterNLCDLandCat)) {
+				rlanHasClutter = false;
+			}
+
+			if (rlanHasClutter) {
+				double ha, dk;
+				switch (nlcdLandCatTx) {
+					case CConst::deciduousTreesNLCDLandCat:
+						ha = 15.0;
+						dk = 0.05;
+						if (txClutterStrPtr) {
+							*txClutterStrPtr = "DECIDUOUS_TREES";
+						}
+						break;
+					case CConst::coniferousTreesNLCDLandCat:
+						ha = 20.0;
+						dk = 0.05;
+						if (txClutterStrPtr) {
+							*txClutterStrPtr = "CONIFEROUS_TREES";
+						}
+						break;
+					case CConst::highCropFieldsNLCDLandCat:
+						ha = 4.0;
+						dk = 0.1;
+						if (txClutterStrPtr) {
+							*txClutterStrPtr = "HIGH_CROP_FIELDS";
+						}
+						break;
+					case CConst::villageCenterNLCDLandCat:
+					case CConst::unknownNLCDLandCat:
+						ha = 5.0;
+						dk = 0.07;
+						if (txClutterStrPtr) {
+							*txClutterStrPtr = "VILLAGE_CENTER";
+						}
+						break;
+					case CConst::tropicalRainForestNLCDLandCat:
+						ha = 20.0;
+						dk = 0.03;
+						if (txClutterStrPtr) {
+							*txClutterStrPtr = "TROPICAL_RAIN_FOREST";
+						}
+						break;
+					default:
+						ha = quietNaN;
+						dk = quietNaN;
+						CORE_DUMP;
+						break;
+				}
+
+				if (distKm < 10 * dk) {
+					pathClutterTxDB = 0.0;
+				} else {
+					double elevationAngleThresholdDeg =
+						std::atan((ha - txHeightM) / (dk * 1000.0)) *
+						180.0 / M_PI;
+					if (elevationAngleTxDeg > elevationAngleThresholdDeg) {
+						pathClutterTxDB = 0.0;
+					} else {
+						const double Ffc =
+							0.25 +
+							0.375 * (1 + std::tanh(7.5 * (frequencyGHz -
+										      0.5)));
+						double result = 10.25 * Ffc * exp(-1 * dk);
+						result *= 1 -
+							  std::tanh(6 * (txHeightM / ha - 0.625));
+						result -= 0.33;
+						pathClutterTxDB = result;
+					}
+				}
+
+				pathClutterTxModelStr = "452_NLCD";
+				pathClutterTxCDF = 0.5;
+			} else {
+				pathClutterTxModelStr = "NONE";
+				pathClutterTxDB = 0.0;
+				pathClutterTxCDF = 0.5;
+			}
+		} else {
+			CORE_DUMP;
+		}
+	}
+
+	if (applyClutterFSRxFlag && (rxHeightM <= maxFsAglHeight) && (distKm >= 1.0)) {
+		if (distKm * 1000 < closeInDist) {
+			pathClutterRxDB = 0.0;
+			pathClutterRxModelStr = "NONE";
+			pathClutterRxCDF = 0.5;
+		} else if ((propEnvRx == CConst::urbanPropEnv) ||
+			   (propEnvRx == CConst::suburbanPropEnv)) {
+			LOGGER_TIMED_SCOPE("pathLoss.P2108");
+			// ITU-R P.[CLUTTER] sec 3.2
+			double Ll = 23.5 + 9.6 * log(frequencyGHz) / log(10.0);
+			double Ls = 32.98 + 23.9 * log(distKm) / log(10.0) +
+				    3.0 * log(frequencyGHz) / log(10.0);
+
+			arma::vec gauss(1);
+			gauss[0] = fsZclutter2108;
+
+			double Lctt = -5.0 *
+					      log(exp(-0.2 * Ll * log(10.0)) +
+						  exp(-0.2 * Ls * log(10.0))) /
+					      log(10.0) +
+				      6.0 * gauss[0];
+
+			pathClutterRxDB = Lctt;
+			pathClutterRxModelStr = "P.2108";
+			pathClutterRxCDF = q(-gauss[0]);
+		} else if ((propEnvRx == CConst::ruralPropEnv) ||
+			   (propEnvRx == CConst::barrenPropEnv)) {
+			bool clutterFlag = allowRuralFSClutterFlag &&
+					   (nlcdLandCatRx == CConst::noClutterNLCDLandCat ? false :
+											    true);
+
+			if (clutterFlag) {
+				double ha, dk;
+				switch (nlcdLandCatRx) {
+					case CConst::deciduousTreesNLCDLandCat:
+						ha = 15.0;
+						dk = 0.05;
+						if (rxClutterStrPtr) {
+							*rxClutterStrPtr = "DECIDUOUS_TREES";
+						}
+						break;
+					case CConst::coniferousTreesNLCDLandCat:
+						ha = 20.0;
+						dk = 0.05;
+						if (rxClutterStrPtr) {
+							*rxClutterStrPtr = "CONIFEROUS_TREES";
+						}
+						break;
+					case CConst::highCropFieldsNLCDLandCat:
+						ha = 4.0;
+						dk = 0.1;
+						if (rxClutterStrPtr) {
+							*rxClutterStrPtr = "HIGH_CROP_FIELDS";
+						}
+						break;
+					case CConst::villageCenterNLCDLandCat:
+					case CConst::unknownNLCDLandCat:
+						ha = 5.0;
+						dk = 0.07;
+						if (rxClutterStrPtr) {
+							*rxClutterStrPtr = "VILLAGE_CENTER";
+						}
+						break;
+					default:
+						ha = quietNaN;
+						dk = quietNaN;
+						CORE_DUMP;
+						break;
+				}
+
+				if (distKm < 10 * dk) {
+					pathClutterRxDB = 0.0;
+				} else {
+					double elevationAngleThresholdDeg =
+						std::atan((ha - rxHeightM) / (dk * 1000.0)) *
+						180.0 / M_PI;
+					if (elevationAngleRxDeg > elevationAngleThresholdDeg) {
+						pathClutterRxDB = 0.0;
+					} else {
+						const double Ffc =
+							0.25 +
+							0.375 * (1 + std::tanh(7.5 * (frequencyGHz -
+										      0.5)));
+						double result = 10.25 * Ffc * exp(-1 * dk);
+						result *= 1 -
+							  std::tanh(6 * (rxHeightM / ha - 0.625));
+						result -= 0.33;
+						pathClutterRxDB = result;
+					}
+				}
+
+				pathClutterRxModelStr = "452_NLCD";
+				pathClutterRxCDF = 0.5;
+			} else {
+				pathClutterRxDB = 0.0;
+				pathClutterRxModelStr = "NONE";
+				pathClutterRxCDF = 0.5;
+			}
+		} else {
+			throw std::runtime_error(ErrStream()
+						 << "ERROR: Invalid morphology, propEnvRx = "
+						 << propEnvRx);
+		}
+	} else {
+		pathClutterRxDB = 0.0;
+		pathClutterRxModelStr = "NONE";
+		pathClutterRxCDF = 0.5;
+	}
+
+	if (pathLossClampFSPL) {
+		double fspl = 20.0 * log((4 * M_PI * frequency * fsplDistKm * 1000) / CConst::c) /
+			      log(10.0);
+		if (pathLoss < fspl) {
+			pathLossModelStr += "_" + std::to_string(pathLoss) + "_CLAMPFSPL";
+			pathLoss = fspl;
+		}
+	}
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_C1suburban_LOS                          ****/
+/**** Winner II: C1, suburban LOS                                                      ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_C1suburban_LOS(double distance,
+						     double hBS,
+						     double hMS,
+						     double frequency,
+						     double zval,
+						     double &sigma,
+						     double &pathLossCDF) const
+{
+	double retval;
+
+	double dBP = 4 * hBS * hMS * frequency / CConst::c;
+
+	if (distance < 30.0) {
+		// FSPL
+		sigma = 0.0;
+		retval = -(20.0 * log10(CConst::c / (4 * M_PI * frequency * distance)));
+	} else if (distance < dBP) {
+		sigma = 4.0;
+		retval = 23.8 * log10(distance) + 41.2 + 20 * log10(frequency * 1.0e-9 / 5);
+	} else {
+		sigma = 6.0;
+		retval = 40.0 * log10(distance) + 11.65 - 16.2 * log10(hBS) - 16.2 * log10(hMS) +
+			 3.8 * log10(frequency * 1.0e-9 / 5);
+	}
+
+	arma::vec gauss(1);
+	gauss[0] = zval;
+
+	retval += sigma * (gauss[0]);
+	pathLossCDF = q(-gauss[0]);
+
+	return (retval);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_C1suburban_NLOS                         ****/
+/**** Winner II: C1, suburban NLOS                                                     ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_C1suburban_NLOS(double distance,
+						      double hBS,
+						      double /* hMS */,
+						      double frequency,
+						      double zval,
+						      double &sigma,
+						      double &pathLossCDF) const
+{
+	double retval;
+
+	sigma = 8.0;
+	retval = (44.9 - 6.55 * log10(hBS)) * log10(distance) + 31.46 + 5.83 * log10(hBS) +
+		 23.0 * log10(frequency * 1.0e-9 / 5);
+
+	arma::vec gauss(1);
+	gauss[0] = zval;
+
+	retval += sigma * (gauss[0]);
+	pathLossCDF = q(-gauss[0]);
+
+	return (retval);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_C1suburban                              ****/
+/**** Winner II: C1, suburban                                                          ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_C1suburban(double distance,
+						 double hBS,
+						 double hMS,
+						 double frequency,
+						 double &sigma,
+						 std::string &pathLossModelStr,
+						 double &pathLossCDF,
+						 double &probLOS,
+						 int losValue) const
+{
+	LOGGER_TIMED_SCOPE("pathLoss.Winner2");
+	double retval = quietNaN;
+
+	if ((losValue == 0) && (closeInHgtFlag) && (hMS > closeInHgtLOS)) {
+		losValue = 1;
+		probLOS = 1.0;
+	} else {
+		probLOS = exp(-distance / 200);
+	}
+
+	if (losValue == 0) {
+		if (winner2UnknownLOSMethod == CConst::PLOSCombineWinner2UnknownLOSMethod) {
+			double sigmaLOS, sigmaNLOS;
+			double plLOS = Winner2_C1suburban_LOS(distance,
+							      hBS,
+							      hMS,
+							      frequency,
+							      0.0,
+							      sigmaLOS,
+							      pathLossCDF);
+			double plNLOS = Winner2_C1suburban_NLOS(distance,
+								hBS,
+								hMS,
+								frequency,
+								0.0,
+								sigmaNLOS,
+								pathLossCDF);
+			retval = probLOS * plLOS + (1.0 - probLOS) * plNLOS;
+			sigma = sqrt(probLOS * probLOS * sigmaLOS * sigmaLOS +
+				     (1.0 - probLOS) * (1.0 - probLOS) * sigmaNLOS * sigmaNLOS);
+
+			arma::vec gauss(1);
+			gauss[0] = zwinner2Combined;
+
+			retval += sigma * gauss[0];
+			pathLossCDF = q(-(gauss[0]));
+
+			pathLossModelStr = "W2C1_SUBURBAN_COMB";
+		} else if (winner2UnknownLOSMethod ==
+			   CConst::PLOSThresholdWinner2UnknownLOSMethod) {
+			if (probLOS > winner2ProbLOSThr) {
+				retval = Winner2_C1suburban_LOS(distance,
+								hBS,
+								hMS,
+								frequency,
+								zwinner2LOS,
+								sigma,
+								pathLossCDF);
+				pathLossModelStr = "W2C1_SUBURBAN_LOS";
+			} else {
+				retval = Winner2_C1suburban_NLOS(distance,
+								 hBS,
+								 hMS,
+								 frequency,
+								 zwinner2NLOS,
+								 sigma,
+								 pathLossCDF);
+				pathLossModelStr = "W2C1_SUBURBAN_NLOS";
+			}
+		} else {
+			CORE_DUMP;
+		}
+	} else if (losValue == 1) {
+		retval = Winner2_C1suburban_LOS(distance,
+						hBS,
+						hMS,
+						frequency,
+						zwinner2LOS,
+						sigma,
+						pathLossCDF);
+		pathLossModelStr = "W2C1_SUBURBAN_LOS";
+	} else if (losValue == 2) {
+		retval = Winner2_C1suburban_NLOS(distance,
+						 hBS,
+						 hMS,
+						 frequency,
+						 zwinner2NLOS,
+						 sigma,
+						 pathLossCDF);
+		pathLossModelStr = "W2C1_SUBURBAN_NLOS";
+	} else {
+		CORE_DUMP;
+	}
+
+	return (retval);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_C2urban_LOS                             ****/
+/**** Winner II: C2, urban LOS                                                         ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_C2urban_LOS(double distance,
+						  double hBS,
+						  double hMS,
+						  double frequency,
+						  double zval,
+						  double &sigma,
+						  double &pathLossCDF) const
+{
+	double retval;
+
+	double dBP = 4 * (hBS - 1.0) * (hMS - 1.0) * frequency / CConst::c;
+
+	if (distance < 10.0) {
+		// FSPL
+		sigma = 0.0;
+		retval = -(20.0 * log10(CConst::c / (4 * M_PI * frequency * distance)));
+	} else if (distance < dBP) {
+		sigma = 4.0;
+		retval = 26.0 * log10(distance) + 39.0 + 20 * log10(frequency * 1.0e-9 / 5);
+	} else {
+		sigma = 6.0;
+		retval = 40.0 * log10(distance) + 13.47 - 14.0 * log10(hBS - 1) -
+			 14.0 * log10(hMS - 1) + 6.0 * log10(frequency * 1.0e-9 / 5);
+	}
+
+	arma::vec gauss(1);
+	gauss[0] = zval;
+
+	retval += sigma * (gauss[0]);
+	pathLossCDF = q(-gauss[0]);
+
+	return (retval);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_C2urban_NLOS                            ****/
+/**** Winner II: C2, urban NLOS                                                        ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_C2urban_NLOS(double distance,
+						   double hBS,
+						   double /* hMS */,
+						   double frequency,
+						   double zval,
+						   double &sigma,
+						   double &pathLossCDF) const
+{
+	double retval;
+
+	sigma = 8.0;
+	retval = (44.9 - 6.55 * log10(hBS)) * log10(distance) + 34.46 + 5.83 * log10(hBS) +
+		 23.0 * log10(frequency * 1.0e-9 / 5);
+
+	arma::vec gauss(1);
+	gauss[0] = zval;
+
+	retval += sigma * (gauss[0]);
+	pathLossCDF = q(-gauss[0]);
+
+	return (retval);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_C2urban                                 ****/
+/**** Winner II: C2, suburban                                                          ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_C2urban(double distance,
+					      double hBS,
+					      double hMS,
+					      double frequency,
+					      double &sigma,
+					      std::string &pathLossModelStr,
+					      double &pathLossCDF,
+					      double &probLOS,
+					      int losValue) const
+{
+	LOGGER_TIMED_SCOPE("pathLoss.Winner2");
+	double retval = quietNaN;
+
+	if ((losValue == 0) && (closeInHgtFlag) && (hMS > closeInHgtLOS)) {
+		losValue = 1;
+		probLOS = 1.0;
+	} else {
+		probLOS = (distance > 18.0 ? 18.0 / distance : 1.0) *
+				  (1.0 - exp(-distance / 63.0)) +
+			  exp(-distance / 63.0);
+	}
+
+	if (losValue == 0) {
+		if (winner2UnknownLOSMethod == CConst::PLOSCombineWinner2UnknownLOSMethod) {
+			double sigmaLOS, sigmaNLOS;
+			double plLOS = Winner2_C2urban_LOS(distance,
+							   hBS,
+							   hMS,
+							   frequency,
+							   0.0,
+							   sigmaLOS,
+							   pathLossCDF);
+			double plNLOS = Winner2_C2urban_NLOS(distance,
+							     hBS,
+							     hMS,
+							     frequency,
+							     0.0,
+							     sigmaNLOS,
+							     pathLossCDF);
+			retval = probLOS * plLOS + (1.0 - probLOS) * plNLOS;
+			sigma = sqrt(probLOS * probLOS * sigmaLOS * sigmaLOS +
+				     (1.0 - probLOS) * (1.0 - probLOS) * sigmaNLOS * sigmaNLOS);
+
+			arma::vec gauss(1);
+			gauss[0] = zwinner2Combined;
+
+			retval += sigma * gauss[0];
+			pathLossCDF = q(-(gauss[0]));
+
+			pathLossModelStr = "W2C2_URBAN_COMB";
+		} else if (winner2UnknownLOSMethod ==
+			   CConst::PLOSThresholdWinner2UnknownLOSMethod) {
+			if (probLOS > winner2ProbLOSThr) {
+				retval = Winner2_C2urban_LOS(distance,
+							     hBS,
+							     hMS,
+							     frequency,
+							     zwinner2LOS,
+							     sigma,
+							     pathLossCDF);
+				pathLossModelStr = "W2C2_URBAN_LOS";
+			} else {
+				retval = Winner2_C2urban_NLOS(distance,
+							      hBS,
+							      hMS,
+							      frequency,
+							      zwinner2NLOS,
+							      sigma,
+							      pathLossCDF);
+				pathLossModelStr = "W2C2_URBAN_NLOS";
+			}
+		} else {
+			CORE_DUMP;
+		}
+	} else if (losValue == 1) {
+		retval = Winner2_C2urban_LOS(distance,
+					     hBS,
+					     hMS,
+					     frequency,
+					     zwinner2LOS,
+					     sigma,
+					     pathLossCDF);
+		pathLossModelStr = "W2C2_URBAN_LOS";
+	} else if (losValue == 2) {
+		retval = Winner2_C2urban_NLOS(distance,
+					      hBS,
+					      hMS,
+					      frequency,
+					      zwinner2NLOS,
+					      sigma,
+					      pathLossCDF);
+		pathLossModelStr = "W2C2_URBAN_NLOS";
+	} else {
+		CORE_DUMP;
+	}
+
+	return (retval);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_D1rural_LOS                             ****/
+/**** Winner II: D1, rural LOS                                                         ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_D1rural_LOS(double distance,
+						  double hBS,
+						  double hMS,
+						  double frequency,
+						  double zval,
+						  double &sigma,
+						  double &pathLossCDF) const
+{
+	double retval;
+
+	double dBP = 4 * (hBS) * (hMS)*frequency / CConst::c;
+
+	if (distance < 10.0) {
+		// FSPL
+		sigma = 0.0;
+		retval = -(20.0 * log10(CConst::c / (4 * M_PI * frequency * distance)));
+	} else if (distance < dBP) {
+		sigma = 4.0;
+		retval = 21.5 * log10(distance) + 44.2 + 20 * log10(frequency * 1.0e-9 / 5);
+	} else {
+		sigma = 6.0;
+		retval = 40.0 * log10(distance) + 10.5 - 18.5 * log10(hBS) - 18.5 * log10(hMS) +
+			 1.5 * log10(frequency * 1.0e-9 / 5);
+	}
+
+	arma::vec gauss(1);
+	gauss[0] = zval;
+
+	retval += sigma * gauss[0];
+	pathLossCDF = q(-gauss[0]);
+
+	return (retval);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_D1rural_NLOS                            ****/
+/**** Winner II: D1, rural NLOS                                                        ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_D1rural_NLOS(double distance,
+						   double hBS,
+						   double hMS,
+						   double frequency,
+						   double zval,
+						   double &sigma,
+						   double &pathLossCDF) const
+{
+	double retval;
+
+	sigma = 8.0;
+	retval = 25.1 * log10(distance) + 55.4 - 0.13 * (hBS - 25) * log10(distance / 100) -
+		 0.9 * (hMS - 1.5) + 21.3 * log10(frequency * 1.0e-9 / 5);
+
+	arma::vec gauss(1);
+	gauss[0] = zval;
+
+	retval += sigma * gauss[0];
+	pathLossCDF = q(-gauss[0]);
+
+	return (retval);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BaselinePathLossClass::Winner2_D1rural                                 ****/
+/**** Winner II: D1, rural                                                             ****/
+/**** distance = link distance (m)                                                     ****/
+/**** hBS = BS antenna height (m)                                                      ****/
+/**** hMS = MS antenna height (m)                                                      ****/
+/**** frequency = Frequency (Hz)                                                       ****/
+/******************************************************************************************/
+double BaselinePathLossClass::Winner2_D1rural(double distance,
+					      double hBS,
+					      double hMS,
+					      double frequency,
+					      double &sigma,
+					      std::string &pathLossModelStr,
+					      double &pathLossCDF,
+					      double &probLOS,
+					      int losValue) const
+{
+	LOGGER_TIMED_SCOPE("pathLoss.Winner2");
+	double retval = quietNaN;
+
+	if ((losValue == 0) && (closeInHgtFlag) && (hMS > closeInHgtLOS)) {
+		losValue = 1;
+		probLOS = 1.0;
+	} else {
+		probLOS = exp(-distance / 1000);
+	}
+
+	if (losValue == 0) {
+		if (winner2UnknownLOSMethod == CConst::PLOSCombineWinner2UnknownLOSMethod) {
+			double sigmaLOS, sigmaNLOS;
+			double plLOS = Winner2_D1rural_LOS(distance,
+							   hBS,
+							   hMS,
+							   frequency,
+							   0.0,
+							   sigmaLOS,
+							   pathLossCDF);
+			double plNLOS = Winner2_D1rural_NLOS(distance,
+							     hBS,
+							     hMS,
+							     frequency,
+							     0.0,
+							     sigmaNLOS,
+							     pathLossCDF);
+			retval = probLOS * plLOS + (1.0 - probLOS) * plNLOS;
+			sigma = sqrt(probLOS * probLOS * sigmaLOS * sigmaLOS +
+				     (1.0 - probLOS) * (1.0 - probLOS) * sigmaNLOS * sigmaNLOS);
+
+			arma::vec gauss(1);
+			gauss[0] = zwinner2Combined;
+
+			retval += sigma * gauss[0];
+			pathLossCDF = q(-(gauss[0]));
+
+			pathLossModelStr = "W2D1_RURAL_COMB";
+		} else if (winner2UnknownLOSMethod ==
+			   CConst::PLOSThresholdWinner2UnknownLOSMethod) {
+			if (probLOS > winner2ProbLOSThr) {
+				retval = Winner2_D1rural_LOS(distance,
+							     hBS,
+							     hMS,
+							     frequency,
+							     zwinner2LOS,
+							     sigma,
+							     pathLossCDF);
+				pathLossModelStr = "W2D1_RURAL_LOS";
+			} else {
+				retval = Winner2_D1rural_NLOS(distance,
+							      hBS,
+							      hMS,
+							      frequency,
+							      zwinner2NLOS,
+							      sigma,
+							      pathLossCDF);
+				pathLossModelStr = "W2D1_RURAL_NLOS";
+			}
+		} else {
+			CORE_DUMP;
+		}
+	} else if (losValue == 1) {
+		retval = Winner2_D1rural_LOS(distance,
+					     hBS,
+					     hMS,
+					     frequency,
+					     zwinner2LOS,
+					     sigma,
+					     pathLossCDF);
+		pathLossModelStr = "W2D1_RURAL_LOS";
+	} else if (losValue == 2) {
+		retval = Winner2_D1rural_NLOS(distance,
+					      hBS,
+					      hMS,
+					      frequency,
+					      zwinner2NLOS,
+					      sigma,
+					      pathLossCDF);
+		pathLossModelStr = "W2D1_RURAL_NLOS";
+	} else {
+		CORE_DUMP;
+	}
+
+	return (retval);
+}
@@ -0,0 +1,145 @@
+/******************************************************************************************/
+/**** FILE : BaselinePathLoss.h                                                        ****/
+/******************************************************************************************/
+
+#ifndef BASELINE_PATH_LOSS_H
+#define BASELINE_PATH_LOSS_H
+
+#include <string>
+#include "cconst.h"
+
+/******************************************************************************************/
+/**** CLASS: BaselinePathLossClass                                                     ****/
+/**** Frozen copy of AfcManager::computePathLoss() and Winner II models as they were   ****/
+/**** before PathLossResultClass: model names are built as strings and standard normal ****/
+/**** quantiles are held in arma::vec temporaries. Reference for BM_PathLossKernel.    ****/
+/**** Only FCC 6 GHz path loss model with FSPL in place of ITM (itmFSPLFlag) is kept,  ****/
+/**** without building data LOS, so no terrain is needed. Parameters have the values   ****/
+/**** of AfcManager members of the same name.                                          ****/
+/******************************************************************************************/
+class BaselinePathLossClass
+{
+	public:
+		BaselinePathLossClass();
+
+		void computePathLoss(CConst::PathLossModelEnum pathLossModel,
+				     bool itmFSPLFlag,
+				     CConst::PropEnvEnum propEnv,
+				     CConst::PropEnvEnum propEnvRx,
+				     CConst::NLCDLandCatEnum nlcdLandCatTx,
+				     CConst::NLCDLandCatEnum nlcdLandCatRx,
+				     double distKm,
+				     double fsplDistKm,
+				     double win2DistKm,
+				     double frequency,
+				     double txHeightM,
+				     double elevationAngleTxDeg,
+				     double rxHeightM,
+				     double elevationAngleRxDeg,
+				     double &pathLoss,
+				     double &pathClutterTxDB,
+				     double &pathClutterRxDB,
+				     std::string &pathLossModelStr,
+				     double &pathLossCDF,
+				     std::string &pathClutterTxModelStr,
+				     double &pathClutterTxCDF,
+				     std::string &pathClutterRxModelStr,
+				     double &pathClutterRxCDF,
+				     std::string *txClutterStrPtr,
+				     std::string *rxClutterStrPtr) const;
+
+		double q(double Z) const;
+
+		double Winner2_C1suburban_LOS(double distance,
+					      double hBS,
+					      double hMS,
+					      double frequency,
+					      double zval,
+					      double &sigma,
+					      double &pathLossCDF) const;
+		double Winner2_C1suburban_NLOS(double distance,
+					       double hBS,
+					       double hMS,
+					       double frequency,
+					       double zval,
+					       double &sigma,
+					       double &pathLossCDF) const;
+		double Winner2_C2urban_LOS(double distance,
+					   double hBS,
+					   double hMS,
+					   double frequency,
+					   double zval,
+					   double &sigma,
+					   double &pathLossCDF) const;
+		double Winner2_C2urban_NLOS(double distance,
+					    double hBS,
+					    double hMS,
+					    double frequency,
+					    double zval,
+					    double &sigma,
+					    double &pathLossCDF) const;
+		double Winner2_D1rural_LOS(double distance,
+					   double hBS,
+					   double hMS,
+					   double frequency,
+					   double zval,
+					   double &sigma,
+					   double &pathLossCDF) const;
+		double Winner2_D1rural_NLOS(double distance,
+					    double hBS,
+					    double hMS,
+					    double frequency,
+					    double zval,
+					    double &sigma,
+					    double &pathLossCDF) const;
+
+		double Winner2_C1suburban(double distance,
+					  double hBS,
+					  double hMS,
+					  double frequency,
+					  double &sigma,
+					  std::string &pathLossModelStr,
+					  double &pathLossCDF,
+					  double &probLOS,
+					  int losValue) const;
+		double Winner2_C2urban(double distance,
+				       double hBS,
+				       double hMS,
+				       double frequency,
+				       double &sigma,
+				       std::string &pathLossModelStr,
+				       double &pathLossCDF,
+				       double &probLOS,
+				       int losValue) const;
+		double Winner2_D1rural(double distance,
+				       double hBS,
+				       double hMS,
+				       double frequency,
+				       double &sigma,
+				       std::string &pathLossModelStr,
+				       double &pathLossCDF,
+				       double &probLOS,
+				       int losValue) const;
+
+		double closeInDist; // Radius in which close in path loss model is used
+		bool closeInHgtFlag; // Force LOS when mobile height above closeInHgtLOS
+		double closeInHgtLOS; // RLAN height above which prob of LOS = 100%
+		CConst::LOSOptionEnum winner2LOSOption; // Unknown, ForceLOS or ForceNLOS only
+		CConst::Winner2UnknownLOSMethodEnum winner2UnknownLOSMethod;
+		double winner2ProbLOSThr;
+		CConst::ITMClutterMethodEnum rlanITMTxClutterMethod; // ForceTrue or ForceFalse
+		bool applyClutterFSRxFlag;
+		double maxFsAglHeight;
+		bool allowRuralFSClutterFlag;
+		bool pathLossClampFSPL;
+
+		// Standard normal quantiles of model confidences
+		double zclutter2108;
+		double fsZclutter2108;
+		double zwinner2LOS;
+		double zwinner2NLOS;
+		double zwinner2Combined;
+};
+/******************************************************************************************/
+
+#endif
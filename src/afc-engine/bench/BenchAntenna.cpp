@@ -0,0 +1,149 @@
+/******************************************************************************************/
+/**** FILE: BenchAntenna.cpp                                                           ****/
+/**** FS receive antenna gain: ULSClass::computeRxGain() for each antenna type, from   ****/
+/**** pattern and from gain table.                                                     ****/
+/******************************************************************************************/
+
+#include <cmath>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "BenchFixture.h"
+#include "RxGainTable.h"
+#include "antenna.h"
+#include "cconst.h"
+#include "lininterp.h"
+#include "str_type.h"
+#include "uls.h"
+
+namespace
+{
+const int numSample = 4096; // Inputs cycled through by each benchmark
+const double benchFrequency = 6.1e9;
+
+// Antenna types covered, in order of benchmark argument
+const CConst::ULSAntennaTypeEnum antennaTypeList[] = {CConst::F1245AntennaType,
+						      CConst::F699AntennaType,
+						      CConst::F1336OmniAntennaType,
+						      CConst::R2AIP07AntennaType,
+						      CConst::R2AIP07CANAntennaType,
+						      CConst::LUTAntennaType};
+const int numAntennaType = sizeof(antennaTypeList) / sizeof(antennaTypeList[0]);
+
+/******************************************************************************************/
+/**** FUNCTION: getLUTAntenna()                                                        ****/
+/**** Off boresight gain table resembling measured dish pattern: main lobe, decaying   ****/
+/**** side lobes and flat back lobe, 0.5 deg resolution.                              ****/
+/******************************************************************************************/
+AntennaClass *getLUTAntenna()
+{
+	static AntennaClass *antenna = (AntennaClass *)NULL;
+	if (!antenna) {
+		std::vector<std::tuple<double, double>> gainList;
+		for (int angleIdx = 0; angleIdx <= 360; ++angleIdx) {
+			double angleDeg = 0.5 * angleIdx;
+			double gainDB;
+			if (angleDeg < 2.0) {
+				gainDB = -12.0 * (angleDeg / 2.0) * (angleDeg / 2.0);
+			} else if (angleDeg < 100.0) {
+				gainDB = -10.0 - 25.0 * log10(angleDeg) + 3.0 * cos(angleDeg);
+			} else {
+				gainDB = -65.0;
+			}
+			gainList.push_back(std::make_tuple(angleDeg * M_PI / 180.0, gainDB));
+		}
+		antenna = new AntennaClass(CConst::antennaLUT_Boresight, "bench");
+		antenna->setBoresightGainTable(new LinInterpClass(gainList));
+	}
+	return (antenna);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: makeULS()                                                              ****/
+/**** FS receiver with 38 dBi, 2.4 m antenna of given type.                            ****/
+/******************************************************************************************/
+ULSClass *makeULS(CConst::ULSAntennaTypeEnum antennaType)
+{
+	ULSClass *uls = new ULSClass((AfcManager *)NULL, 1, 0, 0, "US");
+	uls->setRxAntennaType(antennaType);
+	uls->setRxAntennaModel("");
+	uls->setRxAntennaCategory(CConst::HPAntennaCategory);
+	uls->setRxGain(38.0);
+	uls->setRxDlambda(2.4 * benchFrequency / CConst::c);
+	if (antennaType == CConst::LUTAntennaType) {
+		uls->setRxAntenna(getLUTAntenna());
+	}
+	return (uls);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: computeRxGain() of antennaTypeList[range(0)], angles uniform over     ****/
+/**** [0, 180] deg. range(1) = 1 uses gain tables.                                     ****/
+/******************************************************************************************/
+void BM_ComputeRxGain(benchmark::State &state)
+{
+	CConst::ULSAntennaTypeEnum antennaType = antennaTypeList[state.range(0)];
+	bool tableFlag = (state.range(1) != 0);
+	RxGainTableCacheClass rxGainTableCache;
+	ULSClass *uls = makeULS(antennaType);
+	if (tableFlag) {
+		uls->setRxGainTableCache(&rxGainTableCache);
+	}
+
+	std::vector<double> angleList, elevationList;
+	BenchFixtureClass::makeUniform(numSample, 31, angleList);
+	BenchFixtureClass::makeUniform(numSample, 32, elevationList);
+	for (int i = 0; i < numSample; ++i) {
+		angleList[i] *= 180.0;
+		elevationList[i] = -10.0 + 20.0 * elevationList[i];
+	}
+
+	int sampleIdx = 0;
+	std::string subModelStr;
+	for (auto _ : state) {
+		double gainDB = uls->computeRxGain(angleList[sampleIdx],
+						   elevationList[sampleIdx],
+						   benchFrequency,
+						   subModelStr,
+						   0);
+		benchmark::DoNotOptimize(gainDB);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel(CConst::strULSAntennaTypeList->type_to_str(antennaType));
+
+	delete uls;
+}
+BENCHMARK(BM_ComputeRxGain)->ArgsProduct({benchmark::CreateDenseRange(0, numAntennaType - 1, 1),
+					  {0, 1}});
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: Building gain table of antennaTypeList[range(0)] (0.1 deg, 0.01 dB)   ****/
+/******************************************************************************************/
+void BM_RxGainTableBuild(benchmark::State &state)
+{
+	CConst::ULSAntennaTypeEnum antennaType = antennaTypeList[state.range(0)];
+	AntennaClass *antenna = (antennaType == CConst::LUTAntennaType ? getLUTAntenna() :
+									 (AntennaClass *)NULL);
+	for (auto _ : state) {
+		RxGainTableCacheClass rxGainTableCache;
+		const RxGainTableClass *table = rxGainTableCache.getTable(antennaType,
+									  antenna,
+									  CConst::HPAntennaCategory,
+									  38.0,
+									  2.4 * benchFrequency /
+										  CConst::c,
+									  0,
+									  benchFrequency);
+		benchmark::DoNotOptimize(table);
+	}
+	state.SetLabel(CConst::strULSAntennaTypeList->type_to_str(antennaType));
+}
+// F.1336 omni has no table
+BENCHMARK(BM_RxGainTableBuild)->Arg(0)->Arg(1)->Arg(3)->Arg(4)->Arg(5);
+/******************************************************************************************/
+}
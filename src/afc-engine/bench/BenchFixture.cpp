@@ -0,0 +1,763 @@
+/******************************************************************************************/
+/**** FILE: BenchFixture.cpp                                                           ****/
+/******************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <boost/filesystem.hpp>
+#include <gdal_priv.h>
+#include <ogr_spatialref.h>
+#include <QStringList>
+#include <QVariant>
+#include <afcsql/SqlConnectionDefinition.h>
+#include <afcsql/SqlExceptionDb.h>
+#include <afcsql/SqlHelpers.h>
+#include <afcsql/SqlInsert.h>
+#include <afcsql/SqlScopedConnection.h>
+#include <afcsql/SqlTransaction.h>
+#include "BenchFixture.h"
+#include "afclogging/ErrStream.h"
+
+const double BenchFixtureClass::minLat = 40.0;
+const double BenchFixtureClass::minLon = -75.0;
+
+namespace
+{
+/******************************************************************************************/
+/**** FUNCTION: writeRaster()                                                          ****/
+/**** Writes single band WGS84 raster, pixel (0, 0) has upper left corner at           ****/
+/**** (lonStart, latStart).                                                            ****/
+/******************************************************************************************/
+template<class T>
+void writeRaster(const std::string &driverName,
+		 const std::string &filename,
+		 GDALDataType dataType,
+		 int numLat,
+		 int numLon,
+		 double latStart,
+		 double lonStart,
+		 double pixPerDeg,
+		 const std::vector<T> &valList)
+{
+	GDALAllRegister();
+	GDALDriver *driver = GetGDALDriverManager()->GetDriverByName(driverName.c_str());
+	GDALDriver *memDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+	if ((!driver) || (!memDriver)) {
+		throw std::runtime_error(ErrStream() << "ERROR: GDAL driver " << driverName
+						     << " not available");
+	}
+
+	// Not all drivers support Create(), so raster is copied from memory
+	GDALDataset *memDataset = memDriver->Create("", numLon, numLat, 1, dataType, nullptr);
+	double geoTransform[6] = {lonStart, 1.0 / pixPerDeg, 0.0, latStart, 0.0, -1.0 / pixPerDeg};
+	memDataset->SetGeoTransform(geoTransform);
+	OGRSpatialReference spatialRef;
+	spatialRef.SetWellKnownGeogCS("WGS84");
+	char *wkt = nullptr;
+	spatialRef.exportToWkt(&wkt);
+	memDataset->SetProjection(wkt);
+	CPLFree(wkt);
+	CPLErr err = memDataset->GetRasterBand(1)->RasterIO(GF_Write,
+							    0,
+							    0,
+							    numLon,
+							    numLat,
+							    (void *)valList.data(),
+							    numLon,
+							    numLat,
+							    dataType,
+							    0,
+							    0);
+	GDALDataset *dataset = (err == CE_None) ?
+				       driver->CreateCopy(filename.c_str(),
+							  memDataset,
+							  FALSE,
+							  nullptr,
+							  nullptr,
+							  nullptr) :
+				       nullptr;
+	GDALClose(memDataset);
+	if (!dataset) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to write " << filename);
+	}
+	GDALClose(dataset);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: nextRand()                                                             ****/
+/**** xorshift32 step                                                                  ****/
+/******************************************************************************************/
+inline uint32_t nextRand(uint32_t &state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return (state);
+}
+/******************************************************************************************/
+}
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::get()                                               ****/
+/******************************************************************************************/
+BenchFixtureClass &BenchFixtureClass::get()
+{
+	static BenchFixtureClass fixture;
+	return (fixture);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** CONSTRUCTOR: BenchFixtureClass::BenchFixtureClass()                              ****/
+/******************************************************************************************/
+BenchFixtureClass::BenchFixtureClass()
+{
+	boost::filesystem::path root = boost::filesystem::temp_directory_path() /
+				       boost::filesystem::unique_path("afc-engine-bench-%%%%-%%%%");
+	boost::filesystem::create_directories(root);
+	rootDir = root.string();
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** DESTRUCTOR: BenchFixtureClass::~BenchFixtureClass()                              ****/
+/******************************************************************************************/
+BenchFixtureClass::~BenchFixtureClass()
+{
+	boost::system::error_code ec;
+	boost::filesystem::remove_all(rootDir, ec);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::terrainHeight()                                     ****/
+/**** Rolling hills with ~5 km and ~800 m features over 150 - 550 m base.              ****/
+/******************************************************************************************/
+double BenchFixtureClass::terrainHeight(double latDeg, double lonDeg)
+{
+	double x = (lonDeg - minLon) * 2.0 * M_PI;
+	double y = (latDeg - minLat) * 2.0 * M_PI;
+	return (350.0 + 150.0 * sin(17.0 * x) * cos(23.0 * y) + 40.0 * sin(131.0 * x + 3.0 * y) +
+		10.0 * cos(97.0 * y - 5.0 * x));
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::makeProfile()                                       ****/
+/******************************************************************************************/
+std::vector<double> BenchFixtureClass::makeProfile(int numPts, double spacingM, uint32_t seed)
+{
+	std::vector<double> elev(numPts + 2);
+	elev[0] = numPts - 1;
+	elev[1] = spacingM;
+	uint32_t state = seed | 1;
+	double phase = (nextRand(state) & 0xFFFF) / 65536.0 * 2.0 * M_PI;
+	for (int ptIdx = 0; ptIdx < numPts; ++ptIdx) {
+		double distKm = ptIdx * spacingM * 1.0e-3;
+		double noise = (nextRand(state) & 0xFFFF) / 65536.0 - 0.5;
+		elev[ptIdx + 2] = 300.0 + 120.0 * sin(distKm / 3.0 + phase) +
+				  35.0 * sin(distKm * 1.7 + 2.0 * phase) + 4.0 * noise;
+	}
+	return (elev);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::makeUniform()                                       ****/
+/******************************************************************************************/
+void BenchFixtureClass::makeUniform(int n, uint32_t seed, std::vector<double> &valList)
+{
+	valList.resize(n);
+	uint32_t state = seed | 1;
+	for (int i = 0; i < n; ++i) {
+		valList[i] = nextRand(state) / 4294967296.0;
+	}
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getDepDir()                                         ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getDepDir()
+{
+	if (depDir.empty()) {
+		writeDep();
+	}
+	return (depDir);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getSrtmDir()                                        ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getSrtmDir()
+{
+	if (srtmDir.empty()) {
+		writeSrtm();
+	}
+	return (srtmDir);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getGlobeDir()                                       ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getGlobeDir()
+{
+	if (globeDir.empty()) {
+		writeGlobe();
+	}
+	return (globeDir);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getNfaFile()                                        ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getNfaFile()
+{
+	if (nfaFile.empty()) {
+		writeNfa();
+	}
+	return (nfaFile);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getPrFile()                                         ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getPrFile()
+{
+	if (prFile.empty()) {
+		writePr();
+	}
+	return (prFile);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getNlcdFile()                                       ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getNlcdFile()
+{
+	if (nlcdFile.empty()) {
+		writeNlcd();
+	}
+	return (nlcdFile);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getPopulationFile()                                 ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getPopulationFile()
+{
+	if (populationFile.empty()) {
+		writePopulation();
+	}
+	return (populationFile);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getRegionDir()                                      ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getRegionDir()
+{
+	if (regionDir.empty()) {
+		writeRegion();
+	}
+	return (regionDir);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getRadioClimateFile()                               ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getRadioClimateFile()
+{
+	if (radioClimateFile.empty()) {
+		writeItu();
+	}
+	return (radioClimateFile);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getSurfRefracFile()                                 ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getSurfRefracFile()
+{
+	if (surfRefracFile.empty()) {
+		writeItu();
+	}
+	return (surfRefracFile);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::getUlsFile()                                        ****/
+/******************************************************************************************/
+const std::string &BenchFixtureClass::getUlsFile()
+{
+	if (ulsFile.empty()) {
+		writeUls();
+	}
+	return (ulsFile);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writeDep()                                          ****/
+/**** Tile is named as 3DEP 1 arcsec tiles (by NW corner), so that it is found by name ****/
+/**** mapper of TerrainClass.                                                          ****/
+/******************************************************************************************/
+void BenchFixtureClass::writeDep()
+{
+	std::string dir = rootDir + "/dep";
+	boost::filesystem::create_directories(dir);
+
+	int n = depPixPerDeg;
+	std::vector<float> valList((std::size_t)n * n);
+	for (int latIdx = 0; latIdx < n; ++latIdx) {
+		double latDeg = minLat + 1.0 - (latIdx + 0.5) / n;
+		for (int lonIdx = 0; lonIdx < n; ++lonIdx) {
+			double lonDeg = minLon + (lonIdx + 0.5) / n;
+			valList[(std::size_t)latIdx * n + lonIdx] = (float)terrainHeight(latDeg,
+											 lonDeg);
+		}
+	}
+
+	std::ostringstream filename;
+	filename << dir << "/USGS_1_n" << std::setw(2) << std::setfill('0') << (int)minLat + 1
+		 << "w" << std::setw(3) << (int)-minLon << ".tif";
+	writeRaster("GTiff", filename.str(), GDT_Float32, n, n, minLat + 1.0, minLon, n, valList);
+	depDir = dir;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writeSrtm()                                         ****/
+/**** SRTM tiles have samples at both edges, named by SW corner.                       ****/
+/******************************************************************************************/
+void BenchFixtureClass::writeSrtm()
+{
+	std::string dir = rootDir + "/srtm";
+	boost::filesystem::create_directories(dir);
+
+	int n = srtmPixPerDeg + 1;
+	std::vector<int16_t> valList((std::size_t)n * n);
+	for (int latIdx = 0; latIdx < n; ++latIdx) {
+		double latDeg = minLat + 1.0 - (double)latIdx / srtmPixPerDeg;
+		for (int lonIdx = 0; lonIdx < n; ++lonIdx) {
+			double lonDeg = minLon + (double)lonIdx / srtmPixPerDeg;
+			valList[(std::size_t)latIdx * n + lonIdx] = (int16_t)std::lround(
+				terrainHeight(latDeg, lonDeg));
+		}
+	}
+
+	std::ostringstream filename;
+	filename << dir << "/N" << std::setw(2) << std::setfill('0') << (int)minLat << "W"
+		 << std::setw(3) << (int)-minLon << ".hgt";
+	double halfPixDeg = 0.5 / srtmPixPerDeg;
+	writeRaster("SRTMHGT",
+		    filename.str(),
+		    GDT_Int16,
+		    n,
+		    n,
+		    minLat + 1.0 + halfPixDeg,
+		    minLon - halfPixDeg,
+		    srtmPixPerDeg,
+		    valList);
+	srtmDir = dir;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writeGlobe()                                        ****/
+/**** Single .bil file, one degree wider than terrain tile on each side. 0 is GLOBE    ****/
+/**** no data value, so surface is kept above 0.                                       ****/
+/******************************************************************************************/
+void BenchFixtureClass::writeGlobe()
+{
+	std::string dir = rootDir + "/globe";
+	boost::filesystem::create_directories(dir);
+
+	int n = 3 * globePixPerDeg;
+	std::vector<int16_t> valList((std::size_t)n * n);
+	for (int latIdx = 0; latIdx < n; ++latIdx) {
+		double latDeg = minLat + 2.0 - (latIdx + 0.5) / globePixPerDeg;
+		for (int lonIdx = 0; lonIdx < n; ++lonIdx) {
+			double lonDeg = minLon - 1.0 + (lonIdx + 0.5) / globePixPerDeg;
+			valList[(std::size_t)latIdx * n + lonIdx] = (int16_t)std::max(
+				1L,
+				std::lround(terrainHeight(latDeg, lonDeg)));
+		}
+	}
+
+	writeRaster("EHdr",
+		    dir + "/bench.bil",
+		    GDT_Int16,
+		    n,
+		    n,
+		    minLat + 2.0,
+		    minLon - 1.0,
+		    globePixPerDeg,
+		    valList);
+	globeDir = dir;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writeNfa()                                          ****/
+/**** Near field adjustment table on same grid as production table (xdb step 1 dB, u   ****/
+/**** and efficiency steps 0.05) with smooth synthetic values.                         ****/
+/******************************************************************************************/
+void BenchFixtureClass::writeNfa()
+{
+	std::string filename = rootDir + "/nfa.csv";
+	std::ofstream file(filename);
+	file << "xdb,u,eff,nfa\n";
+	file << std::fixed;
+	for (int xdb = -40; xdb <= 0; ++xdb) {
+		for (int uIdx = 0; uIdx <= 100; ++uIdx) {
+			double u = 0.05 * uIdx;
+			for (int effIdx = 8; effIdx <= 20; ++effIdx) {
+				double eff = 0.05 * effIdx;
+				double nfa = -exp(xdb / 10.0) * (1.0 + u) * (1.2 - eff) * 3.0;
+				file << xdb << "," << std::setprecision(2) << u << "," << eff << ","
+				     << std::setprecision(4) << nfa << "\n";
+			}
+		}
+	}
+	if (!file) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to write " << filename);
+	}
+	nfaFile = filename;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writePr()                                           ****/
+/**** Passive repeater table: label line "numQ:numOneOverKs,Q values", then one line   ****/
+/**** per 1/Ks value.                                                                  ****/
+/******************************************************************************************/
+void BenchFixtureClass::writePr()
+{
+	std::string filename = rootDir + "/pr.csv";
+	std::ofstream file(filename);
+	const int numQ = 10;
+	const int numOneOverKs = 40;
+	file << numQ << ":" << numOneOverKs;
+	for (int qIdx = 0; qIdx < numQ; ++qIdx) {
+		file << "," << 0.5 * (qIdx + 1);
+	}
+	file << "\n" << std::fixed;
+	for (int kIdx = 0; kIdx < numOneOverKs; ++kIdx) {
+		double oneOverKs = 0.1 * (kIdx + 1);
+		file << std::setprecision(1) << oneOverKs;
+		for (int qIdx = 0; qIdx < numQ; ++qIdx) {
+			double Q = 0.5 * (qIdx + 1);
+			file << "," << std::setprecision(4)
+			     << 3.0 * cos(oneOverKs * Q) / (1.0 + 0.1 * oneOverKs);
+		}
+		file << "\n";
+	}
+	if (!file) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to write " << filename);
+	}
+	prFile = filename;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writeNlcd()                                         ****/
+/**** NLCD land cover: developed high/medium intensity (24, 23) in city disk at tile   ****/
+/**** center, developed low/open (22, 21) ring around it, forest (41, 42) and crops    ****/
+/**** (82) outside.                                                                    ****/
+/******************************************************************************************/
+void BenchFixtureClass::writeNlcd()
+{
+	std::string dir = rootDir + "/nlcd";
+	boost::filesystem::create_directories(dir);
+
+	int n = nlcdPixPerDeg;
+	std::vector<uint8_t> valList((std::size_t)n * n);
+	for (int latIdx = 0; latIdx < n; ++latIdx) {
+		double y = 0.5 - (latIdx + 0.5) / n;
+		for (int lonIdx = 0; lonIdx < n; ++lonIdx) {
+			double x = (lonIdx + 0.5) / n - 0.5;
+			double r = sqrt(x * x + y * y);
+			uint8_t landcat;
+			if (r < 0.05) {
+				landcat = 24;
+			} else if (r < 0.12) {
+				landcat = 23;
+			} else if (r < 0.2) {
+				landcat = ((latIdx / 16 + lonIdx / 16) % 2) ? 22 : 21;
+			} else {
+				uint8_t ruralList[] = {41, 42, 82, 81};
+				landcat = ruralList[(latIdx / 90 + 3 * (lonIdx / 90)) % 4];
+			}
+			valList[(std::size_t)latIdx * n + lonIdx] = landcat;
+		}
+	}
+
+	std::string filename = dir + "/nlcd_bench.tif";
+	writeRaster("GTiff", filename, GDT_Byte, n, n, minLat + 1.0, minLon, n, valList);
+	nlcdFile = filename;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writePopulation()                                   ****/
+/**** Population density (people / km^2) decaying from 10000 at tile center.           ****/
+/******************************************************************************************/
+void BenchFixtureClass::writePopulation()
+{
+	std::string dir = rootDir + "/population";
+	boost::filesystem::create_directories(dir);
+
+	int n = globePixPerDeg;
+	std::vector<float> valList((std::size_t)n * n);
+	for (int latIdx = 0; latIdx < n; ++latIdx) {
+		double y = 0.5 - (latIdx + 0.5) / n;
+		for (int lonIdx = 0; lonIdx < n; ++lonIdx) {
+			double x = (lonIdx + 0.5) / n - 0.5;
+			valList[(std::size_t)latIdx * n + lonIdx] = (float)(10000.0 *
+									     exp(-(x * x + y * y) /
+										 0.01));
+		}
+	}
+
+	std::string filename = dir + "/population_bench.tif";
+	writeRaster("GTiff", filename, GDT_Float32, n, n, minLat + 1.0, minLon, n, valList);
+	populationFile = filename;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writeRegion()                                       ****/
+/**** Region polygon US.kml is the terrain tile, in format read by                     ****/
+/**** PolygonClass::readMultiGeometry().                                               ****/
+/******************************************************************************************/
+void BenchFixtureClass::writeRegion()
+{
+	std::string dir = rootDir + "/region";
+	boost::filesystem::create_directories(dir);
+
+	std::string filename = dir + "/US.kml";
+	std::ofstream file(filename);
+	file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	     << "<kml xmlns=\"http://www.opengis.net/kml/2.2\">\n"
+	     << "<Document>\n"
+	     << "<Placemark>\n"
+	     << "<name>US</name>\n"
+	     << "<MultiGeometry>\n"
+	     << "<Polygon>\n"
+	     << "<outerBoundaryIs>\n"
+	     << "<LinearRing>\n"
+	     << "<coordinates>\n";
+	double lonList[] = {minLon, minLon + 1.0, minLon + 1.0, minLon, minLon};
+	double latList[] = {minLat, minLat, minLat + 1.0, minLat + 1.0, minLat};
+	for (int ptIdx = 0; ptIdx < 5; ++ptIdx) {
+		file << lonList[ptIdx] << "," << latList[ptIdx] << ",0\n";
+	}
+	file << "</coordinates>\n"
+	     << "</LinearRing>\n"
+	     << "</outerBoundaryIs>\n"
+	     << "</Polygon>\n"
+	     << "</MultiGeometry>\n"
+	     << "</Placemark>\n"
+	     << "</Document>\n"
+	     << "</kml>\n";
+	if (!file) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to write " << filename);
+	}
+	regionDir = dir;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writeItu()                                          ****/
+/**** World ITU maps on grids read by ITUDataClass: radio climate (0.5 deg, 360 x 720) ****/
+/**** all continental temperate (5), surface refractivity (1.5 deg, 121 x 241) 320.    ****/
+/******************************************************************************************/
+void BenchFixtureClass::writeItu()
+{
+	std::string dir = rootDir + "/itudata";
+	boost::filesystem::create_directories(dir);
+
+	std::string rcFilename = dir + "/TropoClim.txt";
+	std::ofstream rcFile(rcFilename);
+	for (int latIdx = 0; latIdx < 360; ++latIdx) {
+		for (int lonIdx = 0; lonIdx < 720; ++lonIdx) {
+			rcFile << (lonIdx ? " " : "") << 5;
+		}
+		rcFile << "\n";
+	}
+	if (!rcFile) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to write " << rcFilename);
+	}
+
+	std::string srFilename = dir + "/N050.TXT";
+	std::ofstream srFile(srFilename);
+	for (int latIdx = 0; latIdx < 121; ++latIdx) {
+		for (int lonIdx = 0; lonIdx < 241; ++lonIdx) {
+			srFile << (lonIdx ? " " : "") << "320.0";
+		}
+		srFile << "\n";
+	}
+	if (!srFile) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to write " << srFilename);
+	}
+
+	radioClimateFile = rcFilename;
+	surfRefracFile = srFilename;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: BenchFixtureClass::writeUls()                                          ****/
+/**** SQLite FS database with tables read by UlsDatabase (uls, pr, ras, antname,       ****/
+/**** antaob, antgain). numUls links with receivers spread over terrain tile,          ****/
+/**** transmitters 3 - 25 km away, frequencies in UNII-5 and UNII-7. No passive        ****/
+/**** repeaters, RAS or antenna patterns.                                              ****/
+/******************************************************************************************/
+void BenchFixtureClass::writeUls()
+{
+	std::string filename = rootDir + "/fs_bench.sqlite3";
+
+	SqlConnectionDefinition config;
+	config.driverName = "QSQLITE";
+	config.dbName = QString::fromStdString(filename);
+	SqlScopedConnection<SqlExceptionDb> db(new SqlExceptionDb(config.newConnection()));
+	db->tryOpen();
+
+	SqlHelpers::exec(*db,
+			 "CREATE TABLE uls (fsid INTEGER PRIMARY KEY, region TEXT, callsign TEXT, "
+			 "status TEXT, radio_service TEXT, name TEXT, common_carrier BOOLEAN, "
+			 "mobile BOOLEAN, rx_callsign TEXT, rx_antenna_num INTEGER, "
+			 "freq_assigned_start_mhz REAL, freq_assigned_end_mhz REAL, tx_eirp REAL, "
+			 "tx_lat_deg REAL, tx_long_deg REAL, tx_ground_elev_m REAL, "
+			 "tx_polarization TEXT, tx_height_to_center_raat_m REAL, "
+			 "tx_architecture TEXT, azimuth_angle_to_tx REAL, "
+			 "elevation_angle_to_tx REAL, tx_gain REAL, rx_lat_deg REAL, "
+			 "rx_long_deg REAL, rx_ground_elev_m REAL, rx_ant_model_idx INTEGER, "
+			 "rx_ant_model TEXT, rx_ant_category TEXT, rx_line_loss REAL, "
+			 "rx_height_to_center_raat_m REAL, rx_gain REAL, rx_ant_diameter REAL, "
+			 "rx_near_field_ant_diameter REAL, rx_near_field_dist_limit REAL, "
+			 "rx_near_field_ant_efficiency REAL, "
+			 "rx_diversity_height_to_center_raat_m REAL, rx_diversity_gain REAL, "
+			 "rx_diversity_ant_diameter REAL, p_rp_num INTEGER, path_number INTEGER)");
+	SqlHelpers::exec(*db, "CREATE INDEX uls_rx_lat ON uls (rx_lat_deg)");
+	SqlHelpers::exec(*db, "CREATE INDEX uls_rx_long ON uls (rx_long_deg)");
+	SqlHelpers::exec(*db,
+			 "CREATE TABLE pr (id INTEGER PRIMARY KEY, fsid INTEGER, prSeq INTEGER, "
+			 "pr_lat_deg REAL, pr_lon_deg REAL, pr_height_to_center_raat_tx_m REAL, "
+			 "pr_height_to_center_raat_rx_m REAL, pr_ant_type TEXT, "
+			 "pr_ant_category TEXT, pr_ant_model_idx INTEGER, pr_ant_model TEXT, "
+			 "pr_line_loss REAL, pr_reflector_width_m REAL, "
+			 "pr_reflector_height_m REAL, pr_back_to_back_gain_tx REAL, "
+			 "pr_back_to_back_gain_rx REAL, pr_ant_diameter_tx REAL, "
+			 "pr_ant_diameter_rx REAL)");
+	SqlHelpers::exec(*db,
+			 "CREATE TABLE ras (rasid INTEGER PRIMARY KEY, region TEXT, name TEXT, "
+			 "location TEXT, startFreqMHz REAL, stopFreqMHz REAL, exclusionZone TEXT, "
+			 "rect1lat1 REAL, rect1lat2 REAL, rect1lon1 REAL, rect1lon2 REAL, "
+			 "rect2lat1 REAL, rect2lat2 REAL, rect2lon1 REAL, rect2lon2 REAL, "
+			 "radiusKm REAL, centerLat REAL, centerLon REAL, heightAGL REAL)");
+	SqlHelpers::exec(*db, "CREATE TABLE antname (ant_idx INTEGER PRIMARY KEY, ant_name TEXT)");
+	SqlHelpers::exec(*db, "CREATE TABLE antaob (aob_idx INTEGER PRIMARY KEY, aob_deg REAL)");
+	SqlHelpers::exec(*db, "CREATE TABLE antgain (id INTEGER PRIMARY KEY, gain_db REAL)");
+
+	QStringList columns;
+	columns << "fsid"
+		<< "region"
+		<< "callsign"
+		<< "status"
+		<< "radio_service"
+		<< "name"
+		<< "common_carrier"
+		<< "mobile"
+		<< "rx_callsign"
+		<< "rx_antenna_num"
+		<< "freq_assigned_start_mhz"
+		<< "freq_assigned_end_mhz"
+		<< "tx_eirp"
+		<< "tx_lat_deg"
+		<< "tx_long_deg"
+		<< "tx_ground_elev_m"
+		<< "tx_polarization"
+		<< "tx_height_to_center_raat_m"
+		<< "tx_architecture"
+		<< "tx_gain"
+		<< "rx_lat_deg"
+		<< "rx_long_deg"
+		<< "rx_ground_elev_m"
+		<< "rx_ant_model_idx"
+		<< "rx_ant_model"
+		<< "rx_ant_category"
+		<< "rx_line_loss"
+		<< "rx_height_to_center_raat_m"
+		<< "rx_gain"
+		<< "rx_ant_diameter"
+		<< "p_rp_num"
+		<< "path_number";
+
+	// Link geometry, heights and channels (10 or 30 MHz wide, on 10 MHz raster)
+	std::vector<double> uList;
+	makeUniform(7 * numUls, 51, uList);
+
+	SqlTransaction transaction(*db);
+	SqlInsert insert(*db, "uls");
+	insert.cols(columns);
+	for (int ulsIdx = 0; ulsIdx < numUls; ++ulsIdx) {
+		const double *u = &uList[7 * ulsIdx];
+		double rxLat = minLat + 0.1 + 0.8 * u[0];
+		double rxLon = minLon + 0.1 + 0.8 * u[1];
+		double distKm = 3.0 + 22.0 * u[2];
+		double azimuthRad = 2.0 * M_PI * u[3];
+		double txLat = rxLat + distKm / 111.0 * cos(azimuthRad);
+		double txLon = rxLon +
+			       distKm / (111.0 * cos(rxLat * M_PI / 180.0)) * sin(azimuthRad);
+		txLat = std::min(std::max(txLat, minLat + 0.02), minLat + 0.98);
+		txLon = std::min(std::max(txLon, minLon + 0.02), minLon + 0.98);
+
+		double bandwidthMHz = (u[4] < 0.5 ? 10.0 : 30.0);
+		double centerFreqMHz;
+		if (u[5] < 0.6) {
+			centerFreqMHz = 5945.0 + std::floor(u[6] * 47.0) * 10.0;
+		} else {
+			centerFreqMHz = 6545.0 + std::floor(u[6] * 32.0) * 10.0;
+		}
+
+		std::ostringstream callsign;
+		callsign << "BNCH" << std::setw(4) << std::setfill('0') << ulsIdx;
+
+		QString callsignStr = QString::fromStdString(callsign.str());
+		double txHeight = 20.0 + 60.0 * u[2];
+		double rxHeight = 20.0 + 60.0 * u[3];
+
+		QVariantList values;
+		values << ulsIdx << "US" << callsignStr << "A"
+		       << "CF"
+		       << "BENCH FS" << false << false << callsignStr << 1;
+		values << centerFreqMHz - bandwidthMHz / 2 << centerFreqMHz + bandwidthMHz / 2;
+		values << 55.0 << txLat << txLon << terrainHeight(txLat, txLon) << "V" << txHeight
+		       << "IDU" << 38.0;
+		values << rxLat << rxLon << terrainHeight(rxLat, rxLon) << -1 << ""
+		       << "HP" << 3.0 << rxHeight << 38.0 << 2.4;
+		values << 0 << 1;
+		insert.run(values);
+	}
+	transaction.commit();
+
+	ulsFile = filename;
+}
+/******************************************************************************************/
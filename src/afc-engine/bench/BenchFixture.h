@@ -0,0 +1,79 @@
+/******************************************************************************************/
+/**** FILE : BenchFixture.h                                                            ****/
+/******************************************************************************************/
+
+#ifndef BENCH_FIXTURE_H
+#define BENCH_FIXTURE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/******************************************************************************************/
+/**** CLASS: BenchFixtureClass                                                         ****/
+/**** Synthetic inputs of engine benchmarks, generated in temporary directory on first ****/
+/**** use and removed on exit, so that benchmarks do not depend on installed data.     ****/
+/**** Terrain covers tile [minLat, minLat+1] x [minLon, minLon+1]: 3DEP style GeoTIFF  ****/
+/**** (float), SRTM .hgt and GLOBE .bil (int16) built from same analytic surface.      ****/
+/**** Databases needed by AfcManager::initializeDatabases() (ULS, NLCD, population,    ****/
+/**** region polygon, ITU maps) cover the same tile.                                   ****/
+/******************************************************************************************/
+class BenchFixtureClass
+{
+	public:
+		static BenchFixtureClass &get();
+		~BenchFixtureClass();
+
+		const std::string &getDepDir();
+		const std::string &getSrtmDir();
+		const std::string &getGlobeDir();
+		const std::string &getNfaFile();
+		const std::string &getPrFile();
+		const std::string &getNlcdFile();
+		const std::string &getPopulationFile();
+		const std::string &getRegionDir(); // Contains US.kml
+		const std::string &getRadioClimateFile();
+		const std::string &getSurfRefracFile();
+		const std::string &getUlsFile();
+
+		// Height (m) of synthetic terrain surface
+		static double terrainHeight(double latDeg, double lonDeg);
+
+		// ITM profile (elev[0] = number of points - 1, elev[1] = spacing (m), heights) of
+		// numPts points over rolling terrain with given spacing
+		static std::vector<double> makeProfile(int numPts, double spacingM, uint32_t seed);
+
+		// Uniformly distributed deterministic pseudo random numbers in [0, 1)
+		static void makeUniform(int n, uint32_t seed, std::vector<double> &valList);
+
+		static const double minLat;
+		static const double minLon;
+		static const int depPixPerDeg = 900; // 4 arcsec
+		static const int srtmPixPerDeg = 1200; // 3 arcsec
+		static const int globePixPerDeg = 120; // 30 arcsec
+		static const int nlcdPixPerDeg = 900; // 4 arcsec
+		static const int numUls = 1000; // FS links in ULS database
+
+	private:
+		BenchFixtureClass();
+
+		void writeDep();
+		void writeSrtm();
+		void writeGlobe();
+		void writeNfa();
+		void writePr();
+		void writeNlcd();
+		void writePopulation();
+		void writeRegion();
+		void writeItu();
+		void writeUls();
+
+		std::string rootDir;
+		std::string depDir, srtmDir, globeDir;
+		std::string nfaFile, prFile;
+		std::string nlcdFile, populationFile, regionDir;
+		std::string radioClimateFile, surfRefracFile, ulsFile;
+};
+/******************************************************************************************/
+
+#endif
@@ -0,0 +1,114 @@
+/******************************************************************************************/
+/**** FILE: BenchGeometry.cpp                                                          ****/
+/**** Geometry kernels: geodetic/ECEF conversions and point in polygon.                ****/
+/******************************************************************************************/
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "BenchFixture.h"
+#include "EcefModel.h"
+#include "polygon.h"
+
+namespace
+{
+const int numSample = 4096; // Inputs cycled through by each benchmark
+
+/******************************************************************************************/
+/**** BENCHMARK: EcefModel::geodeticToEcef()                                           ****/
+/******************************************************************************************/
+void BM_GeodeticToEcef(benchmark::State &state)
+{
+	std::vector<double> latList, lonList;
+	BenchFixtureClass::makeUniform(numSample, 41, latList);
+	BenchFixtureClass::makeUniform(numSample, 42, lonList);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		Vector3 p = EcefModel::geodeticToEcef(-60.0 + 120.0 * latList[sampleIdx],
+						      -180.0 + 360.0 * lonList[sampleIdx],
+						      0.1);
+		benchmark::DoNotOptimize(p);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GeodeticToEcef);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: EcefModel::ecefToGeodetic()                                           ****/
+/******************************************************************************************/
+void BM_EcefToGeodetic(benchmark::State &state)
+{
+	std::vector<double> latList, lonList;
+	BenchFixtureClass::makeUniform(numSample, 43, latList);
+	BenchFixtureClass::makeUniform(numSample, 44, lonList);
+	std::vector<Vector3> posnList;
+	for (int i = 0; i < numSample; ++i) {
+		posnList.push_back(EcefModel::geodeticToEcef(-60.0 + 120.0 * latList[i],
+							     -180.0 + 360.0 * lonList[i],
+							     0.1));
+	}
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		GeodeticCoord pt = EcefModel::ecefToGeodetic(posnList[sampleIdx]);
+		benchmark::DoNotOptimize(pt);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EcefToGeodetic);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: makePolygon()                                                          ****/
+/**** Star shaped polygon with numPt vertices and radius 1e6 +/- 30%, as region or     ****/
+/**** denied region polygons are after conversion to integer coordinates.              ****/
+/******************************************************************************************/
+PolygonClass *makePolygon(int numPt)
+{
+	std::vector<double> uList;
+	BenchFixtureClass::makeUniform(numPt, 45, uList);
+	std::vector<std::tuple<int, int>> ii_list;
+	for (int ptIdx = 0; ptIdx < numPt; ++ptIdx) {
+		double angleRad = 2.0 * M_PI * ptIdx / numPt;
+		double r = 1.0e6 * (1.0 + 0.2 * sin(7.0 * angleRad) + 0.1 * (uList[ptIdx] - 0.5));
+		ii_list.push_back(std::make_tuple((int)std::lround(r * cos(angleRad)),
+						  (int)std::lround(r * sin(angleRad))));
+	}
+	return (new PolygonClass(&ii_list));
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: PolygonClass::in_bdy_area() for polygon of range(0) vertices, points  ****/
+/**** uniform over bounding box. range(1) = 1 builds raster mask first.                ****/
+/******************************************************************************************/
+void BM_InBdyArea(benchmark::State &state)
+{
+	PolygonClass *polygon = makePolygon((int)state.range(0));
+	if (state.range(1)) {
+		polygon->buildMask();
+	}
+	std::vector<double> xList, yList;
+	BenchFixtureClass::makeUniform(numSample, 46, xList);
+	BenchFixtureClass::makeUniform(numSample, 47, yList);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		bool inFlag = polygon->in_bdy_area((int)(-1.3e6 + 2.6e6 * xList[sampleIdx]),
+						   (int)(-1.3e6 + 2.6e6 * yList[sampleIdx]));
+		benchmark::DoNotOptimize(inFlag);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	delete polygon;
+}
+// {number of vertices, mask}
+BENCHMARK(BM_InBdyArea)->ArgsProduct({{64, 1024, 16384}, {0, 1}});
+/******************************************************************************************/
+}
@@ -0,0 +1,47 @@
+/******************************************************************************************/
+/**** FILE: BenchMain.cpp                                                              ****/
+/**** Runs engine benchmarks. Unless --benchmark_out is given, results are also        ****/
+/**** written as JSON to afc-engine-bench.json for regression tracking.                ****/
+/******************************************************************************************/
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "afclogging/Logging.h"
+#include "afclogging/LoggingConfig.h"
+
+int main(int argc, char **argv)
+{
+	// Engine logs fixture loading at info level, keep console output to results
+	Logging::Config conf = Logging::Config();
+	Logging::Filter filter = Logging::Filter();
+	filter.setLevel("warning");
+	conf.filter = filter;
+	Logging::initialize(conf);
+
+	std::vector<char *> argList(argv, argv + argc);
+	bool outFlag = false;
+	for (int argIdx = 1; argIdx < argc; ++argIdx) {
+		if (strncmp(argv[argIdx], "--benchmark_out=", 16) == 0) {
+			outFlag = true;
+		}
+	}
+	std::string outArg = "--benchmark_out=afc-engine-bench.json";
+	std::string outFormatArg = "--benchmark_out_format=json";
+	if (!outFlag) {
+		argList.push_back(&outArg[0]);
+		argList.push_back(&outFormatArg[0]);
+	}
+	int numArg = (int)argList.size();
+	argList.push_back((char *)NULL);
+
+	benchmark::Initialize(&numArg, argList.data());
+	if (benchmark::ReportUnrecognizedArguments(numArg, argList.data())) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
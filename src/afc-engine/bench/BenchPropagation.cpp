@@ -0,0 +1,530 @@
+/******************************************************************************************/
+/**** FILE: BenchPropagation.cpp                                                       ****/
+/**** Propagation model kernels: ITM, Winner II, P.2109, P.2108, spectral overlap and  ****/
+/**** near field / passive repeater tables.                                            ****/
+/******************************************************************************************/
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "AfcManager.h"
+#include "BaselinePathLoss.h"
+#include "BenchFixture.h"
+#include "nfa.h"
+#include "prtable.h"
+
+extern void point_to_point(double elev[],
+			   double tht_m,
+			   double rht_m,
+			   double eps_dielect,
+			   double sgm_conductivity,
+			   double eno_ns_surfref,
+			   double frq_mhz,
+			   int radio_climate,
+			   int pol,
+			   double conf,
+			   double rel,
+			   double &dbloss,
+			   std::string &strmode,
+			   int &errnum);
+
+namespace
+{
+const int numSample = 1024; // Inputs cycled through by each benchmark
+const double benchFrequency = 6.1e9;
+
+/******************************************************************************************/
+/**** FUNCTION: getAfcManager()                                                        ****/
+/**** AfcManager with FCC 6 GHz path loss model and confidences of default AFC config. ****/
+/******************************************************************************************/
+AfcManager &getAfcManager()
+{
+	static AfcManager *afcManager = (AfcManager *)NULL;
+	if (!afcManager) {
+		afcManager = new AfcManager();
+		afcManager->setPathLossModel(CConst::FCC6GHzReportAndOrderPathLossModel);
+		afcManager->setPropModelConfidence(0.5, 0.5, 0.5, 0.5, 0.5, 0.5);
+	}
+	return (*afcManager);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: getFreqCoeff()                                                         ****/
+/**** Model coefficients at benchFrequency for confidences set by getAfcManager().     ****/
+/******************************************************************************************/
+PropModelFreqCoeffClass getFreqCoeff()
+{
+	PropModelContextClass propModelContext;
+	propModelContext.setConfidence(0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+	return (propModelContext.getFreqCoeff(benchFrequency));
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: ITM point_to_point() over synthetic profiles of range(0) points, 30 m ****/
+/**** spacing.                                                                         ****/
+/******************************************************************************************/
+void BM_PointToPoint(benchmark::State &state)
+{
+	int numPts = (int)state.range(0);
+	std::vector<std::vector<double>> profileList;
+	for (int profileIdx = 0; profileIdx < 16; ++profileIdx) {
+		profileList.push_back(BenchFixtureClass::makeProfile(numPts, 30.0, 1 + profileIdx));
+	}
+
+	int profileIdx = 0;
+	std::string strmode;
+	for (auto _ : state) {
+		double dbloss;
+		int errnum;
+		point_to_point(profileList[profileIdx].data(),
+			       20.0,
+			       30.0,
+			       15.0,
+			       0.005,
+			       301.0,
+			       benchFrequency * 1.0e-6,
+			       5,
+			       1,
+			       0.5,
+			       0.5,
+			       dbloss,
+			       strmode,
+			       errnum);
+		benchmark::DoNotOptimize(dbloss);
+		profileIdx = (profileIdx + 1) & 15;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PointToPoint)->Arg(100)->Arg(1000)->Arg(3000);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: Winner II C2 urban LOS/NLOS/combined over 50 m - 1 km                 ****/
+/******************************************************************************************/
+void BM_Winner2Urban(benchmark::State &state)
+{
+	AfcManager &afcManager = getAfcManager();
+	PropModelFreqCoeffClass freqCoeff = getFreqCoeff();
+
+	std::vector<double> uList;
+	BenchFixtureClass::makeUniform(numSample, 11, uList);
+	int losValue = (int)state.range(0);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		double sigma, pathLossCDF, probLOS;
+		CConst::PathLossResultModelEnum pathLossModel;
+		double pathLoss = afcManager.Winner2_C2urban(50.0 + 950.0 * uList[sampleIdx],
+							     25.0,
+							     1.5,
+							     freqCoeff,
+							     sigma,
+							     pathLossModel,
+							     pathLossCDF,
+							     probLOS,
+							     losValue);
+		benchmark::DoNotOptimize(pathLoss);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+// 0: combined by probability of LOS, 1: LOS, 2: NLOS
+BENCHMARK(BM_Winner2Urban)->Arg(0)->Arg(1)->Arg(2);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: Winner II C1 suburban and D1 rural, combined                          ****/
+/******************************************************************************************/
+void BM_Winner2SuburbanRural(benchmark::State &state)
+{
+	AfcManager &afcManager = getAfcManager();
+	PropModelFreqCoeffClass freqCoeff = getFreqCoeff();
+
+	std::vector<double> uList;
+	BenchFixtureClass::makeUniform(numSample, 12, uList);
+	bool ruralFlag = (state.range(0) != 0);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		double sigma, pathLossCDF, probLOS;
+		CConst::PathLossResultModelEnum pathLossModel;
+		double distance = 50.0 + 950.0 * uList[sampleIdx];
+		double pathLoss = ruralFlag ? afcManager.Winner2_D1rural(distance,
+									  25.0,
+									  1.5,
+									  freqCoeff,
+									  sigma,
+									  pathLossModel,
+									  pathLossCDF,
+									  probLOS,
+									  0) :
+					      afcManager.Winner2_C1suburban(distance,
+									    25.0,
+									    1.5,
+									    freqCoeff,
+									    sigma,
+									    pathLossModel,
+									    pathLossCDF,
+									    probLOS,
+									    0);
+		benchmark::DoNotOptimize(pathLoss);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+// 0: C1 suburban, 1: D1 rural
+BENCHMARK(BM_Winner2SuburbanRural)->Arg(0)->Arg(1);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: P.2109 building entry loss over elevation angles                      ****/
+/******************************************************************************************/
+void BM_P2109BuildingLoss(benchmark::State &state)
+{
+	AfcManager &afcManager = getAfcManager();
+	PropModelFreqCoeffClass freqCoeff = getFreqCoeff();
+	CConst::BuildingTypeEnum buildingType = (state.range(0) ?
+							 CConst::thermallyEfficientBuildingType :
+							 CConst::traditionalBuildingType);
+
+	std::vector<double> uList;
+	BenchFixtureClass::makeUniform(numSample, 13, uList);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		CConst::BuildingPenetrationModelEnum buildingPenetrationModel;
+		double buildingPenetrationCDF;
+		double lossDB = afcManager.computeBuildingPenetration(buildingType,
+								      -90.0 + 180.0 * uList[sampleIdx],
+								      freqCoeff,
+								      buildingPenetrationModel,
+								      buildingPenetrationCDF);
+		benchmark::DoNotOptimize(lossDB);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+// 0: traditional, 1: thermally efficient
+BENCHMARK(BM_P2109BuildingLoss)->Arg(0)->Arg(1);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: getPathLossDistKm()                                                    ****/
+/**** Path lengths of path loss benchmarks: closeInFlag set: 50 m - 1 km (Winner II),  ****/
+/**** otherwise 1 - 30 km (FSPL with P.2108 clutter).                                  ****/
+/******************************************************************************************/
+std::vector<double> getPathLossDistKm(bool closeInFlag)
+{
+	std::vector<double> distKmList;
+	BenchFixtureClass::makeUniform(numSample, 14, distKmList);
+	for (auto &distKm : distKmList) {
+		distKm = closeInFlag ? 0.05 + 0.95 * distKm : 1.0 + 29.0 * distKm;
+	}
+	return (distKmList);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: runPathLossKernel()                                                    ****/
+/**** AfcManager::computePathLoss() on urban path of given length                      ****/
+/******************************************************************************************/
+void runPathLossKernel(const AfcManager &afcManager,
+		       const PropModelFreqCoeffClass &freqCoeff,
+		       double distKm,
+		       PathLossResultClass &result)
+{
+#if DEBUG_AFC
+	std::vector<std::string> ITMHeightType;
+#endif
+	afcManager.computePathLoss(CConst::FCC6GHzReportAndOrderPathLossModel,
+				   true,
+				   CConst::urbanPropEnv,
+				   CConst::urbanPropEnv,
+				   CConst::noClutterNLCDLandCat,
+				   CConst::noClutterNLCDLandCat,
+				   distKm,
+				   distKm,
+				   distKm,
+				   freqCoeff,
+				   -74.5,
+				   40.5,
+				   1.5,
+				   0.0,
+				   -74.5,
+				   40.5 + distKm / 111.0,
+				   30.0,
+				   0.0,
+				   result,
+				   (double **)NULL,
+				   (LOSOracleClass *)NULL
+#if DEBUG_AFC
+				   ,
+				   ITMHeightType
+#endif
+	);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: runPathLossBaseline()                                                  ****/
+/**** BaselinePathLossClass::computePathLoss() on same path as runPathLossKernel()     ****/
+/******************************************************************************************/
+void runPathLossBaseline(const BaselinePathLossClass &baseline,
+			 double distKm,
+			 double &pathLoss,
+			 double &pathClutterTxDB,
+			 double &pathClutterRxDB,
+			 std::string &pathLossModelStr,
+			 std::string &pathClutterTxModelStr,
+			 std::string &pathClutterRxModelStr)
+{
+	double pathLossCDF, pathClutterTxCDF, pathClutterRxCDF;
+	std::string txClutterStr, rxClutterStr;
+	baseline.computePathLoss(CConst::FCC6GHzReportAndOrderPathLossModel,
+				 true,
+				 CConst::urbanPropEnv,
+				 CConst::urbanPropEnv,
+				 CConst::noClutterNLCDLandCat,
+				 CConst::noClutterNLCDLandCat,
+				 distKm,
+				 distKm,
+				 distKm,
+				 benchFrequency,
+				 1.5,
+				 0.0,
+				 30.0,
+				 0.0,
+				 pathLoss,
+				 pathClutterTxDB,
+				 pathClutterRxDB,
+				 pathLossModelStr,
+				 pathLossCDF,
+				 pathClutterTxModelStr,
+				 pathClutterTxCDF,
+				 pathClutterRxModelStr,
+				 pathClutterRxCDF,
+				 &txClutterStr,
+				 &rxClutterStr);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: checkPathLossBaseline()                                                ****/
+/**** Empty string if kernel and baseline agree on all inputs, error message otherwise ****/
+/******************************************************************************************/
+std::string checkPathLossBaseline(bool closeInFlag)
+{
+	AfcManager &afcManager = getAfcManager();
+	PropModelFreqCoeffClass freqCoeff = getFreqCoeff();
+	BaselinePathLossClass baseline;
+	std::vector<double> distKmList = getPathLossDistKm(closeInFlag);
+
+	for (double distKm : distKmList) {
+		PathLossResultClass result;
+		runPathLossKernel(afcManager, freqCoeff, distKm, result);
+
+		double pathLoss, pathClutterTxDB, pathClutterRxDB;
+		std::string pathLossModelStr, pathClutterTxModelStr, pathClutterRxModelStr;
+		runPathLossBaseline(baseline,
+				    distKm,
+				    pathLoss,
+				    pathClutterTxDB,
+				    pathClutterRxDB,
+				    pathLossModelStr,
+				    pathClutterTxModelStr,
+				    pathClutterRxModelStr);
+
+		if ((std::fabs(result.pathLoss - pathLoss) > 1.0e-9) ||
+		    (std::fabs(result.pathClutterTxDB - pathClutterTxDB) > 1.0e-9) ||
+		    (std::fabs(result.pathClutterRxDB - pathClutterRxDB) > 1.0e-9) ||
+		    (result.pathLossModelStr() != pathLossModelStr) ||
+		    (result.pathClutterTxModelStr() != pathClutterTxModelStr) ||
+		    (result.pathClutterRxModelStr() != pathClutterRxModelStr)) {
+			return ("Kernel and baseline differ at " + std::to_string(distKm) +
+				" km: " + result.pathLossModelStr() + " " +
+				std::to_string(result.pathLoss) + " vs " + pathLossModelStr + " " +
+				std::to_string(pathLoss));
+		}
+	}
+	return (std::string());
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: Path loss kernel, FCC 6 GHz model, FSPL. range(0) = 0: urban path     ****/
+/**** 1 - 30 km (P.2108 clutter), range(0) = 1: urban path 50 m - 1 km (Winner II)     ****/
+/******************************************************************************************/
+void BM_PathLossKernel(benchmark::State &state)
+{
+	AfcManager &afcManager = getAfcManager();
+	PropModelFreqCoeffClass freqCoeff = getFreqCoeff();
+	std::vector<double> distKmList = getPathLossDistKm(state.range(0) != 0);
+
+	int sampleIdx = 0;
+	PathLossResultClass result;
+	for (auto _ : state) {
+		runPathLossKernel(afcManager, freqCoeff, distKmList[sampleIdx], result);
+		benchmark::DoNotOptimize(result.pathLoss);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PathLossKernel)->Arg(0)->Arg(1);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: Same paths as BM_PathLossKernel, computed by frozen copy of path loss ****/
+/**** computation before the allocation-free kernel (model names as strings). Fails if ****/
+/**** its results differ from the kernel's.                                            ****/
+/******************************************************************************************/
+void BM_PathLossBaseline(benchmark::State &state)
+{
+	bool closeInFlag = (state.range(0) != 0);
+	std::string errMsg = checkPathLossBaseline(closeInFlag);
+	if (!errMsg.empty()) {
+		state.SkipWithError(errMsg.c_str());
+		return;
+	}
+
+	BaselinePathLossClass baseline;
+	std::vector<double> distKmList = getPathLossDistKm(closeInFlag);
+
+	int sampleIdx = 0;
+	double pathLoss, pathClutterTxDB, pathClutterRxDB;
+	std::string pathLossModelStr, pathClutterTxModelStr, pathClutterRxModelStr;
+	for (auto _ : state) {
+		runPathLossBaseline(baseline,
+				    distKmList[sampleIdx],
+				    pathLoss,
+				    pathClutterTxDB,
+				    pathClutterRxDB,
+				    pathLossModelStr,
+				    pathClutterTxModelStr,
+				    pathClutterRxModelStr);
+		benchmark::DoNotOptimize(pathLoss);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PathLossBaseline)->Arg(0)->Arg(1);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: computeSpectralOverlapLoss() of 20 - 320 MHz channels against FS      ****/
+/**** receivers, with (range(0) = 1) and without adjacent channel interference (aciFn) ****/
+/******************************************************************************************/
+void BM_SpectralOverlapLoss(benchmark::State &state)
+{
+	AfcManager &afcManager = getAfcManager();
+	bool aciFlag = (state.range(0) != 0);
+	CConst::SpectralAlgorithmEnum spectralAlgorithm = (state.range(1) ?
+								   CConst::psdSpectralAlgorithm :
+								   CConst::pwrSpectralAlgorithm);
+
+	std::vector<double> uList;
+	BenchFixtureClass::makeUniform(2 * numSample, 15, uList);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		double bwMHz = 20.0 * (1 << (int)(5 * uList[2 * sampleIdx]));
+		double sigStartFreq = (5925.0 + 1200.0 * uList[2 * sampleIdx + 1]) * 1.0e6;
+		double spectralOverlapLossDB;
+		bool overlapFlag = afcManager.computeSpectralOverlapLoss(&spectralOverlapLossDB,
+									 sigStartFreq,
+									 sigStartFreq +
+										 bwMHz * 1.0e6,
+									 6000.0e6,
+									 6030.0e6,
+									 aciFlag,
+									 spectralAlgorithm);
+		benchmark::DoNotOptimize(overlapFlag);
+		benchmark::DoNotOptimize(spectralOverlapLossDB);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+// {aciFlag, 0: power / 1: PSD algorithm}
+BENCHMARK(BM_SpectralOverlapLoss)->Args({0, 0})->Args({1, 0})->Args({1, 1});
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: Near field adjustment table, single value and batch API               ****/
+/******************************************************************************************/
+void BM_NFA(benchmark::State &state)
+{
+	NFAClass nfa(BenchFixtureClass::get().getNfaFile());
+	std::vector<double> xdbList, uList, effList;
+	BenchFixtureClass::makeUniform(numSample, 16, xdbList);
+	BenchFixtureClass::makeUniform(numSample, 17, uList);
+	BenchFixtureClass::makeUniform(numSample, 18, effList);
+	for (int i = 0; i < numSample; ++i) {
+		xdbList[i] = -40.0 + 40.0 * xdbList[i];
+		uList[i] = 5.0 * uList[i];
+		effList[i] = 0.4 + 0.6 * effList[i];
+	}
+	bool batchFlag = (state.range(0) != 0);
+	std::vector<double> nfaList(numSample);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		if (batchFlag) {
+			nfa.computeNFA(numSample,
+				       xdbList.data(),
+				       uList.data(),
+				       effList.data(),
+				       nfaList.data());
+			benchmark::DoNotOptimize(nfaList.data());
+		} else {
+			double val = nfa.computeNFA(xdbList[sampleIdx],
+						    uList[sampleIdx],
+						    effList[sampleIdx]);
+			benchmark::DoNotOptimize(val);
+			sampleIdx = (sampleIdx + 1) % numSample;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * (batchFlag ? numSample : 1));
+}
+// 0: single value, 1: batch of numSample values
+BENCHMARK(BM_NFA)->Arg(0)->Arg(1);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: Passive repeater table, single value and batch API                    ****/
+/******************************************************************************************/
+void BM_PRTable(benchmark::State &state)
+{
+	PRTABLEClass prTable(BenchFixtureClass::get().getPrFile());
+	std::vector<double> QList, oneOverKsList;
+	BenchFixtureClass::makeUniform(numSample, 19, QList);
+	BenchFixtureClass::makeUniform(numSample, 20, oneOverKsList);
+	for (int i = 0; i < numSample; ++i) {
+		QList[i] = 0.5 + 4.5 * QList[i];
+		oneOverKsList[i] = 0.1 + 3.9 * oneOverKsList[i];
+	}
+	bool batchFlag = (state.range(0) != 0);
+	std::vector<double> valList(numSample);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		if (batchFlag) {
+			prTable.computePRTABLE(numSample,
+					       QList.data(),
+					       oneOverKsList.data(),
+					       valList.data());
+			benchmark::DoNotOptimize(valList.data());
+		} else {
+			double val = prTable.computePRTABLE(QList[sampleIdx],
+							    oneOverKsList[sampleIdx]);
+			benchmark::DoNotOptimize(val);
+			sampleIdx = (sampleIdx + 1) % numSample;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * (batchFlag ? numSample : 1));
+}
+// 0: single value, 1: batch of numSample values
+BENCHMARK(BM_PRTable)->Arg(0)->Arg(1);
+/******************************************************************************************/
+}
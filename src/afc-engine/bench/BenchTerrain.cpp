@@ -0,0 +1,210 @@
+/******************************************************************************************/
+/**** FILE: BenchTerrain.cpp                                                           ****/
+/**** Terrain access: CachedGdal lookup patterns and elevation profiles on synthetic   ****/
+/**** terrain tiles.                                                                   ****/
+/******************************************************************************************/
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <QPointF>
+#include <benchmark/benchmark.h>
+#include "BenchFixture.h"
+#include "CachedGdal.h"
+#include "GdalNameMapper.h"
+#include "LOSOracle.h"
+#include "UlsMeasurementAnalysis.h"
+#include "terrain.h"
+
+namespace
+{
+const int numSample = 4096; // Inputs cycled through by each benchmark
+
+/******************************************************************************************/
+/**** FUNCTION: makeDepCache()                                                         ****/
+/**** CachedGdal over synthetic 3DEP tile, set up as TerrainClass does.                ****/
+/******************************************************************************************/
+std::unique_ptr<CachedGdal<float>> makeDepCache()
+{
+	const std::string &depDir = BenchFixtureClass::get().getDepDir();
+	std::unique_ptr<CachedGdal<float>> cgDep(new CachedGdal<float>(
+		depDir,
+		"dep",
+		GdalNameMapperPattern::make_unique("USGS_1_{latHem:ns}{latDegCeil:02}{"
+						   "lonHem:ew}{lonDegFloor:03}.tif",
+						   depDir)));
+	cgDep->setTransformationModifier([](GdalTransform *t) {
+		t->roundPpdToMultipleOf(1.);
+		t->setMarginsOutsideDeg(1.);
+	});
+	return (cgDep);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: getTerrain()                                                           ****/
+/**** TerrainClass over synthetic 3DEP, SRTM and GLOBE data (no LiDAR).                ****/
+/******************************************************************************************/
+TerrainClass *getTerrain()
+{
+	static TerrainClass *terrain = (TerrainClass *)NULL;
+	if (!terrain) {
+		BenchFixtureClass &fixture = BenchFixtureClass::get();
+		double minLat = BenchFixtureClass::minLat;
+		double minLon = BenchFixtureClass::minLon;
+		terrain = new TerrainClass("",
+					   "",
+					   fixture.getSrtmDir(),
+					   fixture.getDepDir(),
+					   fixture.getGlobeDir(),
+					   minLat,
+					   minLon,
+					   minLat + 1.0,
+					   minLon + 1.0,
+					   minLat,
+					   minLon,
+					   minLat + 1.0,
+					   minLon + 1.0,
+					   0);
+	}
+	return (terrain);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: CachedGdal lookups along path: consecutive points 30 m apart, as in   ****/
+/**** elevation profile extraction.                                                    ****/
+/******************************************************************************************/
+void BM_CachedGdalSequential(benchmark::State &state)
+{
+	std::unique_ptr<CachedGdal<float>> cgDep = makeDepCache();
+	double stepDeg = 30.0 / 111.0e3;
+	double minLat = BenchFixtureClass::minLat + 0.05;
+	double minLon = BenchFixtureClass::minLon + 0.05;
+	int numStep = (int)(0.9 / stepDeg);
+
+	int stepIdx = 0;
+	for (auto _ : state) {
+		float height;
+		bool found = cgDep->getValueAt(minLat + stepIdx * stepDeg * 0.6,
+					       minLon + stepIdx * stepDeg * 0.8,
+					       &height);
+		benchmark::DoNotOptimize(found);
+		benchmark::DoNotOptimize(height);
+		if (++stepIdx == numStep) {
+			stepIdx = 0;
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CachedGdalSequential);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: CachedGdal lookups at random points of tile, through tile cache       ****/
+/**** (range(0) = 0) or reading pixels directly (range(0) = 1).                        ****/
+/******************************************************************************************/
+void BM_CachedGdalRandom(benchmark::State &state)
+{
+	std::unique_ptr<CachedGdal<float>> cgDep = makeDepCache();
+	bool directFlag = (state.range(0) != 0);
+	std::vector<double> latList, lonList;
+	BenchFixtureClass::makeUniform(numSample, 21, latList);
+	BenchFixtureClass::makeUniform(numSample, 22, lonList);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		float height;
+		bool found = cgDep->getValueAt(BenchFixtureClass::minLat + latList[sampleIdx],
+					       BenchFixtureClass::minLon + lonList[sampleIdx],
+					       &height,
+					       1,
+					       directFlag);
+		benchmark::DoNotOptimize(found);
+		benchmark::DoNotOptimize(height);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+// 0: cached, 1: direct
+BENCHMARK(BM_CachedGdalRandom)->Arg(0)->Arg(1);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: UlsMeasurementAnalysis::computeElevationVector() over paths of        ****/
+/**** range(0) km in random directions, 30 m spacing.                                  ****/
+/******************************************************************************************/
+void BM_ComputeElevationVector(benchmark::State &state)
+{
+	TerrainClass *terrain = getTerrain();
+	double distKm = (double)state.range(0);
+	int numPts = (int)(distKm * 1000 / 30.0) + 1;
+	std::vector<double> uList;
+	BenchFixtureClass::makeUniform(3 * numSample, 23, uList);
+
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		const double *u = &uList[3 * sampleIdx];
+		double angleRad = 2.0 * M_PI * u[2];
+		double deltaDeg = distKm / 111.0;
+		QPointF from(BenchFixtureClass::minLat + 0.4 + 0.2 * u[0],
+			     BenchFixtureClass::minLon + 0.4 + 0.2 * u[1]);
+		QPointF to(from.x() + deltaDeg * sin(angleRad),
+			   from.y() + deltaDeg * cos(angleRad) / cos(from.x() * M_PI / 180.0));
+		double *heightProfile = UlsMeasurementAnalysis::computeElevationVector(
+			terrain,
+			false,
+			false,
+			from,
+			to,
+			numPts,
+			(double *)NULL);
+		benchmark::DoNotOptimize(heightProfile);
+		free(heightProfile);
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations() * numPts);
+}
+BENCHMARK(BM_ComputeElevationVector)->Arg(1)->Arg(10)->Arg(30);
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** BENCHMARK: LOSOracleClass over 1 km ground tracks (5 m spacing), range(0) RLAN   ****/
+/**** heights queried per track, as for scan point with several heights.               ****/
+/******************************************************************************************/
+void BM_LOSOracle(benchmark::State &state)
+{
+	TerrainClass *terrain = getTerrain();
+	int numHeight = state.range(0);
+	int numPts = 201;
+	std::vector<double> uList;
+	BenchFixtureClass::makeUniform(3 * numSample, 24, uList);
+
+	LOSOracleClass losOracle;
+	int sampleIdx = 0;
+	for (auto _ : state) {
+		const double *u = &uList[3 * sampleIdx];
+		double angleRad = 2.0 * M_PI * u[2];
+		double deltaDeg = 1.0 / 111.0;
+		QPointF from(BenchFixtureClass::minLat + 0.4 + 0.2 * u[0],
+			     BenchFixtureClass::minLon + 0.4 + 0.2 * u[1]);
+		QPointF to(from.x() + deltaDeg * sin(angleRad),
+			   from.y() + deltaDeg * cos(angleRad) / cos(from.x() * M_PI / 180.0));
+		losOracle.clear();
+		for (int heightIdx = 0; heightIdx < numHeight; ++heightIdx) {
+			bool losFlag = losOracle.isLOS(terrain,
+						       from,
+						       1.5 + 3.0 * heightIdx,
+						       to,
+						       30.0,
+						       numPts);
+			benchmark::DoNotOptimize(losFlag);
+		}
+		sampleIdx = (sampleIdx + 1) % numSample;
+	}
+	state.SetItemsProcessed(state.iterations() * numHeight);
+}
+BENCHMARK(BM_LOSOracle)->Arg(1)->Arg(16);
+/******************************************************************************************/
+}
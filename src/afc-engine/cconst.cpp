@@ -57,6 +57,50 @@ const StrTypeClass CConst::strPathLossModelList[] = {
 
 	{-1, (char *)0}};
 
+const StrTypeClass CConst::strPathLossResultModelList[] = {
+	{CConst::unknownPathLossResultModel, ""},
+	{CConst::FSPLPathLossResultModel, "FSPL"},
+	{CConst::ITMPathLossResultModel, "ITM"},
+	{CConst::ITMBldgPathLossResultModel, "ITM_BLDG"},
+	{CConst::W2C1SuburbanLOSPathLossResultModel, "W2C1_SUBURBAN_LOS"},
+	{CConst::W2C1SuburbanNLOSPathLossResultModel, "W2C1_SUBURBAN_NLOS"},
+	{CConst::W2C1SuburbanCombPathLossResultModel, "W2C1_SUBURBAN_COMB"},
+	{CConst::W2C2UrbanLOSPathLossResultModel, "W2C2_URBAN_LOS"},
+	{CConst::W2C2UrbanNLOSPathLossResultModel, "W2C2_URBAN_NLOS"},
+	{CConst::W2C2UrbanCombPathLossResultModel, "W2C2_URBAN_COMB"},
+	{CConst::W2D1RuralLOSPathLossResultModel, "W2D1_RURAL_LOS"},
+	{CConst::W2D1RuralNLOSPathLossResultModel, "W2D1_RURAL_NLOS"},
+	{CConst::W2D1RuralCombPathLossResultModel, "W2D1_RURAL_COMB"},
+
+	{-1, (char *)0}};
+
+const StrTypeClass CConst::strClutterModelList[] = {
+	{CConst::unknownClutterModel, ""},
+	{CConst::noneClutterModel, "NONE"},
+	{CConst::P2108ClutterModel, "P.2108"},
+	{CConst::P452HtElAngClutterModel, "452_HT_ELANG"},
+	{CConst::P452NLCDClutterModel, "452_NLCD"},
+
+	{-1, (char *)0}};
+
+const StrTypeClass CConst::strBuildingPenetrationModelList[] = {
+	{CConst::fixedValueBuildingPenetrationModel, "FIXED VALUE"},
+	{CConst::noneBuildingPenetrationModel, "NONE"},
+	{CConst::P2109BuildingPenetrationModel, "P.2109"},
+
+	{-1, (char *)0}};
+
+const StrTypeClass CConst::strNLCDClutterList[] = {
+	{CConst::deciduousTreesNLCDLandCat, "DECIDUOUS_TREES"},
+	{CConst::coniferousTreesNLCDLandCat, "CONIFEROUS_TREES"},
+	{CConst::highCropFieldsNLCDLandCat, "HIGH_CROP_FIELDS"},
+	{CConst::noClutterNLCDLandCat, ""},
+	{CConst::villageCenterNLCDLandCat, "VILLAGE_CENTER"},
+	{CConst::tropicalRainForestNLCDLandCat, "TROPICAL_RAIN_FOREST"},
+	{CConst::unknownNLCDLandCat, "VILLAGE_CENTER"},
+
+	{-1, (char *)0}};
+
 const StrTypeClass CConst::strLOSOptionList[] = {
 	{CConst::UnknownLOSOption, "UNKNOWN"},
 	{CConst::BldgDataLOSOption, "BLDG_DATA"},
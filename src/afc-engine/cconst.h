@@ -146,6 +146,48 @@ class CConst
 		};
 		/**************************************************************************************/
 
+		/**************************************************************************************/
+		/**** PathLossResultModel (model that produced path loss value) ****/
+		/**************************************************************************************/
+		enum PathLossResultModelEnum {
+			unknownPathLossResultModel,
+			FSPLPathLossResultModel,
+			ITMPathLossResultModel,
+			ITMBldgPathLossResultModel,
+			W2C1SuburbanLOSPathLossResultModel,
+			W2C1SuburbanNLOSPathLossResultModel,
+			W2C1SuburbanCombPathLossResultModel,
+			W2C2UrbanLOSPathLossResultModel,
+			W2C2UrbanNLOSPathLossResultModel,
+			W2C2UrbanCombPathLossResultModel,
+			W2D1RuralLOSPathLossResultModel,
+			W2D1RuralNLOSPathLossResultModel,
+			W2D1RuralCombPathLossResultModel
+		};
+		/**************************************************************************************/
+
+		/**************************************************************************************/
+		/**** ClutterModel (model that produced clutter loss value) ****/
+		/**************************************************************************************/
+		enum ClutterModelEnum {
+			unknownClutterModel,
+			noneClutterModel,
+			P2108ClutterModel,
+			P452HtElAngClutterModel,
+			P452NLCDClutterModel
+		};
+		/**************************************************************************************/
+
+		/**************************************************************************************/
+		/**** BuildingPenetrationModel ****/
+		/**************************************************************************************/
+		enum BuildingPenetrationModelEnum {
+			fixedValueBuildingPenetrationModel,
+			noneBuildingPenetrationModel,
+			P2109BuildingPenetrationModel
+		};
+		/**************************************************************************************/
+
 		/**************************************************************************************/
 		/**** Global Parameters ****/
 		/**************************************************************************************/
@@ -195,7 +237,8 @@ class CConst
 		/**************************************************************************************/
 		enum LidarFormatEnum {
 			fromVectorLidarFormat, // building data comes from vector data
-			fromRasterLidarFormat // building data comes from raster data
+			fromRasterLidarFormat, // building data comes from raster data
+			compactLidarFormat // decimeter heights and building mask (lidar_compact.py)
 		};
 		/**************************************************************************************/
 
@@ -307,6 +350,10 @@ class CConst
 		static const StrTypeClass strPropEnvList[];
 		static const StrTypeClass strPropEnvMethodList[];
 		static const StrTypeClass strPathLossModelList[];
+		static const StrTypeClass strPathLossResultModelList[];
+		static const StrTypeClass strClutterModelList[];
+		static const StrTypeClass strBuildingPenetrationModelList[];
+		static const StrTypeClass strNLCDClutterList[];
 		static const StrTypeClass strLOSOptionList[];
 		static const StrTypeClass strITMClutterMethodList[];
 		static const StrTypeClass strHeightSourceList[];
@@ -197,6 +197,123 @@ bool AfcDataIf::gzipBuffer(QByteArray &input, QByteArray &output)
 	return true;
 }
 
+std::unique_ptr<AfcGzipWriter> AfcDataIf::openGzipWriter(QString fileName)
+{
+	LOGGER_DEBUG(logger) << "openGzipWriter(" << fileName << ")";
+	std::unique_ptr<AfcGzipWriter> writer(new AfcGzipWriter(this, fileName));
+	if (!writer->_ok) {
+		return nullptr;
+	}
+	return writer;
+}
+
+#define GZIP_WRITER_BUF_SIZE 65536
+
+AfcGzipWriter::AfcGzipWriter(AfcDataIf *dataIf, const QString &fileName) :
+	_dataIf(dataIf), _fileName(fileName), _started(false), _closed(false), _ok(true)
+{
+	_strm.zalloc = Z_NULL;
+	_strm.zfree = Z_NULL;
+	_strm.opaque = Z_NULL;
+	if (!_dataIf->_useUrl) {
+		_file.setFileName(fileName);
+		if (!_file.open(QFile::WriteOnly)) {
+			LOGGER_ERROR(logger)
+				<< "AfcGzipWriter(" << fileName << ") QFile.open error";
+			_ok = false;
+		}
+	}
+}
+
+AfcGzipWriter::~AfcGzipWriter()
+{
+	/* Not closed - abandoned (e.g. on exception), incomplete file removed */
+	if (!_closed) {
+		if (_started) {
+			deflateEnd(&_strm);
+		}
+		if (_file.isOpen()) {
+			_file.close();
+			_file.remove();
+		}
+	}
+}
+
+bool AfcGzipWriter::write(const char *data, size_t len)
+{
+	if (!_ok || _closed) {
+		return false;
+	}
+	if (!len) {
+		return true;
+	}
+	if (!_started) {
+		if (deflateInit2(&_strm,
+				 ZLIB_COMPRESS_LEVEL,
+				 Z_DEFLATED,
+				 ZLIB_WINDOW_BITS,
+				 ZLIB_MEMORY_LEVEL,
+				 Z_DEFAULT_STRATEGY) != Z_OK) {
+			LOGGER_ERROR(logger) << "deflateInit2 error";
+			_ok = false;
+			return false;
+		}
+		_outBuf.resize(GZIP_WRITER_BUF_SIZE);
+		_started = true;
+	}
+	_ok = deflateData(data, len, Z_NO_FLUSH);
+	return _ok;
+}
+
+bool AfcGzipWriter::close()
+{
+	if (_closed) {
+		return _ok;
+	}
+	_closed = true;
+	if (_started) {
+		_ok = _ok && deflateData(NULL, 0, Z_FINISH);
+		deflateEnd(&_strm);
+	}
+	if (!_dataIf->_useUrl) {
+		if (_file.isOpen()) {
+			_file.close();
+			_ok = _ok && (_file.error() == QFileDevice::NoError);
+		}
+	} else if (_ok) {
+		_ok = _dataIf->writeFile(_fileName, _compressed);
+	}
+	if (!_ok) {
+		LOGGER_ERROR(logger) << "AfcGzipWriter(" << _fileName << ") write error";
+	}
+	return _ok;
+}
+
+bool AfcGzipWriter::deflateData(const char *data, size_t len, int flush)
+{
+	_strm.next_in = (unsigned char *)data;
+	_strm.avail_in = len;
+	int ret;
+	do {
+		_strm.next_out = (unsigned char *)_outBuf.data();
+		_strm.avail_out = _outBuf.size();
+		ret = deflate(&_strm, flush);
+		if (ret == Z_STREAM_ERROR) {
+			LOGGER_ERROR(logger) << "deflate error";
+			return false;
+		}
+		int outLen = _outBuf.size() - _strm.avail_out;
+		if (outLen) {
+			if (_dataIf->_useUrl) {
+				_compressed.append(_outBuf.data(), outLen);
+			} else if (_file.write(_outBuf.data(), outLen) != outLen) {
+				return false;
+			}
+		}
+	} while ((_strm.avail_out == 0) || ((flush == Z_FINISH) && (ret != Z_STREAM_END)));
+	return true;
+}
+
 #if GUNZIP_INPUT_FILES
 bool AfcDataIf::gunzipBuffer(QByteArray &input, QByteArray &output)
 {
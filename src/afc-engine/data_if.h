@@ -2,9 +2,42 @@
 
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <memory>
+#include <zlib.h>
 
 #define GUNZIP_INPUT_FILES 0 /* Do input files are gzipped? */
 
+class AfcDataIf;
+
+/* Streaming gzip writer, created by AfcDataIf::openGzipWriter().
+ * Data is compressed as it is written. Local file is written as data is
+ * compressed, in URL mode compressed data is accumulated and posted by close().
+ * If no data was written, empty (not even gzip header) file is created. Writer,
+ * destroyed without close() leaves no file */
+class AfcGzipWriter
+{
+	public:
+		~AfcGzipWriter();
+		bool write(const char *data, size_t len);
+		bool close();
+
+	private:
+		friend class AfcDataIf;
+		AfcGzipWriter(AfcDataIf *dataIf, const QString &fileName);
+		bool deflateData(const char *data, size_t len, int flush);
+
+		AfcDataIf *_dataIf;
+		QString _fileName;
+		QFile _file; /* Local file (not used in URL mode) */
+		QByteArray _compressed; /* Compressed data (URL mode) */
+		QByteArray _outBuf; /* Compression output buffer */
+		z_stream _strm;
+		bool _started; /* Compression started (some data written) */
+		bool _closed;
+		bool _ok;
+};
+
 class AfcDataIf : public QObject
 {
 		Q_OBJECT
@@ -14,8 +47,10 @@ class AfcDataIf : public QObject
 		bool readFile(QString fileName, QByteArray &data);
 		bool writeFile(QString fileName, QByteArray &data);
 		bool gzipAndWriteFile(QString fileName, QByteArray &data);
+		std::unique_ptr<AfcGzipWriter> openGzipWriter(QString fileName);
 
 	private:
+		friend class AfcGzipWriter;
 		bool _useUrl;
 		QNetworkAccessManager _mngr;
 		bool gzipBuffer(QByteArray &indata, QByteArray &outdata);
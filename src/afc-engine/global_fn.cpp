@@ -8,6 +8,8 @@
 #include <sys/stat.h>
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
+#include <new>
 
 #ifdef __linux__
 	#include <unistd.h>
@@ -223,3 +225,18 @@ std::vector<std::string> splitCSV(const std::string &line)
 	return elems;
 }
 /******************************************************************************************/
+
+/******************************************************************************************/
+/**** Allocate array of numVal doubles starting on cache line boundary, release with   ****/
+/**** free().                                                                          ****/
+/******************************************************************************************/
+double *mallocCacheAligned(std::size_t numVal)
+{
+	void *ptr = NULL;
+	if (posix_memalign(&ptr, 64, std::max(numVal, (std::size_t)1) * sizeof(double)) != 0) {
+		throw std::bad_alloc();
+	}
+
+	return ((double *)ptr);
+}
+/******************************************************************************************/
@@ -14,5 +14,6 @@ int fgetline(FILE *file, std::string &s, bool keepcr = true);
 int fgetline(FILE *, char *);
 std::vector<std::string> split(const std::string &s, char delim);
 std::vector<std::string> splitCSV(const std::string &cmd);
+double *mallocCacheAligned(std::size_t numVal);
 
 #endif
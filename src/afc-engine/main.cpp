@@ -46,7 +46,12 @@ int main(int argc, char **argv)
 						    argc,
 						    argv);
 			conf.filter.setLevel(logLevel);
-			Logging::initialize(conf); // reinitialize log level
+			if (afcManager.getAsyncLogFlag()) {
+				// Worker threads don't wait for stdout writes, but records still
+				// queued when engine aborts or is killed are lost
+				conf.async = std::make_shared<Logging::AsyncConfig>();
+			}
+			Logging::initialize(conf); // reinitialize log level and sink mode
 		} catch (std::exception &err) {
 			throw std::runtime_error(ErrStream() << "Failed to parse command line "
 								"arguments provided by GUI: "
@@ -124,6 +129,8 @@ int main(int argc, char **argv)
 		afcManager.exportGUIjson(outputPath, tempDir);
 
 		LOGGER_DEBUG(logger) << "AFC Engine has exported the data for the GUI...";
+
+		afcManager.writeTimingReport();
 		/**************************************************************************************/
 
 		return 0;
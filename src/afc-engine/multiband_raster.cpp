@@ -23,15 +23,36 @@ const StrTypeClass MultibandRasterClass::strHeightResultList[] = {
 
 MultibandRasterClass::MultibandRasterClass(const std::string &rasterFile,
 					   CConst::LidarFormatEnum formatVal) :
-	_format(formatVal), _cgLidar(rasterFile, "lidar", nullptr, 2)
+	_format(formatVal)
 {
-	_cgLidar.setNoData(std::numeric_limits<float>::quiet_NaN(), 1);
-	_cgLidar.setNoData(std::numeric_limits<float>::quiet_NaN(), 2);
+	if (_format == CConst::compactLidarFormat) {
+		_cgCompact.reset(new CachedGdal<uint16_t>(rasterFile, "lidar", nullptr, 2));
+		_cgMask.reset(new CachedGdal<uint8_t>(rasterFile, "lidar_mask", nullptr, 3));
+	} else {
+		_cgLidar.reset(new CachedGdal<float>(rasterFile, "lidar", nullptr, 2));
+		_cgLidar->setNoData(std::numeric_limits<float>::quiet_NaN(), 1);
+		_cgLidar->setNoData(std::numeric_limits<float>::quiet_NaN(), 2);
+	}
 }
 
 bool MultibandRasterClass::contains(const double &lonDeg, const double &latDeg)
 {
-	return _cgLidar.covers(latDeg, lonDeg);
+	return _cgLidar ? _cgLidar->covers(latDeg, lonDeg) : _cgMask->covers(latDeg, lonDeg);
+}
+
+bool MultibandRasterClass::isBuilding(const double &latDeg,
+				      const double &lonDeg,
+				      bool directGdalMode) const
+{
+	if (_format == CConst::compactLidarFormat) {
+		// Converter only sets mask where terrain height is valid
+		uint8_t mask;
+		return _cgMask->getValueAt(latDeg, lonDeg, &mask, 3, directGdalMode) && mask;
+	}
+	double terrainHeight, bldgHeight;
+	HeightResult heightResult;
+	getHeight(latDeg, lonDeg, terrainHeight, bldgHeight, heightResult, directGdalMode);
+	return heightResult == BUILDING;
 }
 
 void MultibandRasterClass::getHeight(const double &latDeg,
@@ -41,12 +62,21 @@ void MultibandRasterClass::getHeight(const double &latDeg,
 				     HeightResult &heightResult,
 				     bool directGdalMode) const
 {
+	if (_format == CConst::compactLidarFormat) {
+		getCompactHeight(latDeg,
+				 lonDeg,
+				 terrainHeight,
+				 bldgHeight,
+				 heightResult,
+				 directGdalMode);
+		return;
+	}
 	float terrainHeightF = std::numeric_limits<float>::quiet_NaN();
 	float bldgHeightF = std::numeric_limits<float>::quiet_NaN();
-	if (_cgLidar.covers(latDeg, lonDeg)) {
-		if (!_cgLidar.getValueAt(latDeg, lonDeg, &terrainHeightF, 1, directGdalMode)) {
+	if (_cgLidar->covers(latDeg, lonDeg)) {
+		if (!_cgLidar->getValueAt(latDeg, lonDeg, &terrainHeightF, 1, directGdalMode)) {
 			heightResult = NO_DATA;
-		} else if (!_cgLidar.getValueAt(latDeg, lonDeg, &bldgHeightF, 2, directGdalMode)) {
+		} else if (!_cgLidar->getValueAt(latDeg, lonDeg, &bldgHeightF, 2, directGdalMode)) {
 			heightResult = (_format == CConst::fromVectorLidarFormat) ? NO_BUILDING :
 										    NO_DATA;
 		} else if ((_format == CConst::fromRasterLidarFormat) &&
@@ -62,4 +92,32 @@ void MultibandRasterClass::getHeight(const double &latDeg,
 	terrainHeight = terrainHeightF;
 	bldgHeight = bldgHeightF;
 }
+
+void MultibandRasterClass::getCompactHeight(const double &latDeg,
+					    const double &lonDeg,
+					    double &terrainHeight,
+					    double &bldgHeight,
+					    HeightResult &heightResult,
+					    bool directGdalMode) const
+{
+	uint16_t terrainDm, bldgDm;
+	uint8_t mask;
+	terrainHeight = std::numeric_limits<double>::quiet_NaN();
+	bldgHeight = std::numeric_limits<double>::quiet_NaN();
+	if (!_cgCompact->covers(latDeg, lonDeg)) {
+		heightResult = OUTSIDE_REGION;
+	} else if (!_cgCompact->getValueAt(latDeg, lonDeg, &terrainDm, 1, directGdalMode)) {
+		heightResult = NO_DATA;
+	} else {
+		terrainHeight = COMPACT_TERRAIN_OFFSET + terrainDm * COMPACT_HEIGHT_SCALE;
+		// Building height band is only read where mask says there is a building
+		if (_cgMask->getValueAt(latDeg, lonDeg, &mask, 3, directGdalMode) && mask &&
+		    _cgCompact->getValueAt(latDeg, lonDeg, &bldgDm, 2, directGdalMode)) {
+			heightResult = BUILDING;
+			bldgHeight = bldgDm * COMPACT_HEIGHT_SCALE;
+		} else {
+			heightResult = NO_BUILDING;
+		}
+	}
+}
 /******************************************************************************************/
@@ -9,6 +9,7 @@
 #include "cconst.h"
 #include <boost/core/noncopyable.hpp>
 #include "str_type.h"
+#include <memory>
 #include <string>
 
 /******************************************************************************************/
@@ -27,6 +28,11 @@ class MultibandRasterClass : private boost::noncopyable
 				 // valid values
 		};
 
+		// Scale (meters per unit) of heights in compactLidarFormat files
+		static constexpr double COMPACT_HEIGHT_SCALE = 0.1;
+		// Offset (meters) of terrain heights in compactLidarFormat files
+		static constexpr double COMPACT_TERRAIN_OFFSET = -1000.0;
+
 		MultibandRasterClass(const std::string &rasterFile,
 				     CConst::LidarFormatEnum formatVal);
 
@@ -38,13 +44,33 @@ class MultibandRasterClass : private boost::noncopyable
 			       double &bldgHeight,
 			       HeightResult &heightResult,
 			       bool directGdalMode = false) const;
+		// Returns true if there is a building at a specified (lat/lon) point (i.e. if
+		// getHeight() would return BUILDING). For compactLidarFormat only building mask
+		// is read
+		bool isBuilding(const double &latDeg,
+				const double &lonDeg,
+				bool directGdalMode = false) const;
 		bool contains(const double &latDeg, const double &lonDeg);
 
 		static const StrTypeClass strHeightResultList[];
 
 	private:
+		// getHeight() for compactLidarFormat
+		void getCompactHeight(const double &latDeg,
+				      const double &lonDeg,
+				      double &terrainHeight,
+				      double &bldgHeight,
+				      HeightResult &heightResult,
+				      bool directGdalMode) const;
+
 		CConst::LidarFormatEnum _format;
-		mutable CachedGdal<float> _cgLidar;
+		// Terrain and building height bands of fromVectorLidarFormat and
+		// fromRasterLidarFormat files
+		mutable std::unique_ptr<CachedGdal<float>> _cgLidar;
+		// Terrain and building height bands of compactLidarFormat files
+		mutable std::unique_ptr<CachedGdal<uint16_t>> _cgCompact;
+		// Building mask band of compactLidarFormat files
+		mutable std::unique_ptr<CachedGdal<uint8_t>> _cgMask;
 };
 /******************************************************************************************/
 
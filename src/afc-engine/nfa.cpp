@@ -11,7 +11,10 @@
 #include <iomanip>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include "AfcDefinitions.h"
+#include "global_fn.h"
+#include "ratcommon/MappedCsvReader.h"
 
 /******************************************************************************************/
 /**** CONSTRUCTOR: NFAClass::NFAClass()                                                ****/
@@ -19,7 +22,7 @@
 NFAClass::NFAClass()
 {
 	tableFile = "";
-	nfaTable = (double ***)NULL;
+	nfaTable = (double *)NULL;
 	numxdb = -1;
 	numu = -1;
 	numeff = -1;
@@ -42,15 +45,7 @@ NFAClass::NFAClass(std::string tableFileVal) : tableFile(tableFileVal)
 /******************************************************************************************/
 NFAClass::~NFAClass()
 {
-	if (nfaTable) {
-		for (int xdbIdx = 0; xdbIdx < numxdb; ++xdbIdx) {
-			for (int uIdx = 0; uIdx < numu; ++uIdx) {
-				free(nfaTable[xdbIdx][uIdx]);
-			}
-			free(nfaTable[xdbIdx]);
-		}
-		free(nfaTable);
-	}
+	free(nfaTable);
 };
 /******************************************************************************************/
 
@@ -59,7 +54,6 @@ NFAClass::~NFAClass()
 /******************************************************************************************/
 void NFAClass::readTable()
 {
-	string line;
 	vector<string> headerList;
 	vector<vector<double>> datastore;
 	// data structure
@@ -80,30 +74,20 @@ void NFAClass::readTable()
 	double mineff = quietNaN;
 	double maxeff = quietNaN;
 
-	ifstream file(tableFile);
-	if (!file.is_open()) {
+	std::unique_ptr<MappedCsvReader> reader;
+	try {
+		reader.reset(new MappedCsvReader(tableFile));
+	} catch (const MappedCsvReader::FileError &) {
 		errStr << std::string("ERROR: Unable to open Near Field Adjustment File \"") +
 				  tableFile + std::string("\"\n");
 		throw std::runtime_error(errStr.str());
 	}
 	int linenum = 0;
+	std::vector<MappedCsvReader::Field> current_row;
 
-	while (getline(file, line)) {
+	while (reader->readRow(current_row)) {
 		linenum++;
-		vector<string> current_row;
-
-		size_t last = 0;
-		size_t next = 0;
-		bool found_last_comma = false;
 
-		while (!found_last_comma) {
-			if ((next = line.find(',', last)) == string::npos) {
-				found_last_comma = true;
-			}
-
-			current_row.push_back(line.substr(last, next - last));
-			last = next + 1;
-		}
 		if (current_row.size() != 4) {
 			errStr << std::string("ERROR: Near Field Adjustment File ") << tableFile
 			       << ":" << linenum << " INVALID DATA\n";
@@ -112,12 +96,14 @@ void NFAClass::readTable()
 		if (linenum == 1) {
 		} else {
 			vector<double> doubleVector(current_row.size());
-			transform(current_row.begin(),
-				  current_row.end(),
-				  doubleVector.begin(),
-				  [](const std::string &val) {
-					  return std::stod(val);
-				  });
+			for (size_t fieldIdx = 0; fieldIdx < current_row.size(); ++fieldIdx) {
+				if (!MappedCsvReader::toDouble(current_row[fieldIdx],
+							       doubleVector[fieldIdx])) {
+					errStr << std::string("ERROR: Near Field Adjustment File ")
+					       << tableFile << ":" << linenum << " INVALID DATA\n";
+					throw std::runtime_error(errStr.str());
+				}
+			}
 			datastore.push_back(doubleVector);
 
 			double xdb = doubleVector[0];
@@ -160,16 +146,8 @@ void NFAClass::readTable()
 
 	int xdbIdx, uIdx, effIdx;
 
-	nfaTable = (double ***)malloc(numxdb * sizeof(double **));
-	for (xdbIdx = 0; xdbIdx < numxdb; ++xdbIdx) {
-		nfaTable[xdbIdx] = (double **)malloc(numu * sizeof(double *));
-		for (uIdx = 0; uIdx < numu; ++uIdx) {
-			nfaTable[xdbIdx][uIdx] = (double *)malloc(numeff * sizeof(double));
-			for (effIdx = 0; effIdx < numeff; ++effIdx) {
-				nfaTable[xdbIdx][uIdx][effIdx] = quietNaN;
-			}
-		}
-	}
+	nfaTable = mallocCacheAligned((std::size_t)numxdb * numu * numeff);
+	std::fill(nfaTable, nfaTable + (std::size_t)numxdb * numu * numeff, quietNaN);
 
 	double xdb, u, eff, nfa;
 
@@ -185,16 +163,17 @@ void NFAClass::readTable()
 		xdbIdx = (int)floor(((xdb - xdbStart) / xdbStep) + 0.5);
 		uIdx = (int)floor(((u - uStart) / uStep) + 0.5);
 		effIdx = (int)floor(((eff - effStart) / effStep) + 0.5);
-		nfaTable[xdbIdx][uIdx][effIdx] = nfa;
+		nfaTable[(xdbIdx * numu + uIdx) * numeff + effIdx] = nfa;
 	}
 
 	for (xdbIdx = 0; xdbIdx < numxdb; ++xdbIdx) {
 		for (effIdx = 0; effIdx < numeff; ++effIdx) {
 			bool foundDataStart = false;
 			for (uIdx = numu - 1; uIdx >= 0; --uIdx) {
-				if (std::isnan(nfaTable[xdbIdx][uIdx][effIdx])) {
+				double &nfaVal = nfaTable[(xdbIdx * numu + uIdx) * numeff + effIdx];
+				if (std::isnan(nfaVal)) {
 					if (!foundDataStart) {
-						nfaTable[xdbIdx][uIdx][effIdx] = 0.0;
+						nfaVal = 0.0;
 					} else {
 						xdb = xdbStart + xdbIdx * xdbStep;
 						u = uStart + uIdx * uStep;
@@ -219,9 +198,10 @@ void NFAClass::readTable()
 /******************************************************************************************/
 
 /******************************************************************************************/
-/**** FUNCTION: NFAClass::computeNFA()                                                 ****/
+/**** FUNCTION: NFAClass::interpNFA()                                                  ****/
+/**** Trilinear interpolation, values outside of table are clamped to table edges.     ****/
 /******************************************************************************************/
-double NFAClass::computeNFA(double xdb, double u, double eff)
+inline double NFAClass::interpNFA(double xdb, double u, double eff) const
 {
 	double xdbIdxDbl = (xdb - xdbStart) / xdbStep;
 	double uIdxDbl = (u - uStart) / uStep;
@@ -245,41 +225,57 @@ double NFAClass::computeNFA(double xdb, double u, double eff)
 		effIdxDbl = (double)numeff - 1;
 	}
 
-	int xdbIdx0 = (int)floor(xdbIdxDbl);
+	int xdbIdx0 = (int)xdbIdxDbl;
 	if (xdbIdx0 == numxdb - 1) {
 		xdbIdx0 = numxdb - 2;
 	}
 
-	int uIdx0 = (int)floor(uIdxDbl);
+	int uIdx0 = (int)uIdxDbl;
 	if (uIdx0 == numu - 1) {
 		uIdx0 = numu - 2;
 	}
 
-	int effIdx0 = (int)floor(effIdxDbl);
+	int effIdx0 = (int)effIdxDbl;
 	if (effIdx0 == numeff - 1) {
 		effIdx0 = numeff - 2;
 	}
 
-	double F000 = nfaTable[xdbIdx0][uIdx0][effIdx0];
-	double F001 = nfaTable[xdbIdx0][uIdx0][effIdx0 + 1];
-	double F010 = nfaTable[xdbIdx0][uIdx0 + 1][effIdx0];
-	double F011 = nfaTable[xdbIdx0][uIdx0 + 1][effIdx0 + 1];
-	double F100 = nfaTable[xdbIdx0 + 1][uIdx0][effIdx0];
-	double F101 = nfaTable[xdbIdx0 + 1][uIdx0][effIdx0 + 1];
-	double F110 = nfaTable[xdbIdx0 + 1][uIdx0 + 1][effIdx0];
-	double F111 = nfaTable[xdbIdx0 + 1][uIdx0 + 1][effIdx0 + 1];
-
-	double nfa =
-		F000 * (xdbIdx0 + 1 - xdbIdxDbl) * (uIdx0 + 1 - uIdxDbl) *
-			(effIdx0 + 1 - effIdxDbl) +
-		F001 * (xdbIdx0 + 1 - xdbIdxDbl) * (uIdx0 + 1 - uIdxDbl) * (effIdxDbl - effIdx0) +
-		F010 * (xdbIdx0 + 1 - xdbIdxDbl) * (uIdxDbl - uIdx0) * (effIdx0 + 1 - effIdxDbl) +
-		F011 * (xdbIdx0 + 1 - xdbIdxDbl) * (uIdxDbl - uIdx0) * (effIdxDbl - effIdx0) +
-		F100 * (xdbIdxDbl - xdbIdx0) * (uIdx0 + 1 - uIdxDbl) * (effIdx0 + 1 - effIdxDbl) +
-		F101 * (xdbIdxDbl - xdbIdx0) * (uIdx0 + 1 - uIdxDbl) * (effIdxDbl - effIdx0) +
-		F110 * (xdbIdxDbl - xdbIdx0) * (uIdxDbl - uIdx0) * (effIdx0 + 1 - effIdxDbl) +
-		F111 * (xdbIdxDbl - xdbIdx0) * (uIdxDbl - uIdx0) * (effIdxDbl - effIdx0);
+	// Corners along eff are adjacent, corners along u are numeff apart
+	const double *F00 = nfaTable + (xdbIdx0 * numu + uIdx0) * numeff + effIdx0;
+	const double *F10 = F00 + numu * numeff;
+
+	double wx0 = xdbIdx0 + 1 - xdbIdxDbl;
+	double wx1 = xdbIdxDbl - xdbIdx0;
+	double wu0 = uIdx0 + 1 - uIdxDbl;
+	double wu1 = uIdxDbl - uIdx0;
+	double we0 = effIdx0 + 1 - effIdxDbl;
+	double we1 = effIdxDbl - effIdx0;
+
+	double nfa = F00[0] * wx0 * wu0 * we0 + F00[1] * wx0 * wu0 * we1 +
+		     F00[numeff] * wx0 * wu1 * we0 + F00[numeff + 1] * wx0 * wu1 * we1 +
+		     F10[0] * wx1 * wu0 * we0 + F10[1] * wx1 * wu0 * we1 +
+		     F10[numeff] * wx1 * wu1 * we0 + F10[numeff + 1] * wx1 * wu1 * we1;
 
 	return (nfa);
 }
 /******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: NFAClass::computeNFA()                                                 ****/
+/******************************************************************************************/
+double NFAClass::computeNFA(double xdb, double u, double eff)
+{
+	return (interpNFA(xdb, u, eff));
+}
+
+void NFAClass::computeNFA(int n,
+			  const double *xdbList,
+			  const double *uList,
+			  const double *effList,
+			  double *nfaList)
+{
+	for (int i = 0; i < n; ++i) {
+		nfaList[i] = interpNFA(xdbList[i], uList[i], effList[i]);
+	}
+}
+/******************************************************************************************/
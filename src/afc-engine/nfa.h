@@ -21,11 +21,21 @@ class NFAClass
 
 		double computeNFA(double xdb, double u, double eff);
 
+		// Computes nfaList[i] = computeNFA(xdbList[i], uList[i], effList[i]) for n values
+		void computeNFA(int n,
+				const double *xdbList,
+				const double *uList,
+				const double *effList,
+				double *nfaList);
+
 	private:
 		void readTable();
+		inline double interpNFA(double xdb, double u, double eff) const;
 
 		std::string tableFile;
-		double ***nfaTable;
+		// Flat, cache aligned table, value at (xdbIdx, uIdx, effIdx) is
+		// nfaTable[(xdbIdx*numu + uIdx)*numeff + effIdx]
+		double *nfaTable;
 		int numxdb, numu, numeff;
 		double xdbStart, uStart, effStart;
 		double xdbStep, uStep, effStep;
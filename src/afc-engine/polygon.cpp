@@ -7,11 +7,20 @@
 #include <sstream>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 #include "global_defines.h"
 #include "global_fn.h"
 #include "polygon.h"
 
+#include "afclogging/Logging.h"
+
+namespace
+{
+// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "PolygonClass")
+}
+
 /******************************************************************************************/
 /**** FUNCTION: PolygonClass::PolygonClass                                             ****/
 /******************************************************************************************/
@@ -615,6 +624,8 @@ void PolygonClass::translate(int x, int y)
 {
 	int i, segment_idx, n;
 
+	mask.clear();
+
 	for (segment_idx = 0; segment_idx <= num_segment - 1; segment_idx++) {
 		n = num_bdy_pt[segment_idx];
 		for (i = 0; i <= n - 1; i++) {
@@ -677,6 +688,27 @@ bool PolygonClass::in_bdy_area(const int a, const int b, bool *edge)
 	if (edge) {
 		*edge = false;
 	}
+
+	if (!mask.empty()) {
+		if ((a < maskMinX) || (b < maskMinY)) {
+			return (false);
+		}
+		int cx = (a - maskMinX) / maskCellSize;
+		int cy = (b - maskMinY) / maskCellSize;
+		if ((cx >= maskNumX) || (cy >= maskNumY)) {
+			return (false);
+		}
+		switch (mask[(std::size_t)cy * maskNumX + cx]) {
+			case maskInside:
+				return (true);
+			case maskOutside:
+				return (false);
+			default:
+				// Cell crossed by boundary - exact computation needed
+				break;
+		}
+	}
+
 	n = 0;
 	for (segment_idx = 0; segment_idx <= num_segment - 1; segment_idx++) {
 		n += in_bdy_area(a,
@@ -695,6 +727,140 @@ bool PolygonClass::in_bdy_area(const int a, const int b, bool *edge)
 
 	return (n & 1 ? true : false);
 }
+/******************************************************************************************/
+/**** FUNCTION: PolygonClass::buildMask                                                ****/
+/**** Build raster mask that makes in_bdy_area() O(1) for points in cells not crossed  ****/
+/**** by boundary. Grid covers bounding box with at most maxCellsPerDim cells in each  ****/
+/**** dimension. Inside/outside state of each cell is determined by crossing number of ****/
+/**** horizontal line through cell centers.                                            ****/
+/******************************************************************************************/
+void PolygonClass::buildMask(int maxCellsPerDim)
+{
+	int segment_idx, i, n, cx, cy;
+
+	mask.clear();
+	if (num_segment == 0) {
+		return;
+	}
+
+	int minx, maxx, miny, maxy;
+	comp_bdy_min_max(minx, maxx, miny, maxy);
+
+	long long extent = std::max((long long)maxx - minx, (long long)maxy - miny) + 1;
+	maskCellSize = (int)std::max(1LL, (extent + maxCellsPerDim - 1) / maxCellsPerDim);
+	maskMinX = minx;
+	maskMinY = miny;
+	maskNumX = (maxx - minx) / maskCellSize + 1;
+	maskNumY = (maxy - miny) / maskCellSize + 1;
+	mask.assign((std::size_t)maskNumX * maskNumY, maskOutside);
+
+	// X coordinates of boundary crossings of horizontal line through centers of each row
+	std::vector<std::vector<double>> rowCrossings(maskNumY);
+
+	for (segment_idx = 0; segment_idx <= num_segment - 1; segment_idx++) {
+		n = num_bdy_pt[segment_idx];
+		int *x = bdy_pt_x[segment_idx];
+		int *y = bdy_pt_y[segment_idx];
+		for (i = 0; i <= n - 1; i++) {
+			int x1 = x[i];
+			int y1 = y[i];
+			int x2 = x[(i + 1) % n];
+			int y2 = y[(i + 1) % n];
+
+			markMaskEdge(x1, y1, x2, y2);
+
+			if (y1 == y2) {
+				continue;
+			}
+			// Edge crosses row center line yc if yLo <= yc < yHi
+			double yLo = std::min(y1, y2);
+			double yHi = std::max(y1, y2);
+			cy = std::max((int)floor((yLo - maskMinY) / maskCellSize - 0.5), 0);
+			for (; cy < maskNumY; cy++) {
+				double yc = maskMinY + (cy + 0.5) * maskCellSize;
+				if (yc < yLo) {
+					continue;
+				}
+				if (yc >= yHi) {
+					break;
+				}
+				rowCrossings[cy].push_back(x1 + ((double)x2 - x1) * (yc - y1) /
+								    (y2 - y1));
+			}
+		}
+	}
+
+	int numEdgeCell = 0;
+	for (cy = 0; cy < maskNumY; cy++) {
+		std::vector<double> &crossings = rowCrossings[cy];
+		std::sort(crossings.begin(), crossings.end());
+		std::size_t numLeft = 0;
+		for (cx = 0; cx < maskNumX; cx++) {
+			double xc = maskMinX + (cx + 0.5) * maskCellSize;
+			while ((numLeft < crossings.size()) && (crossings[numLeft] < xc)) {
+				numLeft++;
+			}
+			unsigned char &cell = mask[(std::size_t)cy * maskNumX + cx];
+			if (cell == maskEdge) {
+				numEdgeCell++;
+			} else {
+				cell = (numLeft & 1) ? maskInside : maskOutside;
+			}
+		}
+	}
+
+	LOGGER_DEBUG(logger) << "Polygon " << name << " mask: " << maskNumX << " x " << maskNumY
+			     << " cells of " << maskCellSize << " x " << maskCellSize << ", "
+			     << 100.0 * numEdgeCell / mask.size() << " % crossed by boundary";
+
+	return;
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PolygonClass::markMaskEdge                                             ****/
+/**** Mark mask cells, whose closed area intersects given boundary edge, as crossed by ****/
+/**** boundary. Marking is conservative (may mark some neighboring cells as well).     ****/
+/******************************************************************************************/
+void PolygonClass::markMaskEdge(int x1, int y1, int x2, int y2)
+{
+	if (x1 > x2) {
+		std::swap(x1, x2);
+		std::swap(y1, y2);
+	}
+	// Half-point margins protect against rounding errors and take care of edges, touching
+	// cell boundaries
+	int cxStart = std::max((int)floor((x1 - 0.5 - maskMinX) / maskCellSize), 0);
+	int cxStop = std::min((int)floor((x2 + 0.5 - maskMinX) / maskCellSize), maskNumX - 1);
+	for (int cx = cxStart; cx <= cxStop; cx++) {
+		// Part of edge within closed column
+		double colMinX = maskMinX + (double)cx * maskCellSize;
+		double colMaxX = colMinX + maskCellSize;
+		double xa = std::min(std::max((double)x1, colMinX), (double)x2);
+		double xb = std::max(std::min((double)x2, colMaxX), (double)x1);
+		double ya, yb;
+		if (x1 == x2) {
+			ya = y1;
+			yb = y2;
+		} else {
+			ya = y1 + ((double)y2 - y1) * (xa - x1) / (x2 - x1);
+			yb = y1 + ((double)y2 - y1) * (xb - x1) / (x2 - x1);
+		}
+		if (ya > yb) {
+			std::swap(ya, yb);
+		}
+		int cyStart = std::max((int)floor((ya - 0.5 - maskMinY) / maskCellSize), 0);
+		int cyStop = std::min((int)floor((yb + 0.5 - maskMinY) / maskCellSize),
+				      maskNumY - 1);
+		for (int cy = cyStart; cy <= cyStop; cy++) {
+			mask[(std::size_t)cy * maskNumX + cx] = maskEdge;
+		}
+	}
+
+	return;
+}
+/******************************************************************************************/
+
 /******************************************************************************************/
 /**** FUNCTION: PolygonClass::duplicate                                                ****/
 /******************************************************************************************/
@@ -5,6 +5,7 @@
 #ifndef POLYGON_H
 #define POLYGON_H
 
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -22,6 +23,7 @@ class PolygonClass
 		static std::vector<PolygonClass *> readMultiGeometry(std::string kmlFilename,
 								     double resolution);
 		bool in_bdy_area(const int a, const int b, bool *edge = (bool *)NULL);
+		void buildMask(int maxCellsPerDim = 2048);
 		double comp_bdy_area();
 		void comp_bdy_min_max(int &minx, int &maxx, int &miny, int &maxy);
 		void remove_duplicate_points(int segment_idx);
@@ -53,6 +55,14 @@ class PolygonClass
 				      int &miny,
 				      int &maxy,
 				      const int segment_idx);
+		void markMaskEdge(int x1, int y1, int x2, int y2);
+
+		// Raster mask, built by buildMask(). Each cell of maskCellSize x maskCellSize
+		// points is either entirely inside, entirely outside or crossed by boundary (only
+		// the latter require exact in_bdy_area() computation). Empty if not built
+		enum MaskCellEnum { maskOutside = 0, maskInside = 1, maskEdge = 2 };
+		std::vector<unsigned char> mask;
+		int maskMinX, maskMinY, maskCellSize, maskNumX, maskNumY;
 };
 /******************************************************************************************/
 
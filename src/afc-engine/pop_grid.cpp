@@ -9,6 +9,8 @@
 #include <math.h>
 #include <stdexcept>
 #include <iomanip>
+#include <algorithm>
+#include <memory>
 #include <ogr_spatialref.h>
 
 #include "gdal_priv.h"
@@ -24,6 +26,7 @@
 #include "list.h"
 #include "uls.h"
 #include "EcefModel.h"
+#include "GridCache.h"
 
 #include "afclogging/Logging.h"
 #include "afclogging/ErrStream.h"
@@ -55,9 +58,6 @@ PopGridClass::PopGridClass(double densityThrUrbanVal,
 	numLon = 0;
 	numLat = 0;
 
-	pop = (double **)NULL;
-	propEnv = (char **)NULL;
-	region = (int **)NULL;
 	numRegion = (int)regionNameList.size();
 
 	isCumulative = false;
@@ -76,7 +76,8 @@ PopGridClass::PopGridClass(std::string worldPopulationFile,
 			   double minLat,
 			   double minLon,
 			   double maxLat,
-			   double maxLon) :
+			   double maxLon,
+			   const std::string &cacheDir) :
 	densityThrUrban(densityThrUrbanVal),
 	densityThrSuburban(densityThrSuburbanVal),
 	densityThrRural(densityThrRuralVal)
@@ -86,11 +87,125 @@ PopGridClass::PopGridClass(std::string worldPopulationFile,
 	// first.  For example, if regions are defined for india and asia, specifying india first
 	// effectively defines two regions as india and "asia except india".
 
-	std::ostringstream errStr;
 	if (worldPopulationFile.empty()) {
 		throw std::invalid_argument("worldPopulationFile is empty");
 	}
 
+	numRegion = regionPolygonList.size();
+	isCumulative = false;
+
+	if (cacheDir.empty()) {
+		readWorldPopulationFile(worldPopulationFile,
+					regionPolygonList,
+					regionPolygonResolution,
+					minLat,
+					minLon,
+					maxLat,
+					maxLon);
+		return;
+	}
+
+	/**************************************************************************************/
+	/**** Cached grid covers analysis region expanded to whole degrees, so that it may ****/
+	/**** be reused by subsequent requests with nearby analysis regions.               ****/
+	/**************************************************************************************/
+	double cacheMinLat = std::max(floor(minLat), -90.0);
+	double cacheMaxLat = std::min(ceil(maxLat), 90.0);
+	double cacheMinLon = floor(minLon);
+	double cacheMaxLon = ceil(maxLon);
+
+	GridCache::KeyBuilder keyBuilder;
+	keyBuilder.addString("popgrid")
+		.addFile(worldPopulationFile)
+		.add(regionPolygonResolution)
+		.add(densityThrUrban)
+		.add(densityThrSuburban)
+		.add(densityThrRural)
+		.add(cacheMinLat)
+		.add(cacheMinLon)
+		.add(cacheMaxLat)
+		.add(cacheMaxLon);
+	for (auto regionPolygon : regionPolygonList) {
+		keyBuilder.addString(regionPolygon->name).add(regionPolygon->num_segment);
+		for (int segIdx = 0; segIdx < regionPolygon->num_segment; ++segIdx) {
+			int numPt = regionPolygon->num_bdy_pt[segIdx];
+			keyBuilder.add(numPt)
+				.addBytes(regionPolygon->bdy_pt_x[segIdx], numPt * sizeof(int))
+				.addBytes(regionPolygon->bdy_pt_y[segIdx], numPt * sizeof(int));
+		}
+	}
+	std::string cacheFile = GridCache::filename(cacheDir, "popgrid", keyBuilder.key());
+
+	std::unique_ptr<GridCache> gridCache = GridCache::open(cacheFile, keyBuilder.key());
+	if (gridCache) {
+		LOGGER_INFO(logger) << "Using cached population grid " << cacheFile;
+		const int32_t *dims = gridCache->next<int32_t>(2);
+		const double *geo = gridCache->next<double>(4);
+		GridView src;
+		src.numLon = dims[0];
+		src.numLat = dims[1];
+		src.minLonDeg = geo[0];
+		src.minLatDeg = geo[1];
+		src.deltaLonDeg = geo[2];
+		src.deltaLatDeg = geo[3];
+		std::size_t size = (std::size_t)src.numLon * src.numLat;
+		src.pop = gridCache->next<double>(size);
+		src.region = gridCache->next<int>(size);
+		src.propEnv = gridCache->next<char>(size);
+		cropFrom(src, regionPolygonResolution, minLat, minLon, maxLat, maxLon);
+		return;
+	}
+
+	PopGridClass cached(densityThrUrban, densityThrSuburban, densityThrRural);
+	cached.numRegion = numRegion;
+	cached.readWorldPopulationFile(worldPopulationFile,
+				       regionPolygonList,
+				       regionPolygonResolution,
+				       cacheMinLat,
+				       cacheMinLon,
+				       cacheMaxLat,
+				       cacheMaxLon);
+	int32_t dims[2] = {cached.numLon, cached.numLat};
+	double geo[4] = {cached.minLonDeg,
+			 cached.minLatDeg,
+			 cached.deltaLonDeg,
+			 cached.deltaLatDeg};
+	GridCache::write(cacheFile,
+			 keyBuilder.key(),
+			 {GridCache::Chunk(dims, sizeof(dims)),
+			  GridCache::Chunk(geo, sizeof(geo)),
+			  GridCache::Chunk(cached.pop.data(), cached.pop.size() * sizeof(double)),
+			  GridCache::Chunk(cached.region.data(),
+					   cached.region.size() * sizeof(int)),
+			  GridCache::Chunk(cached.propEnv.data(), cached.propEnv.size())});
+
+	GridView src;
+	src.numLon = cached.numLon;
+	src.numLat = cached.numLat;
+	src.minLonDeg = cached.minLonDeg;
+	src.minLatDeg = cached.minLatDeg;
+	src.deltaLonDeg = cached.deltaLonDeg;
+	src.deltaLatDeg = cached.deltaLatDeg;
+	src.pop = cached.pop.data();
+	src.region = cached.region.data();
+	src.propEnv = cached.propEnv.data();
+	cropFrom(src, regionPolygonResolution, minLat, minLon, maxLat, maxLon);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PopGridClass::readWorldPopulationFile()                                ****/
+/**** Fills grid for given analysis region from world population GDAL file.            ****/
+/******************************************************************************************/
+void PopGridClass::readWorldPopulationFile(std::string worldPopulationFile,
+					   const std::vector<PolygonClass *> &regionPolygonList,
+					   double regionPolygonResolution,
+					   double minLat,
+					   double minLon,
+					   double maxLat,
+					   double maxLon)
+{
+	std::ostringstream errStr;
 	int regionIdx;
 
 #if DEBUG_AFC
@@ -106,8 +221,6 @@ PopGridClass::PopGridClass(std::string worldPopulationFile,
 	}
 #endif
 
-	numRegion = regionPolygonList.size();
-
 	std::cout << "Loading world polulation file " << worldPopulationFile << std::endl;
 
 	GDALDataset *gdalDataset = static_cast<GDALDataset *>(
@@ -290,19 +403,9 @@ PopGridClass::PopGridClass(std::string worldPopulationFile,
 	/**************************************************************************************/
 	/**** Allocate matrix and initialize to zeros                                      ****/
 	/**************************************************************************************/
-	pop = (double **)malloc(numLon * sizeof(double *));
-	propEnv = (char **)malloc(numLon * sizeof(char *));
-	region = (int **)malloc(numLon * sizeof(int *));
-	for (int lonIdx = 0; lonIdx < numLon; lonIdx++) {
-		pop[lonIdx] = (double *)malloc(numLat * sizeof(double));
-		propEnv[lonIdx] = (char *)malloc(numLat * sizeof(char));
-		region[lonIdx] = (int *)malloc(numLat * sizeof(int));
-		for (int latIdx = 0; latIdx < numLat; latIdx++) {
-			pop[lonIdx][latIdx] = 0.0;
-			propEnv[lonIdx][latIdx] = 'X';
-			region[lonIdx][latIdx] = -1;
-		}
-	}
+	pop.assign((std::size_t)numLon * numLat, 0.0);
+	propEnv.assign((std::size_t)numLon * numLat, 'X');
+	region.assign((std::size_t)numLon * numLat, -1);
 	isCumulative = false;
 	/**************************************************************************************/
 
@@ -413,8 +516,8 @@ PopGridClass::PopGridClass(std::string worldPopulationFile,
 						double area = areaGridEquator *
 							      cos(latitudeDeg * M_PI / 180.0);
 
-						pop[lonIdx][latIdx] = density * area;
-						region[lonIdx][latIdx] = regionIdx;
+						pop[idx(lonIdx, latIdx)] = density * area;
+						region[idx(lonIdx, latIdx)] = regionIdx;
 
 						if (density == 0.0) {
 							zeroArea[regionIdx] += area;
@@ -425,29 +528,29 @@ PopGridClass::PopGridClass(std::string worldPopulationFile,
 							if (density != 0.0) {
 								urbanArea[regionIdx] += area;
 							}
-							propEnv[lonIdx][latIdx] = 'U';
+							propEnv[idx(lonIdx, latIdx)] = 'U';
 						} else if (density >= densityThrSuburban) {
 							suburbanPop[regionIdx] += density * area;
 							if (density != 0.0) {
 								suburbanArea[regionIdx] += area;
 							}
-							propEnv[lonIdx][latIdx] = 'S';
+							propEnv[idx(lonIdx, latIdx)] = 'S';
 						} else if (density >= densityThrRural) {
 							ruralPop[regionIdx] += density * area;
 							if (density != 0.0) {
 								ruralArea[regionIdx] += area;
 							}
-							propEnv[lonIdx][latIdx] = 'R';
+							propEnv[idx(lonIdx, latIdx)] = 'R';
 						} else {
 							barrenPop[regionIdx] += density * area;
 							if (density != 0.0) {
 								barrenArea[regionIdx] += area;
 							}
-							propEnv[lonIdx][latIdx] = 'B';
+							propEnv[idx(lonIdx, latIdx)] = 'B';
 						}
 
 						totalArea += area;
-						totalPop += pop[lonIdx][latIdx];
+						totalPop += pop[idx(lonIdx, latIdx)];
 
 #if DEBUG_AFC
 						if (fchk) {
@@ -537,6 +640,99 @@ PopGridClass::PopGridClass(std::string worldPopulationFile,
 }
 /******************************************************************************************/
 
+/******************************************************************************************/
+/**** FUNCTION: PopGridClass::cropFrom()                                               ****/
+/**** Fills grid for given analysis region from bigger grid (that must contain the     ****/
+/**** region and be aligned with world population file pixels), computes totals.       ****/
+/******************************************************************************************/
+void PopGridClass::cropFrom(const GridView &src,
+			    double regionPolygonResolution,
+			    double minLat,
+			    double minLon,
+			    double maxLat,
+			    double maxLon)
+{
+	int regionIdx;
+
+	// Region boundaries computed the same way as in readWorldPopulationFile()
+	double regionMinLonDeg = floor(minLon / regionPolygonResolution) * regionPolygonResolution;
+	double regionMaxLonDeg = (floor(maxLon / regionPolygonResolution) + 1) *
+				 regionPolygonResolution;
+	double regionMinLatDeg = floor(minLat / regionPolygonResolution) * regionPolygonResolution;
+	double regionMaxLatDeg = (floor(maxLat / regionPolygonResolution) + 1) *
+				 regionPolygonResolution;
+
+	int lonOffset = (int)floor((regionMinLonDeg - src.minLonDeg) / src.deltaLonDeg + 0.5);
+	int lonEnd = (int)floor((regionMaxLonDeg - src.minLonDeg) / src.deltaLonDeg + 0.5);
+	int latOffset = (int)floor((regionMinLatDeg - src.minLatDeg) / src.deltaLatDeg + 0.5);
+	int latEnd = (int)floor((regionMaxLatDeg - src.minLatDeg) / src.deltaLatDeg + 0.5);
+
+	lonOffset = std::max(lonOffset, 0);
+	latOffset = std::max(latOffset, 0);
+	lonEnd = std::min(lonEnd, src.numLon);
+	latEnd = std::min(latEnd, src.numLat);
+
+	/**************************************************************************************/
+	/**** Set parameters                                                               ****/
+	/**************************************************************************************/
+	numLon = std::max(lonEnd - lonOffset, 0);
+	numLat = std::max(latEnd - latOffset, 0);
+	deltaLonDeg = src.deltaLonDeg;
+	deltaLatDeg = src.deltaLatDeg;
+	minLonDeg = src.minLonDeg + lonOffset * deltaLonDeg;
+	minLatDeg = src.minLatDeg + latOffset * deltaLatDeg;
+	isCumulative = false;
+	/**************************************************************************************/
+
+	pop.resize((std::size_t)numLon * numLat);
+	propEnv.resize((std::size_t)numLon * numLat);
+	region.resize((std::size_t)numLon * numLat);
+
+	urbanPop.assign(numRegion, 0.0);
+	suburbanPop.assign(numRegion, 0.0);
+	ruralPop.assign(numRegion, 0.0);
+	barrenPop.assign(numRegion, 0.0);
+
+	double totalPop = 0.0;
+	int lonIdx, latIdx;
+	for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
+		std::size_t srcStart = (std::size_t)(lonOffset + lonIdx) * src.numLat + latOffset;
+		std::copy(src.pop + srcStart,
+			  src.pop + srcStart + numLat,
+			  pop.begin() + idx(lonIdx, 0));
+		std::copy(src.propEnv + srcStart,
+			  src.propEnv + srcStart + numLat,
+			  propEnv.begin() + idx(lonIdx, 0));
+		std::copy(src.region + srcStart,
+			  src.region + srcStart + numLat,
+			  region.begin() + idx(lonIdx, 0));
+		for (latIdx = 0; latIdx < numLat; latIdx++) {
+			regionIdx = region[idx(lonIdx, latIdx)];
+			switch (propEnv[idx(lonIdx, latIdx)]) {
+				case 'U':
+					urbanPop[regionIdx] += pop[idx(lonIdx, latIdx)];
+					break;
+				case 'S':
+					suburbanPop[regionIdx] += pop[idx(lonIdx, latIdx)];
+					break;
+				case 'R':
+					ruralPop[regionIdx] += pop[idx(lonIdx, latIdx)];
+					break;
+				case 'B':
+					barrenPop[regionIdx] += pop[idx(lonIdx, latIdx)];
+					break;
+			}
+			totalPop += pop[idx(lonIdx, latIdx)];
+		}
+	}
+
+	LOGGER_INFO(logger) << "numLon: " << numLon << "  numLat: " << numLat;
+	LOGGER_INFO(logger) << "TOTAL INTEGRATED POPULATION: " << totalPop;
+
+	return;
+}
+/******************************************************************************************/
+
 /******************************************************************************************/
 /**** COPY CONSTRUCTOR: PopGridClass::PopGridClass(const PopGridClass &obj)            ****/
 /******************************************************************************************/
@@ -554,24 +750,9 @@ PopGridClass::PopGridClass(const PopGridClass &obj) : regionNameList(obj.regionN
 	numLat = obj.numLat;
 	numRegion = obj.numRegion;
 
-	/**************************************************************************************/
-	/**** Allocate matrix and copy values                                              ****/
-	/**************************************************************************************/
-	int lonIdx, latIdx;
-	pop = (double **)malloc(numLon * sizeof(double *));
-	propEnv = (char **)malloc(numLon * sizeof(char *));
-	region = (int **)malloc(numLon * sizeof(int *));
-	for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-		pop[lonIdx] = (double *)malloc(numLat * sizeof(double));
-		propEnv[lonIdx] = (char *)malloc(numLat * sizeof(char));
-		region[lonIdx] = (int *)malloc(numLat * sizeof(int));
-		for (latIdx = 0; latIdx < numLat; latIdx++) {
-			pop[lonIdx][latIdx] = obj.pop[lonIdx][latIdx];
-			propEnv[lonIdx][latIdx] = obj.propEnv[lonIdx][latIdx];
-			region[lonIdx][latIdx] = obj.region[lonIdx][latIdx];
-		}
-	}
-	/**************************************************************************************/
+	pop = obj.pop;
+	propEnv = obj.propEnv;
+	region = obj.region;
 
 	urbanPop = obj.urbanPop;
 	suburbanPop = obj.suburbanPop;
@@ -585,28 +766,6 @@ PopGridClass::PopGridClass(const PopGridClass &obj) : regionNameList(obj.regionN
 /******************************************************************************************/
 PopGridClass::~PopGridClass()
 {
-	int lonIdx;
-
-	if (pop) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(pop[lonIdx]);
-		}
-		free(pop);
-	}
-
-	if (propEnv) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(propEnv[lonIdx]);
-		}
-		free(propEnv);
-	}
-
-	if (region) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(region[lonIdx]);
-		}
-		free(region);
-	}
 }
 /******************************************************************************************/
 
@@ -636,12 +795,12 @@ double PopGridClass::getDensityThrRural()
 
 void PopGridClass::setPop(int lonIdx, int latIdx, double popVal)
 {
-	pop[lonIdx][latIdx] = popVal;
+	pop[idx(lonIdx, latIdx)] = popVal;
 	return;
 }
 void PopGridClass::setPropEnv(int lonIdx, int latIdx, char propEnvVal)
 {
-	propEnv[lonIdx][latIdx] = propEnvVal;
+	propEnv[idx(lonIdx, latIdx)] = propEnvVal;
 	return;
 }
 
@@ -677,7 +836,7 @@ double PopGridClass::getPropEnvPop(CConst::PropEnvEnum propEnvVal, int regionIdx
 /******************************************************************************************/
 char PopGridClass::getPropEnv(int lonIdx, int latIdx) const
 {
-	return propEnv[lonIdx][latIdx];
+	return propEnv[idx(lonIdx, latIdx)];
 }
 /******************************************************************************************/
 
@@ -704,7 +863,7 @@ double PopGridClass::getPop(int lonIdx, int latIdx) const
 		throw("ERROR in PopGridClass::getPop(), pop grid is cumulative\n");
 	}
 
-	return pop[lonIdx][latIdx];
+	return pop[idx(lonIdx, latIdx)];
 }
 /******************************************************************************************/
 
@@ -719,12 +878,12 @@ double PopGridClass::getPopFromCDF(int lonIdx, int latIdx) const
 		throw("ERROR in PopGridClass::getPopFromCDF(), pop grid not cumulative\n");
 	}
 
-	if ((lonIdx == 0) && (latIdx == 0)) {
-		population = pop[0][0];
-	} else if (latIdx == 0) {
-		population = pop[lonIdx][latIdx] - pop[lonIdx - 1][numLat - 1];
+	// CDF is accumulated in storage order, so previous element is previous CDF value
+	std::size_t i = idx(lonIdx, latIdx);
+	if (i == 0) {
+		population = pop[0];
 	} else {
-		population = pop[lonIdx][latIdx] - pop[lonIdx][latIdx - 1];
+		population = pop[i] - pop[i - 1];
 	}
 
 	return population;
@@ -738,7 +897,7 @@ double PopGridClass::getProbFromCDF(int lonIdx, int latIdx) const
 {
 	double population = getPopFromCDF(lonIdx, latIdx);
 
-	double prob = population / pop[numLon - 1][numLat - 1];
+	double prob = population / pop.back();
 
 	return prob;
 }
@@ -787,19 +946,9 @@ void PopGridClass::readData(std::string filename,
 	/**************************************************************************************/
 	/**** Allocate matrix and initialize to zeros                                      ****/
 	/**************************************************************************************/
-	pop = (double **)malloc(numLon * sizeof(double *));
-	propEnv = (char **)malloc(numLon * sizeof(char *));
-	region = (int **)malloc(numLon * sizeof(int *));
-	for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-		pop[lonIdx] = (double *)malloc(numLat * sizeof(double));
-		propEnv[lonIdx] = (char *)malloc(numLat * sizeof(char));
-		region[lonIdx] = (int *)malloc(numLat * sizeof(int));
-		for (latIdx = 0; latIdx < numLat; latIdx++) {
-			pop[lonIdx][latIdx] = 0.0; // default to no population
-			propEnv[lonIdx][latIdx] = 'B'; // Default to barren outside defined area
-			region[lonIdx][latIdx] = 0; // default to first region
-		}
-	}
+	pop.assign((std::size_t)numLon * numLat, 0.0); // default to no population
+	propEnv.assign((std::size_t)numLon * numLat, 'B'); // Default to barren outside defined area
+	region.assign((std::size_t)numLon * numLat, 0); // default to first region
 	/**************************************************************************************/
 
 	// variables updated for each row in database
@@ -888,34 +1037,34 @@ void PopGridClass::readData(std::string filename,
 
 		// assign data value to class members
 		double populationVal = density * area;
-		pop[lonIdx][latIdx] = populationVal;
+		pop[idx(lonIdx, latIdx)] = populationVal;
 
-		region[lonIdx][latIdx] = regionVal;
+		region[idx(lonIdx, latIdx)] = regionVal;
 
 		if (density >=
 		    densityThrUrban) { // Check density against different thresholds to determine
 				       // what the population environment is (urban, suburban, etc.)
 			urbanPop[regionVal] += populationVal;
 			urbanArea[regionVal] += area;
-			propEnv[lonIdx][latIdx] = 'U'; // Urban
+			propEnv[idx(lonIdx, latIdx)] = 'U'; // Urban
 		} else if (density >= densityThrSuburban) {
 			suburbanPop[regionVal] += populationVal;
 			suburbanArea[regionVal] += area;
-			propEnv[lonIdx][latIdx] = 'S'; // Suburban
+			propEnv[idx(lonIdx, latIdx)] = 'S'; // Suburban
 		} else if (density >= densityThrRural) {
 			ruralPop[regionVal] += populationVal;
 			ruralArea[regionVal] += area;
-			propEnv[lonIdx][latIdx] = 'R'; // Ruran
+			propEnv[idx(lonIdx, latIdx)] = 'R'; // Ruran
 		} else {
 			barrenPop[regionVal] += populationVal;
 			barrenArea[regionVal] += area;
-			propEnv[lonIdx][latIdx] = 'B'; // Barren
+			propEnv[idx(lonIdx, latIdx)] = 'B'; // Barren
 		} // Char is used since working with big files, so 8 bit char is better than 32 bit
 		  // int
 
 		// add to totals
 		totalArea += area;
-		totalPop += pop[lonIdx][latIdx];
+		totalPop += pop[idx(lonIdx, latIdx)];
 	}
 
 	LOGGER_INFO(logger) << "Lines processed: " << rows.size();
@@ -963,8 +1112,6 @@ void PopGridClass::setDimensions(int numLonVal,
 				 double deltaLatDegVal,
 				 double minLatDegVal)
 {
-	int lonIdx, latIdx;
-
 	/**************************************************************************************/
 	/**** Set parameters                                                               ****/
 	/**************************************************************************************/
@@ -982,19 +1129,9 @@ void PopGridClass::setDimensions(int numLonVal,
 	/**************************************************************************************/
 	/**** Allocate matrix and initialize to zeros                                      ****/
 	/**************************************************************************************/
-	pop = (double **)malloc(numLon * sizeof(double *));
-	propEnv = (char **)malloc(numLon * sizeof(char *));
-	region = (int **)malloc(numLon * sizeof(int *));
-	for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-		pop[lonIdx] = (double *)malloc(numLat * sizeof(double));
-		propEnv[lonIdx] = (char *)malloc(numLat * sizeof(char));
-		region[lonIdx] = (int *)malloc(numLat * sizeof(int));
-		for (latIdx = 0; latIdx < numLat; latIdx++) {
-			pop[lonIdx][latIdx] = 0.0;
-			propEnv[lonIdx][latIdx] = 'X';
-			region[lonIdx][latIdx] = -1;
-		}
-	}
+	pop.assign((std::size_t)numLon * numLat, 0.0);
+	propEnv.assign((std::size_t)numLon * numLat, 'X');
+	region.assign((std::size_t)numLon * numLat, -1);
 	/**************************************************************************************/
 
 	return;
@@ -1039,26 +1176,26 @@ void PopGridClass::scale(std::vector<double> urbanPopVal,
 	double totalPop = 0.0;
 	for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
 		for (latIdx = 0; latIdx < numLat; latIdx++) {
-			regionIdx = region[lonIdx][latIdx];
-			switch (propEnv[lonIdx][latIdx]) {
+			regionIdx = region[idx(lonIdx, latIdx)];
+			switch (propEnv[idx(lonIdx, latIdx)]) {
 				case 'U':
-					pop[lonIdx][latIdx] *= scaleUrban[regionIdx];
-					urbanPop[regionIdx] += pop[lonIdx][latIdx];
+					pop[idx(lonIdx, latIdx)] *= scaleUrban[regionIdx];
+					urbanPop[regionIdx] += pop[idx(lonIdx, latIdx)];
 					break;
 				case 'S':
-					pop[lonIdx][latIdx] *= scaleSuburban[regionIdx];
-					suburbanPop[regionIdx] += pop[lonIdx][latIdx];
+					pop[idx(lonIdx, latIdx)] *= scaleSuburban[regionIdx];
+					suburbanPop[regionIdx] += pop[idx(lonIdx, latIdx)];
 					break;
 				case 'R':
-					pop[lonIdx][latIdx] *= scaleRural[regionIdx];
-					ruralPop[regionIdx] += pop[lonIdx][latIdx];
+					pop[idx(lonIdx, latIdx)] *= scaleRural[regionIdx];
+					ruralPop[regionIdx] += pop[idx(lonIdx, latIdx)];
 					break;
 				case 'B':
-					pop[lonIdx][latIdx] *= scaleBarren[regionIdx];
-					barrenPop[regionIdx] += pop[lonIdx][latIdx];
+					pop[idx(lonIdx, latIdx)] *= scaleBarren[regionIdx];
+					barrenPop[regionIdx] += pop[idx(lonIdx, latIdx)];
 					break;
 			}
-			totalPop += pop[lonIdx][latIdx];
+			totalPop += pop[idx(lonIdx, latIdx)];
 		}
 	}
 
@@ -1110,12 +1247,12 @@ void PopGridClass::writeDensity(std::string filename, bool dumpPopGrid)
 		fprintf(fp, "lonIdx,latIdx,pop,popSum\n");
 		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
 			for (latIdx = 0; latIdx < numLat; latIdx++) {
-				popSum += pop[lonIdx][latIdx];
+				popSum += pop[idx(lonIdx, latIdx)];
 				fprintf(fp,
 					"%d,%d,%.5f,%.5f\n",
 					lonIdx,
 					latIdx,
-					pop[lonIdx][latIdx],
+					pop[idx(lonIdx, latIdx)],
 					popSum);
 			}
 		}
@@ -1126,8 +1263,8 @@ void PopGridClass::writeDensity(std::string filename, bool dumpPopGrid)
 		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
 			double longitudeDeg = minLonDeg + (lonIdx + 0.5) * deltaLonDeg;
 			for (latIdx = 0; latIdx < numLat; latIdx++) {
-				if ((propEnv[lonIdx][latIdx] != 'X') &&
-				    (propEnv[lonIdx][latIdx] != 'B')) {
+				if ((propEnv[idx(lonIdx, latIdx)] != 'X') &&
+				    (propEnv[idx(lonIdx, latIdx)] != 'B')) {
 					double latitudeDeg = minLatDeg +
 							     (latIdx + 0.5) * deltaLatDeg;
 					double area = computeArea(lonIdx, latIdx);
@@ -1136,8 +1273,8 @@ void PopGridClass::writeDensity(std::string filename, bool dumpPopGrid)
 						"%.5f,%.5f,%.3f,%c\n",
 						longitudeDeg,
 						latitudeDeg,
-						(pop[lonIdx][latIdx] / area) * 1.0e6,
-						propEnv[lonIdx][latIdx]);
+						(pop[idx(lonIdx, latIdx)] / area) * 1.0e6,
+						propEnv[idx(lonIdx, latIdx)]);
 				}
 			}
 		}
@@ -1212,72 +1349,51 @@ int PopGridClass::adjustRegion(double centerLongitudeDeg, double centerLatitudeD
 	/**************************************************************************************/
 	/**** Allocate matrix                                                              ****/
 	/**************************************************************************************/
-	double **newPop = (double **)malloc(newNumLon * sizeof(double *));
-	char **newPropEnv = (char **)malloc(newNumLon * sizeof(char *));
-	int **newRegion = (int **)malloc(newNumLon * sizeof(int *));
+	std::vector<double> newPop((std::size_t)newNumLon * newNumLat);
+	std::vector<char> newPropEnv((std::size_t)newNumLon * newNumLat);
+	std::vector<int> newRegion((std::size_t)newNumLon * newNumLat);
 	for (lonIdx = 0; lonIdx < newNumLon; lonIdx++) {
-		newPop[lonIdx] = (double *)malloc(newNumLat * sizeof(double));
-		newPropEnv[lonIdx] = (char *)malloc(newNumLat * sizeof(char));
-		newRegion[lonIdx] = (int *)malloc(newNumLat * sizeof(int));
 		double lonDeg = (newMinLon + lonIdx * deltaLonDeg);
 		for (latIdx = 0; latIdx < newNumLat; latIdx++) {
+			std::size_t newIdx = (std::size_t)lonIdx * newNumLat + latIdx;
 			double latDeg = (newMinLat + latIdx * deltaLatDeg);
 			Vector3 posn = EcefModel::geodeticToEcef(latDeg, lonDeg, 0.0);
 			if ((posn - centerPosition).len() * 1000.0 <= radius) {
-				newPop[lonIdx][latIdx] =
-					pop[minLonIdx + lonIdx][minLatIdx + latIdx];
-				newPropEnv[lonIdx][latIdx] =
-					propEnv[minLonIdx + lonIdx][minLatIdx + latIdx];
-				newRegion[lonIdx][latIdx] =
-					region[minLonIdx + lonIdx][minLatIdx + latIdx];
+				newPop[newIdx] =
+					pop[idx(minLonIdx + lonIdx, minLatIdx + latIdx)];
+				newPropEnv[newIdx] =
+					propEnv[idx(minLonIdx + lonIdx, minLatIdx + latIdx)];
+				newRegion[newIdx] =
+					region[idx(minLonIdx + lonIdx, minLatIdx + latIdx)];
 			} else {
-				newPop[lonIdx][latIdx] = 0.0;
-				newPropEnv[lonIdx][latIdx] = 'X';
-				newRegion[lonIdx][latIdx] = -1;
+				newPop[newIdx] = 0.0;
+				newPropEnv[newIdx] = 'X';
+				newRegion[newIdx] = -1;
 			}
-			regionIdx = newRegion[lonIdx][latIdx];
-			switch (newPropEnv[lonIdx][latIdx]) {
+			regionIdx = newRegion[newIdx];
+			switch (newPropEnv[newIdx]) {
 				case 'U':
-					urbanPop[regionIdx] += newPop[lonIdx][latIdx];
+					urbanPop[regionIdx] += newPop[newIdx];
 					break;
 				case 'S':
-					suburbanPop[regionIdx] += newPop[lonIdx][latIdx];
+					suburbanPop[regionIdx] += newPop[newIdx];
 					break;
 				case 'R':
-					ruralPop[regionIdx] += newPop[lonIdx][latIdx];
+					ruralPop[regionIdx] += newPop[newIdx];
 					break;
 				case 'B':
-					barrenPop[regionIdx] += newPop[lonIdx][latIdx];
+					barrenPop[regionIdx] += newPop[newIdx];
 					break;
 			}
-			totalPop += newPop[lonIdx][latIdx];
+			totalPop += newPop[newIdx];
 		}
 	}
 	/**************************************************************************************/
 
-	if (pop) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(pop[lonIdx]);
-		}
-		free(pop);
-	}
 
-	if (propEnv) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(propEnv[lonIdx]);
-		}
-		free(propEnv);
-	}
-	if (region) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(region[lonIdx]);
-		}
-		free(region);
-	}
-
-	pop = newPop;
-	propEnv = newPropEnv;
-	region = newRegion;
+	pop.swap(newPop);
+	propEnv.swap(newPropEnv);
+	region.swap(newRegion);
 	minLonDeg = newMinLon;
 	minLatDeg = newMinLat;
 	numLon = newNumLon;
@@ -1312,13 +1428,7 @@ double PopGridClass::adjustRegion(ListClass<ULSClass *> *ulsList, double maxRadi
 			     (maxRadius + maxDistGridCenterToEdge) * 1.0e-6;
 
 	int lonIdx, latIdx;
-	int **possible = (int **)malloc(numLon * sizeof(int *));
-	for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-		possible[lonIdx] = (int *)malloc(numLat * sizeof(int));
-		for (latIdx = 0; latIdx < numLat; latIdx++) {
-			possible[lonIdx][latIdx] = 0;
-		}
-	}
+	std::vector<char> possible((std::size_t)numLon * numLat, 0);
 
 	double minDeltaY = CConst::earthRadius * deltaLatDeg * (M_PI / 180.0);
 	double cosa = cos(minLatDeg * M_PI / 180.0);
@@ -1352,7 +1462,7 @@ double PopGridClass::adjustRegion(ListClass<ULSClass *> *ulsList, double maxRadi
 
 		for (lonIdx = lonIdxStart; lonIdx <= lonIdxStop; lonIdx++) {
 			for (latIdx = latIdxStart; latIdx <= latIdxStop; latIdx++) {
-				possible[lonIdx][latIdx] = 1;
+				possible[idx(lonIdx, latIdx)] = 1;
 			}
 		}
 	}
@@ -1369,7 +1479,7 @@ double PopGridClass::adjustRegion(ListClass<ULSClass *> *ulsList, double maxRadi
 
 			bool useFlag = false;
 
-			if (possible[lonIdx][latIdx]) {
+			if (possible[idx(lonIdx, latIdx)]) {
 				Vector3 gridPosition = EcefModel::geodeticToEcef(latitudeDeg,
 										 longitudeDeg,
 										 0.0);
@@ -1400,9 +1510,9 @@ double PopGridClass::adjustRegion(ListClass<ULSClass *> *ulsList, double maxRadi
 				}
 				initFlag = false;
 			} else {
-				pop[lonIdx][latIdx] = 0.0;
-				propEnv[lonIdx][latIdx] = 'X';
-				region[lonIdx][latIdx] = -1;
+				pop[idx(lonIdx, latIdx)] = 0.0;
+				propEnv[idx(lonIdx, latIdx)] = 'X';
+				region[idx(lonIdx, latIdx)] = -1;
 			}
 		}
 
@@ -1441,82 +1551,54 @@ double PopGridClass::adjustRegion(ListClass<ULSClass *> *ulsList, double maxRadi
 	/**************************************************************************************/
 	/**** Allocate matrix                                                              ****/
 	/**************************************************************************************/
-	double **newPop = (double **)malloc(newNumLon * sizeof(double *));
-	char **newPropEnv = (char **)malloc(newNumLon * sizeof(char *));
-	int **newRegion = (int **)malloc(newNumLon * sizeof(int *));
+	std::vector<double> newPop((std::size_t)newNumLon * newNumLat);
+	std::vector<char> newPropEnv((std::size_t)newNumLon * newNumLat);
+	std::vector<int> newRegion((std::size_t)newNumLon * newNumLat);
 	for (lonIdx = 0; lonIdx < newNumLon; lonIdx++) {
-		newPop[lonIdx] = (double *)malloc(newNumLat * sizeof(double));
-		newPropEnv[lonIdx] = (char *)malloc(newNumLat * sizeof(char));
-		newRegion[lonIdx] = (int *)malloc(newNumLat * sizeof(int));
 		for (latIdx = 0; latIdx < newNumLat; latIdx++) {
+			std::size_t newIdx = (std::size_t)lonIdx * newNumLat + latIdx;
 			double latitudeDeg = minLatDeg + latIdx * deltaLatDeg;
 			double area = CConst::earthRadius * CConst::earthRadius *
 				      cos(latitudeDeg * M_PI / 180.0) * deltaLonDeg * deltaLatDeg *
 				      (M_PI / 180.0) * (M_PI / 180.0);
 
-			newPop[lonIdx][latIdx] = pop[minLonIdx + lonIdx][minLatIdx + latIdx];
-			newPropEnv[lonIdx][latIdx] =
-				propEnv[minLonIdx + lonIdx][minLatIdx + latIdx];
-			newRegion[lonIdx][latIdx] = region[minLonIdx + lonIdx][minLatIdx + latIdx];
+			newPop[newIdx] = pop[idx(minLonIdx + lonIdx, minLatIdx + latIdx)];
+			newPropEnv[newIdx] =
+				propEnv[idx(minLonIdx + lonIdx, minLatIdx + latIdx)];
+			newRegion[newIdx] = region[idx(minLonIdx + lonIdx, minLatIdx + latIdx)];
 
-			regionIdx = newRegion[lonIdx][latIdx];
-			switch (newPropEnv[lonIdx][latIdx]) {
+			regionIdx = newRegion[newIdx];
+			switch (newPropEnv[newIdx]) {
 				case 'U':
-					urbanPop[regionIdx] += newPop[lonIdx][latIdx];
+					urbanPop[regionIdx] += newPop[newIdx];
 					urbanArea[regionIdx] += area;
 					totalArea += area;
 					break;
 				case 'S':
-					suburbanPop[regionIdx] += newPop[lonIdx][latIdx];
+					suburbanPop[regionIdx] += newPop[newIdx];
 					suburbanArea[regionIdx] += area;
 					totalArea += area;
 					break;
 				case 'R':
-					ruralPop[regionIdx] += newPop[lonIdx][latIdx];
+					ruralPop[regionIdx] += newPop[newIdx];
 					ruralArea[regionIdx] += area;
 					totalArea += area;
 					break;
 				case 'B':
-					barrenPop[regionIdx] += newPop[lonIdx][latIdx];
+					barrenPop[regionIdx] += newPop[newIdx];
 					barrenArea[regionIdx] += area;
 					totalArea += area;
 					break;
 			}
-			totalPop += newPop[lonIdx][latIdx];
+			totalPop += newPop[newIdx];
 		}
 	}
 	/**************************************************************************************/
 
-	if (pop) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(pop[lonIdx]);
-		}
-		free(pop);
-	}
-
-	if (propEnv) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(propEnv[lonIdx]);
-		}
-		free(propEnv);
-	}
-	if (region) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(region[lonIdx]);
-		}
-		free(region);
-	}
-
-	if (possible) {
-		for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
-			free(possible[lonIdx]);
-		}
-		free(possible);
-	}
 
-	pop = newPop;
-	propEnv = newPropEnv;
-	region = newRegion;
+	pop.swap(newPop);
+	propEnv.swap(newPropEnv);
+	region.swap(newRegion);
 	minLonDeg = newMinLon;
 	minLatDeg = newMinLat;
 	numLon = newNumLon;
@@ -1577,8 +1659,8 @@ void PopGridClass::makeCDF()
 	double sum = 0.0;
 	for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
 		for (latIdx = 0; latIdx < numLat; latIdx++) {
-			sum += pop[lonIdx][latIdx];
-			pop[lonIdx][latIdx] = sum;
+			sum += pop[idx(lonIdx, latIdx)];
+			pop[idx(lonIdx, latIdx)] = sum;
 		}
 	}
 
@@ -1595,9 +1677,10 @@ void PopGridClass::check(std::string s)
 
 	for (lonIdx = 0; lonIdx < numLon; lonIdx++) {
 		for (latIdx = 0; latIdx < numLat; latIdx++) {
-			if ((propEnv[lonIdx][latIdx] == 'X') && (pop[lonIdx][latIdx] != 0.0)) {
+			if ((propEnv[idx(lonIdx, latIdx)] == 'X') &&
+			    (pop[idx(lonIdx, latIdx)] != 0.0)) {
 				std::cout << "CHECK GRID: " << s << " " << lonIdx << " " << latIdx
-					  << " POP = " << pop[lonIdx][latIdx] << std::endl;
+					  << " POP = " << pop[idx(lonIdx, latIdx)] << std::endl;
 			}
 		}
 	}
@@ -1630,8 +1713,8 @@ void PopGridClass::findDeg(double longitudeDeg,
 		propEnvVal = 0;
 		regionIdx = -1;
 	} else {
-		propEnvVal = propEnv[lonIdx][latIdx];
-		regionIdx = region[lonIdx][latIdx];
+		propEnvVal = propEnv[idx(lonIdx, latIdx)];
+		regionIdx = region[idx(lonIdx, latIdx)];
 	}
 
 	return;
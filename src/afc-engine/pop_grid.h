@@ -5,6 +5,8 @@
 #ifndef POP_GRID_H
 #define POP_GRID_H
 
+#include <cstddef>
+#include <string>
 #include <vector>
 #include "list.h"
 #include "cconst.h"
@@ -26,6 +28,8 @@ class PolygonClass;
 /**** variable names.                                                                  ****/
 /**** Non-rectangular regions can be converted to rectangular regions by padding with  ****/
 /**** zeros.                                                                           ****/
+/**** Grid layers are stored contiguously in LON-major order: value for lonIdx, latIdx ****/
+/**** is at index lonIdx*numLat + latIdx (see idx()).                                  ****/
 /******************************************************************************************/
 class PopGridClass
 {
@@ -42,7 +46,8 @@ class PopGridClass
 			     double minLat,
 			     double minLon,
 			     double maxLat,
-			     double maxLon);
+			     double maxLon,
+			     const std::string &cacheDir = "");
 		PopGridClass(const PopGridClass &obj);
 		~PopGridClass();
 		void readData(std::string populationDensityFile,
@@ -116,6 +121,33 @@ class PopGridClass
 		}
 
 	private:
+		// View of grid data, residing elsewhere (e.g. in mapped cache file)
+		struct GridView {
+				int numLon, numLat;
+				double minLonDeg, minLatDeg, deltaLonDeg, deltaLatDeg;
+				const double *pop;
+				const char *propEnv;
+				const int *region;
+		};
+
+		std::size_t idx(int lonIdx, int latIdx) const
+		{
+			return (std::size_t)lonIdx * numLat + latIdx;
+		}
+		void readWorldPopulationFile(std::string worldPopulationFile,
+					     const std::vector<PolygonClass *> &regionPolygonList,
+					     double regionPolygonResolution,
+					     double minLat,
+					     double minLon,
+					     double maxLat,
+					     double maxLon);
+		void cropFrom(const GridView &src,
+			      double regionPolygonResolution,
+			      double minLat,
+			      double minLon,
+			      double maxLat,
+			      double maxLon);
+
 		int numRegion;
 		std::vector<std::string> regionNameList;
 		// std::vector<int> regionIDList;
@@ -127,9 +159,9 @@ class PopGridClass
 		double deltaLatDeg;
 
 		int numLon, numLat;
-		double **pop;
-		char **propEnv;
-		int **region;
+		std::vector<double> pop;
+		std::vector<char> propEnv;
+		std::vector<int> region;
 		std::vector<double> urbanPop;
 		std::vector<double> suburbanPop;
 		std::vector<double> ruralPop;
@@ -20,11 +20,13 @@
 PRTABLEClass::PRTABLEClass()
 {
 	tableFile = "";
-	prTable = (double **)NULL;
+	prTable = (double *)NULL;
 	numQ = -1;
 	numOneOverKs = -1;
 	oneOverKsValList = (double *)NULL;
 	QValList = (double *)NULL;
+	QInvStep = 0.0;
+	oneOverKsInvStep = 0.0;
 };
 
 PRTABLEClass::PRTABLEClass(std::string tableFileVal) : tableFile(tableFileVal)
@@ -40,9 +42,6 @@ PRTABLEClass::~PRTABLEClass()
 {
 	free(QValList);
 	free(oneOverKsValList);
-	for (int qIdx = 0; qIdx < numQ; ++qIdx) {
-		free(prTable[qIdx]);
-	}
 	free(prTable);
 };
 /******************************************************************************************/
@@ -72,7 +71,7 @@ void PRTABLEClass::readTable()
 
 	bool foundLabelLine = false;
 	int kIdx = -1;
-	int qIdx, fieldIdx;
+	int fieldIdx;
 
 	while (getline(file, line)) {
 		linenum++;
@@ -125,11 +124,7 @@ void PRTABLEClass::readTable()
 			}
 				QValList = (double *)malloc(numQ * sizeof(double));
 				oneOverKsValList = (double *)malloc(numOneOverKs * sizeof(double));
-				prTable = (double **)malloc(numQ * sizeof(double *));
-				for (qIdx = 0; qIdx < numQ; ++qIdx) {
-					prTable[qIdx] = (double *)malloc(numOneOverKs *
-									 sizeof(double));
-				}
+				prTable = mallocCacheAligned((std::size_t)numQ * numOneOverKs);
 				if ((int)fieldList.size() != numQ + 1) {
 					errStr << std::string("ERROR: Passive Repeater Table File ")
 					       << tableFile << ":" << linenum << " INVALID DATA\n";
@@ -164,7 +159,8 @@ void PRTABLEClass::readTable()
 				for (fieldIdx = 1; fieldIdx < (int)fieldList.size(); fieldIdx++) {
 					field = fieldList.at(fieldIdx);
 
-					prTable[fieldIdx - 1][kIdx] = std::stod(field);
+					prTable[(fieldIdx - 1) * numOneOverKs + kIdx] =
+						std::stod(field);
 
 					// std::cout << "FIELD: \"" << field << "\"" << std::endl;
 				}
@@ -186,17 +182,21 @@ void PRTABLEClass::readTable()
 		throw std::runtime_error(errStr.str());
 	}
 
+	QInvStep = getInvStep(QValList, numQ);
+	oneOverKsInvStep = getInvStep(oneOverKsValList, numOneOverKs);
+
 	return;
 };
 /******************************************************************************************/
 
 /******************************************************************************************/
-/**** FUNCTION: PRTABLEClass::computePRTABLE()                                         ****/
+/**** FUNCTION: PRTABLEClass::interpPRTABLE()                                          ****/
+/**** Bilinear interpolation, values outside of table are clamped to table edges.      ****/
 /******************************************************************************************/
-double PRTABLEClass::computePRTABLE(double Q, double oneOverKs)
+inline double PRTABLEClass::interpPRTABLE(double Q, double oneOverKs) const
 {
-	double qIdxDbl = getIdx(Q, QValList, numQ);
-	double kIdxDbl = getIdx(oneOverKs, oneOverKsValList, numOneOverKs);
+	double qIdxDbl = getIdx(Q, QValList, numQ, QInvStep);
+	double kIdxDbl = getIdx(oneOverKs, oneOverKsValList, numOneOverKs, oneOverKsInvStep);
 
 	if (qIdxDbl < 0.0) {
 		qIdxDbl = 0.0;
@@ -210,34 +210,59 @@ double PRTABLEClass::computePRTABLE(double Q, double oneOverKs)
 		kIdxDbl = (double)numOneOverKs - 1;
 	}
 
-	int qIdx0 = (int)floor(qIdxDbl);
+	int qIdx0 = (int)qIdxDbl;
 	if (qIdx0 == numQ - 1) {
 		qIdx0 = numQ - 2;
 	}
 
-	int kIdx0 = (int)floor(kIdxDbl);
+	int kIdx0 = (int)kIdxDbl;
 	if (kIdx0 == numOneOverKs - 1) {
 		kIdx0 = numOneOverKs - 2;
 	}
 
-	double F00 = prTable[qIdx0][kIdx0];
-	double F01 = prTable[qIdx0][kIdx0 + 1];
-	double F10 = prTable[qIdx0 + 1][kIdx0];
-	double F11 = prTable[qIdx0 + 1][kIdx0 + 1];
+	const double *F0 = prTable + qIdx0 * numOneOverKs + kIdx0;
+	const double *F1 = F0 + numOneOverKs;
 
-	double tableVal = F00 * (qIdx0 + 1 - qIdxDbl) * (kIdx0 + 1 - kIdxDbl) +
-			  F01 * (qIdx0 + 1 - qIdxDbl) * (kIdxDbl - kIdx0) +
-			  F10 * (qIdxDbl - qIdx0) * (kIdx0 + 1 - kIdxDbl) +
-			  F11 * (qIdxDbl - qIdx0) * (kIdxDbl - kIdx0);
+	double tableVal = F0[0] * (qIdx0 + 1 - qIdxDbl) * (kIdx0 + 1 - kIdxDbl) +
+			  F0[1] * (qIdx0 + 1 - qIdxDbl) * (kIdxDbl - kIdx0) +
+			  F1[0] * (qIdxDbl - qIdx0) * (kIdx0 + 1 - kIdxDbl) +
+			  F1[1] * (qIdxDbl - qIdx0) * (kIdxDbl - kIdx0);
 
 	return (tableVal);
 }
 /******************************************************************************************/
 
+/******************************************************************************************/
+/**** FUNCTION: PRTABLEClass::computePRTABLE()                                         ****/
+/******************************************************************************************/
+double PRTABLEClass::computePRTABLE(double Q, double oneOverKs)
+{
+	return (interpPRTABLE(Q, oneOverKs));
+}
+
+void PRTABLEClass::computePRTABLE(int n,
+				  const double *QList,
+				  const double *oneOverKsList,
+				  double *valList)
+{
+	for (int i = 0; i < n; ++i) {
+		valList[i] = interpPRTABLE(QList[i], oneOverKsList[i]);
+	}
+}
+/******************************************************************************************/
+
 /******************************************************************************************/
 /**** FUNCTION: PRTABLEClass::getIdx()                                                 ****/
+/**** Fractional index of val in increasing valList: -1 if val <= valList[0],          ****/
+/**** numVal-1 if val >= valList[numVal-1].  If invStep > 0, valList is uniform with   ****/
+/**** step 1/invStep and bracketing index is computed rather than searched for.        ****/
 /******************************************************************************************/
 double PRTABLEClass::getIdx(double val, double *valList, int numVal)
+{
+	return (getIdx(val, valList, numVal, 0.0));
+}
+
+double PRTABLEClass::getIdx(double val, const double *valList, int numVal, double invStep)
 {
 	int i0 = 0;
 	int i1 = numVal - 1;
@@ -252,15 +277,28 @@ double PRTABLEClass::getIdx(double val, double *valList, int numVal)
 		return ((double)numVal - 1.0);
 	}
 
-	while (i1 > i0 + 1) {
-		int im = (i0 + i1) / 2;
-		double vm = valList[im];
-		if (val >= vm) {
-			i0 = im;
-			v0 = vm;
-		} else {
-			i1 = im;
-			v1 = vm;
+	if (invStep > 0.0) {
+		i0 = std::min((int)((val - v0) * invStep), numVal - 2);
+		// Index computed from step may be off by one due to rounding
+		while (val < valList[i0]) {
+			i0--;
+		}
+		while (val >= valList[i0 + 1]) {
+			i0++;
+		}
+		v0 = valList[i0];
+		v1 = valList[i0 + 1];
+	} else {
+		while (i1 > i0 + 1) {
+			int im = (i0 + i1) / 2;
+			double vm = valList[im];
+			if (val >= vm) {
+				i0 = im;
+				v0 = vm;
+			} else {
+				i1 = im;
+				v1 = vm;
+			}
 		}
 	}
 
@@ -269,3 +307,26 @@ double PRTABLEClass::getIdx(double val, double *valList, int numVal)
 	return (idxDbl);
 }
 /******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: PRTABLEClass::getInvStep()                                             ****/
+/**** 1/step if valList is uniformly spaced, otherwise 0.                              ****/
+/******************************************************************************************/
+double PRTABLEClass::getInvStep(const double *valList, int numVal)
+{
+	if (numVal < 2) {
+		return (0.0);
+	}
+	double step = (valList[numVal - 1] - valList[0]) / (numVal - 1);
+	if (!(step > 0.0)) {
+		return (0.0);
+	}
+	for (int i = 0; i < numVal; ++i) {
+		if (fabs(valList[i] - (valList[0] + i * step)) > 1.0e-6 * step) {
+			return (0.0);
+		}
+	}
+
+	return (1.0 / step);
+}
+/******************************************************************************************/
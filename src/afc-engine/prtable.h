@@ -20,16 +20,30 @@ class PRTABLEClass
 		~PRTABLEClass();
 
 		double computePRTABLE(double Q, double oneOverKs);
+
+		// Computes valList[i] = computePRTABLE(QList[i], oneOverKsList[i]) for n values
+		void computePRTABLE(int n,
+				    const double *QList,
+				    const double *oneOverKsList,
+				    double *valList);
+
 		double getIdx(double val, double *valList, int numVal);
 
 	private:
 		void readTable();
+		inline double interpPRTABLE(double Q, double oneOverKs) const;
+		static double getIdx(double val, const double *valList, int numVal, double invStep);
+		static double getInvStep(const double *valList, int numVal);
 
 		std::string tableFile;
-		double **prTable;
+		// Flat, cache aligned table, value at (qIdx, kIdx) is
+		// prTable[qIdx*numOneOverKs + kIdx]
+		double *prTable;
 		int numOneOverKs, numQ;
 		double *oneOverKsValList;
 		double *QValList;
+		// 1/step of QValList and oneOverKsValList if uniformly spaced, otherwise 0
+		double QInvStep, oneOverKsInvStep;
 };
 /******************************************************************************************/
 
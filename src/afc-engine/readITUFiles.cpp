@@ -1,4 +1,5 @@
 #include "readITUFiles.hpp"
+#include "GridCache.h"
 
 #include <cmath>
 #include <fstream>
@@ -7,25 +8,42 @@
 #include <string>
 #include <vector>
 
-ITUDataClass::ITUDataClass(std::string t_radioClimatePath, std::string t_surfRefracPath)
+ITUDataClass::ITUDataClass(std::string t_radioClimatePath,
+			   std::string t_surfRefracPath,
+			   const std::string &cacheDir)
 {
+	std::string cacheFile;
+	GridCache::KeyBuilder keyBuilder;
+	if (!cacheDir.empty()) {
+		keyBuilder.addString("itu")
+			.addFile(t_radioClimatePath)
+			.addFile(t_surfRefracPath)
+			.add(RCNumLat)
+			.add(RCNumLon)
+			.add(SRNumLat)
+			.add(SRNumLon);
+		cacheFile = GridCache::filename(cacheDir, "itu", keyBuilder.key());
+		gridCache = GridCache::open(cacheFile, keyBuilder.key());
+		if (gridCache) {
+			RCData = gridCache->next<int>(RCNumLat * RCNumLon);
+			SRData = gridCache->next<double>(SRNumLat * SRNumLon);
+			return;
+		}
+	}
+
 	readRCFile(t_radioClimatePath);
 	readSRFile(t_surfRefracPath);
+
+	if (!cacheFile.empty()) {
+		GridCache::write(cacheFile,
+				 keyBuilder.key(),
+				 {GridCache::Chunk(RCData, RCDataVec.size() * sizeof(int)),
+				  GridCache::Chunk(SRData, SRDataVec.size() * sizeof(double))});
+	}
 }
 
 ITUDataClass::~ITUDataClass()
 {
-	int latIdx;
-
-	for (latIdx = 0; latIdx < RCNumLat; ++latIdx) {
-		free(RCData[latIdx]);
-	}
-	free(RCData);
-
-	for (latIdx = 0; latIdx < SRNumLat; ++latIdx) {
-		free(SRData[latIdx]);
-	}
-	free(SRData);
 }
 
 void ITUDataClass::readRCFile(std::string RCFile)
@@ -34,17 +52,19 @@ void ITUDataClass::readRCFile(std::string RCFile)
 
 	int latIdx, lonIdx;
 
-	RCData = (int **)malloc(RCNumLat * sizeof(int *));
-	for (latIdx = 0; latIdx < RCNumLat; ++latIdx) {
-		RCData[latIdx] = (int *)malloc(RCNumLon * sizeof(int));
-	}
+	RCDataVec.assign(RCNumLat * RCNumLon, 0);
+	RCData = RCDataVec.data();
 	std::string line;
 
 	latIdx = 0;
 	while (std::getline(file, line)) {
+		if (latIdx >= RCNumLat) {
+			throw std::length_error("ERROR: Incorrect number of rows in " + RCFile);
+		}
 		std::istringstream lineBuffer(line);
+		int *row = RCDataVec.data() + latIdx * RCNumLon;
 		for (lonIdx = 0; lonIdx < RCNumLon; ++lonIdx)
-			lineBuffer >> RCData[latIdx][lonIdx];
+			lineBuffer >> row[lonIdx];
 
 		latIdx++;
 	}
@@ -61,17 +81,19 @@ void ITUDataClass::readSRFile(std::string SRFile)
 
 	int latIdx, lonIdx;
 
-	SRData = (double **)malloc(SRNumLat * sizeof(double *));
-	for (latIdx = 0; latIdx < SRNumLat; ++latIdx) {
-		SRData[latIdx] = (double *)malloc(SRNumLon * sizeof(double));
-	}
+	SRDataVec.assign(SRNumLat * SRNumLon, 0.0);
+	SRData = SRDataVec.data();
 	std::string line;
 
 	latIdx = 0;
 	while (std::getline(file, line)) {
+		if (latIdx >= SRNumLat) {
+			throw std::length_error("ERROR: Incorrect number of rows in " + SRFile);
+		}
 		std::istringstream lineBuffer(line);
+		double *row = SRDataVec.data() + latIdx * SRNumLon;
 		for (lonIdx = 0; lonIdx < SRNumLon; lonIdx++)
-			lineBuffer >> SRData[latIdx][lonIdx];
+			lineBuffer >> row[lonIdx];
 
 		latIdx++;
 	}
@@ -102,7 +124,7 @@ int ITUDataClass::getRadioClimateValue(double latDeg, double lonDeg)
 		lonIdx -= 720;
 	}
 
-	int radio_climate_value = RCData[latIdx][lonIdx];
+	int radio_climate_value = RCData[latIdx * RCNumLon + lonIdx];
 
 	return radio_climate_value;
 }
@@ -140,10 +162,12 @@ double ITUDataClass::getSurfaceRefractivityValue(double latDeg, double lonDeg)
 	int latIdx1 = latIdx0 + 1;
 	int lonIdx1 = lonIdx0 + 1;
 
-	double val00 = SRData[latIdx0][lonIdx0];
-	double val01 = SRData[latIdx0][lonIdx1];
-	double val10 = SRData[latIdx1][lonIdx0];
-	double val11 = SRData[latIdx1][lonIdx1];
+	const double *row0 = SRData + latIdx0 * SRNumLon;
+	const double *row1 = row0 + SRNumLon;
+	double val00 = row0[lonIdx0];
+	double val01 = row0[lonIdx1];
+	double val10 = row1[lonIdx0];
+	double val11 = row1[lonIdx1];
 
 	double surf_refract = (val00 * (latIdx1 - latIdxDbl) * (lonIdx1 - lonIdxDbl) +
 			       val01 * (latIdx1 - latIdxDbl) * (lonIdxDbl - lonIdx0) +
@@ -2,28 +2,41 @@
 #define INCLUDE_IPDR_UTIL_READITUFILES_HPP_
 
 #include <array>
+#include <memory>
 #include <string>
 #include <vector>
 
+class GridCache;
+
 class ITUDataClass
 {
 	public:
-		ITUDataClass(std::string t_radioClimatePath, std::string t_surfRefracPath);
+		// If cacheDir is not empty, parsed data is cached there as binary file and
+		// memory-mapped by subsequent runs
+		ITUDataClass(std::string t_radioClimatePath,
+			     std::string t_surfRefracPath,
+			     const std::string &cacheDir = "");
 		~ITUDataClass();
 
 		int getRadioClimateValue(double latDeg, double lonDeg);
 		double getSurfaceRefractivityValue(double latDeg, double lonDeg);
 
 	private:
+		// Both grids are stored contiguously in row (latitude) major order. Data
+		// pointers point either to vectors below or to mapped cache file
 		const int RCNumLat = 360;
 		const int RCNumLon = 720;
 		void readRCFile(std::string RCFile);
-		int **RCData;
+		std::vector<int> RCDataVec;
+		const int *RCData;
 
 		const int SRNumLat = 121;
 		const int SRNumLon = 241;
 		void readSRFile(std::string SRFile);
-		double **SRData;
+		std::vector<double> SRDataVec;
+		const double *SRData;
+
+		std::unique_ptr<GridCache> gridCache;
 };
 
 #endif // INCLUDE_IPDR_UTIL_READITUFILES_HPP_
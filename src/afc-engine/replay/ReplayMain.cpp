@@ -0,0 +1,443 @@
+/******************************************************************************************/
+/**** FILE: ReplayMain.cpp                                                             ****/
+/**** Replays recorded inquiries (JSONL file, one AvailableSpectrumInquiryRequest      ****/
+/**** message per line) through AfcManager in-process, one at a time. Engine is not    ****/
+/**** reentrant (AfcManager sets static members of ULSClass, RlanRegionClass, ...),    ****/
+/**** so inquiries are not run concurrently. Reports latency percentiles, throughput,  ****/
+/**** peak RSS and time per processing phase, optionally compares responses with       ****/
+/**** golden responses.                                                                ****/
+/**** By default engine data (terrain, ULS, NLCD, ...) is synthetic, generated in      ****/
+/**** temporary directory, so inquiries should be located in the synthetic terrain     ****/
+/**** tile (see BenchFixtureClass).                                                    ****/
+/******************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <QByteArray>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include "BenchFixture.h"
+#include "ReplayRunner.h"
+#include "afclogging/ErrStream.h"
+#include "afclogging/Logging.h"
+#include "afclogging/LoggingConfig.h"
+#include "afclogging/LoggingTiming.h"
+#include "afclogging/QtStream.h"
+
+namespace po = boost::program_options;
+
+namespace
+{
+// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "replay")
+
+/******************************************************************************************/
+/**** FUNCTION: readJsonl()                                                            ****/
+/**** Reads JSON objects from JSONL file, one per nonempty line.                       ****/
+/******************************************************************************************/
+std::vector<QByteArray> readJsonl(const std::string &filename)
+{
+	std::ifstream file(filename);
+	if (!file) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to open " << filename);
+	}
+	std::vector<QByteArray> lineList;
+	std::string line;
+	int lineNum = 0;
+	while (std::getline(file, line)) {
+		lineNum++;
+		if (line.find_first_not_of(" \t\r") == std::string::npos) {
+			continue;
+		}
+		QByteArray data = QByteArray::fromStdString(line);
+		QJsonParseError parseError;
+		if (!QJsonDocument::fromJson(data, &parseError).isObject()) {
+			throw std::runtime_error(ErrStream()
+						 << "ERROR: " << filename << ":" << lineNum
+						 << ": not a JSON object: "
+						 << parseError.errorString().toStdString());
+		}
+		lineList.push_back(data);
+	}
+	return (lineList);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: prepareConfig()                                                        ****/
+/**** Writes AFC config used by all inquiries to tempRoot. Unless configDataFlag is    ****/
+/**** set, data file locations are replaced with synthetic fixtures (US region).       ****/
+/******************************************************************************************/
+std::string prepareConfig(const std::string &configFile,
+			  bool configDataFlag,
+			  const std::string &tempRoot)
+{
+	QFile inFile(QString::fromStdString(configFile));
+	if (!inFile.open(QIODevice::ReadOnly)) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to open " << configFile);
+	}
+	QJsonParseError parseError;
+	QJsonDocument doc = QJsonDocument::fromJson(inFile.readAll(), &parseError);
+	if (!doc.isObject()) {
+		throw std::runtime_error(ErrStream() << "ERROR: Invalid JSON in " << configFile
+						     << ": "
+						     << parseError.errorString().toStdString());
+	}
+	QJsonObject config = doc.object();
+
+	if (!configDataFlag) {
+		LOGGER_INFO(logger) << "Generating synthetic engine data";
+		BenchFixtureClass &fixture = BenchFixtureClass::get();
+		config["globeDir"] = QString::fromStdString(fixture.getGlobeDir());
+		config["srtmDir"] = QString::fromStdString(fixture.getSrtmDir());
+		config["depDir"] = QString::fromStdString(fixture.getDepDir());
+		config["cdsmDir"] = QString();
+		config["lidarDir"] = QString();
+		config["nlcdFile"] = QString::fromStdString(fixture.getNlcdFile());
+		config["worldPopulationFile"] = QString::fromStdString(
+			fixture.getPopulationFile());
+		config["regionDir"] = QString::fromStdString(fixture.getRegionDir());
+		config["regionStr"] = QString("US");
+		config["rainForestFile"] = QString();
+		config["deniedRegionFile"] = QString();
+		config["nfaTableFile"] = QString::fromStdString(fixture.getNfaFile());
+		config["prTableFile"] = QString::fromStdString(fixture.getPrFile());
+		config["radioClimateFile"] = QString::fromStdString(fixture.getRadioClimateFile());
+		config["surfRefracFile"] = QString::fromStdString(fixture.getSurfRefracFile());
+		config.remove("fsDatabaseFileList");
+		config["fsDatabaseFile"] = QString::fromStdString(fixture.getUlsFile());
+	}
+
+	std::string outFilename = tempRoot + "/afc_config.json";
+	QFile outFile(QString::fromStdString(outFilename));
+	QByteArray data = QJsonDocument(config).toJson(QJsonDocument::Compact);
+	if ((!outFile.open(QIODevice::WriteOnly)) || (outFile.write(data) != data.size())) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to write " << outFilename);
+	}
+	return (outFilename);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: makeStats()                                                            ****/
+/**** Mean, max and nearest rank percentiles of valList (seconds).                     ****/
+/******************************************************************************************/
+QJsonObject makeStats(std::vector<double> valList)
+{
+	QJsonObject stats;
+	if (valList.empty()) {
+		return (stats);
+	}
+	std::sort(valList.begin(), valList.end());
+	double sum = 0.0;
+	for (double val : valList) {
+		sum += val;
+	}
+	int n = valList.size();
+	auto percentile = [&valList, n](double p) {
+		int idx = (int)std::ceil(p / 100.0 * n) - 1;
+		return (valList[std::min(std::max(idx, 0), n - 1)]);
+	};
+	stats["mean"] = sum / n;
+	stats["p50"] = percentile(50.0);
+	stats["p95"] = percentile(95.0);
+	stats["p99"] = percentile(99.0);
+	stats["max"] = valList.back();
+	return (stats);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: getPeakRssMB()                                                         ****/
+/******************************************************************************************/
+double getPeakRssMB()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (usage.ru_maxrss / 1024.0); // ru_maxrss is in kilobytes
+}
+/******************************************************************************************/
+}
+
+int main(int argc, char **argv)
+{
+	try {
+		po::options_description optDescript {"Allowed options"};
+		optDescript.add_options()("help,h", "print this help message")(
+			"inquiries,i",
+			po::value<std::string>()->required(),
+			"JSONL file of inquiries, one AvailableSpectrumInquiryRequest message per "
+			"line")("config,c",
+				po::value<std::string>()->required(),
+				"AFC config JSON file (as passed to afc-engine)")(
+			"config-data",
+			"use data files named in config instead of synthetic data")(
+			"request-type,r",
+			po::value<std::string>()->default_value("AP-AFC"),
+			"engine request type")(
+			"repeat,n",
+			po::value<int>()->default_value(1),
+			"number of times each inquiry is run")(
+			"warmup",
+			po::value<int>()->default_value(0),
+			"number of unmeasured sequential passes over inquiries before measurement")(
+			"golden",
+			po::value<std::string>()->default_value(""),
+			"JSONL file of expected responses (one per inquiry, in order) to compare "
+			"responses with")("golden-tolerance",
+					  po::value<double>()->default_value(1.0e-3),
+					  "maximum difference of numeric values (EIRP, PSD) from "
+					  "golden responses")(
+			"write-golden",
+			po::value<std::string>()->default_value(""),
+			"JSONL file to write responses of first pass to (golden output)")(
+			"report",
+			po::value<std::string>()->default_value("afc-engine-replay.json"),
+			"JSON report file")(
+			"temp-dir",
+			po::value<std::string>()->default_value(""),
+			"directory for engine input and output files (temporary directory if "
+			"empty)")(
+			"log-level,l",
+			po::value<std::string>()->default_value("warning"),
+			"engine log level");
+
+		po::variables_map cmdLineArgs;
+		po::store(po::parse_command_line(argc, argv, optDescript), cmdLineArgs);
+		if (cmdLineArgs.count("help")) {
+			std::cout << optDescript << std::endl;
+			return 0;
+		}
+		po::notify(cmdLineArgs);
+
+		std::string logLevel = cmdLineArgs["log-level"].as<std::string>();
+		QtStream::installLogHandler();
+		Logging::Config conf = Logging::Config();
+		Logging::Filter filter = Logging::Filter();
+		filter.setLevel(logLevel);
+		conf.useStdOut = false;
+		conf.useStdErr = true;
+		conf.filter = filter;
+		Logging::initialize(conf);
+
+		int numRepeat = cmdLineArgs["repeat"].as<int>();
+		int numWarmup = cmdLineArgs["warmup"].as<int>();
+		if ((numRepeat < 1) || (numWarmup < 0)) {
+			throw std::runtime_error("ERROR: repeat must be positive, warmup must not "
+						 "be negative");
+		}
+		double goldenTolerance = cmdLineArgs["golden-tolerance"].as<double>();
+
+		/******************************************************************************/
+		/* Inputs                                                                     */
+		/******************************************************************************/
+		std::string tempRoot = cmdLineArgs["temp-dir"].as<std::string>();
+		bool removeTempFlag = tempRoot.empty();
+		if (removeTempFlag) {
+			tempRoot = (boost::filesystem::temp_directory_path() /
+				    boost::filesystem::unique_path("afc-engine-replay-%%%%-%%%%"))
+					   .string();
+		}
+		boost::filesystem::create_directories(tempRoot);
+
+		std::vector<QByteArray> inquiryList =
+			readJsonl(cmdLineArgs["inquiries"].as<std::string>());
+		int numInquiry = inquiryList.size();
+		if (!numInquiry) {
+			throw std::runtime_error("ERROR: No inquiries to replay");
+		}
+
+		std::vector<QJsonObject> goldenList;
+		std::string goldenFile = cmdLineArgs["golden"].as<std::string>();
+		if (!goldenFile.empty()) {
+			for (const auto &data : readJsonl(goldenFile)) {
+				goldenList.push_back(QJsonDocument::fromJson(data).object());
+			}
+			if ((int)goldenList.size() != numInquiry) {
+				throw std::runtime_error(ErrStream()
+							 << "ERROR: " << goldenFile << " has "
+							 << goldenList.size() << " responses, "
+							 << numInquiry << " expected");
+			}
+		}
+
+		std::string configFile = prepareConfig(cmdLineArgs["config"].as<std::string>(),
+						       cmdLineArgs.count("config-data") > 0,
+						       tempRoot);
+		std::string timingReportFile = tempRoot + "/timing.json";
+		ReplayRunnerClass runner(cmdLineArgs["request-type"].as<std::string>(),
+					 configFile,
+					 tempRoot,
+					 logLevel,
+					 timingReportFile);
+		double setupPeakRssMB = getPeakRssMB();
+		/******************************************************************************/
+
+		/******************************************************************************/
+		/* Run inquiries. Run i processes inquiry (i % numInquiry)                    */
+		/******************************************************************************/
+		// Warmup runs are made without timing report, so that engine phase timing
+		// counts measured runs only
+		ReplayRunnerClass warmupRunner(cmdLineArgs["request-type"].as<std::string>(),
+					       configFile,
+					       tempRoot,
+					       logLevel,
+					       "");
+		int runIdx = 0;
+		for (int passIdx = 0; passIdx < numWarmup; ++passIdx) {
+			for (int inquiryIdx = 0; inquiryIdx < numInquiry; ++inquiryIdx) {
+				warmupRunner.run(inquiryIdx, runIdx++, inquiryList[inquiryIdx]);
+			}
+		}
+
+		int numRun = numRepeat * numInquiry;
+		std::vector<ReplayRunnerClass::ResultStruct> resultList(numRun);
+
+		auto tStart = std::chrono::steady_clock::now();
+		for (int idx = 0; idx < numRun; ++idx) {
+			int inquiryIdx = idx % numInquiry;
+			resultList[idx] = runner.run(inquiryIdx, runIdx++, inquiryList[inquiryIdx]);
+		}
+		double wallSec =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart)
+				.count();
+		/******************************************************************************/
+
+		/******************************************************************************/
+		/* Results                                                                    */
+		/******************************************************************************/
+		std::vector<double> latencyList;
+		std::vector<std::vector<double>> phaseLatencyList(ReplayRunnerClass::numPhase);
+		std::map<int, int> responseCodeCount;
+		int numFailed = 0;
+		int numMismatch = 0;
+		QJsonArray failureArray;
+		for (const auto &result : resultList) {
+			if (!result.okFlag) {
+				numFailed++;
+				QJsonObject failure;
+				failure["inquiry"] = result.inquiryIdx;
+				failure["error"] = QString::fromStdString(result.errMsg);
+				failureArray.append(failure);
+				LOGGER_ERROR(logger) << "Inquiry " << result.inquiryIdx
+						     << " failed: " << result.errMsg;
+				continue;
+			}
+			latencyList.push_back(result.totalSec);
+			for (int phaseIdx = 0; phaseIdx < ReplayRunnerClass::numPhase; ++phaseIdx) {
+				phaseLatencyList[phaseIdx].push_back(result.phaseSec[phaseIdx]);
+			}
+			responseCodeCount[result.responseCode]++;
+			if (!goldenList.empty()) {
+				std::string diff = compareResponse(result.response,
+								   goldenList[result.inquiryIdx],
+								   goldenTolerance);
+				if (!diff.empty()) {
+					numMismatch++;
+					QJsonObject failure;
+					failure["inquiry"] = result.inquiryIdx;
+					failure["goldenDiff"] = QString::fromStdString(diff);
+					failureArray.append(failure);
+					LOGGER_ERROR(logger) << "Inquiry " << result.inquiryIdx
+							     << " differs from golden response: "
+							     << diff;
+				}
+			}
+		}
+
+		std::string writeGoldenFile = cmdLineArgs["write-golden"].as<std::string>();
+		if (!writeGoldenFile.empty()) {
+			std::ofstream file(writeGoldenFile);
+			for (int inquiryIdx = 0; inquiryIdx < numInquiry; ++inquiryIdx) {
+				QJsonDocument doc(resultList[inquiryIdx].response);
+				file << doc.toJson(QJsonDocument::Compact).toStdString() << "\n";
+			}
+			if (!file) {
+				throw std::runtime_error(ErrStream() << "ERROR: Unable to write "
+								     << writeGoldenFile);
+			}
+		}
+
+		QJsonObject report;
+		report["inquiries"] = numInquiry;
+		report["runs"] = numRun;
+		report["failed"] = numFailed;
+		report["wallSec"] = wallSec;
+		report["throughputPerSec"] = (numRun - numFailed) / wallSec;
+		report["latencySec"] = makeStats(latencyList);
+		QJsonObject phaseObj;
+		for (int phaseIdx = 0; phaseIdx < ReplayRunnerClass::numPhase; ++phaseIdx) {
+			phaseObj[ReplayRunnerClass::getPhaseName(phaseIdx)] = makeStats(
+				phaseLatencyList[phaseIdx]);
+		}
+		report["phaseSec"] = phaseObj;
+		std::ostringstream timingReport;
+		Logging::writeTimingReport(timingReport);
+		report["enginePhases"] =
+			QJsonDocument::fromJson(QByteArray::fromStdString(timingReport.str()))
+				.object()["phases"];
+		QJsonObject responseCodeObj;
+		for (const auto &codeCount : responseCodeCount) {
+			responseCodeObj[QString::number(codeCount.first)] = codeCount.second;
+		}
+		report["responseCodes"] = responseCodeObj;
+		report["setupPeakRssMB"] = setupPeakRssMB;
+		report["peakRssMB"] = getPeakRssMB();
+		if (!goldenList.empty()) {
+			report["goldenMismatches"] = numMismatch;
+		}
+		report["failures"] = failureArray;
+
+		QByteArray reportData = QJsonDocument(report).toJson();
+		std::string reportFile = cmdLineArgs["report"].as<std::string>();
+		QFile reportQFile(QString::fromStdString(reportFile));
+		if ((!reportQFile.open(QIODevice::WriteOnly)) ||
+		    (reportQFile.write(reportData) != reportData.size())) {
+			throw std::runtime_error(ErrStream() << "ERROR: Unable to write "
+							     << reportFile);
+		}
+		reportQFile.close();
+		/******************************************************************************/
+
+		QJsonObject latencyObj = report["latencySec"].toObject();
+		std::cout << "runs: " << numRun << " (" << numFailed << " failed)" << std::endl
+			  << "latency (s): p50 " << latencyObj["p50"].toDouble() << ", p95 "
+			  << latencyObj["p95"].toDouble() << ", p99 "
+			  << latencyObj["p99"].toDouble() << std::endl
+			  << "throughput: " << report["throughputPerSec"].toDouble()
+			  << " inquiries/s, peak RSS: " << report["peakRssMB"].toDouble() << " MB"
+			  << std::endl;
+		for (int phaseIdx = 0; phaseIdx < ReplayRunnerClass::numPhase; ++phaseIdx) {
+			const char *phaseName = ReplayRunnerClass::getPhaseName(phaseIdx);
+			std::cout << "  " << phaseName << " mean (s): "
+				  << phaseObj[phaseName].toObject()["mean"].toDouble() << std::endl;
+		}
+		if (!goldenList.empty()) {
+			std::cout << "golden mismatches: " << numMismatch << std::endl;
+		}
+		std::cout << "report: " << reportFile << std::endl;
+
+		if (removeTempFlag) {
+			boost::system::error_code ec;
+			boost::filesystem::remove_all(tempRoot, ec);
+		}
+
+		return ((numFailed || numMismatch) ? 1 : 0);
+	} catch (std::exception &e) {
+		std::cerr << "afc-engine-replay error: " << e.what() << std::endl;
+		return 1;
+	}
+}
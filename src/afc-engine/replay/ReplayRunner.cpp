@@ -0,0 +1,273 @@
+/******************************************************************************************/
+/**** FILE: ReplayRunner.cpp                                                           ****/
+/******************************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <boost/filesystem.hpp>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QString>
+#include "AfcManager.h"
+#include "ReplayRunner.h"
+#include "afclogging/ErrStream.h"
+#include "ratcommon/GzipStream.h"
+
+namespace
+{
+const char *phaseNameList[] = {"importConfig",
+			       "importInquiry",
+			       "initializeDatabases",
+			       "compute",
+			       "export"};
+
+/******************************************************************************************/
+/**** FUNCTION: readGzipJson()                                                         ****/
+/**** Reads JSON object from gzipped file written by AfcManager::exportGUIjson()       ****/
+/******************************************************************************************/
+QJsonObject readGzipJson(const std::string &filename)
+{
+	QFile file(QString::fromStdString(filename));
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to open " << filename);
+	}
+	GzipStream gzipStream(&file);
+	if (!gzipStream.open(QIODevice::ReadOnly)) {
+		throw std::runtime_error(ErrStream() << "ERROR: Unable to decompress " << filename
+						     << ": "
+						     << gzipStream.errorString().toStdString());
+	}
+	QByteArray data = gzipStream.readAll();
+
+	QJsonParseError parseError;
+	QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+	if (!doc.isObject()) {
+		throw std::runtime_error(ErrStream() << "ERROR: Invalid JSON in " << filename
+						     << ": "
+						     << parseError.errorString().toStdString());
+	}
+	return (doc.object());
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: compareValue()                                                         ****/
+/**** Recursive part of compareResponse(), path is JSON path of value for messages.    ****/
+/******************************************************************************************/
+std::string compareValue(const QJsonValue &value,
+			 const QJsonValue &golden,
+			 double tolerance,
+			 const std::string &path)
+{
+	std::ostringstream diff;
+	if (value.type() != golden.type()) {
+		diff << path << ": type " << value.type() << " instead of " << golden.type();
+	} else if (value.isObject()) {
+		QJsonObject valueObj = value.toObject();
+		QJsonObject goldenObj = golden.toObject();
+		for (auto it = goldenObj.begin(); it != goldenObj.end(); ++it) {
+			std::string keyPath = path + "." + it.key().toStdString();
+			if (it.key() == "availabilityExpireTime") {
+				continue;
+			} else if (!valueObj.contains(it.key())) {
+				return (keyPath + ": missing");
+			}
+			std::string keyDiff = compareValue(valueObj[it.key()],
+							   it.value(),
+							   tolerance,
+							   keyPath);
+			if (!keyDiff.empty()) {
+				return (keyDiff);
+			}
+		}
+		for (auto it = valueObj.begin(); it != valueObj.end(); ++it) {
+			if (!goldenObj.contains(it.key())) {
+				return (path + "." + it.key().toStdString() + ": unexpected");
+			}
+		}
+	} else if (value.isArray()) {
+		QJsonArray valueArray = value.toArray();
+		QJsonArray goldenArray = golden.toArray();
+		if (valueArray.size() != goldenArray.size()) {
+			diff << path << ": " << valueArray.size() << " elements instead of "
+			     << goldenArray.size();
+		} else {
+			for (int idx = 0; idx < valueArray.size(); ++idx) {
+				std::ostringstream idxPath;
+				idxPath << path << "[" << idx << "]";
+				std::string idxDiff = compareValue(valueArray[idx],
+								   goldenArray[idx],
+								   tolerance,
+								   idxPath.str());
+				if (!idxDiff.empty()) {
+					return (idxDiff);
+				}
+			}
+		}
+	} else if (value.isDouble()) {
+		if (!(fabs(value.toDouble() - golden.toDouble()) <= tolerance)) {
+			diff << path << ": " << value.toDouble() << " instead of "
+			     << golden.toDouble();
+		}
+	} else if (value != golden) {
+		diff << path << ": " << value.toVariant().toString().toStdString()
+		     << " instead of " << golden.toVariant().toString().toStdString();
+	}
+	return (diff.str());
+}
+/******************************************************************************************/
+}
+
+/******************************************************************************************/
+/**** CONSTRUCTOR: ReplayRunnerClass::ReplayRunnerClass()                              ****/
+/******************************************************************************************/
+ReplayRunnerClass::ReplayRunnerClass(const std::string &requestTypeVal,
+				     const std::string &configFileVal,
+				     const std::string &tempRootVal,
+				     const std::string &logLevelVal,
+				     const std::string &timingReportFileVal) :
+	requestType(requestTypeVal),
+	configFile(configFileVal),
+	tempRoot(tempRootVal),
+	logLevel(logLevelVal),
+	timingReportFile(timingReportFileVal)
+{
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: ReplayRunnerClass::getPhaseName()                                      ****/
+/******************************************************************************************/
+const char *ReplayRunnerClass::getPhaseName(int phaseIdx)
+{
+	return (phaseNameList[phaseIdx]);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: ReplayRunnerClass::run()                                               ****/
+/**** Engine parameters are passed through AfcManager::setCmdLineParams(), as from     ****/
+/**** afc-engine command line, so that options are parsed the same way.                ****/
+/******************************************************************************************/
+ReplayRunnerClass::ResultStruct ReplayRunnerClass::run(int inquiryIdx,
+						       int runIdx,
+						       const QByteArray &inquiry) const
+{
+	ResultStruct result;
+	result.inquiryIdx = inquiryIdx;
+	result.okFlag = false;
+	result.totalSec = 0.0;
+	for (int phaseIdx = 0; phaseIdx < numPhase; ++phaseIdx) {
+		result.phaseSec[phaseIdx] = 0.0;
+	}
+	result.responseCode = -1;
+
+	std::ostringstream runDirStr;
+	runDirStr << tempRoot << "/run-" << runIdx;
+	std::string runDir = runDirStr.str();
+	boost::filesystem::create_directories(runDir);
+	std::string inputFile = runDir + "/analysisRequest.json";
+	std::string outputFile = runDir + "/analysisResponse.json.gz";
+
+	try {
+		QFile inputQFile(QString::fromStdString(inputFile));
+		if ((!inputQFile.open(QIODevice::WriteOnly)) ||
+		    (inputQFile.write(inquiry) != inquiry.size())) {
+			throw std::runtime_error(ErrStream()
+						 << "ERROR: Unable to write " << inputFile);
+		}
+		inputQFile.close();
+
+		std::vector<std::string> argStrList = {"afc-engine-replay",
+						       "--request-type=" + requestType,
+						       "--state-root=" + runDir,
+						       "--mnt-path=" + runDir,
+						       "--input-file-path=" + inputFile,
+						       "--config-file-path=" + configFile,
+						       "--output-file-path=" + outputFile,
+						       "--temp-dir=" + runDir,
+						       "--log-level=" + logLevel,
+						       "--runtime_opt=0",
+						       "--timing-report=" + timingReportFile};
+		std::vector<char *> argv;
+		for (auto &argStr : argStrList) {
+			argv.push_back(&argStr[0]);
+		}
+		argv.push_back((char *)NULL);
+
+		// Latency includes AfcManager construction and destruction, as in afc-engine
+		auto tStart = std::chrono::steady_clock::now();
+		{
+			AfcManager afcManager;
+			std::string inputFilePath, configFilePath, outputFilePath, tempDir,
+				logLevelVal;
+			afcManager.setCmdLineParams(inputFilePath,
+						    configFilePath,
+						    outputFilePath,
+						    tempDir,
+						    logLevelVal,
+						    (int)argStrList.size(),
+						    argv.data());
+			afcManager.setConstInputs(tempDir);
+
+			auto t0 = std::chrono::steady_clock::now();
+			afcManager.importConfigAFCjson(configFilePath, tempDir);
+			auto t1 = std::chrono::steady_clock::now();
+			afcManager.importGUIjson(inputFilePath);
+			auto t2 = std::chrono::steady_clock::now();
+			afcManager.initializeDatabases();
+			auto t3 = std::chrono::steady_clock::now();
+			afcManager.compute();
+			auto t4 = std::chrono::steady_clock::now();
+			afcManager.exportGUIjson(QString::fromStdString(outputFilePath), tempDir);
+			auto t5 = std::chrono::steady_clock::now();
+
+			result.phaseSec[importConfigPhase] =
+				std::chrono::duration<double>(t1 - t0).count();
+			result.phaseSec[importInquiryPhase] =
+				std::chrono::duration<double>(t2 - t1).count();
+			result.phaseSec[initializeDatabasesPhase] =
+				std::chrono::duration<double>(t3 - t2).count();
+			result.phaseSec[computePhase] =
+				std::chrono::duration<double>(t4 - t3).count();
+			result.phaseSec[exportPhase] =
+				std::chrono::duration<double>(t5 - t4).count();
+		}
+		result.totalSec =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart)
+				.count();
+
+		result.response = readGzipJson(outputFile);
+		QJsonArray responseArray =
+			result.response["availableSpectrumInquiryResponses"].toArray();
+		if (responseArray.size()) {
+			QJsonObject responseObj = responseArray[0].toObject();
+			result.responseCode =
+				responseObj["response"].toObject()["responseCode"].toInt(-1);
+		}
+		result.okFlag = true;
+	} catch (std::exception &err) {
+		result.errMsg = err.what();
+	}
+
+	boost::system::error_code ec;
+	boost::filesystem::remove_all(runDir, ec);
+
+	return (result);
+}
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: compareResponse()                                                      ****/
+/******************************************************************************************/
+std::string compareResponse(const QJsonObject &response,
+			    const QJsonObject &golden,
+			    double tolerance)
+{
+	return (compareValue(QJsonValue(response), QJsonValue(golden), tolerance, "$"));
+}
+/******************************************************************************************/
@@ -0,0 +1,75 @@
+/******************************************************************************************/
+/**** FILE : ReplayRunner.h                                                            ****/
+/******************************************************************************************/
+
+#ifndef REPLAY_RUNNER_H
+#define REPLAY_RUNNER_H
+
+#include <string>
+#include <vector>
+#include <QByteArray>
+#include <QJsonObject>
+
+/******************************************************************************************/
+/**** CLASS: ReplayRunnerClass                                                         ****/
+/**** Runs recorded inquiries through AfcManager in-process, in the same sequence of   ****/
+/**** calls as afc-engine main(), timing each phase. One AfcManager is created per     ****/
+/**** inquiry. AfcManager sets static members of engine classes, so run() must         ****/
+/**** not be called concurrently.                                                      ****/
+/******************************************************************************************/
+class ReplayRunnerClass
+{
+	public:
+		// Phases timed for each inquiry, in execution order
+		enum PhaseEnum {
+			importConfigPhase,
+			importInquiryPhase,
+			initializeDatabasesPhase,
+			computePhase,
+			exportPhase,
+			numPhase
+		};
+
+		struct ResultStruct {
+				int inquiryIdx;
+				bool okFlag; // Engine completed (response may still be an error)
+				std::string errMsg; // Exception text if !okFlag
+				double totalSec; // Wall time of all phases
+				double phaseSec[numPhase];
+				int responseCode; // responseCode of response (-1 if not available)
+				QJsonObject response; // AvailableSpectrumInquiryResponseMessage
+		};
+
+		ReplayRunnerClass(const std::string &requestType,
+				  const std::string &configFile,
+				  const std::string &tempRoot,
+				  const std::string &logLevel,
+				  const std::string &timingReportFile);
+
+		// Runs single inquiry (AvailableSpectrumInquiryRequestMessage JSON). runIdx
+		// makes name of temporary directory unique
+		ResultStruct run(int inquiryIdx, int runIdx, const QByteArray &inquiry) const;
+
+		static const char *getPhaseName(int phaseIdx);
+
+	private:
+		std::string requestType;
+		std::string configFile;
+		std::string tempRoot;
+		std::string logLevel;
+		std::string timingReportFile;
+};
+/******************************************************************************************/
+
+/******************************************************************************************/
+/**** FUNCTION: compareResponse()                                                      ****/
+/**** Compares response with golden response. Numbers may differ by at most tolerance, ****/
+/**** availabilityExpireTime is ignored. Returns empty string if responses match,      ****/
+/**** otherwise description of first difference.                                       ****/
+/******************************************************************************************/
+std::string compareResponse(const QJsonObject &response,
+			    const QJsonObject &golden,
+			    double tolerance);
+/******************************************************************************************/
+
+#endif
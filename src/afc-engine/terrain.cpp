@@ -253,6 +253,25 @@ void TerrainClass::getTerrainHeight(double longitudeDeg,
 }
 /******************************************************************************************/
 
+/******************************************************************************************/
+/**** FUNCTION: TerrainClass::isBuilding()                                             ****/
+/******************************************************************************************/
+bool TerrainClass::isBuilding(double longitudeDeg, double latitudeDeg) const
+{
+	if ((longitudeDeg < minLidarLongitude) || (longitudeDeg > maxLidarLongitude) ||
+	    (latitudeDeg < minLidarLatitude) || (latitudeDeg > maxLidarLatitude)) {
+		return false;
+	}
+	int lidarRegionIdx = getLidarRegion(longitudeDeg, latitudeDeg);
+	if (lidarRegionIdx == -1) {
+		return false;
+	}
+	return lidarRegionList[lidarRegionIdx].multibandRaster->isBuilding(latitudeDeg,
+									    longitudeDeg,
+									    gdalDirectMode);
+}
+/******************************************************************************************/
+
 /******************************************************************************************/
 /**** FUNCTION: TerrainClass::getGdalDirectMode()                                        ****/
 /******************************************************************************************/
@@ -578,6 +597,8 @@ void TerrainClass::readLidarInfo(std::string lidarDir)
 						lidarRegion.format = CConst::fromVectorLidarFormat;
 					} else if (strval == "from_raster") {
 						lidarRegion.format = CConst::fromRasterLidarFormat;
+					} else if (strval == "compact") {
+						lidarRegion.format = CConst::compactLidarFormat;
 					} else {
 						errStr << "lidarRegion.format not a valid value. "
 							  "Got "
@@ -671,5 +692,14 @@ void TerrainClass::printStats()
 			    << (double)(totalNumTerrain ? numGlobal * 100.0 / totalNumTerrain : 0.0)
 			    << " %)";
 	LOGGER_INFO(logger) << "NUM_ITM = " << numITM;
+	if (CachedGdalBase::sharedTileCache()) {
+		const SharedTileCache &stc = *CachedGdalBase::sharedTileCache();
+		LOGGER_INFO(logger) << "SHARED_TILE_CACHE " << stc.name()
+				    << ": HITS = " << stc.hits() << "  MISSES = " << stc.misses()
+				    << "  PUBLISHED = " << stc.publishes();
+	}
+	if (CachedGdalBase::accessProfiler()) {
+		CachedGdalBase::accessProfiler()->logSummary();
+	}
 }
 /******************************************************************************************/
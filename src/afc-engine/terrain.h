@@ -77,6 +77,10 @@ class TerrainClass
 				      CConst::HeightSourceEnum &heightSource,
 				      bool cdsmFlag = false) const;
 
+		// True if LiDAR data has building at given point. Cheaper than
+		// getTerrainHeight() for LiDAR files with building mask
+		bool isBuilding(double longitudeDeg, double latitudeDeg) const;
+
 		void writeTerrainProfile(std::string filename,
 					 double startLongitudeDeg,
 					 double startLatitudeDeg,
@@ -13,6 +13,7 @@
 
 #include "uls.h"
 #include "antenna.h"
+#include "RxGainTable.h"
 #include "calcitu1245.h"
 #include "calcitu699.h"
 #include "calcitu1336_4.h"
@@ -44,8 +45,6 @@ ULSClass::ULSClass(AfcManager *dataSetVal,
 
 	location = (char *)NULL;
 	ITMHeightProfile = (double *)NULL;
-	isLOSHeightProfile = (double *)NULL;
-	isLOSSurfaceFrac = quietNaN;
 
 	dataSet = (AfcManager *)NULL;
 
@@ -108,6 +107,7 @@ ULSClass::ULSClass(AfcManager *dataSetVal,
 	fadeMarginDB = quietNaN;
 	pairIdx = -1;
 	numOutOfBandRLAN = 0;
+	setRxGainTableCache((RxGainTableCacheClass *)NULL);
 }
 /******************************************************************************************/
 
@@ -649,6 +649,17 @@ void ULSClass::setNumOutOfBandRLAN(int numOutOfBandRLANVal)
 	numOutOfBandRLAN = numOutOfBandRLANVal;
 	return;
 }
+void ULSClass::setRxGainTableCache(RxGainTableCacheClass *rxGainTableCacheVal)
+{
+	rxGainTableCache = rxGainTableCacheVal;
+	for (int divIdx = 0; divIdx < 2; ++divIdx) {
+		for (int bandIdx = 0; bandIdx < 2; ++bandIdx) {
+			rxGainTableList[divIdx][bandIdx] = (const RxGainTableClass *)NULL;
+			rxGainTableInitList[divIdx][bandIdx] = false;
+		}
+	}
+	return;
+}
 /******************************************************************************************/
 
 /******************************************************************************************/
@@ -680,6 +691,14 @@ double ULSClass::computeRxGain(double angleOffBoresightDeg,
 	double rxGainDB;
 	subModelStr = "";
 
+	if (rxGainTableCache) {
+		const RxGainTableClass *rxGainTable = getRxGainTable(divIdx, frequency);
+		if (rxGainTable &&
+		    rxGainTable->lookup(angleOffBoresightDeg, rxGainDB, subModelStr)) {
+			return (rxGainDB);
+		}
+	}
+
 	double maxGain = (divIdx == 0 ? rxGain : diversityGain);
 	double Dlambda = (divIdx == 0 ? rxDlambda : diversityDlambda);
 
@@ -732,6 +751,32 @@ double ULSClass::computeRxGain(double angleOffBoresightDeg,
 }
 /******************************************************************************************/
 
+/******************************************************************************************/
+/**** FUNCTION: ULSClass::getRxGainTable                                               ****/
+/**** Gain table of RX (divIdx = 0) or diversity (divIdx = 1) antenna, NULL if pattern ****/
+/**** has no table.                                                                    ****/
+/******************************************************************************************/
+const RxGainTableClass *ULSClass::getRxGainTable(int divIdx, double frequency)
+{
+	int bandIdx = RxGainTableCacheClass::getBandIdx(rxAntennaType, frequency);
+	if (bandIdx == -1) {
+		return ((const RxGainTableClass *)NULL);
+	}
+	if (!rxGainTableInitList[divIdx][bandIdx]) {
+		rxGainTableList[divIdx][bandIdx] = rxGainTableCache->getTable(
+			rxAntennaType,
+			rxAntenna,
+			rxAntennaCategory,
+			(divIdx == 0 ? rxGain : diversityGain),
+			(divIdx == 0 ? rxDlambda : diversityDlambda),
+			divIdx,
+			frequency);
+		rxGainTableInitList[divIdx][bandIdx] = true;
+	}
+	return (rxGainTableList[divIdx][bandIdx]);
+}
+/******************************************************************************************/
+
 /******************************************************************************************/
 /**** FUNCTION: ULSClass::calcR2AIP07Antenna                                           ****/
 /******************************************************************************************/
@@ -1081,6 +1126,12 @@ PRClass::PRClass()
 
 	reflectorSLambda = quietNaN;
 	reflectorTheta1 = quietNaN;
+
+	gainTableCache = (RxGainTableCacheClass *)NULL;
+	for (int bandIdx = 0; bandIdx < 2; ++bandIdx) {
+		gainTableList[bandIdx] = (const RxGainTableClass *)NULL;
+		gainTableInitList[bandIdx] = false;
+	}
 }
 /******************************************************************************************/
 
@@ -1092,6 +1143,30 @@ PRClass::~PRClass()
 }
 /******************************************************************************************/
 
+/******************************************************************************************/
+/**** FUNCTION: PRClass::getGainTable                                                  ****/
+/**** Gain table of back to back antenna, NULL if pattern has no table.                ****/
+/******************************************************************************************/
+const RxGainTableClass *PRClass::getGainTable(double maxGain, double frequency)
+{
+	int bandIdx = RxGainTableCacheClass::getBandIdx(antennaType, frequency);
+	if (bandIdx == -1) {
+		return ((const RxGainTableClass *)NULL);
+	}
+	if (!gainTableInitList[bandIdx]) {
+		gainTableList[bandIdx] = gainTableCache->getTable(antennaType,
+								  antenna,
+								  antCategory,
+								  maxGain,
+								  rxDlambda,
+								  0,
+								  frequency);
+		gainTableInitList[bandIdx] = true;
+	}
+	return (gainTableList[bandIdx]);
+}
+/******************************************************************************************/
+
 /******************************************************************************************/
 /**** FUNCTION: PRClass::computeDiscriminationGain                                     ****/
 /******************************************************************************************/
@@ -1103,6 +1178,19 @@ double PRClass::computeDiscriminationGain(double angleOffBoresightDeg,
 {
 	double discriminationDB;
 
+	if ((type == CConst::backToBackAntennaPRType) && gainTableCache) {
+		// LUT pattern is discrimination gain, other patterns are relative to rxGain
+		double maxGain = (antennaType == CConst::LUTAntennaType ? 0.0 : rxGain);
+		const RxGainTableClass *gainTable = getGainTable(maxGain, frequency);
+		double gainDB;
+		std::string subModelStr;
+		if (gainTable && gainTable->lookup(angleOffBoresightDeg, gainDB, subModelStr)) {
+			reflectorD0 = quietNaN;
+			reflectorD1 = quietNaN;
+			return (gainDB - maxGain);
+		}
+	}
+
 	switch (type) {
 		case CConst::backToBackAntennaPRType: {
 			std::string subModelStr;
@@ -5,6 +5,7 @@
 #ifndef ULS_H
 #define ULS_H
 
+#include "LOSOracle.h"
 #include "Vector3.h"
 #include "cconst.h"
 #include "pop_grid.h"
@@ -13,6 +14,8 @@ class GdalDataDir;
 class WorldData;
 class AfcManager;
 class AntennaClass;
+class RxGainTableClass;
+class RxGainTableCacheClass;
 
 template<class T>
 class ListClass;
@@ -83,6 +86,13 @@ class PRClass
 
 		double reflectorSLambda; // (s/lambda) used in calculation of discrimination gain
 		double reflectorTheta1; // Theta1 used in calculation of discrimination gain
+
+		// If set, back to back antenna discrimination gain is taken from gain table when
+		// table has angle, tables are fetched from cache on first use for each band
+		const RxGainTableClass *getGainTable(double maxGain, double frequency);
+		RxGainTableCacheClass *gainTableCache;
+		const RxGainTableClass *gainTableList[2];
+		bool gainTableInitList[2];
 };
 /******************************************************************************************/
 
@@ -283,6 +293,7 @@ class ULSClass
 		void setRxTerrainHeightFlag(bool terrainHeightFlagVal);
 		void setTxTerrainHeightFlag(bool terrainHeightFlagVal);
 		void setNumOutOfBandRLAN(int numOutOfBandRLANVal);
+		void setRxGainTableCache(RxGainTableCacheClass *rxGainTableCacheVal);
 
 		void setRxPosition(Vector3 &p);
 		void setTxPosition(Vector3 &p);
@@ -330,8 +341,7 @@ class ULSClass
 
 		char *location;
 		double *ITMHeightProfile;
-		double *isLOSHeightProfile;
-		double isLOSSurfaceFrac;
+		LOSOracleClass losOracle; // LOS along current ground track
 
 #if DEBUG_AFC
 		std::vector<std::string> ITMHeightType;
@@ -414,6 +424,14 @@ class ULSClass
 		std::string status;
 		int pairIdx;
 		int numOutOfBandRLAN;
+
+		const RxGainTableClass *getRxGainTable(int divIdx, double frequency);
+
+		// If set, computeRxGain() takes gain from gain table when table has angle. Tables
+		// are indexed by divIdx and band and fetched from cache on first use
+		RxGainTableCacheClass *rxGainTableCache;
+		const RxGainTableClass *rxGainTableList[2][2];
+		bool rxGainTableInitList[2][2];
 };
 /******************************************************************************************/
 
@@ -13,6 +13,7 @@ import shutil
 import tempfile
 import zlib
 from celery import Celery
+from celery.signals import worker_init, worker_process_shutdown
 from celery.utils.log import get_task_logger
 from appcfg import BrokerConfigurator
 from fst import DataIf
@@ -20,6 +21,9 @@ import defs
 import afctask
 import als
 import json
+import prometheus_client
+import prometheus_client.multiprocess
+import prometheus_utils
 from rcache_models import RcacheClientSettings
 from rcache_client import RcacheClient
 
@@ -37,6 +41,38 @@ class WorkerConfig(BrokerConfigurator):
         # worker task engine timeout
         # the default value predefined by image environment (Dockefile)
         self.AFC_WORKER_ENG_TOUT = os.getenv("AFC_WORKER_ENG_TOUT")
+        # name of POSIX shared memory object for terrain tile cache, shared
+        # by all engine processes of the worker. Empty to not use
+        self.AFC_ENGINE_SHARED_TILE_CACHE = \
+            os.getenv("AFC_ENGINE_SHARED_TILE_CACHE", "")
+        # directory for memory-mapped cache of preprocessed population and ITU
+        # grids, shared by all engine processes of the worker. Empty to not use
+        self.AFC_ENGINE_GRID_CACHE_DIR = \
+            os.getenv("AFC_ENGINE_GRID_CACHE_DIR", "")
+        # format of exc_thr debug file: 'csv' (exc_thr.csv.gz) or 'columnar'
+        # (binary exc_thr.afccol). Empty for engine default (CSV)
+        self.AFC_ENGINE_EXC_THR_FORMAT = \
+            os.getenv("AFC_ENGINE_EXC_THR_FORMAT", "")
+        # nonempty to make engine write per-phase timing report and forward
+        # it to Prometheus metrics. Empty to not measure
+        self.AFC_ENGINE_TIMING_REPORT = \
+            os.getenv("AFC_ENGINE_TIMING_REPORT", "")
+        # port to serve Prometheus metrics of all pool processes on (requires
+        # PROMETHEUS_MULTIPROC_DIR). Empty to not serve
+        self.AFC_WORKER_PROMETHEUS_PORT = \
+            os.getenv("AFC_WORKER_PROMETHEUS_PORT", "")
+
+
+class EngineTimeMetric(prometheus_utils.PrometheusTimeBase):
+    """ Time spent in AFC Engine processing phases (from timing report) """
+    metric = prometheus_utils.PrometheusTimeBase.make_metric(
+        "afc_engine_phase_time", "Time spent in AFC Engine processing phases")
+
+
+# Number of executions of AFC Engine processing phases
+ENGINE_PHASE_CALLS = prometheus_client.Counter(
+    "afc_engine_phase_calls", "Number of AFC Engine processing phase runs",
+    ["scope", "segment"])
 
 
 conf = WorkerConfig()
@@ -49,6 +85,26 @@ rcache = RcacheClient(rcache_settings, rmq_receiver=False) \
 
 LOGGER.info('Celery Broker: %s', conf.BROKER_URL)
 
+
+@worker_init.connect
+def start_prometheus_server(**kwargs):
+    """ Starts metrics endpoint in worker main process. Metrics are
+    collected by pool processes and shared via PROMETHEUS_MULTIPROC_DIR """
+    if (not conf.AFC_WORKER_PROMETHEUS_PORT) or \
+            (not prometheus_utils.multiprocess_prometheus_configured()):
+        return
+    if not prometheus_utils.start_multiprocess_http_server(
+            int(conf.AFC_WORKER_PROMETHEUS_PORT)):
+        LOGGER.info('Prometheus metrics port %s is served by another '
+                    'worker', conf.AFC_WORKER_PROMETHEUS_PORT)
+
+
+@worker_process_shutdown.connect
+def cleanup_prometheus_process(pid=None, **kwargs):
+    """ Removes per-process Prometheus data of terminated pool process """
+    if prometheus_utils.multiprocess_prometheus_configured():
+        prometheus_client.multiprocess.mark_process_dead(pid or os.getpid())
+
 #: constant celery reference. Configure once flask app is created
 client = Celery(
     'fbrat',
@@ -152,6 +208,18 @@ def run(prot, host, port, request_type, task_id, hash_val,
                 "--log-level=" + conf.AFC_ENGINE_LOG_LVL,
                 "--runtime_opt=" + str(runtime_opts),
             ]
+            if conf.AFC_ENGINE_SHARED_TILE_CACHE:
+                cmd.append("--shared-tile-cache=" +
+                           conf.AFC_ENGINE_SHARED_TILE_CACHE)
+            if conf.AFC_ENGINE_GRID_CACHE_DIR:
+                cmd.append("--grid-cache-dir=" +
+                           conf.AFC_ENGINE_GRID_CACHE_DIR)
+            if conf.AFC_ENGINE_EXC_THR_FORMAT:
+                cmd.append("--exc-thr-format=" +
+                           conf.AFC_ENGINE_EXC_THR_FORMAT)
+            timing_report_path = os.path.join(tmpdir, "engine-timing.json")
+            if conf.AFC_ENGINE_TIMING_REPORT:
+                cmd.append("--timing-report=" + timing_report_path)
             LOGGER.debug(cmd)
             retcode = 0
             proc = subprocess.Popen(cmd, stderr=err_file, stdout=log_file)
@@ -194,6 +262,15 @@ def run(prot, host, port, request_type, task_id, hash_val,
                     f"Failed to make ALS report on engine crash: {ex}")
         else:
             LOGGER.info('finished with task computation')
+            if conf.AFC_ENGINE_TIMING_REPORT:
+                try:
+                    with open(timing_report_path, encoding="utf-8") as infile:
+                        prometheus_utils.observe_timing_report(
+                            EngineTimeMetric.metric, request_type,
+                            json.load(infile), ENGINE_PHASE_CALLS)
+                except Exception as ex:
+                    LOGGER.error(f"Failed to process engine timing report: "
+                                 f"{ex}")
 
         proc = None
         log_file.close()
@@ -19,3 +19,4 @@ RNTM_OPT_NODBG_GUI = RNTM_OPT_GUI
 RNTM_OPT_DBG_GUI = (RNTM_OPT_DBG | RNTM_OPT_GUI)
 
 RNTM_OPT_CERT_ID = 32
+RNTM_OPT_TERRAIN_PROFILE = 64
@@ -10,9 +10,12 @@ This module defines a couple of wrappers around some stuff, defined in
 prometheus_client Python module. Specifically:
 
 - PrometheusTimeBase class for time measurements
+- observe_timing_report() for forwarding AFC Engine timing report to metric
 - multiprocess_prometheus_configured() and multiprocess_flask_metrics() for
   defining Prometheus metrics endpoint in multiprocess Flask application (see
   'SETUP' section below)
+- start_multiprocess_http_server() for serving metrics of multiprocess
+  non-Flask application (e.g. Celery worker) on separate port
 
 PrometheusTimeBase is a base class for defining Summary (mapped to Prometheus
 'counter' data type) for measuring time spent inside code (at function level
@@ -141,7 +144,7 @@ import prometheus_client.multiprocess
 import prometheus_client.core
 import sys
 import time
-from typing import Optional
+from typing import Any, Dict, Optional
 
 
 class PrometheusTimeBase:
@@ -268,6 +271,31 @@ class PrometheusTimeBase:
                                               ["type", "scope", "segment"])
 
 
+def observe_timing_report(
+        metric: prometheus_client.core.Summary, scope: str,
+        report: Dict[str, Any],
+        count_metric: Optional[prometheus_client.core.Counter] = None) \
+        -> None:
+    """ Adds times from AFC Engine timing report to metric
+
+    Arguments:
+    metric       -- Summary metric, created by PrometheusTimeBase.make_metric()
+    scope        -- Value for 'scope' label. Phase names from report become
+                    'segment' labels
+    report       -- Timing report (dictionary, loaded from JSON, written by
+                    AFC Engine with --timing-report): {"phases": [{"name":
+                    ..., "count": ..., "wall_sec": ..., "cpu_sec": ...}, ...]}
+    count_metric -- Optional Counter metric with 'scope' and 'segment' labels
+                    for number of executions of each phase
+    """
+    for phase in report.get("phases", []):
+        metric.labels("cpu", scope, phase["name"]).observe(phase["cpu_sec"])
+        metric.labels("wallclock", scope, phase["name"]).\
+            observe(phase["wall_sec"])
+        if count_metric is not None:
+            count_metric.labels(scope, phase["name"]).inc(phase["count"])
+
+
 def multiprocess_prometheus_configured() -> bool:
     """ True if multiprocess Priometheus client support was (hopefully)
     configured, False if definitely not """
@@ -282,3 +310,23 @@ def multiprocess_flask_metrics() -> "flask.Response":
     ret = flask.make_response(prometheus_client.generate_latest(registry))
     ret.mimetype = prometheus_client.CONTENT_TYPE_LATEST
     return ret
+
+
+def start_multiprocess_http_server(port: int) -> bool:
+    """ Starts HTTP server (in background thread) that serves metrics of all
+    processes, sharing 'PROMETHEUS_MULTIPROC_DIR' directory
+
+    Arguments:
+    port -- Port to serve metrics on
+    Returns True if server started, False if port is already in use (e.g. by
+    server, started by another application instance in same container - it
+    serves the same metrics)
+    """
+    assert multiprocess_prometheus_configured()
+    registry = prometheus_client.CollectorRegistry()
+    prometheus_client.multiprocess.MultiProcessCollector(registry)
+    try:
+        prometheus_client.start_http_server(port, registry=registry)
+    except OSError:
+        return False
+    return True
@@ -13,6 +13,7 @@
 #include <boost/log/sources/severity_channel_logger.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/sources/severity_feature.hpp>
+#include <boost/log/keywords/channel.hpp>
 
 /** Utility functions for interacting with boost::log library.
  *
@@ -50,6 +51,22 @@ typedef boost::log::sources::severity_channel_logger_mt<
 	>
 	logger_mt;
 
+/** Per-thread copy of global logger.
+ *
+ * Global loggers (logger_mt) serialize all threads on internal mutex when
+ * record is opened. LOG_SEV() and derived macros instead use single-thread
+ * logger with the same channel, created for each thread on first use.
+ *
+ * @tparam TagT Logger tag type, defined with LOGGER_DEFINE_GLOBAL()
+ * @return Logger for current thread
+ */
+template<typename TagT>
+logger_st &threadLogger()
+{
+	static thread_local logger_st inst(boost::log::keywords::channel = TagT::get().channel());
+	return inst;
+}
+
 /** Access the root logger, which always passes the record filter.
  *
  * @return The root logger instance with channel name "Logging".
@@ -79,6 +96,23 @@ class Flusher
 
 } // End namespace
 
+/** Least severe level of log statements that are compiled in. Statements of
+ * less severe levels (e.g. LOGGER_DEBUG() if defined as Logging::LOG_INFO)
+ * are eliminated at compile time, with their arguments never evaluated.
+ * Set with AFCLOGGING_COMPILED_LEVEL CMake variable.
+ */
+#ifndef LOGGER_COMPILED_LEVEL
+	#define LOGGER_COMPILED_LEVEL Logging::LOG_DEBUG
+#endif
+
+/** Executes following statement only if given severity is compiled in.
+ * @param severity Severity level of log statement
+ */
+#define LOGGER_IF_COMPILED(severity) \
+	for (bool loggerCompiledIn_ = ((int)(severity) >= (int)(LOGGER_COMPILED_LEVEL)); \
+	     loggerCompiledIn_; \
+	     loggerCompiledIn_ = false)
+
 /** Define a global thread-safe logger instance.
  *
  * @param tag_name The object name used to identify the logger.
@@ -95,33 +129,40 @@ class Flusher
 /** Log at Logging::LOG_DEBUG level.
  * @param inst The logger instance to write to.
  */
-#define LOGINST_DEBUG(inst) BOOST_LOG_SEV(inst, Logging::LOG_DEBUG)
+#define LOGINST_DEBUG(inst) \
+	LOGGER_IF_COMPILED(Logging::LOG_DEBUG) BOOST_LOG_SEV(inst, Logging::LOG_DEBUG)
 
 /** Log at Logging::LOG_INFO level.
  * @param inst The logger instance to write to.
  */
-#define LOGINST_INFO(inst) BOOST_LOG_SEV(inst, Logging::LOG_INFO)
+#define LOGINST_INFO(inst) \
+	LOGGER_IF_COMPILED(Logging::LOG_INFO) BOOST_LOG_SEV(inst, Logging::LOG_INFO)
 
 /** Log at Logging::LOG_WARN level.
  * @param inst The logger instance to write to.
  */
-#define LOGINST_WARN(inst) BOOST_LOG_SEV(inst, Logging::LOG_WARN)
+#define LOGINST_WARN(inst) \
+	LOGGER_IF_COMPILED(Logging::LOG_WARN) BOOST_LOG_SEV(inst, Logging::LOG_WARN)
 
 /** Log at Logging::ERROR level.
  * @param inst The logger instance to write to.
  */
-#define LOGINST_ERROR(inst) BOOST_LOG_SEV(inst, Logging::LOG_ERROR)
+#define LOGINST_ERROR(inst) \
+	LOGGER_IF_COMPILED(Logging::LOG_ERROR) BOOST_LOG_SEV(inst, Logging::LOG_ERROR)
 
 /** Log at Logging::LOG_CRIT level.
  * @param inst The logger instance to write to.
  */
-#define LOGINST_CRIT(inst) BOOST_LOG_SEV(inst, Logging::LOG_CRIT)
+#define LOGINST_CRIT(inst) \
+	LOGGER_IF_COMPILED(Logging::LOG_CRIT) BOOST_LOG_SEV(inst, Logging::LOG_CRIT)
 
 /** Log at arbitrary severity level.
  * @param tag_name The object name used to identify the logger.
  * @param severity The specific severity level.
  */
-#define LOG_SEV(tag_name, severity) BOOST_LOG_SEV(tag_name::get(), severity)
+#define LOG_SEV(tag_name, severity) \
+	LOGGER_IF_COMPILED(severity) \
+	BOOST_LOG_SEV(Logging::threadLogger<tag_name>(), severity)
 
 /** Log at Logging::DEBUG level.
  * @param tag_name The object name used to identify the logger.
@@ -0,0 +1,175 @@
+//
+
+#include "LoggingAsyncQueue.h"
+
+Logging::LockFreeRecordQueue::LockFreeRecordQueue() :
+	_mask(0),
+	_policy(OVERFLOW_BLOCK),
+	_head(0),
+	_tail(0),
+	_dropped(0),
+	_consumerWaiting(false),
+	_producersWaiting(0),
+	_interrupted(false),
+	_interruptGeneration(0)
+{
+	configure(DEFAULT_CAPACITY, OVERFLOW_BLOCK);
+}
+
+Logging::LockFreeRecordQueue::~LockFreeRecordQueue()
+{
+}
+
+void Logging::LockFreeRecordQueue::configure(size_t capacity, OverflowPolicy policy)
+{
+	size_t size = 2;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	_slots.reset(new Slot[size]);
+	for (size_t i = 0; i < size; ++i) {
+		_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	_mask = size - 1;
+	_policy = policy;
+	_head.store(0, std::memory_order_relaxed);
+	_tail = 0;
+}
+
+bool Logging::LockFreeRecordQueue::pushSlot(boost::log::record_view const &rec)
+{
+	size_t pos = _head.load(std::memory_order_relaxed);
+	for (;;) {
+		Slot &slot = _slots[pos & _mask];
+		size_t seq = slot.sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+		if (diff == 0) {
+			if (_head.compare_exchange_weak(pos,
+							pos + 1,
+							std::memory_order_relaxed)) {
+				slot.rec = rec;
+				slot.sequence.store(pos + 1, std::memory_order_release);
+				break;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			pos = _head.load(std::memory_order_relaxed);
+		}
+	}
+	// Pairs with fence in dequeue_ready(): either feeding thread sees the
+	// record or this thread sees it waiting
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	return true;
+}
+
+bool Logging::LockFreeRecordQueue::popSlot(boost::log::record_view &rec)
+{
+	Slot &slot = _slots[_tail & _mask];
+	if (slot.sequence.load(std::memory_order_acquire) != _tail + 1) {
+		return false;
+	}
+	rec = std::move(slot.rec);
+	slot.rec.reset();
+	slot.sequence.store(_tail + _mask + 1, std::memory_order_release);
+	++_tail;
+	// Pairs with fence in enqueue()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	return true;
+}
+
+bool Logging::LockFreeRecordQueue::tryPush(boost::log::record_view const &rec)
+{
+	if (!pushSlot(rec)) {
+		return false;
+	}
+	if (_consumerWaiting.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_notEmpty.notify_one();
+	}
+	return true;
+}
+
+bool Logging::LockFreeRecordQueue::tryPop(boost::log::record_view &rec)
+{
+	if (!popSlot(rec)) {
+		return false;
+	}
+	if (_producersWaiting.load(std::memory_order_relaxed) > 0) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_notFull.notify_all();
+	}
+	return true;
+}
+
+void Logging::LockFreeRecordQueue::enqueue(boost::log::record_view const &rec)
+{
+	if (tryPush(rec)) {
+		return;
+	}
+	if (_policy == OVERFLOW_DROP) {
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	std::unique_lock<std::mutex> lock(_mutex);
+	const uint64_t generation = _interruptGeneration;
+	_producersWaiting.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (!pushSlot(rec)) {
+		if (_interruptGeneration != generation) {
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			break;
+		}
+		_notFull.wait(lock);
+	}
+	_producersWaiting.fetch_sub(1, std::memory_order_relaxed);
+	if (_consumerWaiting.load(std::memory_order_relaxed)) {
+		_notEmpty.notify_one();
+	}
+}
+
+bool Logging::LockFreeRecordQueue::try_enqueue(boost::log::record_view const &rec)
+{
+	return tryPush(rec);
+}
+
+bool Logging::LockFreeRecordQueue::try_dequeue(boost::log::record_view &rec)
+{
+	return tryPop(rec);
+}
+
+bool Logging::LockFreeRecordQueue::dequeue_ready(boost::log::record_view &rec)
+{
+	for (;;) {
+		if (tryPop(rec)) {
+			return true;
+		}
+		std::unique_lock<std::mutex> lock(_mutex);
+		if (_interrupted) {
+			_interrupted = false;
+			return false;
+		}
+		_consumerWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const bool popped = popSlot(rec);
+		if (!popped) {
+			_notEmpty.wait(lock);
+		}
+		_consumerWaiting.store(false, std::memory_order_relaxed);
+		if (popped) {
+			if (_producersWaiting.load(std::memory_order_relaxed) > 0) {
+				_notFull.notify_all();
+			}
+			return true;
+		}
+	}
+}
+
+void Logging::LockFreeRecordQueue::interrupt_dequeue()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_interrupted = true;
+	++_interruptGeneration;
+	_notEmpty.notify_one();
+	_notFull.notify_all();
+}
@@ -0,0 +1,147 @@
+//
+
+#ifndef SRC_AFCLOGGING_LOGGINGASYNCQUEUE_H_
+#define SRC_AFCLOGGING_LOGGINGASYNCQUEUE_H_
+
+#include <boost/log/core/record_view.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace Logging
+{
+
+/// What to do with log record when asynchronous sink queue is full
+enum OverflowPolicy {
+	OVERFLOW_BLOCK, //!< Logging thread waits until there is space in queue
+	OVERFLOW_DROP //!< Record is discarded (and counted)
+};
+
+/** Queueing strategy for boost::log::sinks::asynchronous_sink.
+ *
+ * Bounded multi-producer single-consumer ring buffer. Logging threads enqueue
+ * records without taking locks; mutex is only taken to wake up sleeping
+ * feeding thread (when queue was empty) or sleeping logging threads (when
+ * queue was full with OVERFLOW_BLOCK policy).
+ *
+ * Capacity and overflow policy are set with configure() before records are
+ * enqueued (i.e. before sink is added to logging core).
+ */
+class LockFreeRecordQueue
+{
+	public:
+		/** Sets queue parameters. Must be called before queue is used.
+		 *
+		 * @param capacity Maximum number of queued records (rounded up to
+		 * power of 2)
+		 * @param policy What to do when queue is full
+		 */
+		void configure(size_t capacity, OverflowPolicy policy);
+
+		/// Number of records dropped on overflow so far
+		uint64_t droppedCount() const
+		{
+			return _dropped.load(std::memory_order_relaxed);
+		}
+
+	protected:
+		/// Default capacity (until configure() is called)
+		static const size_t DEFAULT_CAPACITY = 8192;
+
+		/// Default constructor
+		LockFreeRecordQueue();
+
+		/// Initializing constructor (named parameters are ignored)
+		template<typename ArgsT>
+		explicit LockFreeRecordQueue(ArgsT const &) : LockFreeRecordQueue()
+		{
+		}
+
+		~LockFreeRecordQueue();
+
+		/// Enqueues record, applying overflow policy if queue is full
+		void enqueue(boost::log::record_view const &rec);
+
+		/// Enqueues record if there is space in queue
+		bool try_enqueue(boost::log::record_view const &rec);
+
+		/// Dequeues record if queue is not empty
+		bool try_dequeue_ready(boost::log::record_view &rec)
+		{
+			return try_dequeue(rec);
+		}
+
+		/// Dequeues record if queue is not empty
+		bool try_dequeue(boost::log::record_view &rec);
+
+		/** Dequeues record, waits if queue is empty.
+		 * @return False if wait was interrupted with interrupt_dequeue()
+		 */
+		bool dequeue_ready(boost::log::record_view &rec);
+
+		/// Wakes feeding thread, waiting in dequeue_ready()
+		void interrupt_dequeue();
+
+	private:
+		/// Ring buffer element
+		struct Slot {
+				/// Position at which slot may be written (if equal to
+				/// position) or read (if equal to position + 1)
+				std::atomic<size_t> sequence;
+				/// Queued record
+				boost::log::record_view rec;
+		};
+
+		/// Lock-free enqueue without wakeup. False if queue is full
+		bool pushSlot(boost::log::record_view const &rec);
+
+		/// Lock-free dequeue (single consumer) without wakeup. False if
+		/// queue is empty
+		bool popSlot(boost::log::record_view &rec);
+
+		/// Enqueue, wakes up feeding thread if it sleeps. False if queue is
+		/// full. Must be called without _mutex held
+		bool tryPush(boost::log::record_view const &rec);
+
+		/// Dequeue, wakes up waiting logging threads. False if queue is
+		/// empty. Must be called without _mutex held
+		bool tryPop(boost::log::record_view &rec);
+
+		/// Ring buffer
+		std::unique_ptr<Slot[]> _slots;
+		/// Ring buffer size minus one (size is power of 2)
+		size_t _mask;
+		/// What to do when queue is full
+		OverflowPolicy _policy;
+
+		/// Next position to write. Separate cache line from reader data
+		alignas(64) std::atomic<size_t> _head;
+		/// Next position to read (only accessed by feeding thread)
+		alignas(64) size_t _tail;
+
+		/// Number of dropped records
+		std::atomic<uint64_t> _dropped;
+
+		/// Mutex for sleeping/waking only
+		std::mutex _mutex;
+		/// Feeding thread waits here when queue is empty
+		std::condition_variable _notEmpty;
+		/// Logging threads wait here when queue is full
+		std::condition_variable _notFull;
+		/// True if feeding thread is (about to be) waiting on _notEmpty
+		std::atomic<bool> _consumerWaiting;
+		/// Number of logging threads waiting on _notFull
+		std::atomic<int> _producersWaiting;
+		/// True if feeding thread should stop waiting
+		bool _interrupted;
+		/// Incremented on interrupt_dequeue(), drops records of waiting
+		/// logging threads (like boost::log::sinks::block_on_overflow does)
+		uint64_t _interruptGeneration;
+};
+
+} // End namespace
+
+#endif /* SRC_AFCLOGGING_LOGGINGASYNCQUEUE_H_ */
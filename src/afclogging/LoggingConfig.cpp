@@ -4,6 +4,7 @@
 #include <boost/log/core.hpp>
 #include <boost/log/attributes/clock.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
 #include <boost/log/sinks/syslog_backend.hpp>
 #include <boost/log/sinks/event_log_backend.hpp>
@@ -16,6 +17,7 @@
 #include <boost/log/support/regex.hpp>
 #include <iomanip>
 #include <ostream>
+#include <thread>
 
 // allows for backwards compatability with older version of Boost.
 #if BOOST_VERSION >= 105600
@@ -115,6 +117,64 @@ const boost::log::formatter textFormatter = (expr::stream
 					     << "TH:" << Logging::thread_id << " "
 					     << "<" << Logging::severity << "> " << Logging::channel
 					     << ": " << Logging::message);
+/// Asynchronous text sink type
+typedef sinks::asynchronous_sink<sinks::text_ostream_backend, Logging::LockFreeRecordQueue>
+	AsyncTextSink;
+
+/** Asynchronous sink with its feeding thread. Destructor stops the thread and
+ * writes records that remain in queue.
+ */
+class AsyncSinkRunner
+{
+	public:
+		explicit AsyncSinkRunner(const boost::shared_ptr<AsyncTextSink> &sinkVal) :
+			sink(sinkVal), _thread([sinkVal]() { sinkVal->run(); })
+		{
+		}
+
+		~AsyncSinkRunner()
+		{
+			sink->stop();
+			_thread.join();
+			sink->feed_records();
+			sink->flush();
+		}
+
+		/// The sink
+		boost::shared_ptr<AsyncTextSink> sink;
+
+	private:
+		std::thread _thread;
+};
+
+/// Running asynchronous sinks
+std::vector<std::unique_ptr<AsyncSinkRunner>> asyncSinks;
+
+/** Add text sink (synchronous or asynchronous, according to configuration)
+ * to logging core.
+ *
+ * @param core Logging core
+ * @param backend Text stream backend to write to
+ * @param config Logging configuration
+ */
+void addTextSink(const boost::shared_ptr<logging::core> &core,
+		 const boost::shared_ptr<sinks::text_ostream_backend> &backend,
+		 const Logging::Config &config)
+{
+	if (config.async) {
+		auto sink = boost::make_shared<AsyncTextSink>(backend, false);
+		sink->configure(config.async->queueSize, config.async->overflow);
+		sink->set_formatter(textFormatter);
+		asyncSinks.emplace_back(new AsyncSinkRunner(sink));
+		core->add_sink(sink);
+	} else {
+		typedef sinks::synchronous_sink<sinks::text_ostream_backend> sink_t;
+		auto sink = boost::make_shared<sink_t>(backend);
+		sink->set_formatter(textFormatter);
+		core->add_sink(sink);
+	}
+}
+
 /// Initial #curConfig has been set
 bool hasConfig = false;
 /// Copy of running configuration
@@ -195,6 +255,8 @@ void Logging::initialize(const Logging::Config &config)
 	boost::shared_ptr<logging::core> core = logging::core::get();
 	// clear initial state
 	core->remove_all_sinks();
+	// stop asynchronous sinks after they are detached, writing what remains
+	asyncSinks.clear();
 	int sinkCount = 0;
 
 	// Fixed attributes
@@ -218,7 +280,6 @@ void Logging::initialize(const Logging::Config &config)
 
 	if (config.useStdOut || config.useStdErr) {
 		typedef sinks::text_ostream_backend backend_t;
-		typedef sinks::synchronous_sink<backend_t> sink_t;
 
 		auto backend = boost::make_shared<backend_t>();
 
@@ -232,10 +293,7 @@ void Logging::initialize(const Logging::Config &config)
 			backend->add_stream(stream);
 		}
 
-		auto sink = boost::make_shared<sink_t>(backend);
-		sink->set_formatter(textFormatter);
-
-		core->add_sink(sink);
+		addTextSink(core, backend, config);
 		++sinkCount;
 	}
 #if !defined(BOOST_LOG_WITHOUT_SYSLOG)
@@ -290,7 +348,6 @@ void Logging::initialize(const Logging::Config &config)
 #endif
 	if (config.useStream) {
 		typedef sinks::text_ostream_backend backend_t;
-		typedef sinks::synchronous_sink<backend_t> sink_t;
 
 		// keep the reference in #extStream but do not manage memory
 		extRef.reset(config.useStream->stream.get(), BOOST_NULL_DELETER);
@@ -298,10 +355,7 @@ void Logging::initialize(const Logging::Config &config)
 		backend->add_stream(extRef);
 		backend->auto_flush(config.useStream->autoFlush);
 
-		auto sink = boost::make_shared<sink_t>(backend);
-		sink->set_formatter(textFormatter);
-
-		core->add_sink(sink);
+		addTextSink(core, backend, config);
 		++sinkCount;
 	} else {
 		extRef.reset();
@@ -317,3 +371,12 @@ void Logging::initialize(const Logging::Config &config)
 	curConfig = config;
 	hasConfig = true;
 }
+
+uint64_t Logging::droppedRecords()
+{
+	uint64_t ret = 0;
+	for (const auto &runner : asyncSinks) {
+		ret += runner->sink->droppedCount();
+	}
+	return ret;
+}
@@ -4,6 +4,7 @@
 #define LOGGING_CONFIG_H_
 
 #include "Logging.h"
+#include "LoggingAsyncQueue.h"
 #include <boost/regex.hpp>
 #include <boost/log/detail/default_attribute_names.hpp>
 #include <boost/log/attributes/current_thread_id.hpp>
@@ -89,6 +90,22 @@ struct OStreamConfig {
 		bool autoFlush = false;
 };
 
+/** Asynchronous text sink configuration.
+ * Records are formatted and written by background thread, logging threads
+ * only put them to lock-free queue.
+ */
+struct AsyncConfig {
+		/// Default configuration
+		AsyncConfig()
+		{
+		}
+
+		/// Maximum number of records waiting to be written
+		size_t queueSize = 8192;
+		/// What to do with new records when queue is full
+		OverflowPolicy overflow = OVERFLOW_BLOCK;
+};
+
 #if !defined(BOOST_LOG_WITHOUT_SYSLOG)
 /// Syslog-specific configuration
 struct SyslogConfig {
@@ -138,6 +155,9 @@ struct Config {
 #endif
 		/// If non-null, output will be appended to this stream
 		std::shared_ptr<OStreamConfig> useStream;
+		/// If non-null, text outputs (stdout, stderr, stream) are
+		/// asynchronous. Otherwise records are written by logging thread
+		std::shared_ptr<AsyncConfig> async;
 
 		/// Filter for log events
 		Filter filter;
@@ -160,6 +180,13 @@ Config currentConfig();
  */
 void initialize(const Config &config = Config());
 
+/** Number of records dropped by asynchronous sinks (with OVERFLOW_DROP
+ * policy) since last initialize().
+ *
+ * @return Number of dropped records
+ */
+uint64_t droppedRecords();
+
 } // End namespace
 
 #endif /* LOGGING_CONFIG_H_ */
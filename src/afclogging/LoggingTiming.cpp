@@ -0,0 +1,114 @@
+//
+
+#include "LoggingTiming.h"
+#include "Logging.h"
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <time.h>
+
+namespace
+{
+/// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "Timing")
+
+/// Head of global list of counters
+std::atomic<Logging::TimingCounter *> counterListHead(nullptr);
+
+int64_t clockNs(clockid_t clockId)
+{
+	struct timespec ts;
+	clock_gettime(clockId, &ts);
+	return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/// Writes string as JSON string literal
+void writeJsonString(std::ostream &stream, const char *s)
+{
+	stream << '"';
+	for (; *s; ++s) {
+		if ((*s == '"') || (*s == '\\')) {
+			stream << '\\';
+		}
+		stream << *s;
+	}
+	stream << '"';
+}
+}
+
+std::atomic<bool> Logging::timingEnabledFlag(false);
+
+Logging::TimingCounter::TimingCounter(const char *name) :
+	_name(name), _count(0), _wallNs(0), _cpuNs(0), _next(counterListHead.load())
+{
+	while (!counterListHead.compare_exchange_weak(_next, this)) {
+	}
+}
+
+void Logging::setTimingEnabled(bool enabled)
+{
+	timingEnabledFlag.store(enabled);
+}
+
+void Logging::ScopedTimer::begin()
+{
+	_wallStartNs = clockNs(CLOCK_MONOTONIC);
+	_cpuStartNs = clockNs(CLOCK_THREAD_CPUTIME_ID);
+}
+
+void Logging::ScopedTimer::end()
+{
+	int64_t cpuNs = clockNs(CLOCK_THREAD_CPUTIME_ID) - _cpuStartNs;
+	int64_t wallNs = clockNs(CLOCK_MONOTONIC) - _wallStartNs;
+	_counter->add(wallNs, cpuNs);
+}
+
+void Logging::writeTimingReport(std::ostream &stream)
+{
+	struct Totals {
+			int64_t count = 0;
+			int64_t wallNs = 0;
+			int64_t cpuNs = 0;
+	};
+	// Counters with same name are merged, report is sorted by name
+	std::map<std::string, Totals> totals;
+	for (const TimingCounter *counter = counterListHead.load(); counter;
+	     counter = counter->next()) {
+		if (counter->count() == 0) {
+			continue;
+		}
+		Totals &t = totals[counter->name()];
+		t.count += counter->count();
+		t.wallNs += counter->wallNs();
+		t.cpuNs += counter->cpuNs();
+	}
+	std::ostringstream out;
+	out.precision(9);
+	out << "{\"phases\": [";
+	bool first = true;
+	for (const auto &entry : totals) {
+		out << (first ? "\n" : ",\n") << "  {\"name\": ";
+		writeJsonString(out, entry.first.c_str());
+		out << ", \"count\": " << entry.second.count
+		    << ", \"wall_sec\": " << (double)entry.second.wallNs * 1e-9
+		    << ", \"cpu_sec\": " << (double)entry.second.cpuNs * 1e-9 << "}";
+		first = false;
+	}
+	out << "\n]}\n";
+	stream << out.str();
+}
+
+void Logging::writeTimingReportFile(const std::string &filename)
+{
+	std::ostringstream report;
+	writeTimingReport(report);
+	LOGGER_INFO(logger) << "Timing report: " << report.str();
+	std::ofstream file(filename);
+	file << report.str();
+	file.close();
+	if (!file) {
+		throw std::runtime_error("Logging::writeTimingReportFile(): Error writing '" +
+					 filename + "'");
+	}
+}
@@ -0,0 +1,197 @@
+//
+
+#ifndef SRC_AFCLOGGING_LOGGINGTIMING_H_
+#define SRC_AFCLOGGING_LOGGINGTIMING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/** @file
+ * Lightweight scoped timers for per-phase latency measurement.
+ *
+ * Each measured code span is identified by name and accumulates wall time,
+ * CPU time (of calling thread) and number of executions. Measurement is off by
+ * default - disabled timer costs a single relaxed atomic load.
+ *
+ * Usage:
+ * @code
+ * void readData() {
+ *     LOGGER_TIMED_SCOPE("readData");
+ *     ...
+ *     LOGGER_TIMER(parseTimer, "readData.parse");
+ *     ...
+ *     parseTimer.stop();
+ *     ...
+ * }
+ * ...
+ * Logging::setTimingEnabled(true);
+ * ...
+ * Logging::writeTimingReportFile("timing.json");
+ * @endcode
+ */
+
+namespace Logging
+{
+
+/** Accumulated statistics of single named code span. Instances must have
+ * static storage duration (they are registered in global list on creation).
+ */
+class TimingCounter
+{
+	public:
+		/** Constructor. Registers counter in global list
+		 *
+		 * @param name Name of code span. Must be string literal
+		 */
+		explicit TimingCounter(const char *name);
+
+		/** Name of code span */
+		const char *name() const
+		{
+			return _name;
+		}
+
+		/** Adds one execution
+		 *
+		 * @param wallNs Wall time in nanoseconds
+		 * @param cpuNs CPU time in nanoseconds
+		 */
+		void add(int64_t wallNs, int64_t cpuNs)
+		{
+			_count.fetch_add(1, std::memory_order_relaxed);
+			_wallNs.fetch_add(wallNs, std::memory_order_relaxed);
+			_cpuNs.fetch_add(cpuNs, std::memory_order_relaxed);
+		}
+
+		/// Number of executions
+		int64_t count() const
+		{
+			return _count.load(std::memory_order_relaxed);
+		}
+
+		/// Total wall time in nanoseconds
+		int64_t wallNs() const
+		{
+			return _wallNs.load(std::memory_order_relaxed);
+		}
+
+		/// Total CPU time in nanoseconds
+		int64_t cpuNs() const
+		{
+			return _cpuNs.load(std::memory_order_relaxed);
+		}
+
+		/// Next counter in global list
+		const TimingCounter *next() const
+		{
+			return _next;
+		}
+
+	private:
+		const char *_name;
+		std::atomic<int64_t> _count;
+		std::atomic<int64_t> _wallNs;
+		std::atomic<int64_t> _cpuNs;
+		TimingCounter *_next;
+};
+
+/// True if timing measurement is enabled. Not for direct use
+extern std::atomic<bool> timingEnabledFlag;
+
+/** Enables or disables timing measurement. Should be called before
+ * measured code starts
+ */
+void setTimingEnabled(bool enabled);
+
+/// True if timing measurement is enabled
+inline bool timingEnabled()
+{
+	return timingEnabledFlag.load(std::memory_order_relaxed);
+}
+
+/** An RAII class that measures time spent in scope and adds it to counter.
+ */
+class ScopedTimer
+{
+	public:
+		/** Starts measurement (if timing is enabled)
+		 *
+		 * @param counter Counter to add measured time to
+		 */
+		explicit ScopedTimer(TimingCounter &counter) :
+			_counter(timingEnabled() ? &counter : nullptr)
+		{
+			if (_counter) {
+				begin();
+			}
+		}
+
+		/** Ends measurement (if not ended yet) */
+		~ScopedTimer()
+		{
+			stop();
+		}
+
+		/** Ends measurement before the end of scope */
+		void stop()
+		{
+			if (_counter) {
+				end();
+				_counter = nullptr;
+			}
+		}
+
+		ScopedTimer(const ScopedTimer &) = delete;
+		ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+	private:
+		void begin();
+		void end();
+
+		TimingCounter *_counter;
+		int64_t _wallStartNs;
+		int64_t _cpuStartNs;
+};
+
+/** Writes JSON report of all counters that have nonzero execution count:
+ * {"phases": [{"name": ..., "count": ..., "wall_sec": ..., "cpu_sec": ...}, ...]}
+ *
+ * @param stream Stream to write to
+ */
+void writeTimingReport(std::ostream &stream);
+
+/** Writes JSON report to file and logs it (at info level).
+ * Throws std::runtime_error if file can't be written.
+ *
+ * @param filename Name of file to write report to
+ */
+void writeTimingReportFile(const std::string &filename);
+
+} // End namespace
+
+#define LOGGER_TIMED_SCOPE_CAT2(a, b) a##b
+#define LOGGER_TIMED_SCOPE_CAT(a, b) LOGGER_TIMED_SCOPE_CAT2(a, b)
+
+/** Measure time spent from this point to the end of enclosing scope.
+ *
+ * @param span_name Name of measured code span (string literal). Spans with
+ * the same name (e.g. variants of the same model in different functions) are
+ * merged in report.
+ */
+#define LOGGER_TIMED_SCOPE(span_name) \
+	LOGGER_TIMER(LOGGER_TIMED_SCOPE_CAT(scopedTimer_, __LINE__), span_name)
+
+/** Define timer variable that measures time spent from this point to the end
+ * of enclosing scope or to explicit call of its stop() method.
+ *
+ * @param timer_name Name of Logging::ScopedTimer variable
+ * @param span_name Name of measured code span (string literal)
+ */
+#define LOGGER_TIMER(timer_name, span_name) \
+	static Logging::TimingCounter LOGGER_TIMED_SCOPE_CAT(timingCounter_, __LINE__)( \
+		span_name); \
+	Logging::ScopedTimer timer_name(LOGGER_TIMED_SCOPE_CAT(timingCounter_, __LINE__))
+
+#endif /* SRC_AFCLOGGING_LOGGINGTIMING_H_ */
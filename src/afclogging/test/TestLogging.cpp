@@ -4,6 +4,8 @@
 #include "../LoggingConfig.h"
 #include <memory>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -200,3 +202,79 @@ TEST_F(TestLogging, testFilterChannelExclude)
 		outbuf->str(std::string());
 	}
 }
+
+TEST_F(TestLogging, testAsyncOrder)
+{
+	auto outbuf = std::make_shared<std::stringstream>();
+
+	Logging::Config conf;
+	conf.useStdOut = false;
+	conf.useStdErr = false;
+	conf.useStream = toStream(outbuf);
+	conf.async = std::make_shared<Logging::AsyncConfig>();
+	conf.async->queueSize = 16;
+	Logging::initialize(conf);
+
+	boost::log::core::get()->flush();
+	outbuf->str(std::string());
+
+	const int numThreads = 4, numRecords = 500;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < numThreads; ++t) {
+		threads.emplace_back([t]() {
+			for (int i = 0; i < numRecords; ++i) {
+				LOGGER_INFO(loggerA) << "thread " << t << " record " << i;
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	boost::log::core::get()->flush();
+
+	// All records are written, records of each thread are in order
+	std::vector<int> next(numThreads, 0);
+	const boost::regex lineRe(".* <info> TestLoggingA: thread (\\d+) record (\\d+)");
+	std::string line;
+	int count = 0;
+	while (std::getline(*outbuf, line)) {
+		boost::smatch match;
+		ASSERT_TRUE(boost::regex_match(line, match, lineRe)) << "Line:" << line;
+		int t = std::stoi(match[1]);
+		ASSERT_EQ(next[t], std::stoi(match[2]));
+		++next[t];
+		++count;
+	}
+	ASSERT_EQ(numThreads * numRecords, count);
+	ASSERT_EQ(0u, Logging::droppedRecords());
+}
+
+TEST_F(TestLogging, testAsyncDrop)
+{
+	auto outbuf = std::make_shared<std::stringstream>();
+
+	Logging::Config conf;
+	conf.useStdOut = false;
+	conf.useStdErr = false;
+	conf.useStream = toStream(outbuf);
+	conf.async = std::make_shared<Logging::AsyncConfig>();
+	conf.async->queueSize = 4;
+	conf.async->overflow = Logging::OVERFLOW_DROP;
+	Logging::initialize(conf);
+
+	boost::log::core::get()->flush();
+	outbuf->str(std::string());
+
+	const int numRecords = 10000;
+	for (int i = 0; i < numRecords; ++i) {
+		LOGGER_INFO(loggerB) << "record " << i;
+	}
+	boost::log::core::get()->flush();
+
+	std::string line;
+	uint64_t count = 0;
+	while (std::getline(*outbuf, line)) {
+		++count;
+	}
+	ASSERT_EQ((uint64_t)numRecords, count + Logging::droppedRecords());
+}
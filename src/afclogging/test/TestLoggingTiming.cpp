@@ -0,0 +1,80 @@
+//
+
+#include "../LoggingTiming.h"
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void timedFunction()
+{
+	LOGGER_TIMED_SCOPE("TestLoggingTiming.timed");
+}
+
+void otherTimedFunction()
+{
+	LOGGER_TIMED_SCOPE("TestLoggingTiming.timed");
+}
+
+void disabledFunction()
+{
+	LOGGER_TIMED_SCOPE("TestLoggingTiming.disabled");
+}
+
+void stoppedTimerFunction()
+{
+	LOGGER_TIMER(timer, "TestLoggingTiming.stopped");
+	timer.stop();
+	timer.stop();
+}
+}
+
+class TestLoggingTiming : public testing::Test
+{
+	public:
+		void TearDown() override
+		{
+			Logging::setTimingEnabled(false);
+		}
+};
+
+TEST_F(TestLoggingTiming, testDisabled)
+{
+	Logging::setTimingEnabled(false);
+	disabledFunction();
+	std::ostringstream report;
+	Logging::writeTimingReport(report);
+	EXPECT_EQ(std::string::npos, report.str().find("TestLoggingTiming.disabled"));
+}
+
+TEST_F(TestLoggingTiming, testMergedCounts)
+{
+	Logging::setTimingEnabled(true);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i) {
+		threads.emplace_back([]() {
+			for (int j = 0; j < 100; ++j) {
+				timedFunction();
+				otherTimedFunction();
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	std::ostringstream report;
+	Logging::writeTimingReport(report);
+	EXPECT_NE(std::string::npos,
+		  report.str().find("{\"name\": \"TestLoggingTiming.timed\", \"count\": 800,"));
+}
+
+TEST_F(TestLoggingTiming, testExplicitStop)
+{
+	Logging::setTimingEnabled(true);
+	stoppedTimerFunction();
+	std::ostringstream report;
+	Logging::writeTimingReport(report);
+	EXPECT_NE(std::string::npos,
+		  report.str().find("{\"name\": \"TestLoggingTiming.stopped\", \"count\": 1,"));
+}
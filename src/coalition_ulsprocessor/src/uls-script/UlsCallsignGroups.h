@@ -0,0 +1,94 @@
+#ifndef ULS_CALLSIGN_GROUPS_H
+#define ULS_CALLSIGN_GROUPS_H
+
+#include <vector>
+
+/* Read-only view of contiguous records */
+template<class T>
+class UlsRecordRange
+{
+	public:
+		typedef const T *const_iterator;
+
+		UlsRecordRange() : b(nullptr), e(nullptr)
+		{
+		}
+		UlsRecordRange(const T *bVal, const T *eVal) : b(bVal), e(eVal)
+		{
+		}
+
+		const T *begin() const
+		{
+			return b;
+		}
+		const T *end() const
+		{
+			return e;
+		}
+		int size() const
+		{
+			return e - b;
+		}
+		bool isEmpty() const
+		{
+			return b == e;
+		}
+		const T &operator[](int i) const
+		{
+			return b[i];
+		}
+
+	private:
+		const T *b;
+		const T *e;
+};
+
+/* Records of one type grouped by callsign id: records are sorted by callsign id (stably, so
+ * file order is kept within a callsign), offsets[id] is the index of the first record of
+ * callsign id */
+template<class T>
+class UlsCallsignGroups
+{
+	public:
+		/* Builds groups from records and callsign id of each record */
+		template<class Container>
+		void build(const Container &recordsVal,
+			   const std::vector<int> &recordIds,
+			   int numCallsigns)
+		{
+			offsets.assign(numCallsigns + 1, 0);
+			for (int id : recordIds) {
+				++offsets[id + 1];
+			}
+			for (int id = 0; id < numCallsigns; ++id) {
+				offsets[id + 1] += offsets[id];
+			}
+			std::vector<int> order(recordIds.size());
+			std::vector<int> pos(offsets.begin(), offsets.end() - 1);
+			for (int recIdx = 0; recIdx < (int)recordIds.size(); ++recIdx) {
+				order[pos[recordIds[recIdx]]++] = recIdx;
+			}
+			records.clear();
+			records.reserve(order.size());
+			for (int recIdx : order) {
+				records.push_back(recordsVal[recIdx]);
+			}
+		}
+
+		/* Records of callsign id, empty for id -1 */
+		UlsRecordRange<T> group(int callsignId) const
+		{
+			if ((callsignId < 0) || (callsignId + 1 >= (int)offsets.size())) {
+				return UlsRecordRange<T>();
+			}
+			const T *data = records.data();
+			return UlsRecordRange<T>(data + offsets[callsignId],
+						 data + offsets[callsignId + 1]);
+		}
+
+	private:
+		std::vector<T> records;
+		std::vector<int> offsets;
+};
+
+#endif
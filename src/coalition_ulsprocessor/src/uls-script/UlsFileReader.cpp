@@ -3,6 +3,9 @@
 #include <math.h>
 #include <iostream>
 #include <sstream>
+#include <future>
+#include <memory>
+#include <stdlib.h>
 #include <bsd/string.h>
 
 #include "global_fn.h"
@@ -27,6 +30,222 @@ double emptyAtof(const char *str)
 	return z;
 }
 
+enum RecordTypeEnum {
+	hdUSRecordType,
+	paUSRecordType,
+	anUSRecordType,
+	frUSRecordType,
+	loUSRecordType,
+	emUSRecordType,
+	enUSRecordType,
+	mfUSRecordType,
+	cpUSRecordType,
+	sgUSRecordType,
+	raUSRecordType,
+	sdCARecordType,
+	ppCARecordType,
+	prCARecordType,
+	apCARecordType,
+	taCARecordType,
+	numRecordTypes,
+	unknownRecordType
+};
+
+RecordTypeEnum getRecordType(const std::string &front)
+{
+	static const char *const names[numRecordTypes] = {"US:HD",
+							  "US:PA",
+							  "US:AN",
+							  "US:FR",
+							  "US:LO",
+							  "US:EM",
+							  "US:EN",
+							  "US:MF",
+							  "US:CP",
+							  "US:SG",
+							  "US:RA",
+							  "CA:SD",
+							  "CA:PP",
+							  "CA:PR",
+							  "CA:AP",
+							  "CA:TA"};
+	for (int i = 0; i < numRecordTypes; ++i) {
+		if (front == names[i]) {
+			return (RecordTypeEnum)i;
+		}
+	}
+	return unknownRecordType;
+}
+
+// Record types parsed together in parallel mode. Both RA and SD records append to RASList, so
+// they are parsed by one task, in file order
+int getParseGroup(RecordTypeEnum recordType)
+{
+	return (recordType == sdCARecordType) ? raUSRecordType : recordType;
+}
+
+// Same line classification as split(line, '|') followed by check of the first field: empty
+// lines, lines with blank single field and lines with first field starting with '#' are
+// ignored. Returns false for ignored lines, otherwise sets front to the first field
+bool getDataLineFront(const std::string &line, std::string &front)
+{
+	if (line.empty()) {
+		return false;
+	}
+	std::string::size_type delimPos = line.find('|');
+	front = line.substr(0, delimPos);
+	std::string::size_type fIdx = front.find_first_not_of(' ');
+	if (fIdx == std::string::npos) {
+		return !((delimPos == std::string::npos) || (delimPos + 1 == line.size()));
+	}
+	return front[fIdx] != '#';
+}
+
+// In-memory FILE that collects warnings of one parse task
+class WarningBuffer
+{
+	public:
+		WarningBuffer() : file(nullptr), buf(nullptr), size(0)
+		{
+		}
+		~WarningBuffer()
+		{
+			close();
+			free(buf);
+		}
+		FILE *open()
+		{
+			file = open_memstream(&buf, &size);
+			return file;
+		}
+		void writeTo(FILE *fwarn)
+		{
+			close();
+			if (size) {
+				fwrite(buf, 1, size, fwarn);
+			}
+		}
+
+	private:
+		WarningBuffer(const WarningBuffer &) = delete;
+		WarningBuffer &operator=(const WarningBuffer &) = delete;
+		void close()
+		{
+			if (file) {
+				fclose(file);
+				file = nullptr;
+			}
+		}
+
+		FILE *file;
+		char *buf;
+		size_t size;
+};
+
+template<class T>
+std::string usCallsign(const T &record)
+{
+	return record.callsign;
+}
+
+template<class T>
+std::string caAuthorizationNumber(const T &record)
+{
+	return record.authorizationNumber;
+}
+
+// Groups records of one type by callsign in three steps: intern() assigns local ids to
+// callsigns of records, assignIds() maps local ids to global callsign ids, fill() builds groups
+// by global id. intern() and fill() of different record types may run concurrently
+class CallsignIndexerBase
+{
+	public:
+		virtual ~CallsignIndexerBase()
+		{
+		}
+		virtual void intern() = 0;
+		void assignIds(std::unordered_map<std::string, int> &callsignIds)
+		{
+			globalIds.clear();
+			for (const std::string &name : localNames) {
+				int id = callsignIds.size();
+				globalIds.push_back(callsignIds.emplace(name, id).first->second);
+			}
+		}
+		virtual void fill(int numCallsigns) = 0;
+
+	protected:
+		std::vector<int> recordIds; // Local callsign id of each record
+		std::vector<std::string> localNames; // Callsign of each local id
+		std::vector<int> globalIds; // Global callsign id of each local id
+};
+
+template<class T>
+class CallsignIndexer : public CallsignIndexerBase
+{
+	public:
+		CallsignIndexer(const QList<T> &recordsVal,
+				std::string (*keyVal)(const T &),
+				UlsCallsignGroups<T> &groupsVal) :
+			records(recordsVal), key(keyVal), groups(groupsVal)
+		{
+		}
+		void intern() override
+		{
+			std::unordered_map<std::string, int> localIds;
+			recordIds.clear();
+			recordIds.reserve(records.size());
+			localNames.clear();
+			for (const T &record : records) {
+				auto ins = localIds.emplace(key(record), (int)localNames.size());
+				if (ins.second) {
+					localNames.push_back(ins.first->first);
+				}
+				recordIds.push_back(ins.first->second);
+			}
+		}
+		void fill(int numCallsigns) override
+		{
+			for (int &id : recordIds) {
+				id = globalIds[id];
+			}
+			groups.build(records, recordIds, numCallsigns);
+		}
+
+	private:
+		const QList<T> &records;
+		std::string (*key)(const T &);
+		UlsCallsignGroups<T> &groups;
+};
+
+template<class T>
+std::unique_ptr<CallsignIndexerBase> makeIndexer(const QList<T> &records,
+						 std::string (*key)(const T &),
+						 UlsCallsignGroups<T> &groups)
+{
+	return std::unique_ptr<CallsignIndexerBase>(new CallsignIndexer<T>(records, key, groups));
+}
+
+template<class F>
+void runIndexers(std::vector<std::unique_ptr<CallsignIndexerBase>> &indexers,
+		 bool parallelFlag,
+		 F step)
+{
+	if (!parallelFlag) {
+		for (auto &indexer : indexers) {
+			step(indexer.get());
+		}
+		return;
+	}
+	std::vector<std::future<void>> futures;
+	for (auto &indexer : indexers) {
+		futures.push_back(std::async(std::launch::async, step, indexer.get()));
+	}
+	for (auto &future : futures) {
+		future.get();
+	}
+}
+
 // On AUG 18, 2022 the FCC modified the format of PA records increasing the number of columns from
 // 22 to 24.  The variable maxcol is set to 22, and this function ignores any additional columns
 // after maxcol. void SetToNextLine(FILE *fi, char c) {
@@ -43,7 +262,8 @@ double emptyAtof(const char *str)
 UlsFileReader::UlsFileReader(const char *fpath,
 			     FILE *fwarn,
 			     bool alignFederatedFlag,
-			     double alignFederatedScale)
+			     double alignFederatedScale,
+			     bool parallelFlag)
 {
 	FILE *fi = fopen(fpath, "r");
 	std::ostringstream errStr;
@@ -51,118 +271,46 @@ UlsFileReader::UlsFileReader(const char *fpath,
 
 	std::string front;
 
-	enum LineTypeEnum { labelLineType, dataLineType, ignoreLineType, unknownLineType };
-
-	LineTypeEnum lineType;
-
 	int linenum = 0;
-	QMap<QString, int> autoCellCounts;
+
+	// In parallel mode data lines are collected per record type and parsed afterwards
+	std::vector<std::vector<std::string>> typeLines(numRecordTypes);
 
 	while (fgetline(fi, line, false)) {
 		linenum++;
-		std::vector<std::string> fieldList = split(line, '|');
-
-		lineType = unknownLineType;
-		/**************************************************************************/
-		/**** Determine line type                                              ****/
-		/**************************************************************************/
-		if (fieldList.size() == 0) {
-			lineType = ignoreLineType;
-		} else {
-			int fIdx = fieldList[0].find_first_not_of(' ');
-			if (fIdx == (int)std::string::npos) {
-				if (fieldList.size() == 1) {
-					lineType = ignoreLineType;
-				}
-			} else {
-				if (fieldList[0].at(fIdx) == '#') {
-					lineType = ignoreLineType;
-				}
-			}
+
+		if (!getDataLineFront(line, front)) {
+			continue;
+		}
+		RecordTypeEnum recordType = getRecordType(front);
+		if (recordType == unknownRecordType) {
+			errStr << std::string("ERROR: Unable to process inputFile "
+					      "line ")
+			       << linenum << ", unrecognized: \"" << front << "\"" << std::endl;
+			throw std::runtime_error(errStr.str());
+		}
+		if (recordType == apCARecordType) {
+			continue;
 		}
 
-		if (lineType == unknownLineType) {
-			lineType = dataLineType;
+		if (parallelFlag) {
+			typeLines[getParseGroup(recordType)].push_back(std::move(line));
+		} else {
+			readRecord(split(line, '|'),
+				   fwarn,
+				   alignFederatedFlag,
+				   alignFederatedScale);
 		}
-		/**************************************************************************/
-
-		/**************************************************************************/
-		/**** Process Line                                                     ****/
-		/**************************************************************************/
-		switch (lineType) {
-			case labelLineType:
-				CORE_DUMP;
-				break;
-			case dataLineType:
-				front = fieldList[0];
-
-				/******************************************************************/
-				/* United States Data (US)                                        */
-				/******************************************************************/
-				if (front == "US:HD") {
-					readIndividualHeaderUS(fieldList);
-				} else if (front == "US:PA") {
-					readIndividualPathUS(fieldList);
-				} else if (front == "US:AN") {
-					readIndividualAntennaUS(fieldList, fwarn);
-				} else if (front == "US:FR") {
-					readIndividualFrequencyUS(fieldList, fwarn);
-				} else if (front == "US:LO") {
-					readIndividualLocationUS(fieldList,
-								 alignFederatedFlag,
-								 alignFederatedScale);
-				} else if (front == "US:EM") {
-					readIndividualEmissionUS(fieldList, fwarn);
-				} else if (front == "US:EN") {
-					readIndividualEntityUS(fieldList);
-				} else if (front == "US:MF") {
-					readIndividualMarketFrequencyUS(fieldList);
-				} else if (front == "US:CP") {
-					readIndividualControlPointUS(fieldList);
-				} else if (front == "US:SG") {
-					readIndividualSegmentUS(fieldList);
-				} else if (front == "US:RA") {
-					readIndividualRASUS(fieldList);
-					/******************************************************************/
-
-					/******************************************************************/
-					/* Canada Data (CA) */
-					/******************************************************************/
-				} else if (front == "CA:SD") {
-					readStationDataCA(fieldList,
-							  fwarn,
-							  alignFederatedFlag,
-							  alignFederatedScale);
-				} else if (front == "CA:PP") {
-					readBackToBackPassiveRepeaterCA(fieldList, fwarn);
-				} else if (front == "CA:PR") {
-					readReflectorPassiveRepeaterCA(fieldList, fwarn);
-				} else if (front == "CA:AP") {
-					// SetToNextLine(fi, fgetc(fi));
-				} else if (front == "CA:TA") {
-					readTransmitterCA(fieldList, fwarn);
-					/******************************************************************/
+	}
 
-				} else {
-					errStr << std::string("ERROR: Unable to process inputFile "
-							      "line ")
-					       << linenum << ", unrecognized: \"" << front << "\""
-					       << std::endl;
-					throw std::runtime_error(errStr.str());
-				}
+	fclose(fi);
 
-				break;
-			case ignoreLineType:
-			case unknownLineType:
-				// do nothing
-				break;
-			default:
-				CORE_DUMP;
-				break;
-		}
-		/**************************************************************************/
+	if (parallelFlag) {
+		readRecordsParallel(typeLines, fwarn, alignFederatedFlag, alignFederatedScale);
 	}
 
+	buildCallsignIndex(parallelFlag);
+
 	/**************************************************************************/
 	/* Create list of authorizationNumbers                                    */
 	/**************************************************************************/
@@ -174,8 +322,170 @@ UlsFileReader::UlsFileReader(const char *fpath,
 	std::cout << "CA: Total " << authorizationNumberList.size() << " authorization numbers"
 		  << std::endl;
 	/**************************************************************************/
+}
+/**************************************************************************/
 
-	fclose(fi);
+/**************************************************************************/
+/* UlsFileReader::readRecord()                                            */
+/**************************************************************************/
+void UlsFileReader::readRecord(const std::vector<std::string> &fieldList,
+			       FILE *fwarn,
+			       bool alignFederatedFlag,
+			       double alignFederatedScale)
+{
+	switch (getRecordType(fieldList[0])) {
+		/******************************************************************/
+		/* United States Data (US)                                        */
+		/******************************************************************/
+		case hdUSRecordType:
+			readIndividualHeaderUS(fieldList);
+			break;
+		case paUSRecordType:
+			readIndividualPathUS(fieldList);
+			break;
+		case anUSRecordType:
+			readIndividualAntennaUS(fieldList, fwarn);
+			break;
+		case frUSRecordType:
+			readIndividualFrequencyUS(fieldList, fwarn);
+			break;
+		case loUSRecordType:
+			readIndividualLocationUS(fieldList,
+						 alignFederatedFlag,
+						 alignFederatedScale);
+			break;
+		case emUSRecordType:
+			readIndividualEmissionUS(fieldList, fwarn);
+			break;
+		case enUSRecordType:
+			readIndividualEntityUS(fieldList);
+			break;
+		case mfUSRecordType:
+			readIndividualMarketFrequencyUS(fieldList);
+			break;
+		case cpUSRecordType:
+			readIndividualControlPointUS(fieldList);
+			break;
+		case sgUSRecordType:
+			readIndividualSegmentUS(fieldList);
+			break;
+		case raUSRecordType:
+			readIndividualRASUS(fieldList);
+			break;
+		/******************************************************************/
+
+		/******************************************************************/
+		/* Canada Data (CA)                                               */
+		/******************************************************************/
+		case sdCARecordType:
+			readStationDataCA(fieldList,
+					  fwarn,
+					  alignFederatedFlag,
+					  alignFederatedScale);
+			break;
+		case ppCARecordType:
+			readBackToBackPassiveRepeaterCA(fieldList, fwarn);
+			break;
+		case prCARecordType:
+			readReflectorPassiveRepeaterCA(fieldList, fwarn);
+			break;
+		case taCARecordType:
+			readTransmitterCA(fieldList, fwarn);
+			break;
+		/******************************************************************/
+
+		case apCARecordType:
+		case unknownRecordType:
+		case numRecordTypes:
+			break;
+	}
+}
+/**************************************************************************/
+
+/**************************************************************************/
+/* UlsFileReader::readRecordsParallel()                                   */
+/**************************************************************************/
+void UlsFileReader::readRecordsParallel(std::vector<std::vector<std::string>> &typeLines,
+					FILE *fwarn,
+					bool alignFederatedFlag,
+					double alignFederatedScale)
+{
+	// Each parse group fills only its own lists, so groups may run concurrently. Warnings
+	// are buffered per group and written in group order, so they do not interleave
+	std::vector<WarningBuffer> warningBuffers(typeLines.size());
+	std::vector<std::future<void>> futures;
+	for (int typeIdx = 0; typeIdx < (int)typeLines.size(); ++typeIdx) {
+		if (typeLines[typeIdx].empty()) {
+			continue;
+		}
+		FILE *typeWarn = fwarn ? warningBuffers[typeIdx].open() : nullptr;
+		std::vector<std::string> *lines = &(typeLines[typeIdx]);
+		futures.push_back(std::async(std::launch::async, [=]() {
+			for (const std::string &line : *lines) {
+				readRecord(split(line, '|'),
+					   typeWarn,
+					   alignFederatedFlag,
+					   alignFederatedScale);
+			}
+			std::vector<std::string>().swap(*lines);
+		}));
+	}
+	for (auto &future : futures) {
+		future.get();
+	}
+	if (fwarn) {
+		for (auto &warningBuffer : warningBuffers) {
+			warningBuffer.writeTo(fwarn);
+		}
+	}
+}
+/**************************************************************************/
+
+/**************************************************************************/
+/* UlsFileReader::buildCallsignIndex()                                    */
+/**************************************************************************/
+void UlsFileReader::buildCallsignIndex(bool parallelFlag)
+{
+	std::vector<std::unique_ptr<CallsignIndexerBase>> indexers;
+	indexers.emplace_back(makeIndexer(allHeaders, usCallsign<UlsHeader>, headerMap));
+	indexers.emplace_back(makeIndexer(allPaths, usCallsign<UlsPath>, pathMap));
+	indexers.emplace_back(makeIndexer(allAntennas, usCallsign<UlsAntenna>, antennaMap));
+	indexers.emplace_back(makeIndexer(allLocations, usCallsign<UlsLocation>, locationMap));
+	indexers.emplace_back(makeIndexer(allEmissions, usCallsign<UlsEmission>, emissionMap));
+	indexers.emplace_back(makeIndexer(allEntities, usCallsign<UlsEntity>, entityMap));
+	indexers.emplace_back(
+		makeIndexer(allControlPoints, usCallsign<UlsControlPoint>, controlPointMap));
+	indexers.emplace_back(makeIndexer(allSegments, usCallsign<UlsSegment>, segmentMap));
+	indexers.emplace_back(makeIndexer(allStations,
+					  caAuthorizationNumber<StationDataCAClass>,
+					  stationMap));
+	indexers.emplace_back(makeIndexer(allBackToBackPassiveRepeaters,
+					  caAuthorizationNumber<BackToBackPassiveRepeaterCAClass>,
+					  backToBackPassiveRepeaterMap));
+	indexers.emplace_back(makeIndexer(allReflectorPassiveRepeaters,
+					  caAuthorizationNumber<ReflectorPassiveRepeaterCAClass>,
+					  reflectorPassiveRepeaterMap));
+	indexers.emplace_back(makeIndexer(allTransmitters,
+					  caAuthorizationNumber<TransmitterCAClass>,
+					  transmitterMap));
+
+	// Record types are interned locally in parallel, so that the only sequential step -
+	// assignment of global ids - is done per distinct callsign, not per record
+	runIndexers(indexers, parallelFlag, [](CallsignIndexerBase *indexer) {
+		indexer->intern();
+	});
+
+	callsignIds.clear();
+	for (auto &indexer : indexers) {
+		indexer->assignIds(callsignIds);
+	}
+
+	int numCallsigns = callsignIds.size();
+	runIndexers(indexers, parallelFlag, [numCallsigns](CallsignIndexerBase *indexer) {
+		indexer->fill(numCallsigns);
+	});
+
+	passiveRepeaterMap.assign(numCallsigns, QList<PassiveRepeaterCAClass>());
 }
 /**************************************************************************/
 
@@ -277,7 +587,6 @@ void UlsFileReader::readIndividualPathUS(const std::vector<std::string> &fieldLi
 	}
 
 	allPaths << current;
-	pathMap[current.callsign] << current;
 	return;
 }
 /**************************************************************************/
@@ -347,7 +656,6 @@ void UlsFileReader::readIndividualEmissionUS(const std::vector<std::string> &fie
 	}
 
 	allEmissions << current;
-	emissionMap[current.callsign] << current;
 
 	return;
 }
@@ -421,7 +729,6 @@ void UlsFileReader::readIndividualEntityUS(const std::vector<std::string> &field
 	}
 
 	allEntities << current;
-	entityMap[current.callsign] << current;
 
 	return;
 }
@@ -566,7 +873,6 @@ void UlsFileReader::readIndividualLocationUS(const std::vector<std::string> &fie
 	}
 
 	allLocations << current;
-	locationMap[current.callsign] << current;
 
 	return;
 }
@@ -709,7 +1015,6 @@ void UlsFileReader::readIndividualAntennaUS(const std::vector<std::string> &fiel
 	}
 
 	allAntennas << current;
-	antennaMap[current.callsign] << current;
 
 	return;
 }
@@ -905,7 +1210,6 @@ void UlsFileReader::readIndividualHeaderUS(const std::vector<std::string> &field
 
 	//  allHeaders should now contain all the header records in the original DB.
 	allHeaders << current;
-	headerMap[current.callsign] << current;
 
 	return;
 }
@@ -959,7 +1263,6 @@ void UlsFileReader::readIndividualControlPointUS(const std::vector<std::string>
 	}
 
 	allControlPoints << current;
-	controlPointMap[current.callsign] << current;
 
 	return;
 }
@@ -1007,7 +1310,6 @@ void UlsFileReader::readIndividualSegmentUS(const std::vector<std::string> &fiel
 	}
 
 	allSegments << current;
-	segmentMap[current.callsign] << current;
 
 	return;
 }
@@ -1273,7 +1575,6 @@ void UlsFileReader::readStationDataCA(const std::vector<std::string> &fieldList,
 		RASList << ras;
 	} else {
 		allStations << current;
-		stationMap[current.authorizationNumber.c_str()] << current;
 	}
 
 	return;
@@ -1347,7 +1648,6 @@ void UlsFileReader::readBackToBackPassiveRepeaterCA(const std::vector<std::strin
 	}
 
 	allBackToBackPassiveRepeaters << current;
-	backToBackPassiveRepeaterMap[current.authorizationNumber.c_str()] << current;
 	return;
 }
 /**************************************************************************/
@@ -1400,7 +1700,6 @@ void UlsFileReader::readReflectorPassiveRepeaterCA(const std::vector<std::string
 	}
 
 	allReflectorPassiveRepeaters << current;
-	reflectorPassiveRepeaterMap[current.authorizationNumber.c_str()] << current;
 
 	return;
 }
@@ -1493,7 +1792,6 @@ void UlsFileReader::readTransmitterCA(const std::vector<std::string> &fieldList,
 	}
 
 	allTransmitters << current;
-	transmitterMap[current.authorizationNumber.c_str()] << current;
 	return;
 }
 /**************************************************************************/
@@ -1521,7 +1819,10 @@ int UlsFileReader::computeStatisticsUS(FreqAssignmentClass &freqAssignment,
 		UlsPath path;
 		bool pathFound = false;
 
-		foreach(const UlsPath &p, pathsMap(freq.callsign))
+		// Path has the same callsign as frequency
+		int freqCallsignId = callsignId(freq.callsign);
+
+		foreach(const UlsPath &p, pathsMap(freqCallsignId))
 		{
 			if (strcmp(p.callsign, freq.callsign) == 0) {
 				if (freq.locationNumber == p.txLocationNumber &&
@@ -1540,7 +1841,7 @@ int UlsFileReader::computeStatisticsUS(FreqAssignmentClass &freqAssignment,
 		/// Find the emissions information.
 		bool txEmFound = false;
 		QList<UlsEmission> allTxEm;
-		foreach(const UlsEmission &e, emissionsMap(freq.callsign))
+		foreach(const UlsEmission &e, emissionsMap(freqCallsignId))
 		{
 			if (strcmp(e.callsign, freq.callsign) == 0 &&
 			    e.locationId == freq.locationNumber &&
@@ -1558,7 +1859,7 @@ int UlsFileReader::computeStatisticsUS(FreqAssignmentClass &freqAssignment,
 		/// Find the header.
 		UlsHeader txHeader;
 		bool txHeaderFound = false;
-		foreach(const UlsHeader &h, headersMap(path.callsign))
+		foreach(const UlsHeader &h, headersMap(freqCallsignId))
 		{
 			if (strcmp(h.callsign, path.callsign) == 0) {
 				txHeader = h;
@@ -1673,7 +1974,7 @@ int UlsFileReader::computeStatisticsUS(FreqAssignmentClass &freqAssignment,
 				}
 			}
 			if (!invalidFlag) {
-				foreach(const UlsSegment &segment, segmentsMap(freq.callsign))
+				foreach(const UlsSegment &segment, segmentsMap(freqCallsignId))
 				{
 					int segmentNumber = segment.segmentNumber;
 					if ((n == 0) || (segmentNumber > maxNumSegment)) {
@@ -1728,8 +2029,10 @@ int UlsFileReader::computeStatisticsCA(FILE *fwarn)
 	/* If entries don't match, there is an error in the database, report in warning file. */
 	/**************************************************************************************/
 	for (std::string authorizationNumber : authorizationNumberList) {
-		const QList<BackToBackPassiveRepeaterCAClass> &bbList =
-			backToBackPassiveRepeatersMap(authorizationNumber.c_str());
+		int authorizationId = callsignId(authorizationNumber);
+		QList<PassiveRepeaterCAClass> &prList = passiveRepeaterMap[authorizationId];
+		UlsRecordRange<BackToBackPassiveRepeaterCAClass> bbList =
+			backToBackPassiveRepeatersMap(authorizationId);
 		std::vector<int> idxList;
 		idxList.clear();
 		for (i = 0; i < bbList.size(); ++i) {
@@ -1784,7 +2087,7 @@ int UlsFileReader::computeStatisticsCA(FILE *fwarn)
 				pr.reflectorHeight = std::numeric_limits<double>::quiet_NaN();
 				pr.reflectorWidth = std::numeric_limits<double>::quiet_NaN();
 
-				passiveRepeaterMap[authorizationNumber.c_str()] << pr;
+				prList << pr;
 				if (iiMatch < iiA - 1) {
 					idxList[iiMatch] = idxList[iiA - 1];
 				}
@@ -1803,7 +2106,7 @@ int UlsFileReader::computeStatisticsCA(FILE *fwarn)
 		}
 
 		foreach(const ReflectorPassiveRepeaterCAClass &br,
-			reflectorPassiveRepeatersMap(authorizationNumber.c_str()))
+			reflectorPassiveRepeatersMap(authorizationId))
 		{
 			PassiveRepeaterCAClass pr;
 			pr.type = PassiveRepeaterCAClass::billboardReflectorPRType;
@@ -1831,10 +2134,10 @@ int UlsFileReader::computeStatisticsCA(FILE *fwarn)
 				pr.longitudeDeg,
 				(pr.groundElevation + pr.heightAGLA) / 1000.0);
 
-			passiveRepeaterMap[authorizationNumber.c_str()] << pr;
+			prList << pr;
 		}
 
-		int numPR = passiveRepeaterMap[authorizationNumber.c_str()].size();
+		int numPR = prList.size();
 
 		if (numPR > maxNumPassiveRepeater) {
 			maxNumPassiveRepeater = numPR;
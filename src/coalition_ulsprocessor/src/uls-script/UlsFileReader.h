@@ -2,8 +2,11 @@
 #define ULS_FILE_READER_H
 
 #include <stdio.h>
+#include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <string>
+#include <vector>
 
 #include "FreqAssignment.h"
 
@@ -26,6 +29,8 @@
 
 #include "RAS.h"
 
+#include "UlsCallsignGroups.h"
+
 #include <QList>
 #include <QHash>
 #include <QString>
@@ -33,10 +38,13 @@
 class UlsFileReader
 {
 	public:
+		/* If parallelFlag is set, records of different types are parsed
+		 * concurrently and per-callsign maps are built concurrently */
 		UlsFileReader(const char *filePath,
 			      FILE *fwarn,
 			      bool alignFederatedFlag,
-			      double alignFederatedScale);
+			      double alignFederatedScale,
+			      bool parallelFlag = false);
 
 		const QList<UlsPath> &paths()
 		{
@@ -96,71 +104,80 @@ class UlsFileReader
 			return allTransmitters;
 		}
 
-		const QList<UlsAntenna> antennasMap(const QString &s) const
+		/* Interned id of callsign (authorization number for CA), -1 if unknown. Records of
+		 * a callsign are retrieved by id with *Map() accessors */
+		int callsignId(const std::string &callsign) const
 		{
-			return antennaMap[s];
+			auto it = callsignIds.find(callsign);
+			return (it == callsignIds.end()) ? -1 : it->second;
 		}
 
-		const QList<UlsSegment> segmentsMap(const QString &s) const
+		UlsRecordRange<UlsAntenna> antennasMap(int id) const
 		{
-			return segmentMap[s];
+			return antennaMap.group(id);
 		}
 
-		const QList<UlsLocation> locationsMap(const QString &s) const
+		UlsRecordRange<UlsSegment> segmentsMap(int id) const
 		{
-			return locationMap[s];
+			return segmentMap.group(id);
 		}
 
-		const QList<UlsEmission> emissionsMap(const QString &s) const
+		UlsRecordRange<UlsLocation> locationsMap(int id) const
 		{
-			return emissionMap[s];
+			return locationMap.group(id);
 		}
 
-		const QList<UlsPath> pathsMap(const QString &s) const
+		UlsRecordRange<UlsEmission> emissionsMap(int id) const
 		{
-			return pathMap[s];
+			return emissionMap.group(id);
 		}
 
-		const QList<UlsEntity> entitiesMap(const QString &s) const
+		UlsRecordRange<UlsPath> pathsMap(int id) const
 		{
-			return entityMap[s];
+			return pathMap.group(id);
 		}
 
-		const QList<UlsHeader> headersMap(const QString &s) const
+		UlsRecordRange<UlsEntity> entitiesMap(int id) const
 		{
-			return headerMap[s];
+			return entityMap.group(id);
 		}
 
-		const QList<UlsControlPoint> controlPointsMap(const QString &s) const
+		UlsRecordRange<UlsHeader> headersMap(int id) const
 		{
-			return controlPointMap[s];
+			return headerMap.group(id);
 		}
 
-		const QList<StationDataCAClass> stationsMap(const QString &s) const
+		UlsRecordRange<UlsControlPoint> controlPointsMap(int id) const
 		{
-			return stationMap[s];
+			return controlPointMap.group(id);
 		}
 
-		const QList<BackToBackPassiveRepeaterCAClass> backToBackPassiveRepeatersMap(
-			const QString &s) const
+		UlsRecordRange<StationDataCAClass> stationsMap(int id) const
 		{
-			return backToBackPassiveRepeaterMap[s];
+			return stationMap.group(id);
 		}
 
-		const QList<ReflectorPassiveRepeaterCAClass> reflectorPassiveRepeatersMap(
-			const QString &s) const
+		UlsRecordRange<BackToBackPassiveRepeaterCAClass> backToBackPassiveRepeatersMap(
+			int id) const
 		{
-			return reflectorPassiveRepeaterMap[s];
+			return backToBackPassiveRepeaterMap.group(id);
 		}
 
-		const QList<PassiveRepeaterCAClass> passiveRepeatersMap(const QString &s) const
+		UlsRecordRange<ReflectorPassiveRepeaterCAClass> reflectorPassiveRepeatersMap(
+			int id) const
 		{
-			return passiveRepeaterMap[s];
+			return reflectorPassiveRepeaterMap.group(id);
 		}
 
-		const QList<TransmitterCAClass> transmittersMap(const QString &s) const
+		const QList<PassiveRepeaterCAClass> &passiveRepeatersMap(int id) const
 		{
-			return transmitterMap[s];
+			static const QList<PassiveRepeaterCAClass> empty;
+			return (id == -1) ? empty : passiveRepeaterMap[id];
+		}
+
+		UlsRecordRange<TransmitterCAClass> transmittersMap(int id) const
+		{
+			return transmitterMap.group(id);
 		}
 
 		std::unordered_set<std::string> authorizationNumberList;
@@ -175,6 +192,16 @@ class UlsFileReader
 		QList<RASClass> RASList;
 
 	private:
+		void readRecord(const std::vector<std::string> &fieldList,
+				FILE *fwarn,
+				bool alignFederatedFlag,
+				double alignFederatedScale);
+		void readRecordsParallel(std::vector<std::vector<std::string>> &typeLines,
+					 FILE *fwarn,
+					 bool alignFederatedFlag,
+					 double alignFederatedScale);
+		void buildCallsignIndex(bool parallelFlag);
+
 		void readIndividualHeaderUS(const std::vector<std::string> &fieldList);
 		void readIndividualPathUS(const std::vector<std::string> &fieldList);
 		void readIndividualAntennaUS(const std::vector<std::string> &fieldList,
@@ -218,21 +245,26 @@ class UlsFileReader
 		QList<ReflectorPassiveRepeaterCAClass> allReflectorPassiveRepeaters;
 		QList<TransmitterCAClass> allTransmitters;
 
-		QHash<QString, QList<UlsEmission>> emissionMap;
-		QHash<QString, QList<UlsAntenna>> antennaMap;
-		QHash<QString, QList<UlsSegment>> segmentMap;
-		QHash<QString, QList<UlsLocation>> locationMap;
-		QHash<QString, QList<UlsPath>> pathMap;
-		QHash<QString, QList<UlsEntity>> entityMap;
-		QHash<QString, QList<UlsControlPoint>> controlPointMap;
-		QHash<QString, QList<UlsHeader>> headerMap;
-
-		QHash<QString, QList<StationDataCAClass>> stationMap;
-		QHash<QString, QList<BackToBackPassiveRepeaterCAClass>>
-			backToBackPassiveRepeaterMap;
-		QHash<QString, QList<ReflectorPassiveRepeaterCAClass>> reflectorPassiveRepeaterMap;
-		QHash<QString, QList<PassiveRepeaterCAClass>> passiveRepeaterMap;
-		QHash<QString, QList<TransmitterCAClass>> transmitterMap;
+		/* Callsigns (US) and authorization numbers (CA), interned to ids */
+		std::unordered_map<std::string, int> callsignIds;
+
+		/* Records grouped by callsign id */
+		UlsCallsignGroups<UlsEmission> emissionMap;
+		UlsCallsignGroups<UlsAntenna> antennaMap;
+		UlsCallsignGroups<UlsSegment> segmentMap;
+		UlsCallsignGroups<UlsLocation> locationMap;
+		UlsCallsignGroups<UlsPath> pathMap;
+		UlsCallsignGroups<UlsEntity> entityMap;
+		UlsCallsignGroups<UlsControlPoint> controlPointMap;
+		UlsCallsignGroups<UlsHeader> headerMap;
+
+		UlsCallsignGroups<StationDataCAClass> stationMap;
+		UlsCallsignGroups<BackToBackPassiveRepeaterCAClass> backToBackPassiveRepeaterMap;
+		UlsCallsignGroups<ReflectorPassiveRepeaterCAClass> reflectorPassiveRepeaterMap;
+		UlsCallsignGroups<TransmitterCAClass> transmitterMap;
+
+		/* Indexed by callsign id, filled by computeStatisticsCA() */
+		std::vector<QList<PassiveRepeaterCAClass>> passiveRepeaterMap;
 };
 
 #endif
@@ -20,6 +20,7 @@ bool includeUnii7US = false;
 bool includeUnii8US = false;
 bool debugFlag = false;
 bool combineAntennaRegionFlag = false;
+bool parallelFlag = false;
 
 void testAntennaModelMap(AntennaModelMapClass &antennaModelMap,
 			 std::string inputFile,
@@ -117,6 +118,7 @@ int main(int argc, char **argv)
 	std::string procPfx = "proc_uls";
 	std::string debugStr = "_debug";
 	std::string caStr = "_ca";
+	std::string parStr = "_par";
 	if (mode == "test_antenna_model_map") {
 		testAntennaModelMap(antennaModelMap, inputFile, outputFSFile);
 		return 0;
@@ -135,6 +137,10 @@ int main(int argc, char **argv)
 				combineAntennaRegionFlag = true;
 				modeStr = modeStr.substr(caStr.size());
 			}
+			if (modeStr.compare(0, parStr.size(), parStr) == 0) {
+				parallelFlag = true;
+				modeStr = modeStr.substr(parStr.size());
+			}
 			int n2 = modeStr.size();
 			if (n1 == n2) {
 				fprintf(stderr, "ERROR: Invalid mode: %s\n", mode.c_str());
@@ -172,7 +178,11 @@ int main(int argc, char **argv)
 		return -1;
 	}
 
-	UlsFileReader r(inputFile.c_str(), fwarn, alignFederatedFlag, alignFederatedScale);
+	UlsFileReader r(inputFile.c_str(),
+			fwarn,
+			alignFederatedFlag,
+			alignFederatedScale,
+			parallelFlag);
 
 	int maxNumPRUS = r.computeStatisticsUS(fccFreqAssignment,
 					       includeUnii5US,
@@ -344,7 +354,11 @@ void processUS(UlsFileReader &r,
 
 		QList<UlsPath> pathList;
 
-		foreach(const UlsPath &p, r.pathsMap(freq.callsign))
+		// Records of paths are looked up with the frequency callsign id, as paths
+		// have the same callsign
+		int callsignId = r.callsignId(freq.callsign);
+
+		foreach(const UlsPath &p, r.pathsMap(callsignId))
 		{
 			if (strcmp(p.callsign, freq.callsign) == 0) {
 				if ((freq.locationNumber == p.txLocationNumber) &&
@@ -370,7 +384,7 @@ void processUS(UlsFileReader &r,
 			/// Find the associated transmit location.
 			UlsLocation txLoc;
 			bool locFound = false;
-			foreach(const UlsLocation &loc, r.locationsMap(path.callsign))
+			foreach(const UlsLocation &loc, r.locationsMap(callsignId))
 			{
 				if (strcmp(loc.callsign, path.callsign) == 0) {
 					if (path.txLocationNumber == loc.locationNumber) {
@@ -395,7 +409,7 @@ void processUS(UlsFileReader &r,
 			/// Find the associated transmit antenna.
 			UlsAntenna txAnt;
 			bool txAntFound = false;
-			foreach(const UlsAntenna &ant, r.antennasMap(path.callsign))
+			foreach(const UlsAntenna &ant, r.antennasMap(callsignId))
 			{
 				if (strcmp(ant.callsign, path.callsign) == 0) {
 					// Implicitly matches with an Antenna record with
@@ -430,7 +444,7 @@ void processUS(UlsFileReader &r,
 			/// Find the RX location.
 			UlsLocation rxLoc;
 			bool rxLocFound = false;
-			foreach(const UlsLocation &loc, r.locationsMap(path.callsign))
+			foreach(const UlsLocation &loc, r.locationsMap(callsignId))
 			{
 				if (strcmp(loc.callsign, path.callsign) == 0) {
 					if (loc.locationNumber == path.rxLocationNumber) {
@@ -455,7 +469,7 @@ void processUS(UlsFileReader &r,
 			/// Find the RX antenna.
 			UlsAntenna rxAnt;
 			bool rxAntFound = false;
-			foreach(const UlsAntenna &ant, r.antennasMap(path.callsign))
+			foreach(const UlsAntenna &ant, r.antennasMap(callsignId))
 			{
 				if (strcmp(ant.callsign, path.callsign) == 0) {
 					// Implicitly matches with an Antenna record with
@@ -489,7 +503,7 @@ void processUS(UlsFileReader &r,
 
 			/// Create list of segments in link.
 			QList<UlsSegment> segList;
-			foreach(const UlsSegment &s, r.segmentsMap(path.callsign))
+			foreach(const UlsSegment &s, r.segmentsMap(callsignId))
 			{
 				if (s.pathNumber == path.pathNumber) {
 					segList << s;
@@ -536,7 +550,7 @@ void processUS(UlsFileReader &r,
 					bool found;
 					found = false;
 					foreach(const UlsLocation &loc,
-						r.locationsMap(path.callsign))
+						r.locationsMap(callsignId))
 					{
 						if (loc.locationNumber == s.txLocationId) {
 							prLocList << loc;
@@ -553,7 +567,7 @@ void processUS(UlsFileReader &r,
 						break;
 					}
 					found = false;
-					foreach(const UlsAntenna &ant, r.antennasMap(path.callsign))
+					foreach(const UlsAntenna &ant, r.antennasMap(callsignId))
 					{
 						if ((ant.antennaType == 'P') &&
 						    (ant.locationNumber ==
@@ -578,7 +592,7 @@ void processUS(UlsFileReader &r,
 
 			UlsSegment txSeg;
 			bool txSegFound = false;
-			foreach(const UlsSegment &s, r.segmentsMap(path.callsign))
+			foreach(const UlsSegment &s, r.segmentsMap(callsignId))
 			{
 				if (strcmp(s.callsign, path.callsign) == 0) {
 					if (s.pathNumber == path.pathNumber) {
@@ -594,7 +608,7 @@ void processUS(UlsFileReader &r,
 			/// Find the emissions information.
 			bool txEmFound = false;
 			QList<UlsEmission> allTxEm;
-			foreach(const UlsEmission &e, r.emissionsMap(path.callsign))
+			foreach(const UlsEmission &e, r.emissionsMap(callsignId))
 			{
 				if (strcmp(e.callsign, path.callsign) == 0) {
 					if (e.locationId == txLoc.locationNumber &&
@@ -613,7 +627,7 @@ void processUS(UlsFileReader &r,
 			/// Find the header.
 			UlsHeader txHeader;
 			bool txHeaderFound = false;
-			foreach(const UlsHeader &h, r.headersMap(path.callsign))
+			foreach(const UlsHeader &h, r.headersMap(callsignId))
 			{
 				if (strcmp(h.callsign, path.callsign) == 0) {
 					txHeader = h;
@@ -636,7 +650,7 @@ void processUS(UlsFileReader &r,
 			/// Find the entity
 			UlsEntity txEntity;
 			bool txEntityFound = false;
-			foreach(const UlsEntity &e, r.entitiesMap(path.callsign))
+			foreach(const UlsEntity &e, r.entitiesMap(callsignId))
 			{
 				if (strcmp(e.callsign, path.callsign) == 0) {
 					txEntity = e;
@@ -655,7 +669,7 @@ void processUS(UlsFileReader &r,
 			/// Find the control point.
 			UlsControlPoint txControlPoint;
 			bool txControlPointFound = false;
-			foreach(const UlsControlPoint &ucp, r.controlPointsMap(path.callsign))
+			foreach(const UlsControlPoint &ucp, r.controlPointsMap(callsignId))
 			{
 				if (strcmp(ucp.callsign, path.callsign) == 0) {
 					txControlPoint = ucp;
@@ -1328,14 +1342,15 @@ void processCA(UlsFileReader &r,
 	int numAntUnmatch = 0;
 
 	for (std::string authorizationNumber : r.authorizationNumberList) {
+		int authorizationId = r.callsignId(authorizationNumber);
 		const QList<PassiveRepeaterCAClass> &prList = r.passiveRepeatersMap(
-			authorizationNumber.c_str());
+			authorizationId);
 
 		int numPR = prList.size();
 		std::vector<int> idxList(numPR);
 
 		foreach(const StationDataCAClass &station,
-			r.stationsMap(authorizationNumber.c_str()))
+			r.stationsMap(authorizationId))
 		{
 			QString anomalousReason = "";
 			QString fixedReason = "";
@@ -868,7 +868,7 @@ def daily_uls_parse(state_root, interactive):
     # If runULSProcessorFlag set, run ULS processor                           #
     ###########################################################################
     if runULSProcessorFlag:
-        mode = "proc_uls"
+        mode = "proc_uls_par"
         if combineAntennaRegionFlag:
             mode += "_ca"
 
@@ -37,7 +37,7 @@ from appcfg import RatafcMsghndCfgIface, AFC_RATAPI_LOG_LEVEL
 from hchecks import RmqHealthcheck
 from defs import RNTM_OPT_NODBG_NOGUI, RNTM_OPT_DBG, RNTM_OPT_GUI, \
     RNTM_OPT_AFCENGINE_HTTP_IO, RNTM_OPT_NOCACHE, RNTM_OPT_SLOW_DBG, \
-    RNTM_OPT_CERT_ID
+    RNTM_OPT_CERT_ID, RNTM_OPT_TERRAIN_PROFILE
 from afc_worker import run
 from ..util import AFCEngineException, require_default_uls, getQueueDirectory
 from afcmodels.aaa import User, AFCConfig, CertId, Ruleset, \
@@ -771,6 +771,10 @@ class RatAfc(MethodView):
                     edebug_opt = flask.request.args.get('edebug')
                     if edebug_opt == 'True':
                         runtime_opts |= RNTM_OPT_SLOW_DBG
+                    # Terrain profile is a debug file (stored in history)
+                    tprofile_opt = flask.request.args.get('tprofile')
+                    if tprofile_opt == 'True':
+                        runtime_opts |= RNTM_OPT_DBG | RNTM_OPT_TERRAIN_PROFILE
                     if is_gui:
                         runtime_opts |= RNTM_OPT_GUI
                     opt = flask.request.args.get('nocache')
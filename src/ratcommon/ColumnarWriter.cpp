@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+
+#include "ColumnarWriter.h"
+#include <afclogging/Logging.h>
+#include <errno.h>
+#include <sstream>
+#include <stdexcept>
+#include <string.h>
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+	#error Columnar file format assumes little-endian platform
+#endif
+
+namespace
+{
+// Logger for all instances of class
+LOGGER_DEFINE_GLOBAL(logger, "ColumnarWriter")
+
+/** File signature */
+const char MAGIC[8] = {'A', 'F', 'C', 'C', 'O', 'L', '1', '\0'};
+
+} // end namespace
+
+ColumnarWriter::ColumnarWriter(const std::string &filename, int groupRows) :
+	_filename(filename), _groupRows(groupRows)
+{
+	LOGGER_INFO(logger) << "Opening '" << filename << "'";
+	_fp = fopen(filename.c_str(), "wb");
+	if (!_fp) {
+		std::ostringstream errStr;
+		errStr << "ERROR: ColumnarWriter::ColumnarWriter(): Unable to open '" << filename
+		       << "' for writing: " << strerror(errno);
+		throw std::runtime_error(errStr.str());
+	}
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+	if (!_fp) {
+		return;
+	}
+	try {
+		finish();
+	} catch (const std::exception &ex) {
+		LOGGER_ERROR(logger) << ex.what();
+	}
+}
+
+int ColumnarWriter::addColumn(const std::string &name,
+			      ColType type,
+			      const std::string &format,
+			      const std::map<int, std::string> &labels)
+{
+	if (_headerWritten) {
+		throw std::logic_error("ERROR: ColumnarWriter::addColumn(): Column '" + name +
+				       "' added after first row");
+	}
+	_columns.push_back(Column());
+	Column &column = _columns.back();
+	column.name = name;
+	column.type = type;
+	column.format = format;
+	column.labels = labels;
+	return (int)_columns.size() - 1;
+}
+
+size_t ColumnarWriter::valueWidth(ColType type)
+{
+	switch (type) {
+		case Float64:
+			return sizeof(double);
+		case Bool:
+			return sizeof(uint8_t);
+		default:
+			return sizeof(int32_t);
+	}
+}
+
+template<class T>
+void ColumnarWriter::setValue(int col, T value)
+{
+	if (!_headerWritten) {
+		writeHeader();
+	}
+	Column &column = _columns[col];
+	memcpy(column.values.data() + (size_t)_numRows * sizeof(T), &value, sizeof(T));
+	column.valid[_numRows / 8] |= (unsigned char)(1 << (_numRows % 8));
+}
+
+void ColumnarWriter::setInt(int col, int value)
+{
+	if (_columns[col].type == Bool) {
+		setValue<uint8_t>(col, value ? 1 : 0);
+	} else {
+		setValue<int32_t>(col, value);
+	}
+}
+
+void ColumnarWriter::setDouble(int col, double value)
+{
+	setValue<double>(col, value);
+}
+
+void ColumnarWriter::setString(int col, const std::string &value)
+{
+	if (!_headerWritten) {
+		writeHeader();
+	}
+	Column &column = _columns[col];
+	auto inserted = column.dict.emplace(value, (uint32_t)column.dict.size());
+	if (inserted.second) {
+		column.newDictEntries.push_back(&inserted.first->first);
+	}
+	setValue<uint32_t>(col, inserted.first->second);
+}
+
+void ColumnarWriter::endRow()
+{
+	if (!_headerWritten) {
+		writeHeader();
+	}
+	if (++_numRows == _groupRows) {
+		writeGroup();
+	}
+}
+
+void ColumnarWriter::finish()
+{
+	if (!_fp) {
+		return;
+	}
+	if (!_headerWritten) {
+		writeHeader();
+	}
+	if (_numRows) {
+		writeGroup();
+	}
+	writeValue<uint32_t>(0);
+	bool ok = (fclose(_fp) == 0) && !_writeError;
+	_fp = nullptr;
+	if (!ok) {
+		std::ostringstream errStr;
+		errStr << "ERROR: ColumnarWriter::finish(): Error writing '" << _filename << "'";
+		throw std::runtime_error(errStr.str());
+	}
+}
+
+void ColumnarWriter::resetGroup()
+{
+	for (auto &column : _columns) {
+		column.values.assign((size_t)_groupRows * valueWidth(column.type), 0);
+		column.valid.assign((_groupRows + 7) / 8, 0);
+		column.newDictEntries.clear();
+	}
+	_numRows = 0;
+}
+
+void ColumnarWriter::writeHeader()
+{
+	_headerWritten = true;
+	writeBytes(MAGIC, sizeof(MAGIC));
+	writeValue<uint32_t>((uint32_t)_columns.size());
+	for (auto &column : _columns) {
+		writeValue<uint8_t>(column.type);
+		writeString(column.name);
+		writeString(column.format);
+		writeValue<uint32_t>((uint32_t)column.labels.size());
+		for (auto &label : column.labels) {
+			writeValue<int32_t>(label.first);
+			writeString(label.second);
+		}
+	}
+	resetGroup();
+}
+
+void ColumnarWriter::writeGroup()
+{
+	writeValue<uint32_t>((uint32_t)_numRows);
+	for (auto &column : _columns) {
+		writeBytes(column.valid.data(), (_numRows + 7) / 8);
+		if (column.type == String) {
+			writeValue<uint32_t>((uint32_t)column.newDictEntries.size());
+			for (auto entry : column.newDictEntries) {
+				writeString(*entry);
+			}
+		}
+		writeBytes(column.values.data(), (size_t)_numRows * valueWidth(column.type));
+	}
+	resetGroup();
+}
+
+void ColumnarWriter::writeBytes(const void *data, size_t len)
+{
+	if (len && (fwrite(data, 1, len, _fp) != len)) {
+		_writeError = true;
+	}
+}
+
+void ColumnarWriter::writeString(const std::string &s)
+{
+	writeValue<uint32_t>((uint32_t)s.size());
+	writeBytes(s.data(), s.size());
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+
+/** @file
+ * Writer of binary columnar table files - compact and fast alternative to
+ * GZIPped CSV for large diagnostic tables.
+ *
+ * File layout (all numbers are little-endian, strings are uint32 length
+ * followed by UTF-8 bytes):
+ *	- Signature "AFCCOL1\0"
+ *	- uint32 number of columns
+ *	- For each column: uint8 type (ColType), name, format (printf format of
+ *	  double column or name for unknown item of enum column, otherwise
+ *	  empty), uint32 number of labels, labels (int32 value, label string) -
+ *	  enum item names or bool true(1)/false(0) names
+ *	- Row groups, each: uint32 number of rows N (0 terminates file), then
+ *	  for each column: validity bitmap of (N + 7) / 8 bytes (bit i of byte
+ *	  i / 8 set if value in row i is present), then values:
+ *		- Int32, Enum: N int32
+ *		- Float64: N float64
+ *		- Bool: N uint8
+ *		- String: uint32 number of dictionary entries, added in this
+ *		  group, these entries, then N uint32 dictionary indices.
+ *		  Dictionary is shared by all groups of the column
+ *	  Values of absent items are zero.
+ *
+ * Fixed-width value arrays may be loaded directly into numpy/pandas arrays.
+ * tools/columnar/afccol_to_csv.py converts files to CSV, identical to one
+ * GzipCsv would write.
+ */
+
+#ifndef COLUMNAR_WRITER_H
+#define COLUMNAR_WRITER_H
+
+#include <boost/core/noncopyable.hpp>
+#include <cstdint>
+#include <map>
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** Binary columnar table file writer */
+class ColumnarWriter : private boost::noncopyable
+{
+	public:
+		/** Column types */
+		enum ColType : uint8_t {
+			Int32 = 1, /*!< 32-bit integer */
+			Float64 = 2, /*!< Double */
+			String = 3, /*!< Dictionary-encoded string */
+			Bool = 4, /*!< Boolean */
+			Enum = 5 /*!< 32-bit integer with names of known values */
+		};
+
+		/** Default number of rows in row group */
+		static const int DEFAULT_GROUP_ROWS = 65536;
+
+		/** Constructor. Opens file. Throws std::runtime_error on failure
+		 * @param filename Name of file to write
+		 * @param groupRows Number of rows in row group
+		 */
+		ColumnarWriter(const std::string &filename, int groupRows = DEFAULT_GROUP_ROWS);
+
+		/** Destructor. Completes file if finish() was not called */
+		~ColumnarWriter();
+
+		/** Adds column. Columns may only be added before first row
+		 * @param name Column name
+		 * @param type Column type
+		 * @param format Printf format for double column, name for unknown
+		 *	items for enum column
+		 * @param labels Names of enum items, bool true (1) and false (0) names
+		 * @return Column index
+		 */
+		int addColumn(const std::string &name,
+			      ColType type,
+			      const std::string &format = "",
+			      const std::map<int, std::string> &labels = {});
+
+		/** Number of columns */
+		int numColumns() const
+		{
+			return (int)_columns.size();
+		}
+
+		/** Sets value of Int32, Enum or Bool column in current row */
+		void setInt(int col, int value);
+
+		/** Sets value of Float64 column in current row */
+		void setDouble(int col, double value);
+
+		/** Sets value of String column in current row */
+		void setString(int col, const std::string &value);
+
+		/** Completes current row. Values not set in this row are absent */
+		void endRow();
+
+		/** Writes remaining rows and closes file. Throws
+		 * std::runtime_error on failure
+		 */
+		void finish();
+
+	private:
+		/** Column data */
+		struct Column {
+				/** Column name */
+				std::string name;
+
+				/** Column type */
+				ColType type;
+
+				/** Double format or unknown enum item name */
+				std::string format;
+
+				/** Enum item names or bool value names */
+				std::map<int, std::string> labels;
+
+				/** Validity bitmap of current group */
+				std::vector<unsigned char> valid;
+
+				/** Values of current group */
+				std::vector<char> values;
+
+				/** String dictionary */
+				std::unordered_map<std::string, uint32_t> dict;
+
+				/** Dictionary entries added in current group */
+				std::vector<const std::string *> newDictEntries;
+		};
+
+		/** Stores fixed-width value of current row to column */
+		template<class T>
+		void setValue(int col, T value);
+
+		/** Value width of column of given type in bytes */
+		static size_t valueWidth(ColType type);
+
+		/** Clears values and validity bitmaps of all columns */
+		void resetGroup();
+
+		/** Writes header if not yet written */
+		void writeHeader();
+
+		/** Writes current row group */
+		void writeGroup();
+
+		/** Writes bytes to file */
+		void writeBytes(const void *data, size_t len);
+
+		/** Writes trivially copyable value to file */
+		template<class T>
+		void writeValue(T value)
+		{
+			writeBytes(&value, sizeof(value));
+		}
+
+		/** Writes string to file */
+		void writeString(const std::string &s);
+
+		// INSTANCE DATA
+
+		/** Name of file being written */
+		std::string _filename;
+
+		/** File being written. Null after finish() */
+		FILE *_fp;
+
+		/** Number of rows in row group */
+		int _groupRows;
+
+		/** Number of complete rows in current group */
+		int _numRows = 0;
+
+		/** True if header was written */
+		bool _headerWritten = false;
+
+		/** True if write error occurred */
+		bool _writeError = false;
+
+		/** Columns */
+		std::vector<Column> _columns;
+};
+#endif /* COLUMNAR_WRITER_H */
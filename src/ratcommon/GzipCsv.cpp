@@ -8,37 +8,351 @@
 
 #include <assert.h>
 #include "GzipCsv.h"
-#include "FileHelpers.h"
-#include <boost/lexical_cast.hpp>
 #include <afclogging/Logging.h>
+#include <condition_variable>
+#include <errno.h>
+#include <mutex>
+#include <sstream>
 #include <stdexcept>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include <zlib.h>
 
 namespace
 {
 // Logger for all instances of class
 LOGGER_DEFINE_GLOBAL(logger, "GzipCsv")
 
+/** Size of row buffer, handed to compressor when filled */
+const size_t BUFFER_SIZE = 256 * 1024;
+
+/** Size of compressed data buffer */
+const size_t OUT_BUFFER_SIZE = 64 * 1024;
+
+/** Row end (as in CsvWriter) */
+const char EOL[] = "\r\n";
+
+/** True if field has to be quoted (contains separator, quote or EOL
+ * characters - same rule as in CsvWriter)
+ */
+bool needsQuoting(const char *s, size_t len)
+{
+	for (size_t i = 0; i < len; ++i) {
+		switch (s[i]) {
+			case ',':
+			case '"':
+			case '\r':
+			case '\n':
+				return true;
+			default:
+				break;
+		}
+	}
+	return false;
+}
+
+/** Appends quoted string to buffer (without closing quote), doubling quote
+ * characters
+ */
+void appendQuotedBody(std::string &buf, const char *s, size_t len)
+{
+	buf += '"';
+	for (size_t i = 0; i < len; ++i) {
+		if (s[i] == '"') {
+			buf += '"';
+		}
+		buf += s[i];
+	}
+}
+
+/** Appends string field to buffer, quoting it if necessary */
+void appendField(std::string &buf, const std::string &s)
+{
+	if (needsQuoting(s.data(), s.size())) {
+		appendQuotedBody(buf, s.data(), s.size());
+		buf += '"';
+	} else {
+		buf += s;
+	}
+}
+
+/** Appends decimal representation of integer to buffer */
+void appendInt(std::string &buf, int value)
+{
+	char digits[16];
+	char *p = digits + sizeof(digits);
+	unsigned int u = (value < 0) ? (0U - (unsigned int)value) : (unsigned int)value;
+	do {
+		*--p = (char)('0' + (u % 10));
+		u /= 10;
+	} while (u);
+	if (value < 0) {
+		*--p = '-';
+	}
+	buf.append(p, digits + sizeof(digits) - p);
+}
+
+/** Appends printf-formatted floating point value to buffer */
+void appendDouble(std::string &buf, const char *format, double value)
+{
+	size_t pos = buf.size();
+	size_t room = 32;
+	buf.resize(pos + room);
+	int len = snprintf(&buf[pos], room, format, value);
+	if (len < 0) {
+		len = 0;
+	} else if ((size_t)len >= room) {
+		buf.resize(pos + len + 1);
+		snprintf(&buf[pos], len + 1, format, value);
+	}
+	buf.resize(pos + len);
+}
+
 } // end namespace
 
-GzipCsv::GzipCsv(const std::string &filename)
+///////////////////////////////////////////////////////////////////////////////
+// GzipCsv::Compressor
+///////////////////////////////////////////////////////////////////////////////
+
+/** Compresses and writes row buffers in background thread.
+ * Buffers are exchanged by swapping, so in steady state no memory is
+ * allocated
+ */
+class GzipCsv::Compressor : private boost::noncopyable
+{
+	public:
+		/** Constructor. Opens file and starts compression thread.
+		 * Throws std::runtime_error on failure
+		 * @param filename Name of file to write
+		 * @param compressLevel Zlib compression level
+		 */
+		Compressor(const std::string &filename, int compressLevel);
+
+		/** Destructor. Completes file if finish() was not called */
+		~Compressor();
+
+		/** Hands buffer to compression thread. Blocks while previously
+		 * handed buffer is not yet taken by compression thread. Throws
+		 * std::runtime_error if compression thread failed
+		 * @param buf Buffer to compress. Upon return contains empty buffer
+		 *	(with retained capacity) for subsequent rows
+		 */
+		void submit(std::string &buf);
+
+		/** Stops compression thread, completes and closes file.
+		 * Throws std::runtime_error on failure
+		 */
+		void finish();
+
+	private:
+		/** Compression thread function */
+		void threadFunc();
+
+		/** Compresses data and writes compressed data to file
+		 * @param data Data to compress
+		 * @param len Data length
+		 * @param flush Zlib flush mode
+		 * @return True on success
+		 */
+		bool deflateData(const char *data, size_t len, int flush);
+
+		/** Name of file being written */
+		std::string _filename;
+
+		/** File being written */
+		FILE *_fp = nullptr;
+
+		/** Zlib stream */
+		z_stream _zs;
+
+		/** Compressed data buffer */
+		std::vector<unsigned char> _outBuf;
+
+		/** Compression thread */
+		std::thread _thread;
+
+		/** Protects fields below */
+		std::mutex _mutex;
+
+		/** Signals change of fields below */
+		std::condition_variable _cv;
+
+		/** Buffer handed to compression thread (or empty buffer returned by it) */
+		std::string _pending;
+
+		/** True if _pending contains data to compress */
+		bool _hasPending = false;
+
+		/** True if no more data will be submitted */
+		bool _done = false;
+
+		/** Error message from compression thread. Empty if no error */
+		std::string _error;
+};
+
+GzipCsv::Compressor::Compressor(const std::string &filename, int compressLevel) :
+	_filename(filename), _outBuf(OUT_BUFFER_SIZE)
+{
+	_fp = fopen(filename.c_str(), "wb");
+	if (!_fp) {
+		std::ostringstream errStr;
+		errStr << "ERROR: GzipCsv::Compressor::Compressor(): Unable to open '" << filename
+		       << "' for writing: " << strerror(errno);
+		throw std::runtime_error(errStr.str());
+	}
+	memset(&_zs, 0, sizeof(_zs));
+	if (deflateInit2(&_zs,
+			 compressLevel,
+			 Z_DEFLATED,
+			 MAX_WBITS + 16,
+			 8,
+			 Z_DEFAULT_STRATEGY) != Z_OK) {
+		fclose(_fp);
+		std::ostringstream errStr;
+		errStr << "ERROR: GzipCsv::Compressor::Compressor(): Gzip '" << filename
+		       << "' failed to open";
+		throw std::runtime_error(errStr.str());
+	}
+	_thread = std::thread(&Compressor::threadFunc, this);
+}
+
+GzipCsv::Compressor::~Compressor()
+{
+	if (_thread.joinable()) {
+		try {
+			finish();
+		} catch (const std::exception &ex) {
+			LOGGER_ERROR(logger) << ex.what();
+		}
+	}
+}
+
+void GzipCsv::Compressor::submit(std::string &buf)
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cv.wait(lock, [this] { return !_hasPending || !_error.empty(); });
+		if (!_error.empty()) {
+			throw std::runtime_error(_error);
+		}
+		_pending.swap(buf);
+		_hasPending = true;
+	}
+	_cv.notify_all();
+	buf.clear();
+}
+
+void GzipCsv::Compressor::finish()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_done = true;
+	}
+	_cv.notify_all();
+	_thread.join();
+	bool ok = _error.empty() && deflateData(nullptr, 0, Z_FINISH);
+	deflateEnd(&_zs);
+	ok = (fclose(_fp) == 0) && ok;
+	if (!ok) {
+		std::ostringstream errStr;
+		errStr << "ERROR: GzipCsv::Compressor::finish(): Error writing '" << _filename
+		       << "'";
+		throw std::runtime_error(_error.empty() ? errStr.str() : _error);
+	}
+}
+
+void GzipCsv::Compressor::threadFunc()
+{
+	std::string work;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cv.wait(lock, [this] { return _hasPending || _done; });
+			if (!_hasPending) {
+				break;
+			}
+			work.clear();
+			work.swap(_pending);
+			_hasPending = false;
+		}
+		_cv.notify_all();
+		if (!deflateData(work.data(), work.size(), Z_NO_FLUSH)) {
+			std::ostringstream errStr;
+			errStr << "ERROR: GzipCsv::Compressor::threadFunc(): Error writing '"
+			       << _filename << "'";
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_error = errStr.str();
+			}
+			_cv.notify_all();
+			break;
+		}
+	}
+}
+
+bool GzipCsv::Compressor::deflateData(const char *data, size_t len, int flush)
+{
+	_zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+	_zs.avail_in = (uInt)len;
+	int status;
+	do {
+		_zs.next_out = _outBuf.data();
+		_zs.avail_out = (uInt)_outBuf.size();
+		status = deflate(&_zs, flush);
+		if (status == Z_STREAM_ERROR) {
+			return false;
+		}
+		size_t outLen = _outBuf.size() - _zs.avail_out;
+		if (outLen && (fwrite(_outBuf.data(), 1, outLen, _fp) != outLen)) {
+			return false;
+		}
+	} while ((_zs.avail_out == 0) || ((flush == Z_FINISH) && (status != Z_STREAM_END)));
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// GzipCsv
+///////////////////////////////////////////////////////////////////////////////
+
+GzipCsv::GzipCsv(const std::string &filename, int compressLevel, Format format)
 {
 	if (filename.empty()) {
 		return;
 	}
-	LOGGER_INFO(logger) << "Opening '" << QString::fromStdString(filename) << "'";
-	QString qfilename = QString::fromStdString(filename);
-	_fileWriter = FileHelpers::open(qfilename, QIODevice::WriteOnly);
-	_gzipWriter.reset(new GzipStream(_fileWriter.get()));
-	if (!_gzipWriter->open(QIODevice::WriteOnly)) {
-		throw std::runtime_error(
-			QString("Gzip \"%1\" failed to open").arg(qfilename).toStdString());
+	if (format == Format::Columnar) {
+		_columnar.reset(new ColumnarWriter(filename));
+		return;
+	}
+	LOGGER_INFO(logger) << "Opening '" << filename << "'";
+	_compressor.reset(new Compressor(filename, compressLevel));
+	_buffer.reserve(BUFFER_SIZE + 4096);
+}
+
+GzipCsv::~GzipCsv()
+{
+	try {
+		if (_columnar) {
+			if (!_headingWritten) {
+				addColumnarColumns();
+			}
+			_columnar->finish();
+		}
+		if (_compressor) {
+			if (!_buffer.empty()) {
+				_compressor->submit(_buffer);
+			}
+			_compressor->finish();
+		}
+	} catch (const std::exception &ex) {
+		LOGGER_ERROR(logger) << ex.what();
 	}
-	_csvWriter.reset(new CsvWriter(*_gzipWriter));
 }
 
 GzipCsv::operator bool() const
 {
-	return (bool)_fileWriter;
+	return _compressor || _columnar;
 }
 
 void GzipCsv::clearRow()
@@ -53,26 +367,53 @@ void GzipCsv::completeRow()
 	if (!*this) {
 		return;
 	}
+	if (_columnar) {
+		if (!_headingWritten) {
+			addColumnarColumns();
+		}
+		for (size_t i = 0; i < _columns.size(); ++i) {
+			if (_columns[i]->isValueSet()) {
+				_columns[i]->storeColumnar(*_columnar, _columnarIndices[i]);
+			}
+		}
+		clearRow();
+		_columnar->endRow();
+		return;
+	}
 	if (!_headingWritten) {
 		_headingWritten = true;
+		std::vector<std::string> names;
 		for (auto &colDef : _columns) {
-			_csvWriter->writeRecord(colDef->name());
+			names.push_back(colDef->name());
 		}
-		_csvWriter->writeEndRow();
+		writeRow(names);
 	}
-	for (auto &colDef : _columns) {
-		_csvWriter->writeRecord(colDef->formatValue());
+	for (size_t i = 0; i < _columns.size(); ++i) {
+		if (i) {
+			_buffer += ',';
+		}
+		_columns[i]->appendValue(_buffer);
 	}
 	clearRow();
-	_csvWriter->writeEndRow();
+	endRow();
 }
 
 void GzipCsv::writeRow(const std::vector<std::string> &columns)
 {
-	for (const auto &col : columns) {
-		_csvWriter->writeRecord(QString::fromStdString(col));
+	if (!*this) {
+		return;
 	}
-	_csvWriter->writeEndRow();
+	if (_columnar) {
+		throw std::logic_error("ERROR: GzipCsv::writeRow(): Not supported for columnar "
+				       "format");
+	}
+	for (size_t i = 0; i < columns.size(); ++i) {
+		if (i) {
+			_buffer += ',';
+		}
+		appendField(_buffer, columns[i]);
+	}
+	endRow();
 }
 
 void GzipCsv::addColumn(ColBase *column)
@@ -80,10 +421,25 @@ void GzipCsv::addColumn(ColBase *column)
 	_columns.push_back(column);
 }
 
+void GzipCsv::addColumnarColumns()
+{
+	_headingWritten = true;
+	for (auto &colDef : _columns) {
+		_columnarIndices.push_back(colDef->addColumnar(*_columnar));
+	}
+}
+
+void GzipCsv::endRow()
+{
+	_buffer += EOL;
+	if (_buffer.size() >= BUFFER_SIZE) {
+		_compressor->submit(_buffer);
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
-GzipCsv::ColBase::ColBase(GzipCsv *container, const std::string &name) :
-	_name(QString::fromStdString(name))
+GzipCsv::ColBase::ColBase(GzipCsv *container, const std::string &name) : _name(name)
 {
 	container->addColumn(this);
 }
@@ -93,10 +449,8 @@ void GzipCsv::ColBase::checkSet() const
 	if (_valueSet) {
 		return;
 	}
-	throw std::runtime_error(QString("Attempt to read value from column \"%1\" that was not "
-					 "set yet")
-					 .arg(_name)
-					 .toStdString());
+	throw std::runtime_error("Attempt to read value from column \"" + _name +
+				 "\" that was not set yet");
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -105,9 +459,21 @@ GzipCsv::ColInt::ColInt(GzipCsv *container, const std::string &name) : ColBase(c
 {
 }
 
-QString GzipCsv::ColInt::formatValue() const
+void GzipCsv::ColInt::appendValue(std::string &buf) const
+{
+	if (isValueSet()) {
+		appendInt(buf, _value);
+	}
+}
+
+int GzipCsv::ColInt::addColumnar(ColumnarWriter &writer) const
+{
+	return writer.addColumn(name(), ColumnarWriter::Int32);
+}
+
+void GzipCsv::ColInt::storeColumnar(ColumnarWriter &writer, int colIdx) const
 {
-	return isValueSet() ? QString::number(_value) : QString();
+	writer.setInt(colIdx, _value);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -115,19 +481,25 @@ QString GzipCsv::ColInt::formatValue() const
 GzipCsv::ColDouble::ColDouble(GzipCsv *container,
 			      const std::string &name,
 			      const std::string &format) :
-	ColBase(container, name), _format(format)
+	ColBase(container, name), _format(format.empty() ? "%.17g" : format)
 {
 }
 
-QString GzipCsv::ColDouble::formatValue() const
+void GzipCsv::ColDouble::appendValue(std::string &buf) const
 {
-	if (!isValueSet()) {
-		return QString();
-	}
-	if (!_format.empty()) {
-		return QString::asprintf(_format.c_str(), _value);
+	if (isValueSet()) {
+		appendDouble(buf, _format.c_str(), _value);
 	}
-	return QString::fromStdString(boost::lexical_cast<std::string>(_value));
+}
+
+int GzipCsv::ColDouble::addColumnar(ColumnarWriter &writer) const
+{
+	return writer.addColumn(name(), ColumnarWriter::Float64, _format);
+}
+
+void GzipCsv::ColDouble::storeColumnar(ColumnarWriter &writer, int colIdx) const
+{
+	writer.setDouble(colIdx, _value);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -136,9 +508,21 @@ GzipCsv::ColStr::ColStr(GzipCsv *container, const std::string &name) : ColBase(c
 {
 }
 
-QString GzipCsv::ColStr::formatValue() const
+void GzipCsv::ColStr::appendValue(std::string &buf) const
 {
-	return isValueSet() ? QString::fromStdString(_value) : QString();
+	if (isValueSet()) {
+		appendField(buf, _value);
+	}
+}
+
+int GzipCsv::ColStr::addColumnar(ColumnarWriter &writer) const
+{
+	return writer.addColumn(name(), ColumnarWriter::String);
+}
+
+void GzipCsv::ColStr::storeColumnar(ColumnarWriter &writer, int colIdx) const
+{
+	writer.setString(colIdx, _value);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -149,14 +533,24 @@ GzipCsv::ColBool::ColBool(GzipCsv *container,
 	ColBase(container, name)
 {
 	assert(tf.size() == 2);
-	for (const auto &s : tf) {
-		_tf.push_back(QString::fromStdString(s));
+	_tf = tf;
+}
+
+void GzipCsv::ColBool::appendValue(std::string &buf) const
+{
+	if (isValueSet()) {
+		appendField(buf, _tf[_value ? 0 : 1]);
 	}
 }
 
-QString GzipCsv::ColBool::formatValue() const
+int GzipCsv::ColBool::addColumnar(ColumnarWriter &writer) const
 {
-	return isValueSet() ? _tf[_value ? 0 : 1] : QString();
+	return writer.addColumn(name(), ColumnarWriter::Bool, "", {{1, _tf[0]}, {0, _tf[1]}});
+}
+
+void GzipCsv::ColBool::storeColumnar(ColumnarWriter &writer, int colIdx) const
+{
+	writer.setInt(colIdx, _value ? 1 : 0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -165,18 +559,37 @@ GzipCsv::ColEnum::ColEnum(GzipCsv *container,
 			  const std::string &name,
 			  const std::map<int, std::string> &items,
 			  const std::string &defName) :
-	ColBase(container, name), _defName(QString::fromStdString(defName))
+	ColBase(container, name), _items(items), _defName(defName)
 {
-	for (const auto &kvp : items) {
-		_items[kvp.first] = QString::fromStdString(kvp.second);
-	}
 }
 
-QString GzipCsv::ColEnum::formatValue() const
+void GzipCsv::ColEnum::appendValue(std::string &buf) const
 {
 	if (!isValueSet()) {
-		return QString();
+		return;
 	}
 	const auto &it = _items.find(_value);
-	return ((it == _items.end()) ? _defName : it->second) + QString::asprintf(" (%d)", _value);
+	const std::string &itemName = (it == _items.end()) ? _defName : it->second;
+	bool quote = needsQuoting(itemName.data(), itemName.size());
+	if (quote) {
+		appendQuotedBody(buf, itemName.data(), itemName.size());
+	} else {
+		buf += itemName;
+	}
+	buf += " (";
+	appendInt(buf, _value);
+	buf += ')';
+	if (quote) {
+		buf += '"';
+	}
+}
+
+int GzipCsv::ColEnum::addColumnar(ColumnarWriter &writer) const
+{
+	return writer.addColumn(name(), ColumnarWriter::Enum, _defName, _items);
+}
+
+void GzipCsv::ColEnum::storeColumnar(ColumnarWriter &writer, int colIdx) const
+{
+	writer.setInt(colIdx, _value);
 }
@@ -40,18 +40,26 @@
  *     // Writing row with values previously set (and resetting values)
  *     fooCsv.writeRow();
  * }
+ *
+ * Rows are formatted directly into a byte buffer (numbers are never quoted,
+ * string values are quoted only when they contain separator, quote or EOL
+ * characters) and full buffers are handed to a background thread that
+ * compresses and writes them. Output is the same CSV as CsvWriter would
+ * produce (comma separator, CRLF row ends).
+ *
+ * Alternatively (Format::Columnar) same columns may be written as binary
+ * columnar file (see ColumnarWriter.h) - faster to write and to load to
+ * dataframes. Such file may be converted back to CSV with
+ * tools/columnar/afccol_to_csv.py
  */
 
 #ifndef GZIP_CSV_H
 #define GZIP_CSV_H
 
-#include "CsvWriter.h"
-#include "GzipStream.h"
+#include "ColumnarWriter.h"
 #include <map>
 #include <memory>
 #include <boost/core/noncopyable.hpp>
-#include <QFile>
-#include <QString>
 #include <string>
 #include <vector>
 
@@ -103,14 +111,28 @@ class GzipCsv : private boost::noncopyable
 				}
 
 				/** Column name */
-				const QString &name() const
+				const std::string &name() const
 				{
 					return _name;
 				}
 
-				/** Returns column value formatted for putting to CSV. "" if not set
+				/** Appends column value formatted for putting to CSV to given
+				 * buffer. Appends nothing if not set
+				 */
+				virtual void appendValue(std::string &buf) const = 0;
+
+				/** Adds column to columnar writer
+				 * @param writer Columnar writer
+				 * @return Column index in columnar writer
 				 */
-				virtual QString formatValue() const = 0;
+				virtual int addColumnar(ColumnarWriter &writer) const = 0;
+
+				/** Stores (set) column value to current row of columnar writer
+				 * @param writer Columnar writer
+				 * @param colIdx Column index in columnar writer
+				 */
+				virtual void storeColumnar(ColumnarWriter &writer,
+							   int colIdx) const = 0;
 
 				/** Raise exception if value not set */
 				void checkSet() const;
@@ -120,7 +142,7 @@ class GzipCsv : private boost::noncopyable
 
 				// INSTANCE DATA
 
-				const QString _name; /*!< Column name */
+				const std::string _name; /*!< Column name */
 				bool _valueSet = false; /*!< Column value set */
 		};
 
@@ -152,9 +174,17 @@ class GzipCsv : private boost::noncopyable
 				}
 
 			protected:
-				/** Returns column value formatted for putting to CSV. "" if not set
+				/** Appends column value formatted for putting to CSV to given
+				 * buffer. Appends nothing if not set
 				 */
-				virtual QString formatValue() const;
+				virtual void appendValue(std::string &buf) const;
+
+				/** Adds column to columnar writer */
+				virtual int addColumnar(ColumnarWriter &writer) const;
+
+				/** Stores column value to current row of columnar writer */
+				virtual void storeColumnar(ColumnarWriter &writer,
+							   int colIdx) const;
 
 			private:
 				// INSTANCE DATA
@@ -194,9 +224,17 @@ class GzipCsv : private boost::noncopyable
 				}
 
 			protected:
-				/** Returns column value formatted for putting to CSV. "" if not set
+				/** Appends column value formatted for putting to CSV to given
+				 * buffer. Appends nothing if not set
 				 */
-				virtual QString formatValue() const;
+				virtual void appendValue(std::string &buf) const;
+
+				/** Adds column to columnar writer */
+				virtual int addColumnar(ColumnarWriter &writer) const;
+
+				/** Stores column value to current row of columnar writer */
+				virtual void storeColumnar(ColumnarWriter &writer,
+							   int colIdx) const;
 
 			private:
 				// INSTANCE DATA
@@ -240,9 +278,17 @@ class GzipCsv : private boost::noncopyable
 				}
 
 			protected:
-				/** Returns column value formatted for putting to CSV. "" if not set
+				/** Appends column value formatted for putting to CSV to given
+				 * buffer. Appends nothing if not set
 				 */
-				virtual QString formatValue() const;
+				virtual void appendValue(std::string &buf) const;
+
+				/** Adds column to columnar writer */
+				virtual int addColumnar(ColumnarWriter &writer) const;
+
+				/** Stores column value to current row of columnar writer */
+				virtual void storeColumnar(ColumnarWriter &writer,
+							   int colIdx) const;
 
 			private:
 				// INSTANCE DATA
@@ -281,14 +327,24 @@ class GzipCsv : private boost::noncopyable
 				}
 
 			protected:
-				/** Returns column value formatted for putting to CSV */
-				virtual QString formatValue() const;
+				/** Appends column value formatted for putting to CSV to given
+				 * buffer. Appends nothing if not set
+				 */
+				virtual void appendValue(std::string &buf) const;
+
+				/** Adds column to columnar writer */
+				virtual int addColumnar(ColumnarWriter &writer) const;
+
+				/** Stores column value to current row of columnar writer */
+				virtual void storeColumnar(ColumnarWriter &writer,
+							   int colIdx) const;
 
 			private:
 				// INSTANCE DATA
 
 				bool _value; /*!< Column value (for current row) */
-				std::vector<QString> _tf; /*!< Column values for true and false */
+				/** Column values for true and false */
+				std::vector<std::string> _tf;
 		};
 
 		///////////////////////////////////////////////////////////////////////////
@@ -324,27 +380,50 @@ class GzipCsv : private boost::noncopyable
 				}
 
 			protected:
-				/** Returns column value formatted for putting to CSV */
-				virtual QString formatValue() const;
+				/** Appends column value formatted for putting to CSV to given
+				 * buffer. Appends nothing if not set
+				 */
+				virtual void appendValue(std::string &buf) const;
+
+				/** Adds column to columnar writer */
+				virtual int addColumnar(ColumnarWriter &writer) const;
+
+				/** Stores column value to current row of columnar writer */
+				virtual void storeColumnar(ColumnarWriter &writer,
+							   int colIdx) const;
 
 			private:
 				// INSTANCE DATA
 
 				int _value; /*!< Column value (for current row) */
-				std::map<int, QString> _items; /*!< Item descriptors */
-				QString _defName; /*<! Name for unknown items */
+				std::map<int, std::string> _items; /*!< Item descriptors */
+				std::string _defName; /*<! Name for unknown items */
 		};
 
 		///////////////////////////////////////////////////////////////////////////
 
+		/** Output file format */
+		enum class Format {
+			CsvGz, /*!< GZIPped CSV */
+			Columnar /*!< Binary columnar (see ColumnarWriter.h) */
+		};
+
+		/** Default zlib compression level */
+		static const int DEFAULT_COMPRESS_LEVEL = 6;
+
 		/** Constructor
 		 * @param filename Name of CSV GZIP file (expected to have .csv.gz extension).
 		 *	Empty if writer should not be activated
+		 * @param compressLevel Zlib compression level between 0 and 9 inclusive.
+		 *	Lower levels are faster, but produce bigger files
+		 * @param format Output file format
 		 */
-		GzipCsv(const std::string &filename);
+		GzipCsv(const std::string &filename,
+			int compressLevel = DEFAULT_COMPRESS_LEVEL,
+			Format format = Format::CsvGz);
 
-		/** Default virtual destructor */
-		virtual ~GzipCsv() = default;
+		/** Virtual destructor. Flushes buffered rows and completes the file */
+		virtual ~GzipCsv();
 
 		/** True if writer was active (initialized with nonempty file name */
 		operator bool() const;
@@ -357,28 +436,42 @@ class GzipCsv : private boost::noncopyable
 		 */
 		void completeRow();
 
-		/** Writes sequence of strings as CSV row */
+		/** Writes sequence of strings as CSV row. Not supported for columnar
+		 * format
+		 */
 		void writeRow(const std::vector<std::string> &columns);
 
 	private:
 		friend class ColBase;
 
+		/** Background compressor/writer (defined in GzipCsv.cpp) */
+		class Compressor;
+
 		/** Append reference to column to vector of columns */
 		void addColumn(ColBase *column);
 
+		/** Adds columns to columnar writer */
+		void addColumnarColumns();
+
+		/** Terminates current row, hands buffer to compressor if it is full */
+		void endRow();
+
 		// INSTANCE DATA
 
 		/** True if heading row have been written */
 		bool _headingWritten = false;
 
-		/** File writer, used by gzip writer */
-		std::unique_ptr<QFile> _fileWriter;
+		/** Background compressor. Null if writer is not active */
+		std::unique_ptr<Compressor> _compressor;
+
+		/** Buffer with formatted rows not yet handed to compressor */
+		std::string _buffer;
 
-		/** GZIP writer used by CSV writer */
-		std::unique_ptr<GzipStream> _gzipWriter;
+		/** Columnar writer. Null if writer is not active or format is CSV */
+		std::unique_ptr<ColumnarWriter> _columnar;
 
-		/** CSV writer */
-		std::unique_ptr<CsvWriter> _csvWriter;
+		/** Column indices in columnar writer (in order of _columns) */
+		std::vector<int> _columnarIndices;
 
 		/** Vector of columns */
 		std::vector<ColBase *> _columns;
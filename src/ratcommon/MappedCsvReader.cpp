@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+#include "MappedCsvReader.h"
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <locale.h>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+/** "C" locale for number parsing (strtod() otherwise respects LC_NUMERIC set by Qt) */
+locale_t cLocale()
+{
+	static locale_t loc = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+	return loc;
+}
+
+/** Copies field to null-terminated buffer (fields in mapped text are not
+ * null-terminated). Long fields are copied to heap
+ */
+class FieldBuffer
+{
+	public:
+		explicit FieldBuffer(const MappedCsvReader::Field &field)
+		{
+			if (field.size() < sizeof(_buf)) {
+				memcpy(_buf, field.data(), field.size());
+				_buf[field.size()] = '\0';
+				_str = _buf;
+			} else {
+				_long.assign(field.data(), field.size());
+				_str = _long.c_str();
+			}
+		}
+
+		const char *c_str() const
+		{
+			return _str;
+		}
+
+	private:
+		char _buf[64];
+		std::string _long;
+		const char *_str;
+};
+
+/** True for characters removed by field trimming */
+inline bool isBlank(char c)
+{
+	return (c == ' ') || (c == '\t');
+}
+
+} // end namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+MappedCsvReader::Cursor::Cursor(const MappedCsvReader &reader, const Chunk &chunk) :
+	_reader(reader), _pos(chunk.begin), _end(chunk.end), _rowStart(chunk.begin)
+{
+}
+
+bool MappedCsvReader::Cursor::readRow(std::vector<Field> &fields)
+{
+	fields.clear();
+	if (_pos >= _end) {
+		return false;
+	}
+	_rowStart = _pos;
+	const char *lineEnd = (const char *)memchr(_pos, '\n', _end - _pos);
+	if (lineEnd) {
+		_pos = lineEnd + 1;
+	} else {
+		lineEnd = _end;
+		_pos = _end;
+	}
+	if ((lineEnd > _rowStart) && (lineEnd[-1] == '\r')) {
+		--lineEnd;
+	}
+	if (lineEnd == _rowStart) {
+		return true;
+	}
+	const char sep = _reader._sep;
+	const char quote = _reader._quote;
+	const bool trim = _reader._fieldTrim;
+	size_t numUnescaped = 0;
+	const char *p = _rowStart;
+	for (;;) {
+		if (trim) {
+			while ((p < lineEnd) && isBlank(*p)) {
+				++p;
+			}
+		}
+		if (quote && (p < lineEnd) && (*p == quote)) {
+			const char *start = ++p;
+			const char *q;
+			bool escaped = false;
+			for (;;) {
+				q = (const char *)memchr(p, quote, lineEnd - p);
+				if (!q) {
+					error("unmatched quote");
+				}
+				if ((q + 1 < lineEnd) && (q[1] == quote)) {
+					escaped = true;
+					p = q + 2;
+					continue;
+				}
+				break;
+			}
+			if (escaped) {
+				if (numUnescaped == _unescaped.size()) {
+					_unescaped.emplace_back();
+				}
+				std::string &buf = _unescaped[numUnescaped++];
+				buf.clear();
+				for (const char *c = start; c < q; ++c) {
+					buf += *c;
+					if (*c == quote) {
+						++c;
+					}
+				}
+				fields.push_back(Field(buf.data(), buf.size()));
+			} else {
+				fields.push_back(Field(start, q - start));
+			}
+			p = q + 1;
+			while ((p < lineEnd) && isBlank(*p)) {
+				++p;
+			}
+			if ((p < lineEnd) && (*p != sep)) {
+				error("invalid quotes");
+			}
+		} else {
+			const char *start = p;
+			p = (const char *)memchr(p, sep, lineEnd - p);
+			if (!p) {
+				p = lineEnd;
+			}
+			const char *fieldEnd = p;
+			if (trim) {
+				while ((fieldEnd > start) && isBlank(fieldEnd[-1])) {
+					--fieldEnd;
+				}
+			}
+			fields.push_back(Field(start, fieldEnd - start));
+		}
+		if (p >= lineEnd) {
+			break;
+		}
+		// Skipping separator. Separator at the end of line means empty last field
+		if (++p == lineEnd) {
+			fields.push_back(Field());
+			break;
+		}
+	}
+	return true;
+}
+
+void MappedCsvReader::Cursor::error(const char *message) const
+{
+	std::ostringstream errStr;
+	errStr << "ERROR: MappedCsvReader: File \"" << _reader._fileName << "\" line "
+	       << _reader.lineNumberOf(_rowStart) << ": " << message;
+	throw FileError(errStr.str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+MappedCsvReader::MappedCsvReader(const std::string &fileName, char separator, char quote) :
+	_fileName(fileName),
+	_data(""),
+	_size(0),
+	_mapped(false),
+	_sep(separator),
+	_quote(quote),
+	_fieldTrim(true),
+	_lineNumber(0)
+{
+	int fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		std::ostringstream errStr;
+		errStr << "ERROR: MappedCsvReader: Unable to open file \"" << fileName
+		       << "\": " << strerror(errno);
+		throw FileError(errStr.str());
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		int err = errno;
+		close(fd);
+		std::ostringstream errStr;
+		errStr << "ERROR: MappedCsvReader: Unable to stat file \"" << fileName
+		       << "\": " << strerror(err);
+		throw FileError(errStr.str());
+	}
+	if (st.st_size > 0) {
+		void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr == MAP_FAILED) {
+			int err = errno;
+			close(fd);
+			std::ostringstream errStr;
+			errStr << "ERROR: MappedCsvReader: Unable to map file \"" << fileName
+			       << "\": " << strerror(err);
+			throw FileError(errStr.str());
+		}
+		madvise(addr, st.st_size, MADV_SEQUENTIAL);
+		_data = (const char *)addr;
+		_size = st.st_size;
+		_mapped = true;
+	}
+	close(fd);
+}
+
+MappedCsvReader::~MappedCsvReader()
+{
+	_cursor.reset();
+	if (_mapped) {
+		munmap((void *)_data, _size);
+	}
+}
+
+std::vector<MappedCsvReader::Chunk> MappedCsvReader::split(int numChunks) const
+{
+	std::vector<Chunk> ret;
+	const char *end = _data + _size;
+	const char *begin = _data;
+	numChunks = std::max(numChunks, 1);
+	for (int i = 1; (i <= numChunks) && (begin < end); ++i) {
+		const char *chunkEnd = end;
+		if (i < numChunks) {
+			chunkEnd = _data + (_size * i) / numChunks;
+			if (chunkEnd <= begin) {
+				continue;
+			}
+			const char *nl =
+				(const char *)memchr(chunkEnd - 1, '\n', end - chunkEnd + 1);
+			chunkEnd = nl ? (nl + 1) : end;
+		}
+		ret.push_back(Chunk {begin, chunkEnd});
+		begin = chunkEnd;
+	}
+	return ret;
+}
+
+bool MappedCsvReader::readRow(std::vector<Field> &fields)
+{
+	if (!_cursor) {
+		_cursor.reset(new Cursor(*this, whole()));
+	}
+	if (!_cursor->readRow(fields)) {
+		return false;
+	}
+	++_lineNumber;
+	return true;
+}
+
+int MappedCsvReader::lineNumberOf(const char *pos) const
+{
+	return 1 + (int)std::count(_data, std::min(pos, _data + _size), '\n');
+}
+
+bool MappedCsvReader::toDouble(const Field &field, double &value)
+{
+	if (field.empty()) {
+		return false;
+	}
+	FieldBuffer buf(field);
+	char *endptr;
+	value = strtod_l(buf.c_str(), &endptr, cLocale());
+	return endptr == (buf.c_str() + field.size());
+}
+
+bool MappedCsvReader::toLong(const Field &field, long &value)
+{
+	if (field.empty()) {
+		return false;
+	}
+	FieldBuffer buf(field);
+	char *endptr;
+	errno = 0;
+	value = strtol_l(buf.c_str(), &endptr, 10, cLocale());
+	return (endptr == (buf.c_str() + field.size())) && (errno == 0);
+}
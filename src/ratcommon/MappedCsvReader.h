@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2022 Broadcom. All rights reserved.
+ * The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+ * that owns the software below.
+ * This work is licensed under the OpenAFC Project License, a copy of which is
+ * included with this software program.
+ */
+
+/** @file
+ * Zero-copy reader of large CSV (or other single-character delimited) files.
+ *
+ * File is memory-mapped, fields are returned as views into mapped text, so
+ * reading a row does not allocate (except for quoted fields with embedded
+ * doubled quotes that have to be unescaped). Numeric fields may be converted
+ * in place with toDouble()/toLong().
+ *
+ * Field splitting follows splitCSV() of AFC Engine: row is a line (LF or CRLF
+ * terminated), quoted fields may contain separators and doubled quotes, but
+ * not line breaks; empty line has no fields. With trimming on (default)
+ * spaces and tabs around fields are removed.
+ *
+ * File may be split into chunks on line boundaries, that are parsed by
+ * separate cursors in parallel.
+ *
+ * Sequential usage:
+ *	MappedCsvReader reader("table.csv");
+ *	std::vector<MappedCsvReader::Field> fields;
+ *	while (reader.readRow(fields)) {
+ *		double value;
+ *		if (!MappedCsvReader::toDouble(fields[0], value)) {...}
+ *	}
+ *
+ * Parallel usage:
+ *	for (const auto &chunk : reader.split(numThreads)) {
+ *		// In separate thread:
+ *		MappedCsvReader::Cursor cursor(reader, chunk);
+ *		std::vector<MappedCsvReader::Field> fields;
+ *		while (cursor.readRow(fields)) {...}
+ *	}
+ */
+
+#ifndef MAPPED_CSV_READER_H
+#define MAPPED_CSV_READER_H
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/** Memory-mapped reader of CSV files */
+class MappedCsvReader : private boost::noncopyable
+{
+	public:
+		//////////////////////////////////////////////////
+		// MappedCsvReader. Public class types
+		//////////////////////////////////////////////////
+
+		/** Field value - view into file text (or into cursor's buffer for
+		 * unescaped quoted fields). Valid until next readRow() of the same
+		 * cursor
+		 */
+		typedef boost::string_ref Field;
+
+		/** Any error associated with reading a file */
+		class FileError : public std::runtime_error
+		{
+			public:
+				FileError(const std::string &msg) : runtime_error(msg)
+				{
+				}
+		};
+
+		/** Part of file that starts and ends at line boundary */
+		struct Chunk {
+				/** Start of first line */
+				const char *begin;
+
+				/** End of last line (after its line terminator) */
+				const char *end;
+		};
+
+		/** Row reader over a chunk of file. Different cursors over the same
+		 * reader may be used in different threads
+		 */
+		class Cursor : private boost::noncopyable
+		{
+			public:
+				/** Constructor
+				 * @param reader File reader
+				 * @param chunk Part of file to read
+				 */
+				Cursor(const MappedCsvReader &reader, const Chunk &chunk);
+
+				/** Reads next row. Throws FileError on unmatched quotes
+				 * @param fields Fields of row (previous content is
+				 *	replaced)
+				 * @return False if there are no more rows in chunk
+				 */
+				bool readRow(std::vector<Field> &fields);
+
+				/** Start of last read row (e.g. for lineNumberOf()) */
+				const char *rowStart() const
+				{
+					return _rowStart;
+				}
+
+			private:
+				/** Throws FileError with position of current row
+				 * @param message Error message
+				 */
+				[[noreturn]] void error(const char *message) const;
+
+				/** File reader */
+				const MappedCsvReader &_reader;
+
+				/** Start of next row */
+				const char *_pos;
+
+				/** End of chunk */
+				const char *_end;
+
+				/** Start of last read row */
+				const char *_rowStart;
+
+				/** Storage for unescaped quoted fields (deque keeps
+				 * addresses of its strings stable on growth)
+				 */
+				std::deque<std::string> _unescaped;
+		};
+
+		//////////////////////////////////////////////////
+		// MappedCsvReader. Public member functions
+		//////////////////////////////////////////////////
+
+		/** Opens and maps file. Throws FileError on failure
+		 * @param fileName Name of file to read
+		 * @param separator Field separator character
+		 * @param quote Field quotation character, '\0' if fields are never
+		 *	quoted (e.g. ULS pipe-delimited data)
+		 */
+		explicit MappedCsvReader(const std::string &fileName,
+					 char separator = ',',
+					 char quote = '"');
+
+		/** Unmaps file */
+		~MappedCsvReader();
+
+		/** Determine if whitespace at start and end of fields should be
+		 * removed (it is by default). Must be called before reading
+		 * @param trim If true, field strings will be trimmed by the reader
+		 */
+		void setFieldsTrimmed(bool trim)
+		{
+			_fieldTrim = trim;
+		}
+
+		/** Whole file as a single chunk */
+		Chunk whole() const
+		{
+			return Chunk {_data, _data + _size};
+		}
+
+		/** Splits file into chunks of approximately same size on line
+		 * boundaries
+		 * @param numChunks Desired number of chunks
+		 * @return Nonempty chunks in file order (may be less than requested)
+		 */
+		std::vector<Chunk> split(int numChunks) const;
+
+		/** Reads next row of file (sequential reading from the start)
+		 * @param fields Fields of row (previous content is replaced)
+		 * @return False if there are no more rows
+		 */
+		bool readRow(std::vector<Field> &fields);
+
+		/** 1-based number of line of last row, returned by readRow() */
+		int lineNumber() const
+		{
+			return _lineNumber;
+		}
+
+		/** Name of file */
+		const std::string &fileName() const
+		{
+			return _fileName;
+		}
+
+		/** 1-based number of line that contains given position of mapped
+		 * text (intended for error messages - it is slow)
+		 * @param pos Position in mapped text
+		 */
+		int lineNumberOf(const char *pos) const;
+
+		//////////////////////////////////////////////////
+		// MappedCsvReader. Public static methods
+		//////////////////////////////////////////////////
+
+		/** Converts field to floating point number ("C" locale)
+		 * @param field Field text
+		 * @param value Resulting value
+		 * @return True if field is entirely a number, false if it is empty
+		 *	or contains something else
+		 */
+		static bool toDouble(const Field &field, double &value);
+
+		/** Converts field to integer number
+		 * @param field Field text
+		 * @param value Resulting value
+		 * @return True if field is entirely a decimal integer, false if it
+		 *	is empty or contains something else
+		 */
+		static bool toLong(const Field &field, long &value);
+
+		/** Field as std::string */
+		static std::string toString(const Field &field)
+		{
+			return std::string(field.data(), field.size());
+		}
+
+	private:
+		//////////////////////////////////////////////////
+		// MappedCsvReader. Private instance data
+		//////////////////////////////////////////////////
+
+		/** Name of file */
+		std::string _fileName;
+
+		/** Mapped text */
+		const char *_data;
+
+		/** Size of mapped text */
+		size_t _size;
+
+		/** True if _data is mapped (not mapped for empty file) */
+		bool _mapped;
+
+		/** Field separator */
+		char _sep;
+
+		/** Field quotation character, '\0' for none */
+		char _quote;
+
+		/** Trim field strings */
+		bool _fieldTrim;
+
+		/** Cursor for sequential reading (created on first readRow()) */
+		std::unique_ptr<Cursor> _cursor;
+
+		/** Line number of last row, returned by readRow() */
+		int _lineNumber;
+};
+
+#endif /* MAPPED_CSV_READER_H */
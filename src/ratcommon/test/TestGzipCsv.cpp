@@ -0,0 +1,126 @@
+//
+
+#include "../GzipCsv.h"
+#include <cmath>
+#include <zlib.h>
+
+namespace
+{
+class TestCsv : public GzipCsv
+{
+	public:
+		ColInt intCol;
+		ColDouble dblCol;
+		ColDouble fmtCol;
+		ColStr strCol;
+		ColBool boolCol;
+		ColEnum enumCol;
+
+		TestCsv(const std::string &filename,
+			int compressLevel,
+			Format format = Format::CsvGz) :
+			GzipCsv(filename, compressLevel, format),
+			intCol(this, "INT"),
+			dblCol(this, "DBL,1"),
+			fmtCol(this, "FMT", "%.3f"),
+			strCol(this, "STR"),
+			boolCol(this, "BOOL"),
+			enumCol(this, "ENUM", {{1, "one"}, {2, "t,wo"}})
+		{
+		}
+};
+
+std::string readGzip(const std::string &filename)
+{
+	std::string ret;
+	gzFile gz = gzopen(filename.c_str(), "rb");
+	if (!gz) {
+		return ret;
+	}
+	char buf[4096];
+	int len;
+	while ((len = gzread(gz, buf, sizeof(buf))) > 0) {
+		ret.append(buf, len);
+	}
+	gzclose(gz);
+	return ret;
+}
+}
+
+TEST(TestGzipCsv, inactive)
+{
+	TestCsv csv("", GzipCsv::DEFAULT_COMPRESS_LEVEL);
+	ASSERT_FALSE(csv);
+	csv.intCol = 1;
+	csv.completeRow();
+	csv.writeRow({"a", "b"});
+}
+
+TEST(TestGzipCsv, formatting)
+{
+	const std::string filename = testing::TempDir() + "TestGzipCsv_formatting.csv.gz";
+	{
+		TestCsv csv(filename, 1);
+		ASSERT_TRUE(csv);
+		csv.intCol = -2147483647 - 1;
+		csv.dblCol = 0.1;
+		csv.fmtCol = 2.5;
+		csv.strCol = "q\"u,o";
+		csv.boolCol = true;
+		csv.enumCol = 2;
+		csv.completeRow();
+		csv.intCol = 7;
+		csv.dblCol = NAN;
+		csv.strCol = "plain";
+		csv.boolCol = false;
+		csv.enumCol = 3;
+		csv.completeRow();
+		csv.completeRow();
+		csv.writeRow({"x", "y\nz"});
+	}
+	ASSERT_EQ(std::string("INT,\"DBL,1\",FMT,STR,BOOL,ENUM\r\n"
+			      "-2147483648,0.10000000000000001,2.500,"
+			      "\"q\"\"u,o\",True,\"t,wo (2)\"\r\n"
+			      "7,nan,,plain,False,Unknown (3)\r\n"
+			      ",,,,,\r\n"
+			      "x,\"y\nz\"\r\n"),
+		  readGzip(filename));
+	remove(filename.c_str());
+}
+
+TEST(TestGzipCsv, manyRows)
+{
+	const std::string filename = testing::TempDir() + "TestGzipCsv_manyRows.csv.gz";
+	std::string expected = "INT,\"DBL,1\",FMT,STR,BOOL,ENUM\r\n";
+	{
+		TestCsv csv(filename, GzipCsv::DEFAULT_COMPRESS_LEVEL);
+		for (int i = 0; i < 100000; ++i) {
+			csv.intCol = i;
+			csv.strCol = "row";
+			csv.completeRow();
+			expected += std::to_string(i) + ",,,row,,\r\n";
+		}
+	}
+	ASSERT_EQ(expected, readGzip(filename));
+	remove(filename.c_str());
+}
+
+TEST(TestGzipCsv, columnar)
+{
+	const std::string filename = testing::TempDir() + "TestGzipCsv_columnar.afccol";
+	{
+		TestCsv csv(filename, GzipCsv::DEFAULT_COMPRESS_LEVEL, GzipCsv::Format::Columnar);
+		ASSERT_TRUE(csv);
+		csv.intCol = 1;
+		csv.strCol = "row";
+		csv.completeRow();
+		ASSERT_THROW(csv.writeRow({"a", "b"}), std::logic_error);
+	}
+	FILE *fp = fopen(filename.c_str(), "rb");
+	ASSERT_TRUE(fp != nullptr);
+	char magic[8];
+	ASSERT_EQ(sizeof(magic), fread(magic, 1, sizeof(magic), fp));
+	fclose(fp);
+	ASSERT_EQ(std::string("AFCCOL1"), std::string(magic));
+	remove(filename.c_str());
+}
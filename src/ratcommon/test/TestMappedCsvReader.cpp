@@ -0,0 +1,91 @@
+//
+
+#include "../MappedCsvReader.h"
+#include <fstream>
+
+namespace
+{
+void writeFile(const std::string &filename, const std::string &content)
+{
+	std::ofstream f(filename, std::ios::binary);
+	f << content;
+}
+
+std::vector<std::string> toStrings(const std::vector<MappedCsvReader::Field> &fields)
+{
+	std::vector<std::string> ret;
+	for (const auto &field : fields) {
+		ret.push_back(MappedCsvReader::toString(field));
+	}
+	return ret;
+}
+}
+
+TEST(TestMappedCsvReader, splitting)
+{
+	const std::string filename = testing::TempDir() + "TestMappedCsvReader_splitting.csv";
+	writeFile(filename,
+		  "a,b , c\r\n"
+		  "\n"
+		  " \"x,y\" ,\"he said \"\"hi\"\"\",\n"
+		  "1.5,-2,abc");
+	MappedCsvReader reader(filename);
+	std::vector<MappedCsvReader::Field> fields;
+
+	ASSERT_TRUE(reader.readRow(fields));
+	ASSERT_EQ(std::vector<std::string>({"a", "b", "c"}), toStrings(fields));
+	ASSERT_TRUE(reader.readRow(fields));
+	ASSERT_TRUE(fields.empty());
+	ASSERT_TRUE(reader.readRow(fields));
+	ASSERT_EQ(std::vector<std::string>({"x,y", "he said \"hi\"", ""}), toStrings(fields));
+	ASSERT_EQ(3, reader.lineNumber());
+	ASSERT_TRUE(reader.readRow(fields));
+	double d;
+	long l;
+	ASSERT_TRUE(MappedCsvReader::toDouble(fields[0], d));
+	ASSERT_EQ(1.5, d);
+	ASSERT_TRUE(MappedCsvReader::toLong(fields[1], l));
+	ASSERT_EQ(-2, l);
+	ASSERT_FALSE(MappedCsvReader::toDouble(fields[2], d));
+	ASSERT_FALSE(reader.readRow(fields));
+}
+
+TEST(TestMappedCsvReader, errors)
+{
+	const std::string filename = testing::TempDir() + "TestMappedCsvReader_errors.csv";
+	writeFile(filename, "a\n\"b\" c\n");
+	MappedCsvReader reader(filename);
+	std::vector<MappedCsvReader::Field> fields;
+	ASSERT_TRUE(reader.readRow(fields));
+	ASSERT_THROW(reader.readRow(fields), MappedCsvReader::FileError);
+
+	ASSERT_THROW(MappedCsvReader(filename + ".missing"), MappedCsvReader::FileError);
+}
+
+TEST(TestMappedCsvReader, chunks)
+{
+	const std::string filename = testing::TempDir() + "TestMappedCsvReader_chunks.txt";
+	std::string content;
+	const int numRows = 1000;
+	for (int i = 0; i < numRows; ++i) {
+		content += "US:PA|" + std::to_string(i) + "|\"q\n";
+	}
+	writeFile(filename, content);
+	MappedCsvReader reader(filename, '|', '\0');
+
+	for (int numChunks : {1, 3, 7, 5000}) {
+		int expected = 0;
+		for (const auto &chunk : reader.split(numChunks)) {
+			MappedCsvReader::Cursor cursor(reader, chunk);
+			std::vector<MappedCsvReader::Field> fields;
+			while (cursor.readRow(fields)) {
+				ASSERT_EQ(3u, fields.size());
+				ASSERT_EQ("\"q", MappedCsvReader::toString(fields[2]));
+				long value;
+				ASSERT_TRUE(MappedCsvReader::toLong(fields[1], value));
+				ASSERT_EQ(expected++, value);
+			}
+		}
+		ASSERT_EQ(numRows, expected);
+	}
+}
@@ -61,6 +61,13 @@ export interface AFCConfigFile {
   allowScanPtsInUncReg?: boolean;
   passiveRepeaterFlag?: boolean;
   printSkippedLinksFlag?: boolean;
+  rxGainTableFlag?: boolean;
+  itmScreeningFlag?: boolean;
+  itmScreeningMarginDB?: number;
+  itmScreeningDecimation?: number;
+  heatmapRefineFlag?: boolean;
+  heatmapRefineStep?: number;
+  heatmapRefineTolDB?: number;
   reportErrorRlanHeightLowFlag?: boolean;
   nearFieldAdjFlag?: boolean;
   deniedRegionFile?: string;
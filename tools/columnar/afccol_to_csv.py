@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+""" Converts binary columnar files, produced by AFC Engine, to CSV """
+#
+# Copyright (C) 2023 Broadcom. All rights reserved. The term "Broadcom"
+# refers solely to the Broadcom Inc. corporate affiliate that owns
+# the software below. This work is licensed under the OpenAFC Project License,
+# a copy of which is included with this software program
+#
+
+# pylint: disable=invalid-name, too-many-locals
+
+import argparse
+import array
+import gzip
+import struct
+import sys
+from typing import Any, BinaryIO, Dict, Iterator, List, NamedTuple, Optional
+
+# File signature
+MAGIC = b"AFCCOL1\0"
+
+# Column types (as in ColumnarWriter::ColType)
+TYPE_INT32 = 1
+TYPE_FLOAT64 = 2
+TYPE_STRING = 3
+TYPE_BOOL = 4
+TYPE_ENUM = 5
+
+# Array typecodes of column values
+ARRAY_TYPECODES = {TYPE_INT32: "i", TYPE_FLOAT64: "d", TYPE_STRING: "I",
+                   TYPE_BOOL: "B", TYPE_ENUM: "i"}
+
+_EPILOG = """Binary columnar files (e.g. exc_thr.afccol) are created by AFC
+Engine, invoked with --exc-thr-format=columnar. Output is the same CSV that
+AFC Engine would have written in CSV mode. Output file with .gz extension is
+GZIPped"""
+
+
+class ColumnInfo(NamedTuple):
+    """ Column descriptor from file header """
+    # Column name
+    name: str
+
+    # Column type (TYPE_...)
+    col_type: int
+
+    # Printf format for double column, name for unknown items of enum column
+    fmt: str
+
+    # Enum item names, bool true (1)/false (0) names
+    labels: Dict[int, str]
+
+
+class Reader:
+    """ Reader of binary columnar file
+
+    Public attributes:
+    columns -- List of column descriptors
+    """
+
+    def __init__(self, f: BinaryIO) -> None:
+        """ Constructor, reads header
+
+        Arguments:
+        f -- File opened for binary reading
+        """
+        if sys.byteorder != "little":
+            raise ValueError("Only little-endian platforms are supported")
+        self._f = f
+        if self._read(len(MAGIC)) != MAGIC:
+            raise ValueError("Not a binary columnar file")
+        self.columns: List[ColumnInfo] = []
+        for _ in range(self._read_uint32()):
+            col_type = struct.unpack("<B", self._read(1))[0]
+            name = self._read_str()
+            fmt = self._read_str()
+            labels: Dict[int, str] = {}
+            for _ in range(self._read_uint32()):
+                key = struct.unpack("<i", self._read(4))[0]
+                labels[key] = self._read_str()
+            self.columns.append(
+                ColumnInfo(name=name, col_type=col_type, fmt=fmt,
+                           labels=labels))
+        self._dicts: List[List[str]] = [[] for _ in self.columns]
+
+    def groups(self) -> Iterator[List[List[Optional[Any]]]]:
+        """ Iterates over row groups
+
+        Yields list of columns, each being list of values (None for absent
+        values). String column values are strings, bool column values are
+        bools, others are numbers
+        """
+        while True:
+            num_rows = self._read_uint32()
+            if num_rows == 0:
+                return
+            group: List[List[Optional[Any]]] = []
+            for col_idx, ci in enumerate(self.columns):
+                valid = self._read((num_rows + 7) // 8)
+                if ci.col_type == TYPE_STRING:
+                    for _ in range(self._read_uint32()):
+                        self._dicts[col_idx].append(self._read_str())
+                values = array.array(ARRAY_TYPECODES[ci.col_type])
+                values.frombytes(self._read(num_rows * values.itemsize))
+                col: List[Optional[Any]] = []
+                for row, value in enumerate(values):
+                    if not valid[row // 8] & (1 << (row % 8)):
+                        col.append(None)
+                    elif ci.col_type == TYPE_STRING:
+                        col.append(self._dicts[col_idx][value])
+                    elif ci.col_type == TYPE_BOOL:
+                        col.append(bool(value))
+                    else:
+                        col.append(value)
+                group.append(col)
+            yield group
+
+    def read_all(self) -> Dict[str, List[Optional[Any]]]:
+        """ Reads whole file into dictionary of columns, indexed by column
+        names (suitable for pandas.DataFrame()) """
+        ret: Dict[str, List[Optional[Any]]] = \
+            {ci.name: [] for ci in self.columns}
+        for group in self.groups():
+            for ci, col in zip(self.columns, group):
+                ret[ci.name].extend(col)
+        return ret
+
+    def _read(self, size: int) -> bytes:
+        """ Reads given number of bytes """
+        ret = self._f.read(size)
+        if len(ret) != size:
+            raise ValueError("Unexpected end of file")
+        return ret
+
+    def _read_uint32(self) -> int:
+        """ Reads 32-bit unsigned integer """
+        return struct.unpack("<I", self._read(4))[0]
+
+    def _read_str(self) -> str:
+        """ Reads string """
+        return self._read(self._read_uint32()).decode("utf-8")
+
+
+def csv_field(s: str) -> str:
+    """ Quotes CSV field if necessary (same rule as in AFC Engine) """
+    if any(c in s for c in ",\"\r\n"):
+        return '"' + s.replace('"', '""') + '"'
+    return s
+
+
+def format_value(ci: ColumnInfo, value: Optional[Any]) -> str:
+    """ Formats value the same way as AFC Engine formats it in CSV """
+    if value is None:
+        return ""
+    if ci.col_type == TYPE_FLOAT64:
+        return ci.fmt % value
+    if ci.col_type == TYPE_STRING:
+        return csv_field(value)
+    if ci.col_type == TYPE_BOOL:
+        return csv_field(ci.labels[1 if value else 0])
+    if ci.col_type == TYPE_ENUM:
+        return csv_field(f"{ci.labels.get(value, ci.fmt)} ({value})")
+    return str(value)
+
+
+def main(argv: List[str]) -> None:
+    """Do the job.
+
+    Arguments:
+    argv -- Program arguments
+    """
+    argument_parser = argparse.ArgumentParser(
+        description="Converts binary columnar files, produced by AFC Engine, "
+        "to CSV",
+        formatter_class=argparse.RawDescriptionHelpFormatter, epilog=_EPILOG)
+    argument_parser.add_argument(
+        "SRC", help="Binary columnar file (e.g. exc_thr.afccol)")
+    argument_parser.add_argument(
+        "DST", nargs="?",
+        help="Resulting CSV file (.csv or .csv.gz). Default is to print to "
+        "standard output")
+    args = argument_parser.parse_args(argv)
+
+    with open(args.SRC, "rb") as src:
+        reader = Reader(src)
+        if args.DST is None:
+            dst = sys.stdout.buffer
+        elif args.DST.endswith(".gz"):
+            dst = gzip.open(args.DST, "wb")
+        else:
+            dst = open(args.DST, "wb")
+        try:
+            for group_idx, group in enumerate(reader.groups()):
+                if group_idx == 0:
+                    # Like AFC Engine, heading is only written before rows
+                    dst.write(
+                        (",".join(csv_field(ci.name)
+                                  for ci in reader.columns) +
+                         "\r\n").encode("utf-8"))
+                for row in zip(*group):
+                    dst.write(
+                        (",".join(format_value(ci, value) for ci, value
+                                  in zip(reader.columns, row)) +
+                         "\r\n").encode("utf-8"))
+        finally:
+            if dst is not sys.stdout.buffer:
+                dst.close()
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,347 @@
+#!/usr/bin/env python3
+# Converts LiDAR files to compact (3-band) representation used by AFC Engine
+
+# Copyright (C) 2022 Broadcom. All rights reserved.
+# The term "Broadcom" refers solely to the Broadcom Inc. corporate affiliate
+# that owns the software below.
+# This work is licensed under the OpenAFC Project License, a copy of which is
+# included with this software program.
+
+# pylint: disable=wildcard-import, unused-wildcard-import, too-many-arguments
+# pylint: disable=too-many-locals, invalid-name, too-many-return-statements
+# pylint: disable=too-many-branches, too-many-statements, wrong-import-order
+
+import argparse
+import csv
+import datetime
+import enum
+import multiprocessing.pool
+import os
+import signal
+import sys
+from typing import List, NamedTuple, Optional, Tuple
+
+import numpy
+from osgeo import gdal
+
+from geoutils import *
+
+# Pattern for .csv name that corresponds to locality name
+CSV_PATTERN = "%s_info.csv"
+
+# Values of FORMAT column of .csv file
+SRC_FORMAT_VECTOR = "from_vector"
+SRC_FORMAT_RASTER = "from_raster"
+DST_FORMAT = "compact"
+
+# Height quantum in meters (heights are stored in these units). Must match
+# MultibandRasterClass::COMPACT_HEIGHT_SCALE
+HEIGHT_QUANTUM_M = 0.1
+
+# Offset of bare earth height in meters. Must match
+# MultibandRasterClass::COMPACT_TERRAIN_OFFSET
+TERRAIN_OFFSET_M = -1000.
+
+# No-data value for all bands (never written to building and mask bands)
+NO_DATA = 65535
+
+# Number of raster rows processed at once
+ROWS_PER_CHUNK = 1024
+
+# Default output format options
+DEFAULT_FORMAT_PARAMS = ["COMPRESS=DEFLATE", "TILED=YES", "BIGTIFF=IF_SAFER"]
+
+# Conversion result status
+ConvStatus = enum.Enum("ConvStatus", ["Success", "Exists", "Error"])
+
+_EPILOG = """Source LiDAR files are 2-band files (band 1 - bare earth, band 2 -
+building height) indexed by per-locality .csv files. Result is a set of 3-band
+UInt16 GeoTiff files indexed by .csv files of the same structure:
+  - Band 1: bare earth height in decimeters above -1000m
+  - Band 2: building height in decimeters
+  - Band 3: building mask (1 where there is a building, 0 otherwise)
+Building mask is computed with the same rules AFC Engine applies to source
+files, so engine, reading compact files, produces the same results (up to
+rounding of heights to decimeters), but reads building height band only where
+there are buildings.
+Some usage examples:
+
+- Convert lidars in proc_lidar_2019, result in COMPACT_LIDARS directory,
+  use 8 CPUs on lowered (nice) priority:
+   $ lidar_compact.py --threads 8 --nice proc_lidar_2019 COMPACT_LIDARS
+"""
+
+
+class ConvResult(NamedTuple):
+    """ Conversion result """
+
+    # Name of converted file
+    filename: str
+
+    # Conversion status
+    status: ConvStatus
+
+    # Conversion duration
+    duration: datetime.timedelta
+
+    # Optional error message
+    msg: Optional[str] = None
+
+
+def compact_worker(src_filename: str, dst_filename: str, src_format: str,
+                   format_params: List[str], overwrite: bool) -> ConvResult:
+    """ Conversion worker
+
+    Arguments:
+    src_filename  -- Source 2-band LiDAR file
+    dst_filename  -- Resulting 3-band GeoTiff file
+    src_format    -- Source file format (value of FORMAT column in .csv)
+    format_params -- Output format parameters
+    overwrite     -- True to overwrite existing files
+    Return Conversion result
+    """
+    start_time = datetime.datetime.now()
+    temp_filename = os.path.splitext(dst_filename)[0] + ".incomplete.tif"
+    try:
+        if os.path.isfile(dst_filename) and (not overwrite):
+            return ConvResult(filename=src_filename, status=ConvStatus.Exists,
+                              duration=datetime.datetime.now() - start_time)
+        src_ds = gdal.Open(src_filename, gdal.GA_ReadOnly)
+        if src_ds is None:
+            return ConvResult(filename=src_filename, status=ConvStatus.Error,
+                              duration=datetime.datetime.now() - start_time,
+                              msg=f"Unable to open '{src_filename}'")
+        if src_ds.RasterCount < 2:
+            return ConvResult(filename=src_filename, status=ConvStatus.Error,
+                              duration=datetime.datetime.now() - start_time,
+                              msg=f"'{src_filename}' has less than 2 bands")
+        os.makedirs(os.path.dirname(dst_filename) or ".", exist_ok=True)
+        dst_ds = gdal.GetDriverByName("GTiff").Create(
+            temp_filename, src_ds.RasterXSize, src_ds.RasterYSize, 3,
+            gdal.GDT_UInt16, options=format_params)
+        dst_ds.SetGeoTransform(src_ds.GetGeoTransform())
+        dst_ds.SetProjection(src_ds.GetProjection())
+        src_terrain = src_ds.GetRasterBand(1)
+        src_bldg = src_ds.GetRasterBand(2)
+        terrain_no_data = src_terrain.GetNoDataValue()
+        bldg_no_data = src_bldg.GetNoDataValue()
+        dst_terrain, dst_bldg, dst_mask = \
+            [dst_ds.GetRasterBand(i) for i in (1, 2, 3)]
+        for band in (dst_terrain, dst_bldg, dst_mask):
+            band.SetNoDataValue(NO_DATA)
+        dst_terrain.SetScale(HEIGHT_QUANTUM_M)
+        dst_terrain.SetOffset(TERRAIN_OFFSET_M)
+        dst_terrain.SetDescription("Bare earth height")
+        dst_bldg.SetScale(HEIGHT_QUANTUM_M)
+        dst_bldg.SetDescription("Building height")
+        dst_mask.SetDescription("Building mask")
+        building_pixels = 0
+        for row in range(0, src_ds.RasterYSize, ROWS_PER_CHUNK):
+            rows = min(ROWS_PER_CHUNK, src_ds.RasterYSize - row)
+            terrain = src_terrain.ReadAsArray(0, row, src_ds.RasterXSize,
+                                              rows).astype(numpy.float32)
+            bldg = src_bldg.ReadAsArray(0, row, src_ds.RasterXSize,
+                                        rows).astype(numpy.float32)
+            # Same rules as in MultibandRasterClass::getHeight()
+            terrain_valid = ~numpy.isnan(terrain)
+            if terrain_no_data is not None:
+                terrain_valid &= terrain != numpy.float32(terrain_no_data)
+            bldg_valid = ~numpy.isnan(bldg)
+            if bldg_no_data is not None:
+                bldg_valid &= bldg != numpy.float32(bldg_no_data)
+            mask = terrain_valid & bldg_valid
+            if src_format == SRC_FORMAT_RASTER:
+                with numpy.errstate(invalid="ignore"):
+                    mask &= bldg > (terrain + 1)
+                # Raster format pixel without building data has no data
+                terrain_valid &= bldg_valid
+            terrain = numpy.where(
+                terrain_valid,
+                numpy.clip(numpy.rint((numpy.nan_to_num(terrain) -
+                                       TERRAIN_OFFSET_M) / HEIGHT_QUANTUM_M),
+                           0, NO_DATA - 1), NO_DATA).astype(numpy.uint16)
+            heights = numpy.where(
+                mask,
+                numpy.clip(numpy.rint(numpy.nan_to_num(bldg) /
+                                      HEIGHT_QUANTUM_M),
+                           0, NO_DATA - 1), 0).astype(numpy.uint16)
+            building_pixels += int(numpy.count_nonzero(mask))
+            dst_terrain.WriteArray(terrain, 0, row)
+            dst_bldg.WriteArray(heights, 0, row)
+            dst_mask.WriteArray(mask.astype(numpy.uint16), 0, row)
+        total_pixels = src_ds.RasterXSize * src_ds.RasterYSize
+        dst_ds.FlushCache()
+        dst_ds = None
+        src_ds = None
+        if os.path.isfile(dst_filename):
+            os.unlink(dst_filename)
+        os.rename(temp_filename, dst_filename)
+        return ConvResult(
+            filename=src_filename, status=ConvStatus.Success,
+            duration=datetime.datetime.now() - start_time,
+            msg=f"Building pixels: "
+            f"{building_pixels * 100 / max(total_pixels, 1):.1f}%")
+    except (Exception, KeyboardInterrupt, SystemExit) as ex:
+        return ConvResult(filename=src_filename, status=ConvStatus.Error,
+                          duration=datetime.datetime.now() - start_time,
+                          msg=repr(ex))
+    finally:
+        try:
+            if os.path.isfile(temp_filename):
+                os.unlink(temp_filename)
+        except OSError:
+            pass
+
+
+def main(argv: List[str]) -> None:
+    """Do the job.
+
+    Arguments:
+    argv -- Program arguments
+    """
+    argument_parser = argparse.ArgumentParser(
+        description="Converts LiDAR files to compact representation with "
+        "building mask",
+        formatter_class=argparse.RawDescriptionHelpFormatter, epilog=_EPILOG)
+    argument_parser.add_argument(
+        "--overwrite", action="store_true",
+        help="Overwrite existing files. By default they are skipped (to "
+        "achieve easy resumption of the process)")
+    argument_parser.add_argument(
+        "--format_param", metavar="NAME=VALUE", action="append",
+        help=f"GeoTiff format option. May be specified several times. "
+        f"Default is {' '.join(DEFAULT_FORMAT_PARAMS)}")
+    argument_parser.add_argument(
+        "--threads", metavar="COUNT_OR_PERCENT%",
+        help="Number of threads to use. If positive - number of threads, if "
+        "negative - number of CPU cores NOT to use, if followed by `%%` - "
+        "percent of CPU cores. Default is total number of CPU cores")
+    argument_parser.add_argument(
+        "--nice", action="store_true",
+        help="Lower priority of this process and its subprocesses")
+    argument_parser.add_argument(
+        "--locality", metavar="LOCALITY_NAME", action="append",
+        help="Do the conversion only for given locality (name of subdirectory "
+        "with LiDAR files, initial part of .csv file name). This parameter "
+        "may be specified more than once. Default is to do the conversion for "
+        "all localities")
+    argument_parser.add_argument(
+        "SRC_DIR",
+        help="Source directory - root of all LiDAR files, where .csv files "
+        "are")
+    argument_parser.add_argument(
+        "DST_DIR", help="Target directory")
+
+    if not argv:
+        argument_parser.print_help()
+        sys.exit(1)
+    args = argument_parser.parse_args(argv)
+
+    setup_logging()
+
+    if args.nice:
+        nice()
+
+    error_if(not os.path.isdir(args.SRC_DIR),
+             f"Source directory '{args.SRC_DIR}' not found")
+    gdal.UseExceptions()
+
+    start_time = datetime.datetime.now()
+
+    localities: List[str] = args.locality or \
+        [loc for loc in os.listdir(args.SRC_DIR)
+         if os.path.isdir(os.path.join(args.SRC_DIR, loc)) and
+         os.path.isfile(os.path.join(args.SRC_DIR, CSV_PATTERN % loc))]
+    error_if(not localities, f"No LiDAR localities found in '{args.SRC_DIR}'")
+
+    # Source file name, destination file name, source format
+    jobs: List[Tuple[str, str, str]] = []
+    for locality in localities:
+        src_csv = os.path.join(args.SRC_DIR, CSV_PATTERN % locality)
+        error_if(not os.path.isfile(src_csv),
+                 f"Source data for locality '{locality}' not found in "
+                 f"'{args.SRC_DIR}'")
+        os.makedirs(os.path.join(args.DST_DIR, locality), exist_ok=True)
+        with open(src_csv, newline='', encoding="utf-8") as src_f, \
+                open(os.path.join(args.DST_DIR, CSV_PATTERN % locality), "w",
+                     newline='', encoding="utf-8") as dst_f:
+            reader = csv.DictReader(
+                row for row in src_f if not row.lstrip().startswith("#"))
+            error_if("FILE" not in (reader.fieldnames or []),
+                     f"Invalid '{src_csv}' file structure")
+            fieldnames = list(reader.fieldnames or [])
+            if "FORMAT" not in fieldnames:
+                fieldnames.append("FORMAT")
+            writer = csv.DictWriter(dst_f, fieldnames=fieldnames)
+            writer.writeheader()
+            for row in reader:
+                src_format = row.get("FORMAT") or SRC_FORMAT_VECTOR
+                error_if(src_format not in (SRC_FORMAT_VECTOR,
+                                            SRC_FORMAT_RASTER),
+                         f"Unsupported format '{src_format}' in '{src_csv}'")
+                dst_file = os.path.splitext(row["FILE"])[0] + ".tif"
+                jobs.append(
+                    (os.path.join(args.SRC_DIR, locality, row["FILE"]),
+                     os.path.join(args.DST_DIR, locality, dst_file),
+                     src_format))
+                row["FILE"] = dst_file
+                row["FORMAT"] = DST_FORMAT
+                writer.writerow(row)
+
+    completed_count = [0]  # List to facilitate closure in completer()
+    total_count = len(jobs)
+    skipped_files: List[str] = []
+    failed_files: List[str] = []
+
+    def completer(cr: ConvResult) -> None:
+        """ Processes completion of a single file """
+        completed_count[0] += 1
+        msg = f"{completed_count[0]} of {total_count} " \
+            f"({completed_count[0] * 100 // total_count}%) {cr.filename}: "
+        if cr.status == ConvStatus.Exists:
+            msg += "Destination file exists. Skipped"
+            skipped_files.append(cr.filename)
+        elif cr.status == ConvStatus.Error:
+            if cr.msg is not None:
+                msg += "\n" + cr.msg
+            failed_files.append(cr.filename)
+        else:
+            assert cr.status == ConvStatus.Success
+            if cr.msg is not None:
+                msg += cr.msg + ". "
+            msg += f"Converted in {Durator.duration_to_hms(cr.duration)}"
+        print(msg)
+
+    format_params = args.format_param or DEFAULT_FORMAT_PARAMS
+    try:
+        original_sigint_handler = \
+            signal.signal(signal.SIGINT, signal.SIG_IGN)
+        with multiprocessing.pool.ThreadPool(
+                processes=threads_arg(args.threads)) as pool:
+            signal.signal(signal.SIGINT, original_sigint_handler)
+            for src_filename, dst_filename, src_format in jobs:
+                pool.apply_async(
+                    compact_worker,
+                    kwds={"src_filename": src_filename,
+                          "dst_filename": dst_filename,
+                          "src_format": src_format,
+                          "format_params": format_params,
+                          "overwrite": args.overwrite},
+                    callback=completer)
+            pool.close()
+            pool.join()
+        if skipped_files:
+            print(f"{len(skipped_files)} previously converted files skipped")
+        if failed_files:
+            print("Following files were not converted due to errors:")
+            for filename in sorted(failed_files):
+                print(f"  {filename}")
+        print(
+            f"Total duration: "
+            f"{Durator.duration_to_hms(datetime.datetime.now() - start_time)}")
+    except KeyboardInterrupt:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+""" Renders terrain access profiles, produced by AFC Engine """
+#
+# Copyright (C) 2023 Broadcom. All rights reserved. The term "Broadcom"
+# refers solely to the Broadcom Inc. corporate affiliate that owns
+# the software below. This work is licensed under the OpenAFC Project License,
+# a copy of which is included with this software program
+#
+
+# pylint: disable=invalid-name, too-many-locals
+
+import argparse
+import collections
+import csv
+import math
+import sys
+from typing import DefaultDict, Dict, List, NamedTuple, Set, Tuple
+
+# Characters used in heat map, from coldest to hottest
+HEAT_RAMP = " .:-=+*#%@"
+
+# Default number of hot cells to print
+DEFAULT_TOP = 20
+
+# Share of reloads (among all loads) above which larger cache is recommended
+RELOAD_SHARE_THRESHOLD = 0.1
+
+_EPILOG = """Terrain access profile (terrain_profile.csv) is created by AFC
+Engine, invoked with bit 6 (64) set in --runtime_opt, next to exc_thr.csv.gz.
+Several profiles (e.g. from several requests) may be rendered together"""
+
+
+class Totals:
+    """ Accumulated access statistics """
+
+    def __init__(self) -> None:
+        self.lookups = 0
+        self.loads = 0
+        self.load_ms = 0.
+        self.tiles = 0
+
+    def add(self, row: Dict[str, str]) -> None:
+        """ Adds statistics from profile row """
+        self.lookups += int(row["LOOKUPS"])
+        self.loads += int(row["LOADS"])
+        self.load_ms += float(row["LOAD_MS"])
+        self.tiles += 1
+
+    @property
+    def reloads(self) -> int:
+        """ Number of loads of previously evicted tiles """
+        return self.loads - self.tiles
+
+
+class DatasetInfo(NamedTuple):
+    """ Data set parameters as reported by AFC Engine """
+    # Maximum number of tiles in LRU cache
+    cache_size: int
+
+    # Maximum tile size in one dimension
+    max_tile_size: int
+
+
+def main(argv: List[str]) -> None:
+    """Do the job.
+
+    Arguments:
+    argv -- Program arguments
+    """
+    argument_parser = argparse.ArgumentParser(
+        description="Renders terrain access profiles, produced by AFC Engine",
+        formatter_class=argparse.RawDescriptionHelpFormatter, epilog=_EPILOG)
+    argument_parser.add_argument(
+        "--dataset", metavar="DATASET_NAME", action="append",
+        help="Only render given data set(s) (e.g. lidar, srtm, 3dep). May be "
+        "specified several times. Default is to render all data sets")
+    argument_parser.add_argument(
+        "--top", metavar="COUNT", type=int, default=DEFAULT_TOP,
+        help=f"Number of hottest 1x1 degree cells to print. Default is "
+        f"{DEFAULT_TOP}")
+    argument_parser.add_argument(
+        "--map", action="store_true",
+        help="Print text heat map of lookups per 1x1 degree cell for each "
+        "data set")
+    argument_parser.add_argument(
+        "PROFILE", nargs="+", help="terrain_profile.csv file(s)")
+    args = argument_parser.parse_args(argv)
+
+    per_dataset: DefaultDict[str, Totals] = collections.defaultdict(Totals)
+    per_cell: DefaultDict[Tuple[str, int, int], Totals] = \
+        collections.defaultdict(Totals)
+    dataset_infos: Dict[str, Set[DatasetInfo]] = collections.defaultdict(set)
+    # Maximum number of distinct tiles, used by single instance in single run
+    working_set: DefaultDict[str, int] = collections.defaultdict(int)
+    for filename in args.PROFILE:
+        per_instance: DefaultDict[Tuple[str, str], int] = \
+            collections.defaultdict(int)
+        with open(filename, newline="", encoding="utf-8") as f:
+            for row in csv.DictReader(f):
+                dataset = row["DATASET"]
+                if args.dataset and (dataset not in args.dataset):
+                    continue
+                per_dataset[dataset].add(row)
+                lat = (float(row["MIN_LAT_DEG"]) +
+                       float(row["MAX_LAT_DEG"])) / 2
+                lon = (float(row["MIN_LON_DEG"]) +
+                       float(row["MAX_LON_DEG"])) / 2
+                per_cell[(dataset, math.floor(lat), math.floor(lon))].add(row)
+                dataset_infos[dataset].add(
+                    DatasetInfo(cache_size=int(row["CACHE_SIZE"]),
+                                max_tile_size=int(row["MAX_TILE_SIZE"])))
+                per_instance[(dataset, row["INSTANCE"])] += 1
+        for (dataset, _), tiles in per_instance.items():
+            working_set[dataset] = max(working_set[dataset], tiles)
+    if not per_dataset:
+        print("No data found")
+        return
+
+    print("Data sets:")
+    for dataset in sorted(per_dataset):
+        t = per_dataset[dataset]
+        infos = ", ".join(
+            f"cache {di.cache_size} tiles of up to {di.max_tile_size}px"
+            for di in sorted(dataset_infos[dataset]))
+        print(f"  {dataset} ({infos}): tiles: {t.tiles}, "
+              f"lookups: {t.lookups}, loads: {t.loads}, "
+              f"reloads: {t.reloads}, load time: {t.load_ms / 1000:.3f}s, "
+              f"max tiles per instance: {working_set[dataset]}")
+        if t.loads and \
+                ((t.reloads / t.loads) > RELOAD_SHARE_THRESHOLD):
+            print(f"    {t.reloads * 100 // t.loads}% of loads are reloads "
+                  f"of evicted tiles - consider cache size of at least "
+                  f"{working_set[dataset]} tiles or bigger tiles")
+
+    print("Hottest 1x1 degree cells (by lookups):")
+    print(f"  {'DATASET':<12} {'CELL':<10} {'LOOKUPS':>12} {'LOADS':>8} "
+          f"{'RELOADS':>8} {'LOAD_S':>9}")
+    for (dataset, lat, lon), t in \
+            sorted(per_cell.items(),
+                   key=lambda kv: kv[1].lookups, reverse=True)[:args.top]:
+        cell = f"{'N' if lat >= 0 else 'S'}{abs(lat):02}" \
+            f"{'E' if lon >= 0 else 'W'}{abs(lon):03}"
+        print(f"  {dataset:<12} {cell:<10} {t.lookups:>12} {t.loads:>8} "
+              f"{t.reloads:>8} {t.load_ms / 1000:>9.3f}")
+
+    if args.map:
+        for dataset in sorted(per_dataset):
+            cells = {(lat, lon): t.lookups
+                     for (ds, lat, lon), t in per_cell.items()
+                     if ds == dataset}
+            lats = [lat for lat, _ in cells]
+            lons = [lon for _, lon in cells]
+            max_lookups = max(max(cells.values()), 1)
+            print(f"Heat map of {dataset} lookups, latitudes "
+                  f"{min(lats)}..{max(lats)}, longitudes "
+                  f"{min(lons)}..{max(lons)} (north is up):")
+            for lat in range(max(lats), min(lats) - 1, -1):
+                line = ""
+                for lon in range(min(lons), max(lons) + 1):
+                    lookups = cells.get((lat, lon), 0)
+                    line += HEAT_RAMP[
+                        0 if lookups == 0 else
+                        1 + int(math.log1p(lookups) *
+                                (len(HEAT_RAMP) - 2) /
+                                math.log1p(max_lookups))]
+                print(f"  {lat:>4} |{line}|")
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])